@@ -14,17 +14,32 @@
  * The lamp is controlled by a strategy where the system compares the accumulated hours of light
  * against a schedule of expected hours of light during a day. It turns on the lamp when
  * the system is behind schedule.
+ *
+ * The schedule and the accumulator are integer milliseconds (see fixedPoint.h);
+ * state.lightHoursToday is derived from the exact count, so it does not drift.
+ *
+ * Every zone has its own lamp, target and counter; the LDR is shared, so all
+ * zones see the same ambient light and share one day.
+ *
+ * The LDR is sampled by adcSampler from the periodic timer, LDR_OVERSAMPLE
+ * readings per average, so lightUpdate() never waits for the ADC. Each average
+ * passes a sensorFilter (LDR_FILTER) before the darkness test, so a spike that
+ * survives the averaging neither switches the lamp nor counts as light.
 */
 
 #include "Lightsensor.h"
 #include <Arduino.h>
 #include <math.h>
+#include "hal.h"
+#include "fixedPoint.h"
+#include "zones.h"
+#include "adcSampler.h"
+#include "actuators.h"
 
 /**
  * @name Hardware pins
 */
 static const uint8_t LDR_PIN = A0;
-static const uint8_t LEDPIN  = D5;
 
 /**
  * @brief Raw ADC threshold for the definition of darkness. 
@@ -34,16 +49,19 @@ static const uint8_t LEDPIN  = D5;
 */
 static int DARK_THRESHOLD = 1000;
 
-/**
- *@brief Minimum time between light samples in milliseconds as to 
- * save on resources.
-*/
-static const uint32_t SAMPLE_MS = 1000;
+/// Behind-schedule margin (0.001 h), so the lamp does not chatter on the boundary
+static constexpr uint32_t SCHEDULE_MARGIN_MS = fixedConst(0.001, MS_PER_HOUR);
 
 /// Internal state
-static uint32_t lastSampleMs = 0;
+static uint32_t lastSampleMs = 0; ///< Time of the previous sample, for light accumulation
 static uint32_t dayStartMs   = 0;
-static float hoursToday      = 0.0f;
+static uint32_t lightMsToday[ZONE_MAX]; ///< Effective light so far today, per zone
+static uint32_t targetMs[ZONE_MAX];     ///< state.targetLightHoursToday in ms
+static uint32_t targetGeneration = 0;
+static bool targetValid      = false;
+static SensorFilter ldrFilter;
+static int16_t ldrLevel = 0;      ///< Filtered LDR reading
+static bool ldrValid = false;     ///< ldrLevel holds a reading
 
 /**
  * @brief Clamp a floating-point value to a given range.
@@ -72,82 +90,124 @@ static float clamp(float x, float lo, float hi) {
 
 static void resetDay(uint32_t now, SharedState &state) {
   dayStartMs = now;
-  hoursToday = 0.0f;
-  state.lightHoursToday = 0.0f;
+  for (uint8_t z = 0; z < state.zoneCount; z++) {
+    lightMsToday[z] = 0;
+    state.lightHoursToday[z] = 0.0f;
+  }
 }
 
 
 /**
  * @brief Start light sensor and lamp.
  * 
- * @details Configures lamp and sensor pin
- * and starts internal timer.
+ * @details Attaches the lamp pin of every zone to the actuator layer (off),
+ * starts internal timer and LDR acquisition.
  *
- * Call this function in setup() before lightUpdate().
+ * Call this function in setup(), after zonesBegin() and actuatorsBegin() and before lightUpdate().
 */
 void lightInit() {
-  pinMode(LEDPIN, OUTPUT);
-  digitalWrite(LEDPIN, LOW);
+  for (uint8_t z = 0; z < zoneCount(); z++) {
+    actuatorAttach(z, ACT_LAMP, zonePins(z).lamp, false);
+  }
 
-  uint32_t now = millis();
+  uint32_t now = halMillis();
   lastSampleMs = now;
   dayStartMs = now;
-  hoursToday = 0.0f;
+  for (uint8_t z = 0; z < ZONE_MAX; z++) lightMsToday[z] = 0;
+  targetValid = false;
+  filterInit(ldrFilter, LDR_FILTER);
+  ldrValid = false;
+  adcSamplerBegin(LDR_PIN, LDR_SAMPLE_MS, LDR_OVERSAMPLE);
+}
+
+/**
+ * @brief Convert the light targets to milliseconds when the state generation changed.
+ */
+static void refreshTargets(const SharedState &state) {
+  if (targetValid && targetGeneration == state.generation) return;
+  targetGeneration = state.generation;
+  targetValid = true;
+  for (uint8_t z = 0; z < state.zoneCount; z++) {
+    const float hrs = state.targetLightHoursToday[z];
+    targetMs[z] = isnan(hrs) ? 0 : (uint32_t)lroundf(clamp(hrs, 0.0f, 24.0f) * MS_PER_HOUR);
+  }
+}
+
+/**
+ * @brief Feed the ready LDR averages through the filter.
+ *
+ * Normally one average is ready per call. If none is (the sampler was
+ * starved), the previous level stands; only before the first average is the
+ * ADC read directly.
+ */
+static void consumeLdr() {
+  uint16_t average;
+  while (adcSamplerRead(average)) {
+    ldrLevel = filterPush(ldrFilter, (int16_t)average);
+    ldrValid = true;
+  }
+  if (!ldrValid) {
+    ldrLevel = filterPush(ldrFilter, (int16_t)halAnalogRead(LDR_PIN));
+    ldrValid = true;
+  }
 }
 
 /**
  * @brief Update lamp state and accumulate hours of light.
  * 
  * @details 
- * This function starts by resetting the daily counter every 24 hours. Samples fron the analog pin
- * every (default) 1 seconds. It determines if the light is sufficient and turns on the
- * light if the greenhouse is behind schedule. It counts how many hours of light there has been.
+ * This function starts by resetting the daily counter every 24 hours. Takes the LDR averages
+ * the sampler has ready; the scheduler calls it every LIGHT_SAMPLE_MS, once per average.
+ * It determines if the light is sufficient and turns on the light if the greenhouse is
+ * behind schedule. It counts how many hours of light there has been since the previous call.
+ * The ambient level is applied to every zone.
  * 
- * @param state Shared state structure:
+ * @param state Shared state structure (per zone):
  *  - Reads:  `state.targetLightHoursToday`
  *  - Writes: `state.lampOn`, `state.lightHoursToday`
+ *  - Drives: every zone's lamp, in one actuatorsCommit() at the end
 */
 void lightUpdate(SharedState &state) {
-  uint32_t now = millis();
+  uint32_t now = halMillis();
 
-  const uint32_t dayLenMs = 24UL * 60UL * 60UL * 1000UL;
-
-  if ((uint32_t)(now - dayStartMs) >= dayLenMs) {
+  if ((uint32_t)(now - dayStartMs) >= DAY_MS) {
     resetDay(now, state);
   }
 
-  if ((uint32_t)(now - lastSampleMs) < SAMPLE_MS) { /// To avoid reading from the analog pin too much. It is very slow and might throttle program.
-    state.lightHoursToday = hoursToday;
-    return;
-  }
-
   uint32_t elapsedSampleMs = now - lastSampleMs;
   lastSampleMs = now;
 
-  int raw = analogRead(LDR_PIN);
-  bool ambientDark = (raw < DARK_THRESHOLD);
-
-  const float targetHrs  = clamp(state.targetLightHoursToday, 0.0, 24.0); /// Get the target 
-  const float elapsedHrs = (now - dayStartMs) / 3600000.0; /// How many hours into the current day are we?
-  const float dayLenHrs  = dayLenMs / 3600000.0; /// Day lenght in hours
-
-  bool lampOn = false; /// Turn it off by default, unless it is turned on
-
-  if (targetHrs > 0.0f && hoursToday < targetHrs) {
-    float expectedSoFar = targetHrs * (elapsedHrs / dayLenHrs); /// Figuring out how many hours we should've had by now
-    bool behindSchedule = (hoursToday + 0.001f < expectedSoFar);
-    lampOn = behindSchedule && ambientDark;
+  consumeLdr();
+  bool ambientDark = (ldrLevel < DARK_THRESHOLD);
+
+  refreshTargets(state);
+  const uint32_t elapsedMs = now - dayStartMs; /// How far into the current day are we?
+
+  for (uint8_t z = 0; z < state.zoneCount; z++) {
+    bool lampOn = false; /// Turn it off by default, unless it is turned on
+
+    if (targetMs[z] > 0 && lightMsToday[z] < targetMs[z]) {
+      // Behind schedule when light + margin < target * (elapsed / day). Both sides
+      // are scaled by the day length, which keeps the comparison exact in 64 bits.
+      const uint64_t had = (uint64_t)(lightMsToday[z] + SCHEDULE_MARGIN_MS) * DAY_MS;
+      const uint64_t expectedSoFar = (uint64_t)targetMs[z] * elapsedMs;
+      bool behindSchedule = (had < expectedSoFar);
+      lampOn = behindSchedule && ambientDark;
+    }
+
+    actuatorSet(z, ACT_LAMP, lampOn);
+    if (state.lampOn[z] != lampOn) {
+      state.lampOn[z] = lampOn;
+      stateChanged(state);
+    }
+
+    bool effectiveLight = (!ambientDark) || lampOn;
+    if (effectiveLight && elapsedSampleMs > 0) {
+      const uint32_t had = lightMsToday[z];
+      lightMsToday[z] = (elapsedSampleMs < DAY_MS - had) ? had + elapsedSampleMs : DAY_MS;
+    }
+
+    state.lightHoursToday[z] = lightMsToday[z] * HOURS_PER_MS;
   }
-
-  digitalWrite(LEDPIN, lampOn ? HIGH : LOW);
-  state.lampOn = lampOn;
-
-  bool effectiveLight = (!ambientDark) || lampOn;
-  if (effectiveLight && elapsedSampleMs > 0) {
-    hoursToday += (elapsedSampleMs / 1000.0f) / 3600.0f;
-    hoursToday = clamp(hoursToday, 0.0f, 24.0f);
-  }
-
-  state.lightHoursToday = hoursToday;
+  actuatorsCommit();
 }
-
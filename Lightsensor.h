@@ -1,6 +1,17 @@
 #pragma once
 #include <Arduino.h>
 #include "sharedState.h"
+#include "sensorFilter.h"
+
+/// Period at which lightUpdate() should be called
+static const uint32_t LIGHT_SAMPLE_MS = 1000;
+
+/// LDR acquisition (adcSampler): one reading per LDR_SAMPLE_MS, averaged over LDR_OVERSAMPLE readings
+static const uint32_t LDR_SAMPLE_MS = 20;
+static const uint16_t LDR_OVERSAMPLE = LIGHT_SAMPLE_MS / LDR_SAMPLE_MS;
+
+/// Filter on the averaged LDR reading (ADC counts): spikes of up to two samples are removed
+static const FilterConfig LDR_FILTER = {5, 1, 3, 100};
 
 
 void lightInit();
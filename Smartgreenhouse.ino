@@ -3,8 +3,8 @@
  * @brief Main application wiring together sensor/actuator modules.
  *
  * Flow:
- *  - setup(): init modules + set targets
- *  - loop(): read sensors -> controller -> actuate
+ *  - setup(): init modules + set targets + register periodic tasks
+ *  - loop(): run the scheduler (sensors -> controller -> actuate, server, cloud)
  */
 
 #include <Arduino.h>
@@ -13,16 +13,26 @@
 #include "Lightsensor.h"
 #include "heater.h"
 #include "mister.h"
+#include "actuators.h"
 #include "climateControl.h"
+#include "scheduler.h"
+#include "wsServer.h"
+#include "history.h"
+#include "dataLog.h"
+#include "uploader.h"
+#include "eventLog.h"
+#include "zones.h"
+#include "adcSampler.h"
+#include "wifiLink.h"
+#include "profiler.h"
+#include "heapGuard.h"
+#include "dataflow.h"
 
 // ****************** Server start ****************************
 #include "credentials.h"
 #include <ESP8266WiFi.h>
 #include <ESPAsyncTCP.h>
 #include <ESPAsyncWebServer.h>
-#include <Arduino_JSON.h>
-#include <ThingSpeak.h>
-#include <DHT.h>
 #include "webFiles.h"
 
 // ****************** Server end ****************************
@@ -31,243 +41,435 @@
  */
 SharedState state;
 
+/**
+ * @brief Pins of each greenhouse zone (DHT, heater, mister, lamp, mister active-low).
+ *
+ * One zone by default. A second zone could use e.g. {D6, D0, D3, D8, true}
+ * (D3 idles HIGH and D8 LOW, as the boot straps need);
+ * all zones share the LDR on A0.
+ */
+static const ZonePins ZONE_PINS[] = {
+  ZONE_DEFAULT_PINS,
+};
+
 static const uint32_t PRINT_MS = 1000;
-static const uint32_t LIGHT_UPDATE = 1000; // 5 seconds
+static const uint32_t STATS_MS = 60000;   // scheduler statistics report
 
 // ****************** Server start ****************************
 
-WiFiClient client;
-
-const unsigned long postDelay = 15000; // 15 seconds delay between ThingSpeak posts
-unsigned long lastPostTime = 0;
+const unsigned long postDelay = 15000; // 15 seconds between ThingSpeak samples
 
 // Create AsyncWebServer object on port 80
 AsyncWebServer server(80);
 
-// Create a WebSocket object
-AsyncWebSocket ws("/ws");
+/// Task id of the Wi-Fi state machine, which re-arms itself
+static int8_t wifiTask = -1;
 
-String message = "";
+/// millis() at the end of setup(), when the control tasks start
+static uint32_t setupDoneMs = 0;
 
-JSONVar readings; // Json Variable to Hold Sensor Readings
+/**
+ * @brief Advance the Wi-Fi connection and sleep until it next needs service.
+ */
+void wifiTaskRun() {
+  schedulerWake(wifiTask, wifiLinkRun());
+}
 
-// Timer variables for millis()
-unsigned long lastTime = 0;  
-unsigned long timerDelay = 1000;
+// ****************** Server end ****************************
+
+/// Task id of the DHT acquisition, which re-arms itself
+static int8_t dhtTask = -1;
 
 /**
- * @brief Collect current sensor readings and targets.
- *
- * @details
- * return a JSON object with measured values and configured targets
- * from the shared system state.
- *
- * @return JSON string containing sensor data and targets.
+ * @brief Advance the DHT acquisition and sleep until it next needs service.
  */
-String getSensorReadings() {
-  readings["temperature"] = round(state.tempC); // actual measured temp
-  readings["humidity"] = round(state.humidityPct); // actual measured humidity
-  readings["light"] = state.lampOn; // actual lamp state
+void dhtTaskRun() {
+  const uint32_t t = profStart();
+  const uint32_t nextMs = dht11Read(state);
+  profEnd(PROF_DHT, t);
+  schedulerWake(dhtTask, nextMs);
+}
 
-  readings["tempTarget"] = state.targetTempC; // desired temp
-  readings["humiTarget"] = state.targetHumidityPct ;// desired humidity
-  readings["lightTarget"] = state.targetLightHoursToday; // desired lamp state
+/**
+ * @brief Update the light reading and the lamp's hour count (profiled).
+ */
+void lightTaskRun() {
+  const uint32_t t = profStart();
+  lightUpdate(state);
+  profEnd(PROF_LIGHT, t);
+}
+
+/// Task id of the climate controllers, woken by new readings and targets (dataflow.h)
+static int8_t controlTask = -1;
 
-  return JSON.stringify(readings);
+/**
+ * @brief Run the climate controllers (profiled) and sleep until a mister timer runs out.
+ */
+void controlTaskRun() {
+  const uint32_t t = profStart();
+  const uint32_t nextMs = climateControlUpdate(state);
+  profEnd(PROF_CONTROL, t);
+  if (nextMs != CLIMATE_CONTROL_IDLE) schedulerWake(controlTask, nextMs);
 }
 
-// Initialize WiFi
-void initWiFi() {
-  WiFi.mode(WIFI_STA);
-  WiFi.begin(ssid, password);
-  Serial.print("Connecting to WiFi ..");
-  while (WiFi.status() != WL_CONNECTED) {
-    Serial.print('.');
-    delay(1000);
+/**
+ * @brief Log the current readings, actuator states and targets.
+ *
+ * Zone 0 keeps the original status lines; further zones add zone-tagged ones.
+ */
+void printStatus() {
+  eventLog(EV_STATUS, lroundf(state.tempC[0] * 10), lroundf(state.humidityPct[0] * 10),
+           state.heaterOn[0], state.misterOn[0], state.lampOn[0], lroundf(state.lightHoursToday[0] * 100));
+  eventLog(EV_TARGETS, lroundf(state.targetTempC[0] * 10), lroundf(state.targetHumidityPct[0] * 10),
+           lroundf(state.targetLightHoursToday[0] * 10));
+  for (uint8_t z = 1; z < state.zoneCount; z++) {
+    eventLog(EV_ZONE_STATUS, z, lroundf(state.tempC[z] * 10), lroundf(state.humidityPct[z] * 10),
+             state.heaterOn[z], state.misterOn[z], state.lampOn[z]);
+    eventLog(EV_ZONE_TARGETS, z, lroundf(state.lightHoursToday[z] * 100), lroundf(state.targetTempC[z] * 10),
+             lroundf(state.targetHumidityPct[z] * 10), lroundf(state.targetLightHoursToday[z] * 10));
   }
-  Serial.println(WiFi.localIP());
 }
 
-void notifyClients2(String sensorReadings) {
-  ws.textAll(sensorReadings);
+/**
+ * @brief Log per-task run and overrun counters, and the LDR acquisition counters.
+ */
+void printSchedulerStats() {
+  TaskStats st;
+  for (int8_t id = 0; id < (int8_t)schedulerTaskCount(); id++) {
+    if (!schedulerStats(id, st)) continue;
+    eventLog(EV_TASK_STATS, id, st.runs, st.overruns, st.maxLateMs);
+  }
+  AdcSamplerStats adc;
+  adcSamplerStats(adc);
+  eventLog(EV_ADC_STATS, adc.samples, adc.averages, adc.lost, adc.overruns);
 }
 
+// ****************** Server start ****************************
+
+/// Task id of the ThingSpeak upload state machine, which re-arms itself
+static int8_t uploadTask = -1;
+
 /**
- * @brief Handle incoming WebSocket messages.
+ * @brief Queue temperature and humidity for ThingSpeak.
  *
- * @details
- * control commands received from the web client and updates
- * target values in the shared state. Also responds to data requests.
+ * Only stores the sample; the upload task sends queued samples in batches.
+ */
+void postThingSpeak() {
+  if (isnan(state.tempC[0]) || isnan(state.humidityPct[0])) {
+    eventLog(EV_DHT_MISSING);
+    return;
+  }
+  uploaderEnqueue(state, dataLogNowSec());
+}
+
+/**
+ * @brief Advance the ThingSpeak upload and sleep until it next needs service.
+ */
+void uploadTaskRun() {
+  const uint32_t t = profStart();
+  const uint32_t nextMs = uploaderRun(dataLogNowSec());
+  profEnd(PROF_UPLOAD, t);
+  schedulerWake(uploadTask, nextMs);
+}
+
+/**
+ * @brief Copy query parameter @p name of @p request into @p out (the library's lookup builds Strings).
  *
- * @param arg WebSocket frame information
- * @param data Incoming message buffer
- * @param len Length of the message
+ * @return false if the request has no such parameter.
  */
-void handleWebSocketMessage(void *arg, uint8_t *data, size_t len) {
-  AwsFrameInfo *info = (AwsFrameInfo*)arg;
-  if (!(info->final && info->index == 0 && info->len == len && info->opcode == WS_TEXT)) return;
+static bool queryParam(AsyncWebServerRequest *request, const char *name, char *out, size_t len) {
+  HeapGuardAllow allow;
+  const AsyncWebParameter *param = request->getParam(name);
+  if (!param) return false;
+  strlcpy(out, param->value().c_str(), len);
+  return true;
+}
 
-  String msg;
-  msg.reserve(len + 1);
-  msg = "";                       // ensure empty
+/**
+ * @brief Answer @p request with a short plain-text error.
+ */
+static void sendError(AsyncWebServerRequest *request, int code, const char *text) {
+  HeapGuardAllow allow;
+  request->send(code, "text/plain", text);
+}
 
-  for (size_t i = 0; i < len; i++) {
-    msg.concat((char)data[i]);    // concat is usually better than operator+=
+/**
+ * @brief Serve a precompressed dashboard file.
+ *
+ * @details The gzipped bytes are sent straight from flash. A request whose
+ * If-None-Match carries the asset's ETag gets an empty 304. Files referenced
+ * as name?v=<hash> are cacheable for a year; the page itself is revalidated
+ * on every load, so a firmware update takes effect immediately.
+ */
+void serveAsset(AsyncWebServerRequest *request, const WebAsset &asset) {
+  HeapGuardCallback guard;
+  const char *cacheControl = asset.immutable ? "public, max-age=31536000, immutable" : "no-cache";
+
+  // The request, its headers and the response are the library's objects.
+  HeapGuardAllow allow;
+  if (request->hasHeader("If-None-Match") && request->header("If-None-Match").indexOf(asset.etag) >= 0) {
+    AsyncWebServerResponse *response = request->beginResponse(304);
+    response->addHeader("ETag", asset.etag);
+    response->addHeader("Cache-Control", cacheControl);
+    request->send(response);
+    return;
   }
 
-  msg.trim();
+  AsyncWebServerResponse *response = request->beginResponse_P(200, asset.contentType, asset.data, asset.length);
+  response->addHeader("Content-Encoding", "gzip");
+  response->addHeader("ETag", asset.etag);
+  response->addHeader("Cache-Control", cacheControl);
+  request->send(response);
+}
 
-  if (msg.equalsIgnoreCase("getReadings")) {
-    notifyClients2(getSensorReadings());
+/**
+ * @brief Serve /history?series=&tier=&from= as a packed little-endian int16 array.
+ *
+ * @details
+ * series: temp, humidity, lamp, heater, mister or lightHours (default temp).
+ * tier:   raw (1 s), 1m or 15m (default raw); 1m and 15m records are min, mean, max.
+ * from:   first time wanted, in seconds since boot (default: everything kept).
+ *
+ * The time axis and fixed-point scale are returned in X-History-* headers, so the
+ * body can be wrapped in an Int16Array without any parsing.
+ */
+void handleHistory(AsyncWebServerRequest *request) {
+  HeapGuardCallback guard;
+  uint8_t series = HIST_TEMP;
+  uint8_t tier = HIST_TIER_RAW;
+  uint32_t fromSec = 0;
+  char param[16];
+
+  if (queryParam(request, "series", param, sizeof(param)) && !historyParseSeries(param, series)) {
+    sendError(request, 400, "bad series");
     return;
   }
+  if (queryParam(request, "tier", param, sizeof(param)) && !historyParseTier(param, tier)) {
+    sendError(request, 400, "bad tier");
+    return;
+  }
+  if (queryParam(request, "from", param, sizeof(param))) fromSec = strtoul(param, nullptr, 10);
+
+  HistoryQuery q;
+  historyQuery(series, tier, fromSec, q);
+
+  char now[12], start[12], step[12], scale[8], values[4];
+  snprintf(now, sizeof(now), "%lu", (unsigned long)historyNowSec());
+  snprintf(start, sizeof(start), "%lu", (unsigned long)q.startSec);
+  snprintf(step, sizeof(step), "%lu", (unsigned long)q.stepSec);
+  snprintf(scale, sizeof(scale), "%d", historyScale(series));
+  snprintf(values, sizeof(values), "%u", q.valuesPerRecord);
+
+  HeapGuardAllow allow; // the response and its header Strings
+  AsyncWebServerResponse *response = request->beginResponse("application/octet-stream", historyBytes(q),
+    [q](uint8_t *buffer, size_t maxLen, size_t index) -> size_t {
+      HeapGuardCallback chunkGuard;
+      return historyCopy(q, index, buffer, maxLen);
+    });
+  response->addHeader("Cache-Control", "no-store");
+  response->addHeader("X-History-Now", now);
+  response->addHeader("X-History-Start", start);
+  response->addHeader("X-History-Step", step);
+  response->addHeader("X-History-Scale", scale);
+  response->addHeader("X-History-Values", values);
+  request->send(response);
+}
 
-  if (msg.startsWith("T:")) state.targetTempC = msg.substring(2).toFloat();
-  else if (msg.startsWith("H:")) state.targetHumidityPct = msg.substring(2).toFloat();
-  else if (msg.startsWith("L:")) state.targetLightHoursToday = msg.substring(2).toFloat();
+/**
+ * @brief Name of the last reset cause, as ESP.getResetReason() words it but without building a String.
+ */
+static const char *resetReason() {
+  static const char *const NAMES[] = {"Power On", "Hardware Watchdog", "Exception", "Software Watchdog",
+                                      "Software/System restart", "Deep-Sleep Wake", "External System"};
+  const uint32_t reason = ESP.getResetInfoPtr()->reason;
+  return reason < sizeof(NAMES) / sizeof(NAMES[0]) ? NAMES[reason] : "Unknown";
 }
 
 /**
- * @brief Handle WebSocket connection events.
+ * @brief Serve /boot: boot and Wi-Fi connection timings as JSON.
  *
- * @param server WebSocket server instance
- * @param client Connected client
- * @param type Event type
- * @param arg Event-specific data
- * @param data Payload data
- * @param len Payload length
+ * @details setupMs is when control started; wifiUpMs how long after
+ * wifiLinkBegin() the first connection came up (0 = not yet) and wifiFast
+ * whether the RTC cache made it; lastConnectMs is the latest (re)connection.
  */
-void onEvent(AsyncWebSocket *server, AsyncWebSocketClient *client, AwsEventType type, void *arg, uint8_t *data, size_t len) {
-  switch (type) {
-    case WS_EVT_CONNECT:
-      Serial.printf("WebSocket client #%u connected from %s\n", client->id(), client->remoteIP().toString().c_str());
-      break;
-    case WS_EVT_DISCONNECT:
-      Serial.printf("WebSocket client #%u disconnected\n", client->id());
-      break;
-    case WS_EVT_DATA:
-      handleWebSocketMessage(arg, data, len);
-      break;
-    case WS_EVT_PONG:
-    case WS_EVT_ERROR:
-      break;
-  }
+void handleBoot(AsyncWebServerRequest *request) {
+  HeapGuardCallback guard;
+  WifiMetrics m;
+  wifiLinkMetrics(m);
+  char json[256];
+  snprintf(json, sizeof(json),
+           "{\"reset\":\"%s\",\"setupMs\":%lu,\"wifiStartMs\":%lu,\"wifiUpMs\":%lu,\"wifiFast\":%s,"
+           "\"lastConnectMs\":%lu,\"attempts\":%lu,\"fastHits\":%lu,\"fastMisses\":%lu,\"reconnects\":%lu}",
+           resetReason(), (unsigned long)setupDoneMs, (unsigned long)m.startMs,
+           (unsigned long)m.firstUpMs, m.firstFast ? "true" : "false", (unsigned long)m.lastConnectMs,
+           (unsigned long)m.attempts, (unsigned long)m.fastHits, (unsigned long)m.fastMisses,
+           (unsigned long)m.reconnects);
+  HeapGuardAllow allow; // the response and its header Strings
+  AsyncWebServerResponse *response = request->beginResponse(200, "application/json", json);
+  response->addHeader("Cache-Control", "no-store");
+  request->send(response);
+}
+
+/**
+ * @brief Serve /metrics: stage timings, loop rate and memory margins in Prometheus text format.
+ *
+ * @details Written a line at a time into the chunks of the response (see
+ * profiler.h), so the page never has to fit in RAM.
+ */
+void handleMetrics(AsyncWebServerRequest *request) {
+  HeapGuardCallback guard;
+  ProfCursor cursor;
+  profMetricsBegin(cursor);
+  HeapGuardAllow allow; // the response and its header Strings
+  AsyncWebServerResponse *response = request->beginChunkedResponse("text/plain; version=0.0.4",
+    [cursor](uint8_t *buffer, size_t maxLen, size_t) mutable -> size_t {
+      HeapGuardCallback chunkGuard;
+      return profMetricsRead(cursor, (char *)buffer, maxLen);
+    });
+  response->addHeader("Cache-Control", "no-store");
+  request->send(response);
 }
 
-void initWebSocket() {
-  ws.onEvent(onEvent);
-  server.addHandler(&ws);
+/**
+ * @brief Serve /log?from=&to= as a chunked CSV stream from the flash data log.
+ *
+ * @details from and to are log seconds (inclusive, default: everything); the
+ * current log time is returned in X-Log-Now. Records are read from flash one
+ * page at a time while the response is being sent. With format=packed the
+ * same records come as compressed blocks (see dataLog.h), some 25 times
+ * smaller than the CSV; host/codectool unpacks them.
+ */
+void handleLog(AsyncWebServerRequest *request) {
+  HeapGuardCallback guard;
+  uint32_t fromSec = 0;
+  uint32_t toSec = UINT32_MAX;
+  char param[16];
+  if (queryParam(request, "from", param, sizeof(param))) fromSec = strtoul(param, nullptr, 10);
+  if (queryParam(request, "to", param, sizeof(param))) toSec = strtoul(param, nullptr, 10);
+  const bool packed = queryParam(request, "format", param, sizeof(param)) && !strcmp(param, "packed");
+
+  DataLogCursor cursor;
+  dataLogSeek(cursor, fromSec, toSec);
+  char now[12];
+  snprintf(now, sizeof(now), "%lu", (unsigned long)dataLogNowSec());
+
+  HeapGuardAllow allow; // the response and its header Strings
+  AsyncWebServerResponse *response;
+  if (packed) {
+    response = request->beginChunkedResponse("application/octet-stream",
+      [cursor](uint8_t *buffer, size_t maxLen, size_t) mutable -> size_t {
+        HeapGuardCallback chunkGuard;
+        return dataLogReadPacked(cursor, buffer, maxLen);
+      });
+  } else {
+    response = request->beginChunkedResponse("text/csv",
+      [cursor](uint8_t *buffer, size_t maxLen, size_t) mutable -> size_t {
+        HeapGuardCallback chunkGuard;
+        return dataLogReadCsv(cursor, (char *)buffer, maxLen);
+      });
+  }
+  response->addHeader("Cache-Control", "no-store");
+  response->addHeader("X-Log-Now", now);
+  request->send(response);
 }
 
 // ****************** Server end ****************************
+
 /**
  * @brief Arduino setup function.
  *
  * @details
  * Initializes sensors, actuators, control logic, WiFi,
- * web server, and cloud services.
+ * web server, and cloud services. Nothing here waits for the network, so
+ * control starts within milliseconds of reset.
  */
 void setup() {
   Serial.begin(115200);
   delay(200);
   Serial.println();
   Serial.println(ESP.getResetInfo());
+  eventLogBegin();
 
+  zonesBegin(state, ZONE_PINS, sizeof(ZONE_PINS) / sizeof(ZONE_PINS[0]));
   dht11Begin();
+  actuatorsBegin();
   lightInit();
   heaterBegin();
   misterInit();
 
   climateControlBegin();
+  profBegin();
+  historyBegin();
+  if (!dataLogBegin()) Serial.println("Data log: no filesystem, keeping RAM only");
 
   // Setting temperature targets
-  state.targetTempC = 23.0;
-  state.targetHumidityPct = 55.0;
+  for (uint8_t z = 0; z < state.zoneCount; z++) {
+    state.targetTempC[z] = 23.0;
+    state.targetHumidityPct[z] = 55.0;
+  }
 
  // ****************** Server start ****************************
-  ThingSpeak.begin(client);
-
-  initWiFi();
-  initWebSocket();
-
-  // Web Server Root URL
-  server.on("/", HTTP_GET, [](AsyncWebServerRequest *request){
-    request->send_P(200, "text/html", INDEX_HTML);
-  });
-  server.on("/style.css", HTTP_GET, [](AsyncWebServerRequest *request){
-    request->send_P(200, "text/css", STYLE_CSS);
-  });
-  server.on("/script.js", HTTP_GET, [](AsyncWebServerRequest *request){
-    request->send_P(200, "application/javascript", SCRIPT_JS);
-  });
+  const UploaderConfig uploadConfig = {"api.thingspeak.com", 80, channelID, APIKey};
+  uploaderBegin(uploadConfig);
+
+  // Wi-Fi comes up in the background (wifiTask); the server listens meanwhile.
+  const WifiConfig wifiConfig = {ssid, password};
+  wifiLinkBegin(wifiConfig);
+  wsServerBegin(server, state);
+
+  // Dashboard page and its static files
+  for (uint8_t i = 0; i < WEB_ASSET_COUNT; i++) {
+    const WebAsset *asset = &WEB_ASSETS[i];
+    server.on(asset->path, HTTP_GET, [asset](AsyncWebServerRequest *request) {
+      serveAsset(request, *asset);
+    });
+  }
+  server.on("/history", HTTP_GET, handleHistory);
+  server.on("/log", HTTP_GET, handleLog);
+  server.on("/boot", HTTP_GET, handleBoot);
+  server.on("/metrics", HTTP_GET, handleMetrics);
   
   // Start server
   server.begin();
   // ****************** Server end ****************************
+
+  // Periodic work. Sensors and control first, so they win ties with the server tasks.
+  schedulerBegin();
+  flowBegin();
+  dhtTask = schedulerAdd("dht", dhtTaskRun, 0, SCHED_PRIO_HIGH, 1);
+  schedulerAdd("light", lightTaskRun, LIGHT_SAMPLE_MS, SCHED_PRIO_HIGH);
+  controlTask = schedulerAdd("control", controlTaskRun, 0, SCHED_PRIO_HIGH, 1);
+  flowSubscribe(controlTask, FLOW_BIT(FLOW_READINGS) | FLOW_BIT(FLOW_TARGETS));
+  schedulerAdd("history", []() { historyAppend(state); }, 1000, SCHED_PRIO_NORMAL);
+  schedulerAdd("datalog", []() { dataLogAppend(state); }, DATALOG_SAMPLE_MS, SCHED_PRIO_LOW);
+  schedulerAdd("ws", wsServerFanout, WS_FANOUT_MS, SCHED_PRIO_NORMAL);
+  schedulerAdd("wsCleanup", wsServerCleanup, 1000, SCHED_PRIO_LOW);
+  schedulerAdd("thingspeak", postThingSpeak, postDelay, SCHED_PRIO_LOW, postDelay);
+  uploadTask = schedulerAdd("upload", uploadTaskRun, 0, SCHED_PRIO_LOW, 1);
+  schedulerAdd("print", printStatus, PRINT_MS, SCHED_PRIO_LOW);
+  schedulerAdd("stats", printSchedulerStats, STATS_MS, SCHED_PRIO_LOW, STATS_MS);
+  schedulerAdd("log", eventLogDrain, EVENTLOG_DRAIN_MS, SCHED_PRIO_LOW);
+  wifiTask = schedulerAdd("wifi", wifiTaskRun, 0, SCHED_PRIO_LOW, 1);
+  schedulerAdd("metrics", profSample, PROF_SAMPLE_MS, SCHED_PRIO_LOW, PROF_SAMPLE_MS);
+
+  // Task ids used in the EV_TASK_STATS log lines
+  TaskStats st;
+  for (int8_t id = 0; id < (int8_t)schedulerTaskCount(); id++) {
+    if (schedulerStats(id, st)) Serial.printf("task %d = %s\n", id, st.name);
+  }
+  setupDoneMs = millis();
+  heapGuardArm(); // from here on the tasks and callbacks must not allocate (see heapGuard.h)
 }
 
 /**
  * @brief Main application loop.
  *
  * @details
- * Periodically updates the climate controller, sends sensor data
- * to connected clients, and publishes data to ThingSpeak.
+ * All periodic work (sensors, climate controller, WebSocket updates,
+ * ThingSpeak) is registered with the scheduler in setup(). Between
+ * deadlines the scheduler idles the CPU instead of spinning.
  */
 void loop() {
-  dht11Read(state);
-  lightUpdate(state);
-
-  yield();
-  
-  climateControlUpdate(state);
-
-  static uint32_t lastPrint = 0;
-  if (millis() - lastPrint >= PRINT_MS) {
-    lastPrint = millis();
-    Serial.print("tempC="); Serial.print(state.tempC, 1);
-    Serial.print(" hum="); Serial.print(state.humidityPct, 1);
-    Serial.print(" heaterOn="); Serial.print(state.heaterOn ? "true" : "false");
-    Serial.print(" misterOn="); Serial.print(state.misterOn ? "true" : "false");
-    Serial.print(" lampOn="); Serial.print(state.lampOn ? "true" : "false");
-    Serial.print(" lightHoursToday="); Serial.println(state.lightHoursToday);
-    Serial.print("Desired hours of light="); Serial.println(state.targetLightHoursToday);
-
-  }
-
-  // ****************** Server start ****************************
-
-  // Delay without stopping the CPU
-  if ((millis() - lastTime) > timerDelay) {
-    Serial.print("Desired temp="); Serial.println(state.targetTempC);
-    Serial.print("Desired humidity="); Serial.println(state.targetHumidityPct);
-    Serial.print("Desired hours of light="); Serial.println(state.targetLightHoursToday);
-    
-    Serial.println("_________________");
-    
-    String sensorReadings = getSensorReadings();
-    notifyClients2(sensorReadings);
-  lastTime = millis();
-  }
-
-  // ThingSpeak posting
-if (millis() - lastPostTime > postDelay) {
-    float dhtTemp = state.tempC;
-    float dhtHumi = state.humidityPct;
-
-    if (!isnan(dhtTemp) && !isnan(dhtHumi)) {
-
-        ThingSpeak.setField(1, dhtTemp);
-        ThingSpeak.setField(2, dhtHumi);
-        ThingSpeak.writeFields(channelID, APIKey);
-
-        Serial.print("ThingSpeak updated: ");
-        Serial.print(dhtTemp); Serial.print(" °C, ");
-        Serial.println(dhtHumi); Serial.println(" %");
-    } else {
-        Serial.println("Failed to read DHT sensor!");
-    }
-    lastPostTime = millis();
-}
-
-  ws.cleanupClients();
+  profLoop();
+  schedulerRun();
 }
@@ -0,0 +1,142 @@
+/**
+ * @file actuators.cpp
+ * @brief Actuator shadow, batched commit and switch/duty accounting.
+ *
+ * @details The shadow is kept twice: per actuator (wanted and committed
+ * level, for the accounting) and as pin masks (wanted and driven levels, for
+ * the commit). Two zones may share an output pin; the level set last wins,
+ * as it did with one digitalWrite() per call.
+ */
+#include <Arduino.h>
+#include "actuators.h"
+#include "hal.h"
+#include <string.h>
+
+static const char *const KIND_NAMES[ACT_KINDS] = {"heater", "mister", "lamp"};
+
+/**
+ * @brief One output.
+ */
+struct Actuator {
+  bool attached;
+  uint8_t pin;
+  bool activeLow;
+  bool want;           ///< Set by actuatorSet()
+  bool on;             ///< Committed
+  uint32_t switches;
+  uint64_t onMs;       ///< Completed on periods
+  uint32_t onSinceMs;  ///< Start of the current on period
+  uint32_t attachedAtMs;
+};
+
+static Actuator outputs[ZONE_MAX][ACT_KINDS];
+static uint32_t pinMask = 0;    ///< Pins of attached actuators
+static uint32_t levelWant = 0;  ///< Pin levels after the next commit (1 = HIGH)
+static uint32_t levelOut = 0;   ///< Pin levels last driven
+static bool pending = false;    ///< An actuator changed since the last commit
+
+static inline uint32_t pinBit(uint8_t pin) {
+  return 1u << pin;
+}
+
+static void wantLevel(const Actuator &a) {
+  if (a.want != a.activeLow) levelWant |= pinBit(a.pin);
+  else levelWant &= ~pinBit(a.pin);
+}
+
+/**
+ * @brief Forget every actuator (call in setup() before the actuator modules start).
+ */
+void actuatorsBegin() {
+  memset(outputs, 0, sizeof(outputs));
+  pinMask = 0;
+  levelWant = 0;
+  levelOut = 0;
+  pending = false;
+}
+
+/**
+ * @brief Drive @p zone's @p kind output from @p pin, off right away, and clear its counters.
+ *
+ * @param activeLow The output switches on with a LOW level.
+ */
+void actuatorAttach(uint8_t zone, uint8_t kind, uint8_t pin, bool activeLow) {
+  if (zone >= ZONE_MAX || kind >= ACT_KINDS || pin > ACT_MAX_PIN) return;
+  Actuator &a = outputs[zone][kind];
+  a = Actuator();
+  a.attached = true;
+  a.pin = pin;
+  a.activeLow = activeLow;
+  a.attachedAtMs = halMillis();
+
+  halPinMode(pin, OUTPUT);
+  wantLevel(a);
+  const uint32_t bit = pinBit(pin);
+  if (levelWant & bit) halGpioWrite(bit, 0);
+  else halGpioWrite(0, bit);
+  levelOut = (levelOut & ~bit) | (levelWant & bit);
+  pinMask |= bit;
+}
+
+/**
+ * @brief Ask for @p zone's @p kind output on or off; it changes at the next commit.
+ */
+void actuatorSet(uint8_t zone, uint8_t kind, bool on) {
+  if (zone >= ZONE_MAX || kind >= ACT_KINDS) return;
+  Actuator &a = outputs[zone][kind];
+  if (!a.attached || a.want == on) return;
+  a.want = on;
+  wantLevel(a);
+  pending = true;
+}
+
+/**
+ * @brief Write the pins whose level changed since the last commit, in one GPIO write.
+ *
+ * @return Number of pins written.
+ */
+uint8_t actuatorsCommit() {
+  if (!pending) return 0;
+  pending = false;
+  const uint32_t diff = (levelWant ^ levelOut) & pinMask;
+  const uint32_t now = halMillis();
+
+  for (uint8_t z = 0; z < ZONE_MAX; z++) {
+    for (uint8_t k = 0; k < ACT_KINDS; k++) {
+      Actuator &a = outputs[z][k];
+      if (a.want == a.on) continue;
+      a.on = a.want;
+      a.switches++;
+      if (a.on) a.onSinceMs = now;
+      else a.onMs += now - a.onSinceMs;
+    }
+  }
+
+  if (diff == 0) return 0;
+  halGpioWrite(diff & levelWant, diff & ~levelWant);
+  levelOut ^= diff;
+  return (uint8_t)__builtin_popcount(diff);
+}
+
+/**
+ * @brief Label of @p kind ("?" if out of range).
+ */
+const char *actuatorName(uint8_t kind) {
+  return kind < ACT_KINDS ? KIND_NAMES[kind] : "?";
+}
+
+/**
+ * @brief Copy the counters of @p zone's @p kind output.
+ *
+ * @return false if that output is not attached.
+ */
+bool actuatorStats(uint8_t zone, uint8_t kind, ActuatorStats &out) {
+  if (zone >= ZONE_MAX || kind >= ACT_KINDS || !outputs[zone][kind].attached) return false;
+  const Actuator &a = outputs[zone][kind];
+  const uint32_t now = halMillis();
+  out.on = a.on;
+  out.switches = a.switches;
+  out.onMs = a.onMs + (a.on ? now - a.onSinceMs : 0);
+  out.attachedMs = now - a.attachedAtMs;
+  return true;
+}
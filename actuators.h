@@ -0,0 +1,52 @@
+#pragma once
+#include <stdint.h>
+#include "sharedState.h"
+
+/**
+ * @file actuators.h
+ * @brief Shadow registers of the actuator outputs, committed to the pins in one write.
+ *
+ * @details The heater, mister and lamp modules attach each zone's output pin
+ * and its polarity once (actuatorAttach()) and from then on only change the
+ * shadow (actuatorSet()), as often as they like. actuatorsCommit() compares
+ * the shadow with the levels last driven and writes just the pins that
+ * differ, all in one halGpioWrite() (the GPOS/GPOC set and clear registers
+ * on the ESP8266): a tick that changes nothing touches no register, and
+ * outputs that change in the same tick switch together.
+ *
+ * climateControlUpdate() and lightUpdate() commit at the end of every run.
+ *
+ * Each committed change counts as a switch of that actuator, and the time it
+ * spends on is accumulated (actuatorStats()), for relay wear and mister use.
+ *
+ * Used from loop() context only.
+ */
+
+/// Outputs of a zone
+enum ActuatorKind : uint8_t {
+  ACT_HEATER,
+  ACT_MISTER,
+  ACT_LAMP,
+  ACT_KINDS
+};
+
+/// Highest GPIO an actuator can use (GPIO16 has its own register)
+static const uint8_t ACT_MAX_PIN = 16;
+
+/**
+ * @brief Counters of one actuator since it was attached.
+ */
+struct ActuatorStats {
+  bool on;            ///< Level last committed
+  uint32_t switches;  ///< Committed changes
+  uint64_t onMs;      ///< Time on, up to now
+  uint32_t attachedMs;///< Time since actuatorAttach()
+};
+
+void    actuatorsBegin();
+void    actuatorAttach(uint8_t zone, uint8_t kind, uint8_t pin, bool activeLow);
+void    actuatorSet(uint8_t zone, uint8_t kind, bool on);
+uint8_t actuatorsCommit();
+
+const char *actuatorName(uint8_t kind);
+bool        actuatorStats(uint8_t zone, uint8_t kind, ActuatorStats &out);
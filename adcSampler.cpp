@@ -0,0 +1,110 @@
+/**
+ * @file adcSampler.cpp
+ * @brief Timer-driven ADC oversampling into a lock-free ring of averages.
+ *
+ * @details The timer callback is the only producer and adcSamplerRead() the
+ * only consumer, so the ring needs no lock: the producer owns `head`, the
+ * consumer owns `tail`, and each publishes its index with release ordering
+ * after touching the slot (as in eventLog.cpp). The running sum and the tick
+ * bookkeeping belong to the callback alone.
+ */
+#include "adcSampler.h"
+#include "hal.h"
+#include <atomic>
+
+static uint8_t  adcPin = 0;
+static uint32_t periodUs = 0;
+static uint16_t ratio = 1;
+
+/// Callback-only state
+static uint32_t sum = 0;
+static uint16_t summed = 0;
+static uint32_t lastTickUs = 0;
+static bool     ticked = false;
+
+static uint16_t ring[ADC_RING_SLOTS];
+static std::atomic<uint8_t> head(0);   ///< Written by the callback
+static std::atomic<uint8_t> tail(0);   ///< Written by the consumer
+
+static std::atomic<uint32_t> samples(0);
+static std::atomic<uint32_t> averages(0);
+static std::atomic<uint32_t> lost(0);
+static std::atomic<uint32_t> overruns(0);
+
+/**
+ * @brief One timer tick: take a reading, and publish an average every `ratio` readings.
+ */
+static void sampleTick() {
+  const uint32_t now = halMicros();
+  if (ticked) {
+    // A gap of n periods means n - 1 ticks did not run (half a period of slack for jitter).
+    const uint32_t gaps = (now - lastTickUs + periodUs / 2) / periodUs;
+    if (gaps > 1) lost.fetch_add(gaps - 1, std::memory_order_relaxed);
+  }
+  ticked = true;
+  lastTickUs = now;
+
+  sum += (uint32_t)halAnalogRead(adcPin);
+  samples.fetch_add(1, std::memory_order_relaxed);
+  if (++summed < ratio) return;
+
+  const uint16_t average = (uint16_t)((sum + ratio / 2) / ratio);
+  sum = 0;
+  summed = 0;
+
+  const uint8_t h = head.load(std::memory_order_relaxed);
+  if ((uint8_t)(h - tail.load(std::memory_order_acquire)) >= ADC_RING_SLOTS) {
+    overruns.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  ring[h % ADC_RING_SLOTS] = average;
+  head.store((uint8_t)(h + 1), std::memory_order_release);
+  averages.fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Start sampling @p pin every @p periodMs, averaging @p oversample readings.
+ *
+ * An average is ready every periodMs * oversample; choose them so that the
+ * consumer's period is a multiple. Restarting clears the ring and the counters.
+ */
+void adcSamplerBegin(uint8_t pin, uint32_t periodMs, uint16_t oversample) {
+  halTimerStop();
+  adcPin = pin;
+  periodUs = (periodMs ? periodMs : 1) * 1000;
+  ratio = oversample ? oversample : 1;
+  sum = 0;
+  summed = 0;
+  ticked = false;
+  head.store(0, std::memory_order_relaxed);
+  tail.store(0, std::memory_order_relaxed);
+  samples.store(0, std::memory_order_relaxed);
+  averages.store(0, std::memory_order_relaxed);
+  lost.store(0, std::memory_order_relaxed);
+  overruns.store(0, std::memory_order_relaxed);
+  halTimerBegin(periodMs, sampleTick);
+}
+
+void adcSamplerStop() {
+  halTimerStop();
+}
+
+/**
+ * @brief Take the oldest ready average (ADC counts).
+ *
+ * @return False if none is ready.
+ */
+bool adcSamplerRead(uint16_t &average) {
+  const uint8_t t = tail.load(std::memory_order_relaxed);
+  if (t == head.load(std::memory_order_acquire)) return false;
+  average = ring[t % ADC_RING_SLOTS];
+  tail.store((uint8_t)(t + 1), std::memory_order_release);
+  return true;
+}
+
+void adcSamplerStats(AdcSamplerStats &st) {
+  st.samples = samples.load(std::memory_order_relaxed);
+  st.averages = averages.load(std::memory_order_relaxed);
+  st.lost = lost.load(std::memory_order_relaxed);
+  st.overruns = overruns.load(std::memory_order_relaxed);
+}
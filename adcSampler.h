@@ -0,0 +1,36 @@
+#pragma once
+#include <stdint.h>
+
+/**
+ * @file adcSampler.h
+ * @brief Oversampled ADC acquisition from the periodic timer, decoupled from loop().
+ *
+ * @details The timer callback reads the pin every period and adds the reading
+ * to a running sum; every `oversample` readings the sum becomes one average,
+ * which goes into a single-producer/single-consumer ring. The consumer
+ * (lightUpdate()) only takes ready averages out of the ring and never touches
+ * the ADC itself.
+ *
+ * Two counters show whether acquisition keeps up:
+ *  - lost: timer ticks that never ran because loop() held the CPU for more
+ *    than a period (detected from the gap between two ticks);
+ *  - overruns: averages dropped because the consumer left the ring full.
+ */
+
+/// Averages the ring can hold (power of two)
+static const uint8_t ADC_RING_SLOTS = 8;
+
+/**
+ * @brief Acquisition counters since adcSamplerBegin().
+ */
+struct AdcSamplerStats {
+  uint32_t samples;   ///< ADC readings taken
+  uint32_t averages;  ///< Averages put into the ring
+  uint32_t lost;      ///< Timer ticks that were missed
+  uint32_t overruns;  ///< Averages dropped on a full ring
+};
+
+void adcSamplerBegin(uint8_t pin, uint32_t periodMs, uint16_t oversample);
+void adcSamplerStop();
+bool adcSamplerRead(uint16_t &average);
+void adcSamplerStats(AdcSamplerStats &st);
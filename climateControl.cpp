@@ -2,6 +2,9 @@
 #include "climateControl.h"
 #include "heater.h"
 #include "mister.h"
+#include "actuators.h"
+#include "hal.h"
+#include "fixedPoint.h"
 
 /**
  * @file climateControl.cpp
@@ -11,21 +14,90 @@
  *  - Temperature control using hysteresis (prevents rapid toggling).
  *  - Humidity control using hysteresis + safety timers (max ON time + minimum OFF backoff).
  *
+ * All comparisons are integer: readings in deci-degrees and per mille, timers
+ * in milliseconds (see fixedPoint.h). The switching thresholds are derived from
+ * the float setpoints only when the state generation changes, not on every call.
+ *
+ * Every zone is handled in one pass per call; the controller keeps its
+ * per-zone values in parallel arrays (ZoneControl) next to those of SharedState.
+ *
  * Typical use:
  *  - call climateControlBegin() once in setup()
- *  - call climateControlUpdate(state) repeatedly in loop()
+ *  - call climateControlUpdate(state) when readings or targets were published
+ *    (dataflow.h), and again after the delay it returns: the mister's on-time
+ *    limit and backoff are deadlines the controller reports, not states it
+ *    polls for.
  */
 
-//Allowed temperature hysteriria
-static const float TEMP_HYST = 0.5;
-static const float HUM_HYST = 3.0;
+//Allowed temperature hysteriria, in deci-degrees and per mille
+static constexpr int32_t TEMP_HYST_DECI = fixedConst(0.5, DECI_PER_DEGREE);
+static constexpr int32_t HUM_HYST_PERMILLE = fixedConst(3.0, PERMILLE_PER_PCT);
+static constexpr float TEMP_HYST = (float)TEMP_HYST_DECI / DECI_PER_DEGREE;
+static constexpr float HUM_HYST = (float)HUM_HYST_PERMILLE / PERMILLE_PER_PCT;
 
 static const uint32_t MIST_MAX_ON_MS = 20 * 1000; // max continous on
 static const uint32_t MIST_MIN_OFF_MS = 10 * 1000; // minimum backoff interval
 
-// interval timer
-static uint32_t mistOnSinceMs = 0;
-static uint32_t mistOffSinceMs = 0;
+/**
+ * @brief Controller state of every zone, one contiguous array per field.
+ *
+ * The integer inputs are rebuilt from the float state when its generation
+ * changes; the mister timers persist across calls.
+ */
+struct ZoneControl {
+  uint32_t generation;
+  bool valid;
+  int32_t tempDeci[ZONE_MAX];
+  int32_t humPermille[ZONE_MAX];
+  int32_t heatOnAtOrBelow[ZONE_MAX];  ///< Heater turns on at or below this temperature
+  int32_t heatOffAtOrAbove[ZONE_MAX]; ///< ... and off at or above this one
+  int32_t mistOnAtOrBelow[ZONE_MAX];
+  int32_t mistOffAtOrAbove[ZONE_MAX];
+  uint32_t mistOnSinceMs[ZONE_MAX];   ///< Last switch on; set only by setMister()
+  uint32_t mistOffSinceMs[ZONE_MAX];  ///< Last switch off (or boot); set only by setMister()
+};
+
+static ZoneControl zones = {};
+
+/**
+ * @brief Convert readings and setpoints of all zones to integer units if the state changed.
+ */
+static void refreshInputs(const SharedState &state) {
+  if (zones.valid && zones.generation == state.generation) return;
+  zones.generation = state.generation;
+  zones.valid = true;
+  for (uint8_t z = 0; z < state.zoneCount; z++) {
+    zones.tempDeci[z] = fixedFromFloat(state.tempC[z], DECI_PER_DEGREE);
+    zones.humPermille[z] = fixedFromFloat(state.humidityPct[z], PERMILLE_PER_PCT);
+    zones.heatOnAtOrBelow[z] = fixedAtOrBelow(state.targetTempC[z] - TEMP_HYST, DECI_PER_DEGREE);
+    zones.heatOffAtOrAbove[z] = fixedAtOrAbove(state.targetTempC[z] + TEMP_HYST, DECI_PER_DEGREE);
+    zones.mistOnAtOrBelow[z] = fixedAtOrBelow(state.targetHumidityPct[z] - HUM_HYST, PERMILLE_PER_PCT);
+    zones.mistOffAtOrAbove[z] = fixedAtOrAbove(state.targetHumidityPct[z] + HUM_HYST, PERMILLE_PER_PCT);
+    // A NAN reading never satisfies a comparison, just as the float version.
+    if (isnan(state.tempC[z])) {
+      zones.heatOnAtOrBelow[z] = FIXED_NEVER_BELOW;
+      zones.heatOffAtOrAbove[z] = FIXED_NEVER_ABOVE;
+    }
+    if (isnan(state.humidityPct[z])) {
+      zones.mistOnAtOrBelow[z] = FIXED_NEVER_BELOW;
+      zones.mistOffAtOrAbove[z] = FIXED_NEVER_ABOVE;
+    }
+  }
+}
+
+/**
+ * @brief Drive a zone's mister and record its state.
+ */
+static void setMister(SharedState &state, uint8_t z, bool on, uint32_t now) {
+  misterState(z, on);
+  if (state.misterOn[z] != on) {
+    state.misterOn[z] = on;
+    // The timers start at the switch, which the next run may be far from
+    zones.mistOnSinceMs[z] = on ? now : 0;
+    zones.mistOffSinceMs[z] = on ? 0 : now;
+    stateChanged(state);
+  }
+}
 
 /**
  * @brief Initialize controller timers/state.
@@ -33,85 +105,109 @@ static uint32_t mistOffSinceMs = 0;
    * Call once in setup(). This does not change any outputs by itself.
  */
 void climateControlBegin() {
-  mistOnSinceMs = 0;
-  mistOffSinceMs = millis();
+  zones.valid = false;
+  const uint32_t now = halMillis();
+  for (uint8_t z = 0; z < ZONE_MAX; z++) {
+    zones.mistOnSinceMs[z] = 0;
+    zones.mistOffSinceMs[z] = now;
+  }
 }
 
 /**
- * @brief Update climate control (heater + mister) based on sensor readings and targets.
- *
- * Inputs (read from @p state):
- *  - state.hasDht, state.tempC, state.humidityPct
- *  - state.targetTempC, state.targetHumidityPct
- *  - state.heaterOn, state.misterOn (used for hysteresis decisions)
- *
- * Outputs (written to @p state and hardware):
- *  - Heater output via heaterSet(state, on) (also updates state.heaterOn)
- *  - Mister output via misterState(on) and state.misterOn
- *
- * Fail-safe:
- *  - If state.hasDht is false, heater and mister are turned OFF.
- *
- * @param state Shared state containing latest sensor values, setpoints, and actuator states.
+ * @brief Run the heater and mister logic of zone @p z.
  */
-void climateControlUpdate(SharedState &state) {
+static inline void controlZone(SharedState &state, uint8_t z, uint32_t now) {
   // If sensor invalid, fail safe: turn things off
-  if (!state.hasDht) {
-    heaterSet(state, false);
-    misterState(false);
-    state.misterOn = false;
+  if (!state.hasDht[z]) {
+    heaterSet(state, z, false);
+    setMister(state, z, false, now);
     return;
   }
 
-  const float t = state.tempC;
-  const float h = state.humidityPct;
+  const int32_t t = zones.tempDeci[z];
+  const int32_t h = zones.humPermille[z];
 
   // Temperature Control
   // turn on if too cold, turn off if warm enough
-  if (!state.heaterOn && t <= (state.targetTempC - TEMP_HYST)) {
-    heaterSet(state, true);
-  } else if (state.heaterOn && t >= (state.targetTempC + TEMP_HYST)) {
-    heaterSet(state, false);
+  if (!state.heaterOn[z] && t <= zones.heatOnAtOrBelow[z]) {
+    heaterSet(state, z, true);
+  } else if (state.heaterOn[z] && t >= zones.heatOffAtOrAbove[z]) {
+    heaterSet(state, z, false);
   }
 
   // Humidity Control
-  const uint32_t now = millis();
-
-  // Track timers
-  // Track how long the mister has been off or on for
-  if (state.misterOn) {
-    if (mistOnSinceMs == 0) {
-      mistOnSinceMs = now;
-    }
-
-  mistOffSinceMs = 0;
-
-  } else {
-    if (mistOffSinceMs == 0) {
-      mistOffSinceMs = now;
-    }
-
-  mistOnSinceMs = 0;
-  }
-
   // Safety. If mister has been turned on for too long, turn it off.
-  if (state.misterOn && mistOnSinceMs != 0 && (now - mistOnSinceMs) >= MIST_MAX_ON_MS) {
-    misterState(false);
-    state.misterOn = false;
+  if (state.misterOn[z] && (now - zones.mistOnSinceMs[z]) >= MIST_MAX_ON_MS) {
+    setMister(state, z, false, now);
     return;
   }
 
-  const bool canTurnOn = (mistOffSinceMs != 0) && ((now - mistOffSinceMs) >= MIST_MIN_OFF_MS);
+  const bool canTurnOn = (now - zones.mistOffSinceMs[z]) >= MIST_MIN_OFF_MS;
 
   // Finally, turn the mister on or off 
-  if (!state.misterOn && canTurnOn && h <= (state.targetHumidityPct - HUM_HYST)) {
-    misterState(true);
-    state.misterOn = true;
-  } else if (state.misterOn && h >= (state.targetHumidityPct + HUM_HYST)) {
-    misterState(false);
-    state.misterOn = false;
+  if (!state.misterOn[z] && canTurnOn && h <= zones.mistOnAtOrBelow[z]) {
+    setMister(state, z, true, now);
+  } else if (state.misterOn[z] && h >= zones.mistOffAtOrAbove[z]) {
+    setMister(state, z, false, now);
   }
+}
 
+/**
+ * @brief Time from @p now until a mister timer of zone @p z can switch its output.
+ *
+ * @return CLIMATE_CONTROL_IDLE if no timer is running that matters.
+ */
+static inline uint32_t zoneDeadline(const SharedState &state, uint8_t z, uint32_t now) {
+  if (!state.hasDht[z]) return CLIMATE_CONTROL_IDLE;
+  uint32_t since, limit;
+  if (state.misterOn[z]) {
+    since = zones.mistOnSinceMs[z];
+    limit = MIST_MAX_ON_MS;
+  } else if (zones.humPermille[z] <= zones.mistOnAtOrBelow[z]) {
+    since = zones.mistOffSinceMs[z]; // too dry: only the backoff keeps it off
+    limit = MIST_MIN_OFF_MS;
+  } else {
+    return CLIMATE_CONTROL_IDLE;
+  }
+  const uint32_t elapsed = now - since;
+  return elapsed < limit ? limit - elapsed : 0;
+}
 
-
-}
\ No newline at end of file
+/**
+ * @brief Update climate control (heater + mister) of every zone based on sensor readings and targets.
+ *
+ * Inputs (read from @p state, per zone):
+ *  - state.hasDht, state.tempC, state.humidityPct
+ *  - state.targetTempC, state.targetHumidityPct
+ *  - state.heaterOn, state.misterOn (used for hysteresis decisions)
+ *
+ * Readings and setpoints are only re-read after state.generation changed, so
+ * writers must call stateChanged() (the DHT driver and the WebSocket handler do).
+ * Readings are expected on the DHT's 0.1 grid.
+ *
+ * Outputs (written to @p state and hardware):
+ *  - Heater output via heaterSet(state, zone, on) (also updates state.heaterOn)
+ *  - Mister output via misterState(zone, on) and state.misterOn
+ *  - state generation bumped when an actuator changes
+ *  - the pins that changed, in every zone, written by one actuatorsCommit() at the end
+ *
+ * Fail-safe:
+ *  - If state.hasDht is false for a zone, its heater and mister are turned OFF.
+ *    Repeating that on every call costs no pin writes: only changes are committed.
+ *
+ * @param state Shared state containing latest sensor values, setpoints, and actuator states.
+ * @return Milliseconds until a mister timer runs out and the controller must
+ *         run again without new inputs, or CLIMATE_CONTROL_IDLE.
+ */
+uint32_t climateControlUpdate(SharedState &state) {
+  refreshInputs(state);
+  const uint32_t now = halMillis();
+  uint32_t nextMs = CLIMATE_CONTROL_IDLE;
+  for (uint8_t z = 0; z < state.zoneCount; z++) {
+    controlZone(state, z, now);
+    const uint32_t d = zoneDeadline(state, z, now);
+    if (d < nextMs) nextMs = d;
+  }
+  actuatorsCommit();
+  return nextMs;
+}
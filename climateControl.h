@@ -1,7 +1,10 @@
 #pragma once
 #include "sharedState.h"
 
+/// climateControlUpdate() result when only new readings or targets can switch an output
+static const uint32_t CLIMATE_CONTROL_IDLE = UINT32_MAX;
+
 void climateControlBegin();
 
 
-void climateControlUpdate(SharedState &state);
+uint32_t climateControlUpdate(SharedState &state);
@@ -0,0 +1,645 @@
+/**
+ * @file dataLog.cpp
+ * @brief Persistent append-only log of the greenhouse state on the flash filesystem.
+ *
+ * @details
+ * The log is a sequence of fixed-size segment files /log/NNNNNNNN.bin, numbered in
+ * write order. Only the newest (tail) segment is ever written to:
+ *  - records are collected in a RAM page buffer and appended one full
+ *    DATALOG_PAGE_BYTES page at a time, which keeps flash wear and write stalls
+ *    down to one small write every 16 records;
+ *  - a full segment is never reopened; the next page starts a new segment, and
+ *    beyond DATALOG_MAX_SEGMENTS the oldest segment file is deleted (retention).
+ *
+ * At boot only the tail segment is scanned: its records are CRC-checked to find
+ * the valid prefix and the newest time. A tail that ends in a damaged record is
+ * left alone and writing continues in a new segment. Records that were still in
+ * the page buffer at a reset are lost.
+ *
+ * The RAM index holds, per segment, its number, the time of its first record and
+ * its record count. Records are strictly time-ordered, so a range query picks the
+ * segment from the index and binary-searches inside it with a few small reads. A
+ * query never holds more than one page of records in RAM.
+ */
+#include "dataLog.h"
+#include "hal.h"
+#include "seriesCodec.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+static const char *const DATALOG_DIR = "/log";
+static const uint16_t PAGE_RECORDS = DATALOG_PAGE_BYTES / DATALOG_RECORD_BYTES;
+static const uint32_t SEGMENT_RECORDS = DATALOG_SEGMENT_BYTES / DATALOG_RECORD_BYTES;
+static const int16_t INVALID = INT16_MIN;
+
+/// Upper bound on stale segment files removed at boot
+static const uint16_t MAX_STALE_REMOVALS = 256;
+
+/**
+ * @brief Index entry of one segment file.
+ */
+struct Segment {
+  uint32_t number;
+  uint32_t firstSec;
+  uint32_t records;  ///< Records on flash (a damaged tail may end in invalid ones)
+};
+
+static bool mounted = false;
+static Segment segs[DATALOG_MAX_SEGMENTS];
+static uint8_t segCount = 0;
+static bool tailClosed = false;  ///< Never append to the tail again (damaged at boot)
+
+static uint8_t page[DATALOG_PAGE_BYTES];
+static uint16_t pageRecords = 0;
+
+/// Log clock: seconds since boot plus the base recovered from flash
+static uint32_t clockBase = 0;
+static uint32_t uptimeSec = 0;
+static uint32_t lastMs = 0;
+static uint32_t msAccum = 0;
+static bool hasLast = false;
+static uint32_t lastSec = 0;
+
+static DataLogStats stats;
+
+// ---------------------------------------------------------------- records
+
+/**
+ * @brief CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF).
+ */
+static uint16_t crc16(const uint8_t *data, size_t len) {
+  uint16_t crc = 0xFFFF;
+  for (size_t i = 0; i < len; i++) {
+    crc ^= (uint16_t)data[i] << 8;
+    for (uint8_t b = 0; b < 8; b++) crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+  }
+  return crc;
+}
+
+static void put16(uint8_t *p, uint16_t v) {
+  p[0] = (uint8_t)v;
+  p[1] = (uint8_t)(v >> 8);
+}
+
+static uint16_t get16(const uint8_t *p) {
+  return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t get32(const uint8_t *p) {
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static int16_t toFixed(float v, float scale) {
+  if (isnan(v)) return INVALID;
+  const float d = roundf(v * scale);
+  if (d <= -32767.0f) return -32767;
+  if (d >= 32767.0f) return 32767;
+  return (int16_t)d;
+}
+
+/// Records hold zone 0 only; the record layout predates zones.
+static void encodeRecord(const SharedState &state, uint32_t timeSec, uint8_t *out) {
+  out[0] = (uint8_t)timeSec;
+  out[1] = (uint8_t)(timeSec >> 8);
+  out[2] = (uint8_t)(timeSec >> 16);
+  out[3] = (uint8_t)(timeSec >> 24);
+  put16(out + 4, (uint16_t)toFixed(state.tempC[0], 10.0f));
+  put16(out + 6, (uint16_t)toFixed(state.humidityPct[0], 10.0f));
+  put16(out + 8, (uint16_t)toFixed(state.lightHoursToday[0], 100.0f));
+  put16(out + 10, (uint16_t)toFixed(state.targetTempC[0], 10.0f));
+  const long targetHum = isnan(state.targetHumidityPct[0]) ? 0 : lroundf(state.targetHumidityPct[0]);
+  out[12] = (uint8_t)(targetHum < 0 ? 0 : targetHum > 255 ? 255 : targetHum);
+  out[13] = (uint8_t)((state.lampOn[0] ? 0x01 : 0) | (state.heaterOn[0] ? 0x02 : 0) | (state.misterOn[0] ? 0x04 : 0));
+  put16(out + 14, crc16(out, 14));
+}
+
+static bool recordValid(const uint8_t *p) {
+  return get16(p + 14) == crc16(p, 14);
+}
+
+static void decodeRecord(const uint8_t *p, DataLogRecord &rec) {
+  rec.timeSec = get32(p);
+  rec.tempDeci = (int16_t)get16(p + 4);
+  rec.humidityDeci = (int16_t)get16(p + 6);
+  rec.lightCentiHours = get16(p + 8);
+  rec.targetTempDeci = (int16_t)get16(p + 10);
+  rec.targetHumidityPct = p[12];
+  rec.status = p[13];
+}
+
+// ---------------------------------------------------------------- segments
+
+static void segmentPath(uint32_t number, char *out, size_t len) {
+  snprintf(out, len, "%s/%08lu.bin", DATALOG_DIR, (unsigned long)number);
+}
+
+/**
+ * @brief Parse a segment file name ("NNNNNNNN.bin").
+ */
+static bool parseSegmentName(const char *name, uint32_t &number) {
+  if (strlen(name) != 12 || strcmp(name + 8, ".bin") != 0) return false;
+  for (uint8_t i = 0; i < 8; i++) {
+    if (name[i] < '0' || name[i] > '9') return false;
+  }
+  number = (uint32_t)strtoul(name, nullptr, 10);
+  return true;
+}
+
+/// Lowest segment number seen while listing, for stale removal
+static uint32_t listedMin = 0;
+static bool listedAny = false;
+
+/**
+ * @brief halFsList() callback: keep the newest DATALOG_MAX_SEGMENTS segments, sorted.
+ */
+static void collectSegment(const char *name, uint32_t size, void *) {
+  uint32_t number;
+  if (!parseSegmentName(name, number)) return;
+  if (!listedAny || number < listedMin) listedMin = number;
+  listedAny = true;
+
+  if (segCount == DATALOG_MAX_SEGMENTS) {
+    if (number < segs[0].number) return;
+    memmove(&segs[0], &segs[1], (segCount - 1) * sizeof(Segment));
+    segCount--;
+  }
+  uint8_t pos = segCount;
+  while (pos > 0 && segs[pos - 1].number > number) {
+    segs[pos] = segs[pos - 1];
+    pos--;
+  }
+  segs[pos].number = number;
+  segs[pos].firstSec = 0;
+  segs[pos].records = size / DATALOG_RECORD_BYTES;
+  segCount++;
+}
+
+/**
+ * @brief Delete the oldest segment file and drop it from the index.
+ */
+static void dropOldestSegment() {
+  char path[32];
+  segmentPath(segs[0].number, path, sizeof(path));
+  halFsRemove(path);
+  memmove(&segs[0], &segs[1], (segCount - 1) * sizeof(Segment));
+  segCount--;
+  stats.segmentsDropped++;
+}
+
+/**
+ * @brief Read the first record of every segment but the tail into the index.
+ *
+ * Segments without a valid first record hold nothing usable and are deleted.
+ */
+static void loadFirstTimes() {
+  uint8_t i = 0;
+  while (i + 1 < segCount) {
+    char path[32];
+    segmentPath(segs[i].number, path, sizeof(path));
+    uint8_t rec[DATALOG_RECORD_BYTES];
+    const HalFile f = halFsOpen(path, false);
+    const bool ok = f != HAL_FILE_NONE && halFsRead(f, 0, rec, sizeof(rec)) == sizeof(rec) && recordValid(rec);
+    halFsClose(f);
+
+    if (ok) {
+      segs[i].firstSec = get32(rec);
+      i++;
+    } else {
+      halFsRemove(path);
+      memmove(&segs[i], &segs[i + 1], (segCount - i - 1) * sizeof(Segment));
+      segCount--;
+    }
+  }
+}
+
+/**
+ * @brief Scan the tail segment for its valid prefix and newest record time.
+ */
+static void recoverTail() {
+  Segment &tail = segs[segCount - 1];
+  char path[32];
+  segmentPath(tail.number, path, sizeof(path));
+
+  const HalFile f = halFsOpen(path, false);
+  const uint32_t size = halFsSize(f);
+  uint32_t valid = 0;
+  uint32_t offset = 0;
+  bool intact = true;
+
+  while (intact && offset < size) {
+    const size_t got = halFsRead(f, offset, page, sizeof(page));
+    if (got == 0) break;
+    for (size_t i = 0; i + DATALOG_RECORD_BYTES <= got; i += DATALOG_RECORD_BYTES) {
+      const uint8_t *rec = page + i;
+      const uint32_t t = get32(rec);
+      if (!recordValid(rec) || (valid > 0 && t <= lastSec)) {
+        intact = false;
+        break;
+      }
+      if (valid == 0) tail.firstSec = t;
+      lastSec = t;
+      hasLast = true;
+      valid++;
+    }
+    offset += got;
+  }
+  halFsClose(f);
+
+  stats.recovered = valid;
+  stats.tornTail = valid * DATALOG_RECORD_BYTES != size;
+  tail.records = valid;
+  if (stats.tornTail) {
+    tail.records = size / DATALOG_RECORD_BYTES;
+    tailClosed = true;
+  }
+  if (valid == 0) {
+    // Nothing usable: drop the file so the index never holds an empty segment.
+    halFsRemove(path);
+    segCount--;
+    tailClosed = false;
+    if (segCount > 0) {
+      // Resume the clock after the previous segment's newest record.
+      Segment &prev = segs[segCount - 1];
+      segmentPath(prev.number, path, sizeof(path));
+      const HalFile pf = halFsOpen(path, false);
+      uint8_t rec[DATALOG_RECORD_BYTES];
+      for (uint32_t i = prev.records; i > 0; i--) {
+        if (halFsRead(pf, (i - 1) * DATALOG_RECORD_BYTES, rec, sizeof(rec)) == sizeof(rec) && recordValid(rec)) {
+          lastSec = get32(rec);
+          hasLast = true;
+          break;
+        }
+      }
+      halFsClose(pf);
+      tailClosed = true;
+    }
+  }
+}
+
+/**
+ * @brief Append the page buffer to the tail segment, starting a new one if needed.
+ */
+static void flushPage() {
+  const uint32_t firstSec = get32(page);
+  pageRecords = 0;
+  if (!mounted) return;
+
+  const bool needNew = segCount == 0 || tailClosed || segs[segCount - 1].records + PAGE_RECORDS > SEGMENT_RECORDS;
+  if (needNew) {
+    if (segCount == DATALOG_MAX_SEGMENTS) dropOldestSegment();
+    Segment &s = segs[segCount];
+    s.number = segCount > 0 ? segs[segCount - 1].number + 1 : 1;
+    s.firstSec = firstSec;
+    s.records = 0;
+    segCount++;
+    tailClosed = false;
+  }
+
+  Segment &tail = segs[segCount - 1];
+  char path[32];
+  segmentPath(tail.number, path, sizeof(path));
+  const HalFile f = halFsOpen(path, true);
+  const size_t written = halFsWrite(f, page, sizeof(page));
+  halFsClose(f);
+
+  stats.pageWrites++;
+  if (written != sizeof(page)) {
+    // Keep whatever made it, but never append after a short write.
+    stats.writeErrors++;
+    tail.records += written / DATALOG_RECORD_BYTES;
+    tailClosed = true;
+    if (tail.records == 0) {
+      halFsRemove(path);
+      segCount--;
+    }
+    return;
+  }
+  tail.records += PAGE_RECORDS;
+}
+
+// ---------------------------------------------------------------- public
+
+/**
+ * @brief Mount the filesystem, rebuild the segment index and recover the tail.
+ *
+ * Call once in setup(). Without a filesystem the log keeps working from its
+ * RAM page buffer only.
+ *
+ * @return True if the filesystem is available.
+ */
+bool dataLogBegin() {
+  memset(&stats, 0, sizeof(stats));
+  segCount = 0;
+  tailClosed = false;
+  pageRecords = 0;
+  hasLast = false;
+  lastSec = 0;
+  uptimeSec = 0;
+  msAccum = 0;
+  lastMs = halMillis();
+  listedAny = false;
+
+  mounted = halFsBegin();
+  if (mounted) {
+    halFsList(DATALOG_DIR, collectSegment, nullptr);
+
+    // Anything older than the retained segments is left over from an earlier
+    // retention step that did not complete.
+    if (listedAny && segCount > 0) {
+      char path[32];
+      uint16_t removed = 0;
+      for (uint32_t n = listedMin; n < segs[0].number && removed < MAX_STALE_REMOVALS; n++, removed++) {
+        segmentPath(n, path, sizeof(path));
+        halFsRemove(path);
+      }
+    }
+
+    if (segCount > 0) {
+      loadFirstTimes();
+      recoverTail();
+    }
+  }
+
+  clockBase = hasLast ? lastSec + 1 : 0;
+  return mounted;
+}
+
+/**
+ * @brief Current time on the log clock, in seconds.
+ */
+uint32_t dataLogNowSec() {
+  const uint32_t now = halMillis();
+  msAccum += now - lastMs;
+  lastMs = now;
+  uptimeSec += msAccum / 1000;
+  msAccum %= 1000;
+  return clockBase + uptimeSec;
+}
+
+/**
+ * @brief Log the current state.
+ *
+ * Call every DATALOG_SAMPLE_MS. Writes to flash only when a page is full.
+ *
+ * @param state Shared state to record.
+ */
+void dataLogAppend(const SharedState &state) {
+  const uint32_t t = dataLogNowSec();
+  if (hasLast && t <= lastSec) return;  // at most one record per second
+
+  encodeRecord(state, t, page + pageRecords * DATALOG_RECORD_BYTES);
+  pageRecords++;
+  lastSec = t;
+  hasLast = true;
+
+  if (pageRecords == PAGE_RECORDS) flushPage();
+}
+
+void dataLogStats(DataLogStats &out) {
+  out = stats;
+  out.segments = segCount;
+}
+
+// ---------------------------------------------------------------- range reads
+
+/**
+ * @brief Read up to @p max consecutive valid records with time >= @p fromSec.
+ *
+ * @return Number of records copied to @p out (DATALOG_RECORD_BYTES each); 0 when
+ * no such record exists.
+ */
+static uint16_t readBlock(uint32_t fromSec, uint8_t *out, uint16_t max) {
+  // Index of the last segment that starts at or before fromSec.
+  uint8_t p = 0;
+  while (p + 1 < segCount && segs[p + 1].firstSec <= fromSec) p++;
+
+  for (; mounted && p < segCount; p++) {
+    const Segment &s = segs[p];
+    char path[32];
+    segmentPath(s.number, path, sizeof(path));
+    const HalFile f = halFsOpen(path, false);
+    if (f == HAL_FILE_NONE) continue;
+
+    // First record that is invalid or not older than fromSec. Invalid records
+    // only ever trail the valid ones, so the predicate is monotonic.
+    uint32_t lo = 0, hi = s.records;
+    uint8_t rec[DATALOG_RECORD_BYTES];
+    while (lo < hi) {
+      const uint32_t mid = lo + (hi - lo) / 2;
+      const bool ok = halFsRead(f, mid * DATALOG_RECORD_BYTES, rec, sizeof(rec)) == sizeof(rec) && recordValid(rec);
+      if (ok && get32(rec) < fromSec) lo = mid + 1;
+      else hi = mid;
+    }
+
+    uint16_t n = 0;
+    if (lo < s.records) {
+      uint32_t want = s.records - lo;
+      if (want > max) want = max;
+      const size_t got = halFsRead(f, lo * DATALOG_RECORD_BYTES, out, want * DATALOG_RECORD_BYTES);
+      while (n < got / DATALOG_RECORD_BYTES && recordValid(out + n * DATALOG_RECORD_BYTES)) n++;
+    }
+    halFsClose(f);
+    if (n > 0) return n;
+  }
+
+  // Newest records, not yet on flash.
+  uint16_t i = 0;
+  while (i < pageRecords && get32(page + i * DATALOG_RECORD_BYTES) < fromSec) i++;
+  const uint16_t n = (uint16_t)((pageRecords - i) < max ? (pageRecords - i) : max);
+  memcpy(out, page + i * DATALOG_RECORD_BYTES, n * DATALOG_RECORD_BYTES);
+  return n;
+}
+
+/**
+ * @brief Start a range query over [@p fromSec, @p toSec] (log seconds, inclusive).
+ */
+void dataLogSeek(DataLogCursor &c, uint32_t fromSec, uint32_t toSec) {
+  c.nextSec = fromSec;
+  c.toSec = toSec;
+  c.header = false;
+  c.done = fromSec > toSec;
+  c.lineLen = 0;
+  c.lineOff = 0;
+}
+
+/**
+ * @brief Fetch the next record of a range query.
+ *
+ * @return False at the end of the range.
+ */
+bool dataLogNext(DataLogCursor &c, DataLogRecord &rec) {
+  if (c.done) return false;
+  uint8_t buf[DATALOG_RECORD_BYTES];
+  if (readBlock(c.nextSec, buf, 1) == 0) {
+    c.done = true;
+    return false;
+  }
+  decodeRecord(buf, rec);
+  if (rec.timeSec > c.toSec) {
+    c.done = true;
+    return false;
+  }
+  c.nextSec = rec.timeSec + 1;
+  if (c.nextSec == 0) c.done = true;
+  return true;
+}
+
+/**
+ * @brief Print @p v / @p div with @p decimals digits, or nothing if invalid.
+ */
+static int formatFixed(char *out, size_t len, int32_t v, int32_t div, uint8_t decimals) {
+  if (v == INVALID) return snprintf(out, len, ",");
+  const char *sign = v < 0 ? "-" : "";
+  const int32_t a = v < 0 ? -v : v;
+  return snprintf(out, len, ",%s%ld.%0*ld", sign, (long)(a / div), decimals, (long)(a % div));
+}
+
+/**
+ * @brief Format @p r as one CSV line of dataLogReadCsv(), newline included.
+ */
+void dataLogFormatCsv(const DataLogRecord &r, char *out, size_t len) {
+  int n = snprintf(out, len, "%lu", (unsigned long)r.timeSec);
+  n += formatFixed(out + n, len - n, r.tempDeci, 10, 1);
+  n += formatFixed(out + n, len - n, r.humidityDeci, 10, 1);
+  n += formatFixed(out + n, len - n, r.lightCentiHours, 100, 2);
+  n += formatFixed(out + n, len - n, r.targetTempDeci, 10, 1);
+  snprintf(out + n, len - n, ",%u,%u,%u,%u\n", r.targetHumidityPct,
+           r.status & 0x01 ? 1 : 0, r.status & 0x02 ? 1 : 0, r.status & 0x04 ? 1 : 0);
+}
+
+/**
+ * @brief Produce the next part of a range query as CSV, with a header line.
+ *
+ * Suitable as a chunked HTTP response filler: lines may be split across calls.
+ *
+ * @return Bytes written to @p out, 0 at the end of the range.
+ */
+size_t dataLogReadCsv(DataLogCursor &c, char *out, size_t maxLen) {
+  size_t n = 0;
+  uint8_t block[DATALOG_PAGE_BYTES];
+  uint16_t blockLen = 0, blockPos = 0;
+
+  while (n < maxLen) {
+    if (c.lineOff < c.lineLen) {
+      const size_t take = (size_t)(c.lineLen - c.lineOff) < maxLen - n ? (size_t)(c.lineLen - c.lineOff) : maxLen - n;
+      memcpy(out + n, c.line + c.lineOff, take);
+      c.lineOff += take;
+      n += take;
+      continue;
+    }
+
+    if (!c.header) {
+      strcpy(c.line, "time,tempC,humidityPct,lightHours,targetTempC,targetHumidityPct,lamp,heater,mister\n");
+      c.header = true;
+    } else {
+      if (c.done) break;
+      if (blockPos == blockLen) {
+        blockLen = readBlock(c.nextSec, block, PAGE_RECORDS);
+        blockPos = 0;
+      }
+      if (blockLen == 0) {
+        c.done = true;
+        break;
+      }
+      DataLogRecord rec;
+      decodeRecord(block + blockPos * DATALOG_RECORD_BYTES, rec);
+      blockPos++;
+      if (rec.timeSec > c.toSec) {
+        c.done = true;
+        break;
+      }
+      c.nextSec = rec.timeSec + 1;
+      if (c.nextSec == 0) c.done = true;
+      dataLogFormatCsv(rec, c.line, sizeof(c.line));
+    }
+    c.lineLen = (uint8_t)strlen(c.line);
+    c.lineOff = 0;
+  }
+  return n;
+}
+
+/// Room below which a block is staged in the cursor's line buffer
+static const size_t PACKED_MIN_ROOM = 64;
+
+/**
+ * @brief Encode the next records of a range query into one block at @p out.
+ *
+ * Stops at the first record that does not fit; it starts the next block.
+ *
+ * @return Block length with its header, 0 at the end of the range.
+ */
+static size_t packBlock(DataLogCursor &c, uint8_t *out, size_t maxLen) {
+  const size_t room = maxLen - DATALOG_PACKED_HEADER;
+  SeriesEncoder e;
+  seriesEncoderBegin(e, out + DATALOG_PACKED_HEADER, room < UINT16_MAX ? room : UINT16_MAX, DATALOG_PACKED_COLUMNS);
+  uint8_t block[DATALOG_PAGE_BYTES];
+  bool full = false;
+
+  while (!c.done && !full && e.count < UINT16_MAX) {
+    const uint16_t blockLen = readBlock(c.nextSec, block, PAGE_RECORDS);
+    if (blockLen == 0) {
+      c.done = true;
+      break;
+    }
+    for (uint16_t i = 0; i < blockLen && e.count < UINT16_MAX; i++) {
+      DataLogRecord rec;
+      decodeRecord(block + i * DATALOG_RECORD_BYTES, rec);
+      if (rec.timeSec > c.toSec) {
+        c.done = true;
+        break;
+      }
+      const int16_t values[DATALOG_PACKED_COLUMNS] = {
+        rec.tempDeci, rec.humidityDeci, (int16_t)rec.lightCentiHours,
+        rec.targetTempDeci, rec.targetHumidityPct, rec.status,
+      };
+      if (!seriesAppend(e, rec.timeSec, values)) {
+        full = true;
+        break;
+      }
+      c.nextSec = rec.timeSec + 1;
+      if (c.nextSec == 0) {
+        c.done = true;
+        break;
+      }
+    }
+  }
+
+  if (e.count == 0 && c.done) return 0;
+  const size_t bytes = seriesFinish(e);
+  put16(out, (uint16_t)e.count);
+  put16(out + 2, (uint16_t)bytes);
+  return DATALOG_PACKED_HEADER + bytes;
+}
+
+/**
+ * @brief Produce the next part of a range query as packed blocks.
+ *
+ * Each call fills @p out with one block when there is room for a useful one;
+ * with less room a small block is staged in the cursor and copied out over
+ * the following calls, so blocks may be split across calls like CSV lines.
+ *
+ * @return Bytes written to @p out, 0 at the end of the range.
+ */
+size_t dataLogReadPacked(DataLogCursor &c, uint8_t *out, size_t maxLen) {
+  size_t n = 0;
+  while (n < maxLen) {
+    if (c.lineOff < c.lineLen) {
+      const size_t take = (size_t)(c.lineLen - c.lineOff) < maxLen - n ? (size_t)(c.lineLen - c.lineOff) : maxLen - n;
+      memcpy(out + n, c.line + c.lineOff, take);
+      c.lineOff += take;
+      n += take;
+      continue;
+    }
+    if (c.done) break;
+    if (maxLen - n >= PACKED_MIN_ROOM) {
+      n += packBlock(c, out + n, maxLen - n);
+      break;
+    }
+    c.lineLen = (uint8_t)packBlock(c, (uint8_t *)c.line, sizeof(c.line));
+    c.lineOff = 0;
+    if (c.lineLen == 0) break;
+  }
+  return n;
+}
@@ -0,0 +1,92 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include "sharedState.h"
+
+/**
+ * @file dataLog.h
+ * @brief Persistent append-only log of the greenhouse state on the flash filesystem.
+ *
+ * Record, 16 bytes, little-endian:
+ *
+ * | offset | size | content                                               |
+ * |--------|------|-------------------------------------------------------|
+ * | 0      | 4    | time, log seconds (DATALOG_INVALID never used)        |
+ * | 4      | 2    | temperature, tenths of °C (INT16_MIN = invalid)       |
+ * | 6      | 2    | humidity, tenths of % (INT16_MIN = invalid)           |
+ * | 8      | 2    | light hours today, hundredths                         |
+ * | 10     | 2    | target temperature, tenths of °C                      |
+ * | 12     | 1    | target humidity, %                                    |
+ * | 13     | 1    | status: bit0 lamp, bit1 heater, bit2 mister           |
+ * | 14     | 2    | CRC-16/CCITT of bytes 0..13                           |
+ *
+ * Log seconds continue across reboots: after a restart the clock resumes one
+ * second after the newest record found on flash.
+ *
+ * dataLogReadPacked() serves the same range as a sequence of blocks, each a
+ * 4-byte little-endian header (record count, stream length, uint16 each)
+ * followed by a seriesCodec.h stream of DATALOG_PACKED_COLUMNS values per
+ * record: temperature, humidity, light hours, target temperature, target
+ * humidity and status, in the units above. A block may hold no record.
+ */
+
+static const uint8_t  DATALOG_RECORD_BYTES = 16;
+/// Records are buffered in RAM and written one flash page at a time
+static const uint16_t DATALOG_PAGE_BYTES = 256;
+static const uint32_t DATALOG_SEGMENT_BYTES = 16384;
+/// Retention: the oldest segment is deleted when a new one would exceed this
+static const uint8_t  DATALOG_MAX_SEGMENTS = 32;
+/// Period at which dataLogAppend() should be called
+static const uint32_t DATALOG_SAMPLE_MS = 10000;
+/// Values per record of a packed block
+static const uint8_t  DATALOG_PACKED_COLUMNS = 6;
+static const uint8_t  DATALOG_PACKED_HEADER = 4;
+
+/**
+ * @brief One decoded log record.
+ */
+struct DataLogRecord {
+  uint32_t timeSec;
+  int16_t tempDeci;
+  int16_t humidityDeci;
+  uint16_t lightCentiHours;
+  int16_t targetTempDeci;
+  uint8_t targetHumidityPct;
+  uint8_t status;
+};
+
+/**
+ * @brief Read position of a range query; resumable between calls.
+ */
+struct DataLogCursor {
+  uint32_t nextSec;   ///< Time of the next record wanted
+  uint32_t toSec;     ///< Last time wanted (inclusive)
+  bool header;        ///< CSV header already produced
+  bool done;
+  char line[96];      ///< Formatted line not yet fully copied out
+  uint8_t lineLen;
+  uint8_t lineOff;
+};
+
+/**
+ * @brief Counters for diagnostics.
+ */
+struct DataLogStats {
+  uint8_t segments;
+  uint32_t recovered;    ///< Valid records found in the tail segment at boot
+  bool tornTail;         ///< The tail segment ended in an invalid record at boot
+  uint32_t pageWrites;
+  uint32_t writeErrors;
+  uint32_t segmentsDropped;
+};
+
+bool     dataLogBegin();
+void     dataLogAppend(const SharedState &state);
+uint32_t dataLogNowSec();
+void     dataLogStats(DataLogStats &stats);
+
+void     dataLogSeek(DataLogCursor &c, uint32_t fromSec, uint32_t toSec);
+bool     dataLogNext(DataLogCursor &c, DataLogRecord &rec);
+size_t   dataLogReadCsv(DataLogCursor &c, char *out, size_t maxLen);
+size_t   dataLogReadPacked(DataLogCursor &c, uint8_t *out, size_t maxLen);
+void     dataLogFormatCsv(const DataLogRecord &r, char *out, size_t len);
@@ -0,0 +1,55 @@
+/**
+ * @file dataflow.cpp
+ * @brief Topic versions and subscriber wake-up.
+ */
+#include "dataflow.h"
+#include "scheduler.h"
+
+/**
+ * @brief A task and the topics it depends on.
+ */
+struct Subscriber {
+  int8_t task;
+  uint8_t topics;
+};
+
+static uint32_t versions[FLOW_TOPICS];
+static Subscriber subscribers[FLOW_MAX_SUBSCRIBERS];
+static uint8_t subscriberCount = 0;
+
+/**
+ * @brief Drop all subscriptions and reset the versions (call in setup(), after schedulerBegin()).
+ */
+void flowBegin() {
+  for (uint8_t t = 0; t < FLOW_TOPICS; t++) versions[t] = 0;
+  subscriberCount = 0;
+}
+
+/**
+ * @brief Wake scheduler task @p task whenever a topic in @p topicMask is published.
+ *
+ * @return false if the subscriber table is full or @p task is invalid.
+ */
+bool flowSubscribe(int8_t task, uint8_t topicMask) {
+  if (task < 0 || subscriberCount >= FLOW_MAX_SUBSCRIBERS) return false;
+  subscribers[subscriberCount++] = {task, topicMask};
+  return true;
+}
+
+/**
+ * @brief Announce that the values of @p topic changed: bump its version and wake its subscribers.
+ */
+void flowPublish(uint8_t topic) {
+  if (topic >= FLOW_TOPICS) return;
+  versions[topic]++;
+  for (uint8_t i = 0; i < subscriberCount; i++) {
+    if (subscribers[i].topics & FLOW_BIT(topic)) schedulerWake(subscribers[i].task, 0);
+  }
+}
+
+/**
+ * @brief Number of times @p topic was published since flowBegin().
+ */
+uint32_t flowVersion(uint8_t topic) {
+  return topic < FLOW_TOPICS ? versions[topic] : 0;
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include <stdint.h>
+
+/**
+ * @file dataflow.h
+ * @brief Versioned topics that wake the scheduler tasks depending on them.
+ *
+ * @details Producers publish a topic after changing its values in SharedState
+ * (the DHT driver its readings, the WebSocket commands the setpoints). Each
+ * publish bumps the topic's version and wakes every task subscribed to it
+ * with flowSubscribe(), so a consumer registered as a one-shot task
+ * (periodMs 0, see scheduler.h) runs once per change instead of on a timer:
+ *
+ *   controlTask = schedulerAdd("control", controlTaskRun, 0, SCHED_PRIO_HIGH, 1);
+ *   flowSubscribe(controlTask, FLOW_BIT(FLOW_READINGS) | FLOW_BIT(FLOW_TARGETS));
+ *
+ * Several publishes before the task gets to run coalesce into one run. A
+ * consumer with rules of its own in time (a maximum on-time, a backoff)
+ * re-arms its task for the next such deadline with schedulerWake(), as the
+ * self-timed tasks already do; a publish still wakes it earlier.
+ *
+ * flowVersion() lets any consumer tell whether a topic changed since it last
+ * looked. Used from loop() context only.
+ */
+
+/// Published values
+enum FlowTopic : uint8_t {
+  FLOW_READINGS,  ///< DHT temperature, humidity and validity of any zone
+  FLOW_TARGETS,   ///< Setpoints of any zone
+  FLOW_TOPICS
+};
+
+/// Subscription mask bit of a topic
+#define FLOW_BIT(topic) (1u << (topic))
+
+/// Most subscribed tasks
+static const uint8_t FLOW_MAX_SUBSCRIBERS = 4;
+
+void     flowBegin();
+bool     flowSubscribe(int8_t task, uint8_t topicMask);
+void     flowPublish(uint8_t topic);
+uint32_t flowVersion(uint8_t topic);
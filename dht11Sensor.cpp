@@ -1,54 +1,232 @@
 /**
  * @file dht11Sensor.cpp
  * @brief Implementing the DHT11 sensor
- * 
- * The file handles the reading from the DHT11 sensor and updating the associated sharedState
+ *
+ * The file handles the reading from the DHT11 sensor and updating the associated sharedState.
+ *
+ * @details
+ * Reading is done asynchronously so that loop() (and AsyncTCP) never waits on the sensor
+ * and interrupts are never masked:
+ *  1. IDLE:    once per DHT_INTERVAL_MS the line is pulled LOW (start signal).
+ *  2. START:   after DHT_START_LOW_MS the line is released and a falling-edge interrupt
+ *              timestamps every edge of the sensor's answer into a small buffer.
+ *  3. CAPTURE: once all edges are in (or DHT_CAPTURE_TIMEOUT_MS after the release) the frame is
+ *              decoded and checksum-verified in loop(), outside the interrupt.
+ *
+ * Each call to dht11Read() advances this state machine by at most one step, returns
+ * immediately and reports how long the caller may wait before the next call.
+ *
+ * With several zones the sensors are read in turn, one conversion every
+ * DHT_INTERVAL_MS / zoneCount(), so each sensor is still read once per DHT_INTERVAL_MS.
+ *
+ * Decoded values pass a sensorFilter (median/MAD outlier rejection and a short
+ * EMA) per zone and quantity before they reach SharedState, so one bad frame
+ * that still passes the checksum cannot switch the heater or the mister.
  */
 #include "dht11Sensor.h"
-#include <DHT.h> // Adafruit DHT sensor library
+#include "hal.h"
+#include "zones.h"
+#include "sensorFilter.h"
+#include "dataflow.h"
 
-/// Pin used to on the microcontroller for signal to the sensor
-#define DHTPIN  D7
-/// Type of sensor module. Used to correctly read information using the pre-build library.
-#define DHTTYPE DHT11
+/// Time between conversions of one sensor. The DHT11 cannot deliver a new value more than once per second.
+static const uint32_t DHT_INTERVAL_MS = 1000;
+/// Length of the start signal (datasheet minimum is 18 ms).
+static const uint32_t DHT_START_LOW_MS = 20;
+/// A full answer takes ~5 ms; give up on it after this long.
+static const uint32_t DHT_CAPTURE_TIMEOUT_MS = 10;
+/// Without a good frame for this long, the reading is reported invalid.
+static const uint32_t DHT_STALE_MS = 5000;
 
-/// Internal DHT driver instance (module-owned)
-static DHT dht(DHTPIN, DHTTYPE);
+/// Falling edges in one answer: response pulse, start of each of the 40 bits, end pulse.
+static const uint8_t DHT_EDGES = 42;
+/// Falling-to-falling time separating a 0 bit (~76 us) from a 1 bit (~120 us).
+static const uint32_t DHT_BIT_THRESHOLD_US = 100;
+/// Falling-to-falling times outside this range mean a glitch or a missed edge.
+static const uint32_t DHT_BIT_MIN_US = 50;
+static const uint32_t DHT_BIT_MAX_US = 200;
+
+/// Temperature filter (tenths of a degree): a jump of 3 degrees is rejected on a steady signal
+static const FilterConfig DHT_TEMP_FILTER = {5, 1, 3, 25};
+/// Humidity filter (tenths of a percent)
+static const FilterConfig DHT_HUM_FILTER = {5, 1, 3, 80};
+
+enum DhtPhase : uint8_t { DHT_IDLE, DHT_START, DHT_CAPTURE };
+
+/// Internal state
+static DhtPhase phase = DHT_IDLE;
+static uint32_t phaseStartMs = 0;  ///< Start of the current phase
+static uint32_t slotStartMs = 0;   ///< Start of the current conversion slot
+static uint8_t zone = 0;            ///< Zone whose sensor is being read
+static uint32_t lastGoodMs[ZONE_MAX];
+static SensorFilter tempFilter[ZONE_MAX];
+static SensorFilter humFilter[ZONE_MAX];
+
+/// Edge timestamps written by the interrupt handler
+static volatile uint32_t edgeUs[DHT_EDGES];
+static volatile uint8_t edgeCount = 0;
 
 /**
- * @brief Initialize the DHT11 hardware/library.
+ * @brief Falling-edge interrupt: timestamp the edge.
+ */
+static void IRAM_ATTR dhtEdgeIsr() {
+  const uint8_t n = edgeCount;
+  if (n < DHT_EDGES) {
+    edgeUs[n] = halMicros();
+    edgeCount = n + 1;
+  }
+}
+
+/**
+ * @brief Decode the captured edges into the five data bytes.
  *
- * Call once in setup().
+ * @param data Receives humidity int/dec, temperature int/dec and checksum.
+ * @return True if all edges were present, all bit times were plausible and
+ *         the checksum matches.
+ */
+static bool decodeFrame(uint8_t data[5]) {
+  if (edgeCount < DHT_EDGES) return false;
+
+  for (uint8_t i = 0; i < 5; i++) data[i] = 0;
+
+  for (uint8_t i = 0; i < 40; i++) {
+    const uint32_t dt = edgeUs[i + 2] - edgeUs[i + 1];
+    if (dt < DHT_BIT_MIN_US || dt > DHT_BIT_MAX_US) return false;
+    if (dt > DHT_BIT_THRESHOLD_US) {
+      data[i / 8] |= (uint8_t)(0x80 >> (i % 8));
+    }
+  }
+
+  const uint8_t sum = (uint8_t)(data[0] + data[1] + data[2] + data[3]);
+  return sum == data[4];
+}
+
+/**
+ * @brief Time from one conversion to the next (sensors are read in turn).
+ */
+static uint32_t slotMs() {
+  return DHT_INTERVAL_MS / zoneCount();
+}
+
+/**
+ * @brief Initialize the DHT11 line of every zone.
+ *
+ * Call once in setup(), after zonesBegin(). The first conversion starts on the first dht11Read().
  */
 void dht11Begin() {
-  dht.begin();
+  for (uint8_t z = 0; z < zoneCount(); z++) halPinMode(zonePins(z).dht, INPUT_PULLUP);
+  phase = DHT_IDLE;
+  zone = 0;
+  phaseStartMs = halMillis() - slotMs();
+  slotStartMs = phaseStartMs;
+  for (uint8_t z = 0; z < ZONE_MAX; z++) {
+    lastGoodMs[z] = phaseStartMs;
+    filterInit(tempFilter[z], DHT_TEMP_FILTER);
+    filterInit(humFilter[z], DHT_HUM_FILTER);
+  }
 }
 
 /**
- * @brief Read temperature + humidity and write results into SharedState.
+ * @brief Advance the acquisition and write new results into SharedState.
  *
- * On success:
- *  - state.tempC, state.humidityPct updated
+ * Never blocks. Each conversion reads the sensor of the next zone. When a frame
+ * passes the checksum, for that zone:
+ *  - state.tempC, state.humidityPct updated with the filtered values
  *  - state.hasDht = true
+ *  - state.dhtSampleMs set to the sample time, state.dhtSeq incremented
+ *  - state generation bumped if a value changed
  *
- * On failure:
+ * When no good frame arrived from a zone's sensor for DHT_STALE_MS:
  *  - tempC/humidityPct set to NAN
  *  - state.hasDht = false
  *
+ * Frames that fail to decode are counted in state.dhtErrors.
+ *
  * @param state SharedState to update.
+ * @return Milliseconds until the state machine next needs a call.
  */
-void dht11Read(SharedState &state) {
-  float h = dht.readHumidity();
-  float t = dht.readTemperature();
-  
-  if (isnan(h) || isnan(t)) {
-    state.hasDht = false;
-    state.tempC = NAN;
-    state.humidityPct = NAN;
-    return;
+uint32_t dht11Read(SharedState &state) {
+  const uint32_t now = halMillis();
+  const uint32_t inPhase = now - phaseStartMs;
+  const uint32_t inSlot = now - slotStartMs;
+  const uint8_t pin = zonePins(zone).dht;
+  uint32_t nextMs = slotMs();
+
+  switch (phase) {
+    case DHT_IDLE:
+      if (inSlot < slotMs()) {
+        nextMs = slotMs() - inSlot;
+        break;
+      }
+      halPinMode(pin, OUTPUT);
+      halDigitalWrite(pin, LOW);
+      phaseStartMs = now;
+      slotStartMs = now;
+      phase = DHT_START;
+      nextMs = DHT_START_LOW_MS;
+      break;
+
+    case DHT_START:
+      if (inPhase < DHT_START_LOW_MS) {
+        nextMs = DHT_START_LOW_MS - inPhase;
+        break;
+      }
+      edgeCount = 0;
+      halAttachFallingInterrupt(pin, dhtEdgeIsr);
+      halPinMode(pin, INPUT_PULLUP); // release the line; the sensor answers now
+      phaseStartMs = now;            // the capture timeout runs from here, however late START ran
+      phase = DHT_CAPTURE;
+      nextMs = 1;
+      break;
+
+    case DHT_CAPTURE: {
+      if (edgeCount < DHT_EDGES && inPhase < DHT_CAPTURE_TIMEOUT_MS) {
+        nextMs = 1;
+        break;
+      }
+      halDetachInterrupt(pin);
+      phase = DHT_IDLE;
+
+      const uint8_t z = zone;
+      zone = (uint8_t)((zone + 1) % zoneCount());
+      nextMs = inSlot < slotMs() ? slotMs() - inSlot : 0; // overran the slot: next sensor at once
+
+      uint8_t data[5];
+      if (decodeFrame(data)) {
+        const uint16_t hDeci = (uint16_t)(data[0] * 10 + data[1]);
+        const int16_t tDeci = (int16_t)(data[2] * 10 + (data[3] & 0x0F));
+
+        const float h = filterPush(humFilter[z], (int16_t)hDeci) / 10.0f;
+        const float t = filterPush(tempFilter[z], (data[3] & 0x80) ? (int16_t)-tDeci : tDeci) / 10.0f;
+        const bool changed = !state.hasDht[z] || h != state.humidityPct[z] || t != state.tempC[z];
+
+        state.humidityPct[z] = h;
+        state.tempC[z] = t;
+        state.hasDht[z] = true;
+        state.dhtSampleMs[z] = now;
+        state.dhtSeq[z]++;
+        lastGoodMs[z] = now;
+        if (changed) {
+          stateChanged(state);
+          flowPublish(FLOW_READINGS);
+        }
+      } else {
+        state.dhtErrors[z]++;
+      }
+      break;
+    }
   }
 
-  state.humidityPct = h;
-  state.tempC = t;
-  state.hasDht = true;
+  for (uint8_t z = 0; z < state.zoneCount; z++) {
+    if (state.hasDht[z] && (uint32_t)(now - lastGoodMs[z]) >= DHT_STALE_MS) {
+      state.hasDht[z] = false;
+      state.tempC[z] = NAN;
+      state.humidityPct[z] = NAN;
+      filterReset(tempFilter[z]);  // start afresh when the sensor is back
+      filterReset(humFilter[z]);
+      stateChanged(state);
+      flowPublish(FLOW_READINGS);
+    }
+  }
+  return nextMs;
 }
@@ -4,4 +4,4 @@
 void dht11Begin();
 
 
-void dht11Read(SharedState &state);
+uint32_t dht11Read(SharedState &state);
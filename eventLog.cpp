@@ -0,0 +1,250 @@
+/**
+ * @file eventLog.cpp
+ * @brief Deferred structured logging through a lock-free ring buffer.
+ *
+ * @details
+ * Logging call sites only copy a few bytes (time, event id, integer arguments)
+ * into a single-producer/single-consumer byte ring; nothing is formatted and
+ * nothing touches the UART there. Producers are the loop and the network
+ * callbacks, which on the ESP8266 never preempt each other, so together they
+ * form the single producer. eventLogDrain(), run from a low-priority task, is
+ * the consumer: it formats records (or frames them in binary mode) and writes
+ * only as many bytes as the UART buffer can take without blocking, keeping the
+ * rest for its next run.
+ *
+ * head and tail are free-running byte counters; the producer publishes a record
+ * by storing head with release order after the bytes are in place, and the
+ * consumer frees space by storing tail the same way. A record that does not fit
+ * is dropped and counted; the drain reports the count as an EV_LOG_DROPPED record.
+ */
+#include "eventLog.h"
+#include "hal.h"
+#include <atomic>
+#include <stdio.h>
+#include <string.h>
+
+static_assert((EVENTLOG_RING_BYTES & (EVENTLOG_RING_BYTES - 1)) == 0, "ring size must be a power of two");
+
+struct EventInfo {
+  uint8_t level;
+  uint8_t argc;
+  const char *format;
+};
+
+#define LOG_EVENT_INFO(id, level, argc, fmt) {level, argc, fmt},
+static const EventInfo EVENTS[LOG_EVENT_COUNT] = { LOG_EVENTS(LOG_EVENT_INFO) };
+#undef LOG_EVENT_INFO
+
+static const char LEVEL_TAGS[] = "DIWE";
+
+static uint8_t ring[EVENTLOG_RING_BYTES];
+static std::atomic<uint32_t> head(0);   ///< Written by the producer
+static std::atomic<uint32_t> tail(0);   ///< Written by the consumer
+static std::atomic<uint32_t> dropped(0);
+
+/// Drain side: output not yet accepted by the UART
+static char pending[128];
+static uint16_t pendingLen = 0;
+static uint16_t pendingOff = 0;
+static uint32_t droppedReported = 0;
+static bool binaryOut = EVENTLOG_BINARY_SERIAL;
+
+static void put32(uint8_t *p, uint32_t v) {
+  p[0] = (uint8_t)v;
+  p[1] = (uint8_t)(v >> 8);
+  p[2] = (uint8_t)(v >> 16);
+  p[3] = (uint8_t)(v >> 24);
+}
+
+static uint32_t get32(const uint8_t *p) {
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/**
+ * @brief Empty the ring and reset the counters.
+ */
+void eventLogBegin() {
+  head.store(0);
+  tail.store(0);
+  dropped.store(0);
+  pendingLen = 0;
+  pendingOff = 0;
+  droppedReported = 0;
+}
+
+/**
+ * @brief Switch Serial output between text lines and binary frames.
+ */
+void eventLogSetBinary(bool binary) {
+  binaryOut = binary;
+}
+
+/**
+ * @brief Append one record (use the eventLog() template instead).
+ */
+void eventLogWrite(LogEvent event, const uint32_t *args, uint8_t argc) {
+  if (argc > EVENTLOG_MAX_ARGS) argc = EVENTLOG_MAX_ARGS;
+  uint8_t rec[EVENTLOG_RECORD_MAX];
+  put32(rec, halMillis());
+  rec[4] = event;
+  rec[5] = argc;
+  for (uint8_t i = 0; i < argc; i++) put32(rec + EVENTLOG_HEADER_BYTES + 4 * i, args[i]);
+  const uint32_t len = EVENTLOG_HEADER_BYTES + 4u * argc;
+
+  const uint32_t h = head.load(std::memory_order_relaxed);
+  const uint32_t t = tail.load(std::memory_order_acquire);
+  if (EVENTLOG_RING_BYTES - (h - t) < len) {
+    dropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  const uint32_t pos = h & (EVENTLOG_RING_BYTES - 1);
+  const uint32_t first = (EVENTLOG_RING_BYTES - pos) < len ? (EVENTLOG_RING_BYTES - pos) : len;
+  memcpy(ring + pos, rec, first);
+  memcpy(ring, rec + first, len - first);
+  head.store(h + len, std::memory_order_release);
+}
+
+/**
+ * @brief Number of records dropped because the ring was full.
+ */
+uint32_t eventLogDropped() {
+  return dropped.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Print one record as a text line ("[I] 12.345 message\n").
+ *
+ * Shared with the host decoder. Unknown ids and malformed records produce a
+ * placeholder line instead of reading past @p len.
+ *
+ * @return Characters written (without the terminating NUL).
+ */
+size_t eventLogFormat(const uint8_t *record, size_t len, char *out, size_t maxLen) {
+  if (maxLen == 0) return 0;
+  out[0] = '\0';
+  if (len < EVENTLOG_HEADER_BYTES) return 0;
+
+  const uint32_t ms = get32(record);
+  const uint8_t id = record[4];
+  const uint8_t argc = record[5];
+  if (id >= LOG_EVENT_COUNT || len < EVENTLOG_HEADER_BYTES + 4u * argc) {
+    const int n = snprintf(out, maxLen, "[?] %lu.%03lu event %u (%u args)\n", (unsigned long)(ms / 1000),
+                           (unsigned long)(ms % 1000), id, argc);
+    return n < 0 ? 0 : ((size_t)n < maxLen ? (size_t)n : maxLen - 1);
+  }
+
+  const EventInfo &info = EVENTS[id];
+  size_t n = 0;
+  auto emit = [&](const char *fmt, auto... v) {
+    if (n >= maxLen) return;
+    const int w = snprintf(out + n, maxLen - n, fmt, v...);
+    if (w > 0) n += (size_t)w < maxLen - n ? (size_t)w : maxLen - n - 1;
+  };
+
+  emit("[%c] %lu.%03lu ", LEVEL_TAGS[info.level & 3], (unsigned long)(ms / 1000), (unsigned long)(ms % 1000));
+
+  uint8_t arg = 0;
+  for (const char *f = info.format; *f && n + 1 < maxLen; f++) {
+    if (*f != '%' || f[1] == '\0') {
+      out[n++] = *f;
+      out[n] = '\0';
+      continue;
+    }
+    const char conv = *++f;
+    if (conv == '%') {
+      emit("%%");
+      continue;
+    }
+    const uint32_t v = arg < argc ? get32(record + EVENTLOG_HEADER_BYTES + 4 * arg) : 0;
+    arg++;
+    const int32_t s = (int32_t)v;
+    const uint32_t mag = s < 0 ? 0u - v : v;
+    switch (conv) {
+      case 'u': emit("%lu", (unsigned long)v); break;
+      case 'd': emit("%ld", (long)s); break;
+      case 'x': emit("%lx", (unsigned long)v); break;
+      case 'D': emit("%s%lu.%lu", s < 0 ? "-" : "", (unsigned long)(mag / 10), (unsigned long)(mag % 10)); break;
+      case 'C': emit("%s%lu.%02lu", s < 0 ? "-" : "", (unsigned long)(mag / 100), (unsigned long)(mag % 100)); break;
+      case 'B': emit("%s", v ? "true" : "false"); break;
+      case 'I': emit("%u.%u.%u.%u", (unsigned)(v & 0xFF), (unsigned)((v >> 8) & 0xFF),
+                     (unsigned)((v >> 16) & 0xFF), (unsigned)(v >> 24)); break;
+      default: emit("%%%c", conv); break;
+    }
+  }
+  emit("\n");
+  return n;
+}
+
+/**
+ * @brief Take the oldest record out of the ring.
+ *
+ * @return Record length, 0 if the ring is empty.
+ */
+static size_t popRecord(uint8_t *rec) {
+  const uint32_t t = tail.load(std::memory_order_relaxed);
+  const uint32_t h = head.load(std::memory_order_acquire);
+  if (h == t) return 0;
+
+  const uint32_t pos = t & (EVENTLOG_RING_BYTES - 1);
+  const uint8_t argc = ring[(pos + 5) & (EVENTLOG_RING_BYTES - 1)];
+  const size_t len = EVENTLOG_HEADER_BYTES + 4u * argc;
+  for (size_t i = 0; i < len; i++) rec[i] = ring[(pos + i) & (EVENTLOG_RING_BYTES - 1)];
+  tail.store(t + len, std::memory_order_release);
+  return len;
+}
+
+/**
+ * @brief Render @p rec into the pending output buffer (text line or binary frame).
+ */
+static void stage(const uint8_t *rec, size_t len) {
+  pendingOff = 0;
+  if (!binaryOut) {
+    pendingLen = (uint16_t)eventLogFormat(rec, len, pending, sizeof(pending));
+    return;
+  }
+  uint8_t x = 0;
+  pending[0] = (char)EVENTLOG_SYNC;
+  pending[1] = (char)len;
+  for (size_t i = 0; i < len; i++) {
+    pending[2 + i] = (char)rec[i];
+    x ^= rec[i];
+  }
+  pending[2 + len] = (char)x;
+  pendingLen = (uint16_t)(len + 3);
+}
+
+/**
+ * @brief Move records from the ring to Serial without blocking.
+ *
+ * Call every EVENTLOG_DRAIN_MS from a low-priority task. Stops as soon as the
+ * UART cannot take more; a partly written record is continued on the next call.
+ */
+void eventLogDrain() {
+  for (;;) {
+    if (pendingOff < pendingLen) {
+      const size_t room = halSerialWritable();
+      if (room == 0) return;
+      const size_t want = pendingLen - pendingOff;
+      pendingOff += (uint16_t)halSerialWrite((const uint8_t *)pending + pendingOff, want < room ? want : room);
+      if (pendingOff < pendingLen) return;
+    }
+
+    uint8_t rec[EVENTLOG_RECORD_MAX];
+    const uint32_t d = dropped.load(std::memory_order_relaxed);
+    if (d != droppedReported) {
+      // Report losses in-band, as soon as the drain notices them.
+      put32(rec, halMillis());
+      rec[4] = EV_LOG_DROPPED;
+      rec[5] = 1;
+      put32(rec + EVENTLOG_HEADER_BYTES, d - droppedReported);
+      droppedReported = d;
+      stage(rec, EVENTLOG_HEADER_BYTES + 4);
+      continue;
+    }
+
+    const size_t len = popRecord(rec);
+    if (len == 0) return;
+    stage(rec, len);
+  }
+}
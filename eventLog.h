@@ -0,0 +1,52 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include "logEvents.h"
+
+/**
+ * @file eventLog.h
+ * @brief Deferred structured logging through a lock-free ring buffer.
+ *
+ * Record layout (little-endian): [time ms u32][event id u8][argc u8][args u32 x argc].
+ *
+ * In binary mode each record is sent to Serial as a frame:
+ * [EVENTLOG_SYNC][record length u8][record][XOR of the record bytes].
+ */
+
+enum LogLevel : uint8_t { LOG_DEBUG, LOG_INFO, LOG_WARN, LOG_ERROR };
+
+#define LOG_EVENT_ID(id, level, argc, fmt) id,
+enum LogEvent : uint8_t { LOG_EVENTS(LOG_EVENT_ID) LOG_EVENT_COUNT };
+#undef LOG_EVENT_ID
+
+/// Ring capacity in bytes (power of two)
+static const uint16_t EVENTLOG_RING_BYTES = 2048;
+static const uint8_t  EVENTLOG_MAX_ARGS = 6;
+static const uint8_t  EVENTLOG_HEADER_BYTES = 6;
+static const uint8_t  EVENTLOG_RECORD_MAX = EVENTLOG_HEADER_BYTES + 4 * EVENTLOG_MAX_ARGS;
+static const uint8_t  EVENTLOG_SYNC = 0xA5;
+/// Period at which eventLogDrain() should be called
+static const uint32_t EVENTLOG_DRAIN_MS = 10;
+/// Default output: binary frames (decode with host/logdecode) instead of text lines
+static const bool     EVENTLOG_BINARY_SERIAL = false;
+
+void     eventLogBegin();
+void     eventLogSetBinary(bool binary);
+void     eventLogWrite(LogEvent event, const uint32_t *args, uint8_t argc);
+void     eventLogDrain();
+uint32_t eventLogDropped();
+
+size_t   eventLogFormat(const uint8_t *record, size_t len, char *out, size_t maxLen);
+
+/**
+ * @brief Log @p event with up to EVENTLOG_MAX_ARGS integer arguments.
+ *
+ * Copies the arguments into the ring and returns; safe to call from the loop
+ * and from network callbacks. When the ring is full the record is dropped.
+ */
+template <typename... Args>
+inline void eventLog(LogEvent event, Args... args) {
+  static_assert(sizeof...(Args) <= EVENTLOG_MAX_ARGS, "too many log arguments");
+  const uint32_t values[] = {0, (uint32_t)args...};
+  eventLogWrite(event, values + 1, (uint8_t)sizeof...(Args));
+}
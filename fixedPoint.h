@@ -0,0 +1,85 @@
+#pragma once
+#include <stdint.h>
+#include <math.h>
+
+/**
+ * @file fixedPoint.h
+ * @brief Integer units and compile-time scale factors for the control engine.
+ *
+ * @details
+ * The ESP8266 has no FPU, so the controllers work in integers: time in
+ * milliseconds, temperature in tenths of a degree (deci-degrees) and humidity
+ * in tenths of a percent (per mille). The float values in SharedState are
+ * converted at the boundary, once per change, and every comparison made on the
+ * control path is then an integer one.
+ *
+ * The DHT driver delivers readings on a 0.1 grid (n / 10.0f), so a reading
+ * converts to its integer unit exactly. Float setpoints do not, so instead of
+ * rounding a setpoint the controllers derive the integer threshold at which
+ * the original float comparison flips (fixedAtOrBelow(), fixedAtOrAbove()).
+ * That keeps their decisions identical to comparing the floats.
+ */
+
+/// @name Scale factors
+///@{
+static constexpr int32_t DECI_PER_DEGREE = 10;    ///< Temperature unit: 0.1 °C
+static constexpr int32_t PERMILLE_PER_PCT = 10;   ///< Humidity unit: 0.1 %
+static constexpr uint32_t MS_PER_SECOND = 1000UL;
+static constexpr uint32_t MS_PER_HOUR = 3600UL * MS_PER_SECOND;
+static constexpr uint32_t DAY_MS = 24UL * MS_PER_HOUR;
+static constexpr float HOURS_PER_MS = 1.0f / MS_PER_HOUR;
+///@}
+
+/// Thresholds never reached by a reading (used for NAN setpoints). Readings
+/// saturate to int16, so thresholds are clamped to +/-40000.
+static constexpr int32_t FIXED_NEVER_BELOW = INT32_MIN;
+static constexpr int32_t FIXED_NEVER_ABOVE = INT32_MAX;
+
+/**
+ * @brief Convert a constant to fixed point at compile time, rounding half away from zero.
+ */
+constexpr int32_t fixedConst(double v, int32_t scale) {
+  return (int32_t)(v * scale + (v < 0 ? -0.5 : 0.5));
+}
+
+/**
+ * @brief Convert a reading on the 1/@p scale grid to its integer unit.
+ *
+ * @return The rounded value, saturated to the int16 range (NAN gives 0).
+ */
+inline int32_t fixedFromFloat(float v, int32_t scale) {
+  if (isnan(v)) return 0;
+  const float f = v * scale;
+  if (f <= -32768.0f) return -32768;
+  if (f >= 32767.0f) return 32767;
+  return (int32_t)lroundf(f);
+}
+
+/**
+ * @brief Largest n for which the reading n / @p scale satisfies reading <= @p limit.
+ *
+ * Starts from the rounded estimate and settles with the float comparison
+ * itself, so the result matches it even where the limit is not on the grid.
+ */
+inline int32_t fixedAtOrBelow(float limit, int32_t scale) {
+  if (isnan(limit)) return FIXED_NEVER_BELOW;
+  if (limit * scale >= 40000.0f) return 40000;
+  if (limit * scale <= -40000.0f) return -40000;
+  int32_t n = (int32_t)floorf(limit * scale);
+  while ((float)(n + 1) / scale <= limit) n++;
+  while (!((float)n / scale <= limit)) n--;
+  return n;
+}
+
+/**
+ * @brief Smallest n for which the reading n / @p scale satisfies reading >= @p limit.
+ */
+inline int32_t fixedAtOrAbove(float limit, int32_t scale) {
+  if (isnan(limit)) return FIXED_NEVER_ABOVE;
+  if (limit * scale >= 40000.0f) return 40000;
+  if (limit * scale <= -40000.0f) return -40000;
+  int32_t n = (int32_t)ceilf(limit * scale);
+  while ((float)(n - 1) / scale >= limit) n--;
+  while (!((float)n / scale >= limit)) n++;
+  return n;
+}
@@ -0,0 +1,422 @@
+/**
+ * @file hal.cpp
+ * @brief ESP8266 implementation of the hardware abstraction layer.
+ *
+ * @details Maps the hal*() functions straight onto the Arduino core. The host
+ * build replaces this file with host/halHost.cpp.
+ *
+ * LittleFS, AsyncTCP and the Wi-Fi stack allocate internally; the calls into
+ * them are marked with HeapGuardAllow (see heapGuard.h).
+ */
+#include "hal.h"
+#include "heapGuard.h"
+#include <Arduino.h>
+#include <LittleFS.h>
+#include <ESPAsyncTCP.h>
+#include <ESP8266WiFi.h>
+extern "C" {
+#include <user_interface.h>
+}
+
+/// Files that may be open at the same time
+static const uint8_t HAL_FS_FILES = 4;
+
+static File files[HAL_FS_FILES];
+
+/// TCP connections that may be open at the same time
+static const uint8_t HAL_TCP_SLOTS = 2;
+/// Received bytes buffered per connection until halTcpRead(); the rest is dropped
+static const uint16_t HAL_TCP_RX_BYTES = 256;
+
+/**
+ * @brief One AsyncClient and the state its callbacks report.
+ *
+ * The callbacks run from the SDK task while loop() yields, never in the middle
+ * of a hal call, so no locking is needed.
+ */
+struct TcpSlot {
+  AsyncClient *client;
+  uint8_t state;
+  uint8_t rx[HAL_TCP_RX_BYTES];
+  uint16_t rxLen;
+};
+
+static TcpSlot tcpSlots[HAL_TCP_SLOTS];
+
+uint32_t halMillis() {
+  return millis();
+}
+
+/**
+ * @brief Microsecond clock.
+ *
+ * Kept in IRAM because interrupt handlers timestamp edges with it.
+ */
+uint32_t IRAM_ATTR halMicros() {
+  return micros();
+}
+
+/**
+ * @brief CPU cycle counter (CCOUNT); wraps every 53 s at 80 MHz.
+ */
+uint32_t IRAM_ATTR halCycles() {
+  return ESP.getCycleCount();
+}
+
+/**
+ * @brief Rate of halCycles() in Hz.
+ */
+uint32_t halCpuHz() {
+  return (uint32_t)ESP.getCpuFreqMHz() * 1000000u;
+}
+
+/// Earlier times mean SNTP has not set the clock yet
+static const time_t HAL_EPOCH_VALID = 1600000000;
+
+/**
+ * @brief Wall-clock time in Unix seconds from SNTP (started by halWifiBegin()), 0 until synchronized.
+ */
+uint32_t halEpochSec() {
+  const time_t t = time(nullptr);
+  return t >= HAL_EPOCH_VALID ? (uint32_t)t : 0;
+}
+
+/**
+ * @brief Heap and stack margins from the Arduino core.
+ *
+ * The free stack is the untouched part of the continuation stack loop()
+ * runs on, so it is a low-water mark rather than the current depth.
+ */
+void halMemInfo(HalMemInfo &out) {
+  out.freeHeap = ESP.getFreeHeap();
+  out.maxBlock = ESP.getMaxFreeBlockSize();
+  out.fragmentPct = ESP.getHeapFragmentation();
+  out.freeStack = ESP.getFreeContStack();
+}
+
+/**
+ * @brief Give the CPU away for @p ms milliseconds.
+ *
+ * delay() suspends loop() and lets the SDK service WiFi and AsyncTCP; with no
+ * work pending the radio and CPU drop into the configured WiFi sleep mode.
+ */
+void halIdle(uint32_t ms) {
+  delay(ms);
+}
+
+void halPinMode(uint8_t pin, uint8_t mode) {
+  pinMode(pin, mode);
+}
+
+void halDigitalWrite(uint8_t pin, uint8_t level) {
+  digitalWrite(pin, level);
+}
+
+/**
+ * @brief Drive the pins in @p setMask HIGH and those in @p clearMask LOW (bit n = GPIOn, 0..16).
+ *
+ * GPIO0..15 change together in one write to the set and one to the clear
+ * register; GPIO16 sits in the RTC block and has a register of its own.
+ */
+void halGpioWrite(uint32_t setMask, uint32_t clearMask) {
+  GPOS = setMask & 0xFFFF;
+  GPOC = clearMask & 0xFFFF;
+  if (setMask & (1u << 16)) GP16O |= 1;
+  else if (clearMask & (1u << 16)) GP16O &= ~1;
+}
+
+int halAnalogRead(uint8_t pin) {
+  return analogRead(pin);
+}
+
+/**
+ * @brief Call @p isr on every falling edge of @p pin.
+ *
+ * @p isr must be placed in IRAM (IRAM_ATTR).
+ */
+void halAttachFallingInterrupt(uint8_t pin, HalIsr isr) {
+  attachInterrupt(digitalPinToInterrupt(pin), isr, FALLING);
+}
+
+void halDetachInterrupt(uint8_t pin) {
+  detachInterrupt(digitalPinToInterrupt(pin));
+}
+
+static os_timer_t periodicTimer;
+static HalTimerFn periodicFn = nullptr;
+
+static void periodicTick(void *) {
+  if (periodicFn) periodicFn();
+}
+
+/**
+ * @brief Call @p fn every @p periodMs from the SDK's software timer.
+ *
+ * The SDK timer rather than the timer1 interrupt: the callback may read the
+ * ADC, and analogRead() lives in flash, which is unmapped while the data log
+ * writes to LittleFS. The callback runs whenever loop() yields; a tick that
+ * falls due while loop() is busy runs late, and ticks missed entirely can be
+ * detected from halMicros().
+ */
+void halTimerBegin(uint32_t periodMs, HalTimerFn fn) {
+  os_timer_disarm(&periodicTimer);
+  periodicFn = fn;
+  os_timer_setfn(&periodicTimer, periodicTick, nullptr);
+  os_timer_arm(&periodicTimer, periodMs, true);
+}
+
+void halTimerStop() {
+  os_timer_disarm(&periodicTimer);
+  periodicFn = nullptr;
+}
+
+/**
+ * @brief Bytes Serial can take right now without blocking.
+ */
+size_t halSerialWritable() {
+  return Serial.availableForWrite();
+}
+
+size_t halSerialWrite(const uint8_t *buf, size_t len) {
+  return Serial.write(buf, len);
+}
+
+/**
+ * @brief Mount the flash filesystem, formatting it if it cannot be mounted.
+ */
+bool halFsBegin() {
+  if (LittleFS.begin()) return true;
+  return LittleFS.format() && LittleFS.begin();
+}
+
+/**
+ * @brief Open @p path for reading, or for appending (created if missing).
+ *
+ * @return Handle, or HAL_FILE_NONE if the file cannot be opened or all
+ * HAL_FS_FILES handles are in use.
+ */
+HalFile halFsOpen(const char *path, bool append) {
+  HeapGuardAllow allow;
+  for (uint8_t i = 0; i < HAL_FS_FILES; i++) {
+    if (files[i]) continue;
+    files[i] = LittleFS.open(path, append ? "a" : "r");
+    return files[i] ? (HalFile)i : HAL_FILE_NONE;
+  }
+  return HAL_FILE_NONE;
+}
+
+/**
+ * @brief Read up to @p len bytes at @p offset.
+ */
+size_t halFsRead(HalFile f, uint32_t offset, void *buf, size_t len) {
+  if (f < 0 || f >= HAL_FS_FILES || !files[f]) return 0;
+  if (!files[f].seek(offset)) return 0;
+  return files[f].read((uint8_t *)buf, len);
+}
+
+/**
+ * @brief Append @p len bytes. Data is committed to flash by halFsClose().
+ */
+size_t halFsWrite(HalFile f, const void *buf, size_t len) {
+  if (f < 0 || f >= HAL_FS_FILES || !files[f]) return 0;
+  HeapGuardAllow allow;
+  return files[f].write((const uint8_t *)buf, len);
+}
+
+uint32_t halFsSize(HalFile f) {
+  if (f < 0 || f >= HAL_FS_FILES || !files[f]) return 0;
+  return files[f].size();
+}
+
+void halFsClose(HalFile f) {
+  if (f < 0 || f >= HAL_FS_FILES) return;
+  HeapGuardAllow allow;
+  files[f].close();
+}
+
+bool halFsRemove(const char *path) {
+  HeapGuardAllow allow;
+  return LittleFS.remove(path);
+}
+
+/**
+ * @brief Call @p fn for every file in @p dir (names without the directory).
+ */
+void halFsList(const char *dir, HalFsListFn fn, void *ctx) {
+  HeapGuardAllow allow;
+  Dir d = LittleFS.openDir(dir);
+  while (d.next()) {
+    if (d.isFile()) fn(d.fileName().c_str(), d.fileSize(), ctx);
+  }
+}
+
+/**
+ * @brief Copy the start of RTC user memory into @p buf (@p len a multiple of 4).
+ */
+bool halRtcRead(void *buf, size_t len) {
+  return len <= HAL_RTC_BYTES && ESP.rtcUserMemoryRead(0, (uint32_t *)buf, len);
+}
+
+bool halRtcWrite(const void *buf, size_t len) {
+  return len <= HAL_RTC_BYTES && ESP.rtcUserMemoryWrite(0, (uint32_t *)buf, len);
+}
+
+/// True between halWifiBegin() and halWifiDisconnect()
+static bool wifiStarted = false;
+/// SNTP runs from the first halWifiBegin() on
+static bool sntpStarted = false;
+
+/**
+ * @brief Start associating with @p ssid; returns at once.
+ *
+ * With a @p hint from an earlier association the station goes straight to
+ * that access point and channel and configures the cached address, skipping
+ * the scan and DHCP. Nothing is written to flash. The first call also starts
+ * SNTP, which sets the clock behind halEpochSec().
+ */
+void halWifiBegin(const char *ssid, const char *password, const HalWifiLink *hint) {
+  HeapGuardAllow allow;
+  WiFi.persistent(false);
+  WiFi.setAutoReconnect(false);
+  WiFi.mode(WIFI_STA);
+  if (hint) {
+    WiFi.config(IPAddress(hint->ip), IPAddress(hint->gateway), IPAddress(hint->subnet), IPAddress(hint->dns));
+    WiFi.begin(ssid, password, hint->channel, hint->bssid, true);
+  } else {
+    WiFi.config(0u, 0u, 0u); // back to DHCP
+    WiFi.begin(ssid, password);
+  }
+  if (!sntpStarted) {
+    configTime(0, 0, "pool.ntp.org", "time.nist.gov"); // UTC; synchronizes once the link is up
+    sntpStarted = true;
+  }
+  wifiStarted = true;
+}
+
+uint8_t halWifiState() {
+  if (!wifiStarted) return HAL_WIFI_IDLE;
+  switch (WiFi.status()) {
+    case WL_CONNECTED:      return HAL_WIFI_CONNECTED;
+    case WL_NO_SSID_AVAIL:
+    case WL_CONNECT_FAILED:
+    case WL_WRONG_PASSWORD: return HAL_WIFI_FAILED;
+    default:                return HAL_WIFI_CONNECTING;
+  }
+}
+
+/**
+ * @brief Describe the current association (false unless connected).
+ */
+bool halWifiLinkInfo(HalWifiLink &out) {
+  if (WiFi.status() != WL_CONNECTED) return false;
+  memcpy(out.bssid, WiFi.BSSID(), sizeof(out.bssid));
+  out.channel = (uint8_t)WiFi.channel();
+  out.ip = (uint32_t)WiFi.localIP();
+  out.gateway = (uint32_t)WiFi.gatewayIP();
+  out.subnet = (uint32_t)WiFi.subnetMask();
+  out.dns = (uint32_t)WiFi.dnsIP();
+  return true;
+}
+
+void halWifiDisconnect() {
+  HeapGuardAllow allow;
+  WiFi.disconnect();
+  wifiStarted = false;
+}
+
+/**
+ * @brief Start connecting to @p host:@p port without blocking.
+ *
+ * The connection is an AsyncClient; its callbacks only record state and
+ * buffer received data, which halTcpState() and halTcpRead() hand out.
+ *
+ * @return Handle, or HAL_TCP_NONE if no slot is free or the connect could not start.
+ */
+HalTcp halTcpConnect(const char *host, uint16_t port) {
+  HeapGuardAllow allow;
+  for (uint8_t i = 0; i < HAL_TCP_SLOTS; i++) {
+    TcpSlot &slot = tcpSlots[i];
+    if (slot.client) continue;
+
+    slot.client = new AsyncClient();
+    if (!slot.client) return HAL_TCP_NONE;
+    slot.state = HAL_TCP_CONNECTING;
+    slot.rxLen = 0;
+
+    slot.client->onConnect([](void *arg, AsyncClient *) {
+      ((TcpSlot *)arg)->state = HAL_TCP_CONNECTED;
+    }, &slot);
+    slot.client->onDisconnect([](void *arg, AsyncClient *) {
+      TcpSlot *s = (TcpSlot *)arg;
+      if (s->state != HAL_TCP_FAILED) s->state = HAL_TCP_CLOSED;
+    }, &slot);
+    slot.client->onError([](void *arg, AsyncClient *, int8_t) {
+      ((TcpSlot *)arg)->state = HAL_TCP_FAILED;
+    }, &slot);
+    slot.client->onTimeout([](void *arg, AsyncClient *, uint32_t) {
+      ((TcpSlot *)arg)->state = HAL_TCP_FAILED;
+    }, &slot);
+    slot.client->onData([](void *arg, AsyncClient *, void *data, size_t len) {
+      TcpSlot *s = (TcpSlot *)arg;
+      const size_t room = HAL_TCP_RX_BYTES - s->rxLen;
+      if (len > room) len = room;
+      memcpy(s->rx + s->rxLen, data, len);
+      s->rxLen += len;
+    }, &slot);
+
+    if (!slot.client->connect(host, port)) {
+      delete slot.client;
+      slot.client = nullptr;
+      return HAL_TCP_NONE;
+    }
+    return (HalTcp)i;
+  }
+  return HAL_TCP_NONE;
+}
+
+uint8_t halTcpState(HalTcp c) {
+  if (c < 0 || c >= HAL_TCP_SLOTS || !tcpSlots[c].client) return HAL_TCP_FAILED;
+  return tcpSlots[c].state;
+}
+
+/**
+ * @brief Queue up to @p len bytes for sending.
+ *
+ * @return Bytes accepted; less than @p len when the TCP send window is full.
+ */
+size_t halTcpWrite(HalTcp c, const void *buf, size_t len) {
+  if (halTcpState(c) != HAL_TCP_CONNECTED) return 0;
+  AsyncClient *client = tcpSlots[c].client;
+  const size_t space = client->space();
+  if (len > space) len = space;
+  if (len == 0) return 0;
+  HeapGuardAllow allow;
+  len = client->add((const char *)buf, len);
+  client->send();
+  return len;
+}
+
+/**
+ * @brief Take up to @p len received bytes.
+ */
+size_t halTcpRead(HalTcp c, void *buf, size_t len) {
+  if (c < 0 || c >= HAL_TCP_SLOTS || !tcpSlots[c].client) return 0;
+  TcpSlot &slot = tcpSlots[c];
+  if (len > slot.rxLen) len = slot.rxLen;
+  memcpy(buf, slot.rx, len);
+  memmove(slot.rx, slot.rx + len, slot.rxLen - len);
+  slot.rxLen -= len;
+  return len;
+}
+
+void halTcpClose(HalTcp c) {
+  if (c < 0 || c >= HAL_TCP_SLOTS || !tcpSlots[c].client) return;
+  HeapGuardAllow allow;
+  AsyncClient *client = tcpSlots[c].client;
+  tcpSlots[c].client = nullptr;
+  client->onDisconnect(nullptr, nullptr);
+  client->onError(nullptr, nullptr);
+  client->onData(nullptr, nullptr);
+  client->close(true);
+  delete client;
+}
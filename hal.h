@@ -0,0 +1,123 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @file hal.h
+ * @brief Thin hardware abstraction layer (clock, cycle counter, wall clock, memory, GPIO, ADC, pin interrupts, periodic timer,
+ *        serial, flash files, RTC memory, Wi-Fi, TCP).
+ *
+ * The control modules only talk to the hardware through these functions.
+ * On the ESP8266 they are implemented in hal.cpp on top of the Arduino core;
+ * the host build (see host/) links host/halHost.cpp instead, which backs them
+ * with a simulated clock, simulated pins, a simulated DHT11 on the line and a
+ * simulated access point, and maps the flash filesystem onto a directory of
+ * ordinary files and TCP onto non-blocking host sockets.
+ */
+
+/// Pin-change interrupt handler (runs in interrupt context on the ESP8266)
+typedef void (*HalIsr)();
+
+uint32_t halMillis();
+uint32_t halMicros();
+void     halIdle(uint32_t ms);
+
+uint32_t halCycles();
+uint32_t halCpuHz();
+
+/// Wall-clock time (Unix seconds), 0 until it is known
+uint32_t halEpochSec();
+
+/**
+ * @brief Heap and stack margins, as reported by halMemInfo().
+ */
+struct HalMemInfo {
+  uint32_t freeHeap;     ///< Bytes free on the heap
+  uint32_t maxBlock;     ///< Largest single allocation that would succeed
+  uint8_t  fragmentPct;  ///< Heap fragmentation, 0 (one free block) .. 100
+  uint32_t freeStack;    ///< Bytes of loop() stack never used so far
+};
+
+void halMemInfo(HalMemInfo &out);
+
+void halPinMode(uint8_t pin, uint8_t mode);
+void halDigitalWrite(uint8_t pin, uint8_t level);
+void halGpioWrite(uint32_t setMask, uint32_t clearMask);
+int  halAnalogRead(uint8_t pin);
+
+void halAttachFallingInterrupt(uint8_t pin, HalIsr isr);
+void halDetachInterrupt(uint8_t pin);
+
+/// Periodic timer callback (runs outside loop(); must not block)
+typedef void (*HalTimerFn)();
+
+void halTimerBegin(uint32_t periodMs, HalTimerFn fn);
+void halTimerStop();
+
+size_t halSerialWritable();
+size_t halSerialWrite(const uint8_t *buf, size_t len);
+
+/// Handle of an open flash file (negative = none)
+typedef int8_t HalFile;
+static const HalFile HAL_FILE_NONE = -1;
+
+/// Called once per directory entry by halFsList()
+typedef void (*HalFsListFn)(const char *name, uint32_t size, void *ctx);
+
+bool     halFsBegin();
+HalFile  halFsOpen(const char *path, bool append);
+size_t   halFsRead(HalFile f, uint32_t offset, void *buf, size_t len);
+size_t   halFsWrite(HalFile f, const void *buf, size_t len);
+uint32_t halFsSize(HalFile f);
+void     halFsClose(HalFile f);
+bool     halFsRemove(const char *path);
+void     halFsList(const char *dir, HalFsListFn fn, void *ctx);
+
+/// Bytes of RTC user memory (kept across resets, lost on power-off)
+static const size_t HAL_RTC_BYTES = 512;
+
+bool halRtcRead(void *buf, size_t len);
+bool halRtcWrite(const void *buf, size_t len);
+
+/// Wi-Fi states reported by halWifiState()
+enum HalWifiState : uint8_t {
+  HAL_WIFI_IDLE,
+  HAL_WIFI_CONNECTING,
+  HAL_WIFI_CONNECTED,   ///< Associated and holding an IP address
+  HAL_WIFI_FAILED       ///< Access point not found or credentials refused
+};
+
+/**
+ * @brief Where an association ended up; passed back as a hint to skip the scan and DHCP.
+ */
+struct HalWifiLink {
+  uint8_t  bssid[6];
+  uint8_t  channel;
+  uint32_t ip;          ///< IPv4 addresses, first octet in the low byte
+  uint32_t gateway;
+  uint32_t subnet;
+  uint32_t dns;
+};
+
+void    halWifiBegin(const char *ssid, const char *password, const HalWifiLink *hint);
+uint8_t halWifiState();
+bool    halWifiLinkInfo(HalWifiLink &out);
+void    halWifiDisconnect();
+
+/// Handle of a TCP connection (negative = none)
+typedef int8_t HalTcp;
+static const HalTcp HAL_TCP_NONE = -1;
+
+/// Connection states reported by halTcpState()
+enum HalTcpState : uint8_t {
+  HAL_TCP_CONNECTING,
+  HAL_TCP_CONNECTED,
+  HAL_TCP_CLOSED,  ///< Closed by the peer; received data can still be read
+  HAL_TCP_FAILED
+};
+
+HalTcp  halTcpConnect(const char *host, uint16_t port);
+uint8_t halTcpState(HalTcp c);
+size_t  halTcpWrite(HalTcp c, const void *buf, size_t len);
+size_t  halTcpRead(HalTcp c, void *buf, size_t len);
+void    halTcpClose(HalTcp c);
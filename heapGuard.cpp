@@ -0,0 +1,99 @@
+/**
+ * @file heapGuard.cpp
+ * @brief Guarded-section bookkeeping and, with HEAP_GUARD, the allocator hooks.
+ *
+ * @details loop() and the network callbacks take turns on the ESP8266 and a
+ * task never yields, so guarded sections nest but never interleave and plain
+ * depth counters are enough. heapGuardNote() runs inside malloc(): it must
+ * not allocate itself, which eventLog() (a static ring) does not.
+ */
+#include "heapGuard.h"
+#include "eventLog.h"
+#include <stdlib.h>
+
+static bool armed = false;
+static uint8_t guardDepth = 0;
+static uint8_t allowDepth = 0;
+static int8_t guardTask = HEAP_GUARD_CALLBACK;
+static HeapGuardStats stats;
+
+/**
+ * @brief Start checking (call at the end of setup()).
+ */
+void heapGuardArm() {
+  stats = HeapGuardStats();
+  stats.lastTask = HEAP_GUARD_CALLBACK;
+  armed = true;
+  stats.armed = true;
+}
+
+/**
+ * @brief Enter a guarded section: task @p task, or HEAP_GUARD_CALLBACK.
+ */
+void heapGuardEnter(int8_t task) {
+  if (guardDepth++ == 0) guardTask = task;
+}
+
+/**
+ * @brief Leave the section entered last.
+ */
+void heapGuardLeave() {
+  if (guardDepth > 0) guardDepth--;
+}
+
+void heapGuardAllowBegin() {
+  allowDepth++;
+}
+
+void heapGuardAllowEnd() {
+  if (allowDepth > 0) allowDepth--;
+}
+
+/**
+ * @brief Account one allocation of @p size bytes made from @p caller.
+ */
+void heapGuardNote(size_t size, uintptr_t caller) {
+  if (!armed || guardDepth == 0) return;
+  if (allowDepth > 0) {
+    stats.allowed++;
+    return;
+  }
+  stats.unexpected++;
+  stats.lastTask = guardTask;
+  stats.lastSize = (uint32_t)size;
+  stats.lastCaller = caller;
+  eventLog(EV_HEAP_ALLOC, guardTask, (uint32_t)size, (uint32_t)caller);
+  if (HEAP_GUARD_TRAP) abort(); // the postmortem stack dump shows the culprit
+}
+
+/**
+ * @brief Copy the counters.
+ */
+void heapGuardStats(HeapGuardStats &out) {
+  out = stats;
+}
+
+#ifdef HEAP_GUARD
+// The linker sends every malloc/calloc/realloc here (-Wl,--wrap=...); operator
+// new and String both end up in malloc/realloc.
+extern "C" {
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t count, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+
+void *__wrap_malloc(size_t size) {
+  heapGuardNote(size, (uintptr_t)__builtin_return_address(0));
+  return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t count, size_t size) {
+  heapGuardNote(count * size, (uintptr_t)__builtin_return_address(0));
+  return __real_calloc(count, size);
+}
+
+void *__wrap_realloc(void *ptr, size_t size) {
+  heapGuardNote(size, (uintptr_t)__builtin_return_address(0));
+  return __real_realloc(ptr, size);
+}
+}
+#endif
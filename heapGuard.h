@@ -0,0 +1,77 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @file heapGuard.h
+ * @brief Debug check that the control loop and the network callbacks never allocate once setup() is done.
+ *
+ * @details Every task body (schedulerRun()), every WebSocket callback and
+ * every HTTP handler, including the callbacks that fill chunked responses,
+ * runs as a guarded section (heapGuardEnter() / heapGuardLeave(), or a
+ * HeapGuardCallback scope). Their buffers are static, fixed-capacity or on the
+ * stack, so after heapGuardArm() an allocation inside a guarded section is a
+ * bug, with deliberate exceptions marked by a HeapGuardAllow scope: the HAL
+ * calls into libraries that allocate internally (LittleFS, AsyncTCP, Wi-Fi),
+ * and the web server library's own objects: WebSocket messages, and the
+ * query parameter lookups, responses and header Strings of an HTTP request.
+ *
+ * The check itself needs the allocator hooks in heapGuard.cpp, which are only
+ * compiled with HEAP_GUARD defined and need the linker to route the C
+ * allocator through them:
+ *
+ *   -DHEAP_GUARD -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc
+ *
+ * In such a build each unexpected allocation is counted and logged as
+ * EV_HEAP_ALLOC with the task id (-1 for a callback), the size and the
+ * caller's address (look it up with addr2line). With HEAP_GUARD_TRAP it also
+ * abort()s, so the exception decoder shows the whole stack. Without
+ * HEAP_GUARD the sections are still tracked (two byte stores per task) but
+ * nothing is counted.
+ */
+
+/// Abort on the first unexpected allocation (HEAP_GUARD builds only)
+static const bool HEAP_GUARD_TRAP = true;
+
+/// heapGuardEnter() id of the network callbacks (WebSocket and HTTP)
+static const int8_t HEAP_GUARD_CALLBACK = -1;
+
+/**
+ * @brief Counters since heapGuardArm().
+ */
+struct HeapGuardStats {
+  bool     armed;
+  uint32_t unexpected;  ///< Allocations in guarded sections outside HeapGuardAllow
+  uint32_t allowed;     ///< Allocations inside HeapGuardAllow scopes
+  int8_t   lastTask;    ///< Section of the last unexpected allocation
+  uint32_t lastSize;    ///< Its size in bytes
+  uintptr_t lastCaller; ///< Its return address
+};
+
+void heapGuardArm();
+void heapGuardEnter(int8_t task);
+void heapGuardLeave();
+void heapGuardAllowBegin();
+void heapGuardAllowEnd();
+void heapGuardNote(size_t size, uintptr_t caller);
+void heapGuardStats(HeapGuardStats &out);
+
+/**
+ * @brief Guards a network callback for as long as it is in scope.
+ */
+struct HeapGuardCallback {
+  HeapGuardCallback() { heapGuardEnter(HEAP_GUARD_CALLBACK); }
+  ~HeapGuardCallback() { heapGuardLeave(); }
+  HeapGuardCallback(const HeapGuardCallback &) = delete;
+  HeapGuardCallback &operator=(const HeapGuardCallback &) = delete;
+};
+
+/**
+ * @brief Marks a library call that is known to allocate (see the file comment).
+ */
+struct HeapGuardAllow {
+  HeapGuardAllow() { heapGuardAllowBegin(); }
+  ~HeapGuardAllow() { heapGuardAllowEnd(); }
+  HeapGuardAllow(const HeapGuardAllow &) = delete;
+  HeapGuardAllow &operator=(const HeapGuardAllow &) = delete;
+};
@@ -4,43 +4,47 @@
  * @details The code states which pin is reserved for the heaping Lamp, and declares whether or not the LED is on
  * 
  * @section Heater_var Internal state varibles
- * - HEATER_LED_PIN: Hardware pin for LED/heater lamp
+ * - Each zone's heater LED/lamp pin comes from zonePins() (zones.h)
  */
 #include <Arduino.h>
 #include "heater.h"
-
-static const uint8_t HEATER_LED_PIN = D2;
+#include "hal.h"
+#include "zones.h"
+#include "actuators.h"
 
 /**
- * @brief Initialize the heater output pin.
+ * @brief Initialize the heater output pins.
  * 
  * @details
- * Configures the heater control/indicator pin as OUTPUT and ensures the heater
- * starts in a safe OFF state.
- *
- * - pinMode(HEATER_LED_PIN, OUTPUT)
- * - digitalWrite(HEATER_LED_PIN, LOW)
+ * Attaches the heater control/indicator pin of every zone to the actuator
+ * layer, which makes it an OUTPUT and starts the heaters in a safe OFF state.
  *
- * @note Call once in setup() before using heaterSet().
+ * @note Call once in setup(), after zonesBegin() and actuatorsBegin() and before using heaterSet().
  */
 
 void heaterBegin() {
-  pinMode(HEATER_LED_PIN, OUTPUT);
-  digitalWrite(HEATER_LED_PIN, LOW);
+  for (uint8_t z = 0; z < zoneCount(); z++) {
+    actuatorAttach(z, ACT_HEATER, zonePins(z).heater, false);
+  }
 }
 
 /**
  * @brief Turn the output ON or OFF
  * 
  * @details
- * Writes the heater pin (HEATER_LED_PIN) and updates the shared state so the rest
- * of the program knows the current heater status.
+ * Sets the zone's heater in the actuator shadow (the pin follows at the next
+ * actuatorsCommit()) and updates the shared state so the rest of the program
+ * knows the current heater status. A change of state bumps the state generation.
  * 
  * @param state SharedState to update
+ * @param zone Zone whose heater to switch
  * @param on True to turn the heater ON, false to turn it OFF
  */
 
-void heaterSet(SharedState &state, bool on) {
-  digitalWrite(HEATER_LED_PIN, on ? HIGH : LOW);
-  state.heaterOn = on;
+void heaterSet(SharedState &state, uint8_t zone, bool on) {
+  actuatorSet(zone, ACT_HEATER, on);
+  if (state.heaterOn[zone] != on) {
+    state.heaterOn[zone] = on;
+    stateChanged(state);
+  }
 }
@@ -2,4 +2,4 @@
 #include "sharedState.h"
 
 void heaterBegin();
-void heaterSet(SharedState &state, bool on);
+void heaterSet(SharedState &state, uint8_t zone, bool on);
@@ -0,0 +1,324 @@
+/**
+ * @file history.cpp
+ * @brief Fixed-memory multi-resolution history of the greenhouse state.
+ *
+ * @details
+ * Three ring buffers hold the same series at decreasing resolution:
+ *  - raw:     one value per second (HISTORY_RAW_LEN seconds),
+ *  - minute:  min/mean/max per minute (HISTORY_MINUTE_LEN minutes),
+ *  - quarter: min/mean/max per 15 minutes (HISTORY_QUARTER_LEN quarters).
+ *
+ * historyAppend() is called once per second; the aggregate tiers are filled as
+ * each minute and quarter closes, so there is no separate downsampling pass. All
+ * values are 16-bit fixed point (see HistorySeries), and all memory is static.
+ *
+ * Records are numbered with an absolute, ever-increasing record number per tier, so
+ * a reader streaming a range can tell when the writer has already overwritten part
+ * of it. Missing seconds (e.g. a late task) are recorded as HISTORY_INVALID, so the
+ * time of every record follows from its position.
+ */
+#include "history.h"
+#include "hal.h"
+#include <string.h>
+#include <math.h>
+
+struct TierState {
+  uint32_t total;    ///< Records ever written
+  uint32_t lastSec;  ///< Time of the newest record
+};
+
+struct Accum {
+  int16_t min;
+  int16_t max;
+  int32_t sum;
+  uint16_t n;
+};
+
+static const uint32_t STEP_SEC[HIST_TIERS] = {1, 60, 900};
+static const uint16_t TIER_LEN[HIST_TIERS] = {HISTORY_RAW_LEN, HISTORY_MINUTE_LEN, HISTORY_QUARTER_LEN};
+static const int16_t SERIES_SCALE[HIST_SERIES] = {10, 10, 1000, 1000, 1000, 100};
+static const char *const SERIES_NAMES[HIST_SERIES] = {"temp", "humidity", "lamp", "heater", "mister", "lightHours"};
+static const char *const TIER_NAMES[HIST_TIERS] = {"raw", "1m", "15m"};
+
+/// Internal state
+static int16_t rawRing[HISTORY_RAW_LEN][HIST_SERIES];
+static int16_t minuteRing[HISTORY_MINUTE_LEN][HIST_SERIES][3];
+static int16_t quarterRing[HISTORY_QUARTER_LEN][HIST_SERIES][3];
+static TierState tiers[HIST_TIERS];
+
+static Accum minuteAcc[HIST_SERIES];
+static Accum quarterAcc[HIST_SERIES];
+static uint32_t minuteBucket = 0;
+static uint32_t quarterBucket = 0;
+
+/// Seconds since boot, extended past the 49-day millis() wrap
+static uint32_t nowSec = 0;
+static uint32_t lastMs = 0;
+static uint32_t msAccum = 0;
+static bool started = false;
+
+static void resetAccum(Accum acc[HIST_SERIES]) {
+  for (uint8_t i = 0; i < HIST_SERIES; i++) {
+    acc[i].min = INT16_MAX;
+    acc[i].max = INT16_MIN;
+    acc[i].sum = 0;
+    acc[i].n = 0;
+  }
+}
+
+/**
+ * @brief Fold one value (or one aggregate's min/mean/max) into an accumulator.
+ */
+static void accumulate(Accum &acc, int16_t lo, int16_t mean, int16_t hi) {
+  if (mean == HISTORY_INVALID) return;
+  if (lo < acc.min) acc.min = lo;
+  if (hi > acc.max) acc.max = hi;
+  acc.sum += mean;
+  acc.n++;
+}
+
+static void finish(const Accum &acc, int16_t out[3]) {
+  if (acc.n == 0) {
+    out[0] = out[1] = out[2] = HISTORY_INVALID;
+    return;
+  }
+  out[0] = acc.min;
+  out[1] = (int16_t)lroundf((float)acc.sum / acc.n);
+  out[2] = acc.max;
+}
+
+/**
+ * @brief Claim the next slot of a tier for a record at time @p sec.
+ *
+ * @return Ring index of the slot.
+ */
+static uint16_t pushSlot(uint8_t tier, uint32_t sec) {
+  TierState &t = tiers[tier];
+  const uint16_t idx = (uint16_t)(t.total % TIER_LEN[tier]);
+  t.total++;
+  t.lastSec = sec;
+  return idx;
+}
+
+static void pushAggregate(uint8_t tier, uint32_t sec, const Accum acc[HIST_SERIES]) {
+  int16_t (*ring)[HIST_SERIES][3] = (tier == HIST_TIER_MINUTE) ? minuteRing : quarterRing;
+  const uint16_t idx = pushSlot(tier, sec);
+  for (uint8_t s = 0; s < HIST_SERIES; s++) {
+    if (acc) finish(acc[s], ring[idx][s]);
+    else ring[idx][s][0] = ring[idx][s][1] = ring[idx][s][2] = HISTORY_INVALID;
+  }
+}
+
+/**
+ * @brief Close quarter @p bucket and pad any quarters skipped before @p next.
+ */
+static void closeQuarter(uint32_t next) {
+  pushAggregate(HIST_TIER_QUARTER, quarterBucket * 900, quarterAcc);
+  resetAccum(quarterAcc);
+
+  uint32_t missing = next - quarterBucket - 1;
+  if (missing > HISTORY_QUARTER_LEN) missing = HISTORY_QUARTER_LEN;
+  for (uint32_t i = missing; i > 0; i--) pushAggregate(HIST_TIER_QUARTER, (next - i) * 900, nullptr);
+  quarterBucket = next;
+}
+
+/**
+ * @brief Close minute @p bucket, feed it to the quarter tier and pad skipped minutes.
+ */
+static void closeMinute(uint32_t next) {
+  const uint16_t idx = (uint16_t)(tiers[HIST_TIER_MINUTE].total % HISTORY_MINUTE_LEN);
+  pushAggregate(HIST_TIER_MINUTE, minuteBucket * 60, minuteAcc);
+  resetAccum(minuteAcc);
+
+  const uint32_t q = minuteBucket / 15;
+  if (q != quarterBucket) closeQuarter(q);
+  for (uint8_t s = 0; s < HIST_SERIES; s++) {
+    const int16_t *m = minuteRing[idx][s];
+    accumulate(quarterAcc[s], m[0], m[1], m[2]);
+  }
+
+  uint32_t missing = next - minuteBucket - 1;
+  if (missing > HISTORY_MINUTE_LEN) missing = HISTORY_MINUTE_LEN;
+  for (uint32_t i = missing; i > 0; i--) pushAggregate(HIST_TIER_MINUTE, (next - i) * 60, nullptr);
+  minuteBucket = next;
+}
+
+/**
+ * @brief Record the values for second @p sec in every tier.
+ */
+static void step(uint32_t sec, const int16_t v[HIST_SERIES]) {
+  const uint16_t idx = pushSlot(HIST_TIER_RAW, sec);
+  memcpy(rawRing[idx], v, sizeof(rawRing[idx]));
+
+  const uint32_t m = sec / 60;
+  if (m != minuteBucket) closeMinute(m);
+  for (uint8_t s = 0; s < HIST_SERIES; s++) accumulate(minuteAcc[s], v[s], v[s], v[s]);
+}
+
+static int16_t toFixed(float v, int16_t scale) {
+  if (isnan(v)) return HISTORY_INVALID;
+  return (int16_t)lroundf(v * scale);
+}
+
+/**
+ * @brief Clear all tiers.
+ *
+ * Call once in setup().
+ */
+void historyBegin() {
+  memset(tiers, 0, sizeof(tiers));
+  resetAccum(minuteAcc);
+  resetAccum(quarterAcc);
+  nowSec = 0;
+  msAccum = 0;
+  lastMs = halMillis();
+  started = false;
+}
+
+/**
+ * @brief Record the current state.
+ *
+ * Call once per second. Seconds that were missed since the previous call are
+ * recorded as HISTORY_INVALID; calls within the same second are ignored.
+ *
+ * @param state Shared state to sample.
+ */
+void historyAppend(const SharedState &state) {
+  const uint32_t now = halMillis();
+  msAccum += now - lastMs;
+  lastMs = now;
+  nowSec += msAccum / 1000;
+  msAccum %= 1000;
+
+  if (!started) {
+    started = true;
+    tiers[HIST_TIER_RAW].lastSec = nowSec - 1;
+    minuteBucket = nowSec / 60;
+    quarterBucket = nowSec / 900;
+  }
+  if (nowSec == tiers[HIST_TIER_RAW].lastSec) return;
+
+  // History is kept for zone 0 (RAM for the tiers does not scale to ZONE_MAX)
+  int16_t v[HIST_SERIES];
+  v[HIST_TEMP] = toFixed(state.tempC[0], SERIES_SCALE[HIST_TEMP]);
+  v[HIST_HUMIDITY] = toFixed(state.humidityPct[0], SERIES_SCALE[HIST_HUMIDITY]);
+  v[HIST_LAMP] = state.lampOn[0] ? 1000 : 0;
+  v[HIST_HEATER] = state.heaterOn[0] ? 1000 : 0;
+  v[HIST_MISTER] = state.misterOn[0] ? 1000 : 0;
+  v[HIST_LIGHT_HOURS] = toFixed(state.lightHoursToday[0], SERIES_SCALE[HIST_LIGHT_HOURS]);
+
+  int16_t gap[HIST_SERIES];
+  for (uint8_t s = 0; s < HIST_SERIES; s++) gap[s] = HISTORY_INVALID;
+
+  uint32_t sec = tiers[HIST_TIER_RAW].lastSec + 1;
+  if (nowSec - sec > HISTORY_RAW_LEN) sec = nowSec - HISTORY_RAW_LEN;
+  for (; sec != nowSec; sec++) step(sec, gap);
+  step(nowSec, v);
+}
+
+/**
+ * @brief Seconds since boot on the history time axis.
+ */
+uint32_t historyNowSec() {
+  return nowSec;
+}
+
+bool historyParseSeries(const char *name, uint8_t &series) {
+  for (uint8_t i = 0; i < HIST_SERIES; i++) {
+    if (strcmp(name, SERIES_NAMES[i]) == 0) {
+      series = i;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool historyParseTier(const char *name, uint8_t &tier) {
+  for (uint8_t i = 0; i < HIST_TIERS; i++) {
+    if (strcmp(name, TIER_NAMES[i]) == 0) {
+      tier = i;
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief Divisor that turns a stored value of @p series into its unit.
+ */
+int16_t historyScale(uint8_t series) {
+  return series < HIST_SERIES ? SERIES_SCALE[series] : 1;
+}
+
+/**
+ * @brief Resolve the records of one series/tier at or after @p fromSec.
+ *
+ * @return False if @p series or @p tier is out of range.
+ */
+bool historyQuery(uint8_t series, uint8_t tier, uint32_t fromSec, HistoryQuery &q) {
+  if (series >= HIST_SERIES || tier >= HIST_TIERS) return false;
+
+  const TierState &t = tiers[tier];
+  const uint32_t step = STEP_SEC[tier];
+  const uint32_t count = t.total < TIER_LEN[tier] ? t.total : TIER_LEN[tier];
+  const uint32_t oldestSec = t.lastSec - (count ? count - 1 : 0) * step;
+
+  uint32_t skip = 0;
+  if (count > 0 && fromSec > oldestSec) {
+    skip = (fromSec - oldestSec + step - 1) / step;
+    if (skip > count) skip = count;
+  }
+
+  q.series = series;
+  q.tier = tier;
+  q.firstRecord = t.total - count + skip;
+  q.count = (uint16_t)(count - skip);
+  q.startSec = oldestSec + skip * step;
+  q.stepSec = step;
+  q.valuesPerRecord = (tier == HIST_TIER_RAW) ? 1 : 3;
+  return true;
+}
+
+/**
+ * @brief Size in bytes of the packed response for @p q.
+ */
+size_t historyBytes(const HistoryQuery &q) {
+  return (size_t)q.count * q.valuesPerRecord * sizeof(int16_t);
+}
+
+/**
+ * @brief Copy part of the packed little-endian int16 array for @p q.
+ *
+ * @details Records overwritten since historyQuery() read as HISTORY_INVALID.
+ *
+ * @param q      Range from historyQuery().
+ * @param offset Byte offset into the packed array.
+ * @param out    Destination buffer.
+ * @param maxLen Capacity of @p out.
+ * @return Bytes copied (0 at the end).
+ */
+size_t historyCopy(const HistoryQuery &q, size_t offset, uint8_t *out, size_t maxLen) {
+  const size_t total = historyBytes(q);
+  const TierState &t = tiers[q.tier];
+  const uint16_t len = TIER_LEN[q.tier];
+  const uint32_t oldestKept = t.total > len ? t.total - len : 0;
+
+  size_t n = 0;
+  while (n < maxLen && offset < total) {
+    const size_t valueIdx = offset / 2;
+    const uint32_t rec = q.firstRecord + (uint32_t)(valueIdx / q.valuesPerRecord);
+    const uint8_t comp = (uint8_t)(valueIdx % q.valuesPerRecord);
+
+    int16_t value = HISTORY_INVALID;
+    if (rec >= oldestKept) {
+      const uint16_t idx = (uint16_t)(rec % len);
+      if (q.tier == HIST_TIER_RAW) value = rawRing[idx][q.series];
+      else if (q.tier == HIST_TIER_MINUTE) value = minuteRing[idx][q.series][comp];
+      else value = quarterRing[idx][q.series][comp];
+    }
+
+    out[n++] = (offset & 1) ? (uint8_t)((uint16_t)value >> 8) : (uint8_t)(value & 0xFF);
+    offset++;
+  }
+  return n;
+}
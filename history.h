@@ -0,0 +1,61 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include "sharedState.h"
+
+/**
+ * @file history.h
+ * @brief Fixed-memory multi-resolution history of the greenhouse state.
+ */
+
+/// Recorded series. Values are int16 fixed point, divide by historyScale().
+enum HistorySeries : uint8_t {
+  HIST_TEMP,        ///< Temperature, tenths of °C
+  HIST_HUMIDITY,    ///< Humidity, tenths of %
+  HIST_LAMP,        ///< Lamp on-fraction, per mille
+  HIST_HEATER,      ///< Heater on-fraction, per mille
+  HIST_MISTER,      ///< Mister on-fraction, per mille
+  HIST_LIGHT_HOURS, ///< Light hours today, hundredths of an hour
+  HIST_SERIES
+};
+
+/// Resolution tiers
+enum HistoryTier : uint8_t {
+  HIST_TIER_RAW,     ///< One value per second
+  HIST_TIER_MINUTE,  ///< min/mean/max per minute
+  HIST_TIER_QUARTER, ///< min/mean/max per 15 minutes
+  HIST_TIERS
+};
+
+/// Records kept per tier (4 min raw, 1 h of minutes, 24 h of quarters)
+static const uint16_t HISTORY_RAW_LEN = 240;
+static const uint16_t HISTORY_MINUTE_LEN = 60;
+static const uint16_t HISTORY_QUARTER_LEN = 96;
+
+/// Marker for "no valid value" (sensor missing, or a gap in sampling)
+static const int16_t HISTORY_INVALID = INT16_MIN;
+
+/**
+ * @brief A resolved range of records in one series and tier.
+ */
+struct HistoryQuery {
+  uint8_t series;
+  uint8_t tier;
+  uint32_t firstRecord;  ///< Absolute number of the first record
+  uint16_t count;        ///< Number of records
+  uint32_t startSec;     ///< Time of the first record (seconds since boot)
+  uint32_t stepSec;      ///< Time between records
+  uint8_t valuesPerRecord; ///< 1 for raw, 3 (min, mean, max) for aggregates
+};
+
+void historyBegin();
+void historyAppend(const SharedState &state);
+uint32_t historyNowSec();
+
+bool   historyParseSeries(const char *name, uint8_t &series);
+bool   historyParseTier(const char *name, uint8_t &tier);
+int16_t historyScale(uint8_t series);
+
+bool   historyQuery(uint8_t series, uint8_t tier, uint32_t fromSec, HistoryQuery &q);
+size_t historyBytes(const HistoryQuery &q);
+size_t historyCopy(const HistoryQuery &q, size_t offset, uint8_t *out, size_t maxLen);
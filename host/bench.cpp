@@ -0,0 +1,406 @@
+/**
+ * @file bench.cpp
+ * @brief Host microbenchmarks for the control loop hot path.
+ *
+ * @details Runs the firmware modules against the simulated HAL and reports,
+ * per benchmark, the mean time per call and the number of heap allocations
+ * (and bytes) per call. Allocations are counted by replacing the global
+ * operator new.
+ *
+ * Usage: bench [--iters N] [--filter SUBSTRING]
+ */
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#include "hal.h"
+#include "halHost.h"
+#include "sharedState.h"
+#include "climateControl.h"
+#include "Lightsensor.h"
+#include "heater.h"
+#include "mister.h"
+#include "actuators.h"
+#include "dht11Sensor.h"
+#include "telemetry.h"
+#include "scheduler.h"
+#include "history.h"
+#include "eventLog.h"
+#include "zones.h"
+#include "sensorFilter.h"
+#include "adcSampler.h"
+#include "wsCommand.h"
+#include "stateSync.h"
+#include "profiler.h"
+#include "seriesCodec.h"
+#include "dataLog.h"
+
+// ---------------------------------------------------------------- allocation counting
+
+static size_t allocCount = 0;
+static size_t allocBytes = 0;
+
+void *operator new(size_t size) {
+  allocCount++;
+  allocBytes += size;
+  void *p = malloc(size ? size : 1);
+  if (!p) throw std::bad_alloc();
+  return p;
+}
+
+void *operator new[](size_t size) {
+  return operator new(size);
+}
+
+void operator delete(void *p) noexcept { free(p); }
+void operator delete[](void *p) noexcept { free(p); }
+void operator delete(void *p, size_t) noexcept { free(p); }
+void operator delete[](void *p, size_t) noexcept { free(p); }
+
+// ---------------------------------------------------------------- fixtures
+
+static SharedState state;
+static volatile unsigned int sink = 0;
+static uint32_t tick = 0;
+
+/**
+ * @brief Reset the simulated board with @p count zones and bring all modules up.
+ */
+static void bootZones(uint8_t count) {
+  static const ZonePins PINS[ZONE_MAX] = {
+    ZONE_DEFAULT_PINS, {D6, D0, D3, D8, true}, {D4, D0, D3, D8, true}, {3, D0, D3, D8, true},
+  };
+  halHostReset();
+  state = SharedState();
+  tick = 0;
+  zonesBegin(state, PINS, count);
+
+  dht11Begin();
+  actuatorsBegin();
+  lightInit();
+  heaterBegin();
+  misterInit();
+  climateControlBegin();
+
+  for (uint8_t z = 0; z < count; z++) {
+    state.targetTempC[z] = 23.0f;
+    state.targetHumidityPct[z] = 55.0f;
+    state.hasDht[z] = true;
+    state.tempC[z] = 23.0f;
+    state.humidityPct[z] = 55.0f;
+  }
+  halHostSetDht(true, 55.0f, 23.0f);
+  halHostSetAnalog(A0, 400);
+}
+
+/**
+ * @brief Reset the simulated board and bring all modules up as setup() does.
+ */
+static void bootModules() {
+  bootZones(1);
+}
+
+/// The same with every zone in use (outputs are shared; only the control work matters)
+static void bootAllZones() {
+  bootZones(ZONE_MAX);
+}
+
+static void nopTask() {
+  sink++;
+}
+
+/**
+ * @brief Register a task set shaped like the sketch's (1 ms .. 60 s periods).
+ */
+static void bootScheduler() {
+  bootModules();
+  schedulerBegin();
+  schedulerAdd("dht", nopTask, 1, SCHED_PRIO_HIGH);
+  schedulerAdd("control", nopTask, 100, SCHED_PRIO_HIGH);
+  schedulerAdd("light", nopTask, 1000, SCHED_PRIO_HIGH);
+  schedulerAdd("ws", nopTask, 1000, SCHED_PRIO_NORMAL);
+  schedulerAdd("print", nopTask, 1000, SCHED_PRIO_LOW);
+  schedulerAdd("thingspeak", nopTask, 15000, SCHED_PRIO_LOW);
+  schedulerAdd("stats", nopTask, 60000, SCHED_PRIO_LOW);
+}
+
+static void runScheduler() {
+  schedulerRun(); // idling advances the simulated clock
+}
+
+static void runClimateSteady() {
+  halHostAdvanceMillis(1);
+  climateControlUpdate(state);
+}
+
+static void runClimateToggling() {
+  // Swing across both hysteresis bands so heater and mister switch regularly.
+  tick++;
+  const bool low = (tick & 0x3FF) < 0x200;
+  const float t = low ? 21.0f : 25.0f;
+  if (t != state.tempC[0]) {
+    // A new reading in every zone, written the way the DHT driver does
+    for (uint8_t z = 0; z < state.zoneCount; z++) {
+      state.tempC[z] = t;
+      state.humidityPct[z] = low ? 45.0f : 65.0f;
+    }
+    stateChanged(state);
+  }
+  halHostAdvanceMillis(50);
+  climateControlUpdate(state);
+}
+
+static void runLightSample() {
+  tick++;
+  halHostSetAnalog(A0, (tick & 0x40) ? 1500 : 400);
+  halHostAdvanceMillis(1000);
+  lightUpdate(state);
+}
+
+static void runDhtRead() {
+  halHostAdvanceMillis(1);
+  dht11Read(state);
+}
+
+static void runSensorReadings() {
+  static char text[TELEMETRY_JSON_MAX];
+  sink += getSensorReadings(state, text, sizeof(text));
+}
+
+static void runTelemetryDelta() {
+  // One changed field per frame, as in a typical broadcast.
+  tick++;
+  state.tempC[0] = 22.0f + (tick & 0x7) * 0.1f;
+  uint8_t frame[TELEMETRY_FRAME_MAX];
+  sink += telemetryEncodeDelta(state, frame);
+}
+
+static void runAdcTick() {
+  // One sampler tick (ADC reading into the running sum) per iteration, draining the averages
+  tick++;
+  halHostSetAnalog(A0, 400 + (tick & 0xF));
+  halHostAdvanceMillis(LDR_SAMPLE_MS);
+  uint16_t average;
+  while (adcSamplerRead(average)) sink += average;
+}
+
+static void runWsCommand() {
+  // A dashboard frame with three setpoints, parsed, applied and acknowledged
+  static const char FRAME[] = "#12;T:23.5;H:55;L1:6";
+  WsCommandBatch batch;
+  wsCommandParse((const uint8_t *)FRAME, sizeof(FRAME) - 1, batch);
+  wsCommandApply(batch, state);
+  char ack[WS_ACK_MAX];
+  sink += wsCommandAck(batch, ack, sizeof(ack));
+}
+
+static void runStateSync() {
+  // loop() publishes a changed state, a network callback reads the snapshot
+  static SharedState view;
+  stateChanged(state);
+  stateSyncPublish(state);
+  sink += stateSyncRead(view) + view.generation;
+}
+
+static void bootProfiler() {
+  bootModules();
+  profBegin();
+}
+
+static void runProfiledControl() {
+  // The control task as the sketch runs it: timing overhead on top of climateControlUpdate()
+  const uint32_t t = profStart();
+  climateControlUpdate(state);
+  profEnd(PROF_CONTROL, t);
+}
+
+static void runProfMetrics() {
+  // A whole /metrics page, in the chunk size AsyncWebServer asks for
+  static ProfCursor cursor;
+  static char chunk[1024];
+  profMetricsBegin(cursor);
+  while (size_t n = profMetricsRead(cursor, chunk, sizeof(chunk))) sink += n;
+}
+
+static SensorFilter filter;
+
+static void bootFilter() {
+  bootModules();
+  filterInit(filter, LDR_FILTER);
+}
+
+static void runFilterPush() {
+  // A noisy LDR-like signal with an occasional spike
+  tick = tick * 1664525u + 1013904223u;
+  const int16_t sample = (int16_t)(500 + (tick >> 28) - ((tick & 0xFFF) == 0 ? 400 : 0));
+  sink += (unsigned)filterPush(filter, sample);
+}
+
+static void bootHistory() {
+  bootModules();
+  historyBegin();
+}
+
+static void runHistoryAppend() {
+  // One call per simulated second, so every 60th/900th call closes an aggregate.
+  tick++;
+  state.tempC[0] = 22.0f + (tick & 0x7) * 0.1f;
+  halHostAdvanceMillis(1000);
+  historyAppend(state);
+}
+
+static void bootEventLog() {
+  bootModules();
+  eventLogBegin();
+  halHostSerialSink(nullptr);
+}
+
+static void runEventLog() {
+  // The per-second status record, as logged by the sketch.
+  // Empty the ring before it fills, so the write path is measured, not the drop path.
+  if ((++tick & 63) == 0) eventLogBegin();
+  eventLog(EV_STATUS, 231, 552, true, false, true, 125);
+}
+
+static void runEventLogDrain() {
+  // Log and print as text; the drain is what used to run inline.
+  eventLog(EV_STATUS, 231, 552, true, false, true, 125);
+  eventLogDrain();
+}
+
+static void runActuatorCommit() {
+  // Four zones: one heater flips per call, and the fail-safe re-sets the other outputs unchanged
+  tick++;
+  for (uint8_t z = 0; z < 4; z++) {
+    actuatorSet(z, ACT_HEATER, z == (tick & 3) ? (tick & 4) != 0 : false);
+    actuatorSet(z, ACT_MISTER, false);
+  }
+  sink += actuatorsCommit();
+}
+
+static uint8_t seriesBuf[1432]; // one TCP segment of /log?format=packed, less the block header
+static SeriesEncoder encoder;
+static SeriesDecoder decoder;
+
+/**
+ * @brief The next record of a slowly drifting signal, DATALOG_SAMPLE_MS apart.
+ */
+static void seriesRecord(uint32_t &time, int16_t *v) {
+  tick++;
+  time = tick * 10;
+  v[0] = (int16_t)(220 + ((tick >> 5) & 0xF));
+  v[1] = (int16_t)(550 + ((tick >> 4) & 0x1F));
+  v[2] = (int16_t)(tick / 36);
+  v[3] = 230;
+  v[4] = 55;
+  v[5] = (int16_t)((tick >> 6) & 0x3);
+}
+
+static void bootSeriesAppend() {
+  bootModules();
+  seriesEncoderBegin(encoder, seriesBuf, sizeof(seriesBuf), DATALOG_PACKED_COLUMNS);
+}
+
+static void runSeriesAppend() {
+  // One log record per call; a full block is finished and a new one started
+  uint32_t time;
+  int16_t v[DATALOG_PACKED_COLUMNS];
+  seriesRecord(time, v);
+  if (!seriesAppend(encoder, time, v)) {
+    sink += seriesFinish(encoder);
+    seriesEncoderBegin(encoder, seriesBuf, sizeof(seriesBuf), DATALOG_PACKED_COLUMNS);
+    seriesAppend(encoder, time, v);
+  }
+}
+
+static void bootSeriesNext() {
+  bootSeriesAppend();
+  uint32_t time;
+  int16_t v[DATALOG_PACKED_COLUMNS];
+  do seriesRecord(time, v);
+  while (seriesAppend(encoder, time, v));
+  seriesFinish(encoder);
+  seriesDecoderBegin(decoder, seriesBuf, sizeof(seriesBuf), DATALOG_PACKED_COLUMNS);
+}
+
+static void runSeriesNext() {
+  // One record per call, the block decoded again from the start at its end
+  uint32_t time;
+  int16_t v[DATALOG_PACKED_COLUMNS];
+  if (!seriesNext(decoder, time, v)) {
+    seriesDecoderBegin(decoder, seriesBuf, sizeof(seriesBuf), DATALOG_PACKED_COLUMNS);
+    seriesNext(decoder, time, v);
+  }
+  sink += time + (uint16_t)v[0];
+}
+
+// ---------------------------------------------------------------- runner
+
+struct Bench {
+  const char *name;
+  void (*boot)();
+  void (*run)();
+  uint32_t itersScale; ///< Divisor applied to --iters for expensive cases
+};
+
+static const Bench BENCHES[] = {
+  {"climateControlUpdate/steady",   bootModules,   runClimateSteady,   1},
+  {"climateControlUpdate/toggling", bootModules,   runClimateToggling, 1},
+  {"climateControlUpdate/4 zones",  bootAllZones,  runClimateToggling, 1},
+  {"lightUpdate",                   bootModules,   runLightSample,     1},
+  {"adcSampler tick",               bootModules,   runAdcTick,         1},
+  {"dht11Read",                     bootModules,   runDhtRead,         1},
+  {"filterPush",                    bootFilter,    runFilterPush,      1},
+  {"getSensorReadings",             bootModules,   runSensorReadings,  10},
+  {"wsCommand parse+apply+ack",     bootAllZones,  runWsCommand,       1},
+  {"stateSyncPublish+Read",         bootModules,   runStateSync,       1},
+  {"climateControlUpdate/profiled", bootProfiler,  runProfiledControl, 1},
+  {"profMetricsRead (whole page)",  bootProfiler,  runProfMetrics,     1000},
+  {"telemetryEncodeDelta",          bootModules,   runTelemetryDelta,  1},
+  {"schedulerRun",                  bootScheduler, runScheduler,       1},
+  {"historyAppend",                 bootHistory,   runHistoryAppend,   1},
+  {"eventLog",                      bootEventLog,  runEventLog,        1},
+  {"eventLog+eventLogDrain",        bootEventLog,  runEventLogDrain,   10},
+  {"actuatorSet x8 + commit",       bootAllZones,  runActuatorCommit,  1},
+  {"seriesAppend",                  bootSeriesAppend, runSeriesAppend, 1},
+  {"seriesNext",                    bootSeriesNext,   runSeriesNext,   1},
+};
+
+int main(int argc, char **argv) {
+  uint32_t iters = 2000000;
+  const char *filter = nullptr;
+
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--iters") && i + 1 < argc) {
+      iters = (uint32_t)strtoul(argv[++i], nullptr, 10);
+    } else if (!strcmp(argv[i], "--filter") && i + 1 < argc) {
+      filter = argv[++i];
+    } else {
+      fprintf(stderr, "usage: %s [--iters N] [--filter SUBSTRING]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  printf("%-32s %10s %10s %12s %12s\n", "benchmark", "iters", "ns/call", "allocs/call", "bytes/call");
+
+  for (const Bench &b : BENCHES) {
+    if (filter && !strstr(b.name, filter)) continue;
+
+    const uint32_t n = iters / b.itersScale ? iters / b.itersScale : 1;
+    b.boot();
+    for (uint32_t i = 0; i < n / 10 + 1; i++) b.run(); // warm-up
+
+    const size_t allocs0 = allocCount;
+    const size_t bytes0 = allocBytes;
+    const auto t0 = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < n; i++) b.run();
+    const auto t1 = std::chrono::steady_clock::now();
+
+    const double ns = std::chrono::duration<double, std::nano>(t1 - t0).count();
+    printf("%-32s %10u %10.1f %12.2f %12.1f\n", b.name, n, ns / n,
+           (double)(allocCount - allocs0) / n, (double)(allocBytes - bytes0) / n);
+  }
+  return 0;
+}
@@ -0,0 +1,168 @@
+/**
+ * @file bootsim.cpp
+ * @brief Boot the firmware tasks against the simulated access point and time the Wi-Fi bring-up.
+ *
+ * @details Each scenario boots the control tasks and the wifiLink task as
+ * setup() does, runs the scheduler on the simulated clock and reports when
+ * control first ran and when the network came up:
+ *
+ *  - cold boot: empty RTC memory, full connection (scan + DHCP);
+ *  - warm reboot: RTC cache from the previous boot, fast connection;
+ *  - link lost: the access point drops the station, fast reconnect;
+ *  - access point moved: stale cache, fast attempt falls back to a full one;
+ *  - access point down at boot: retries with backoff, control unaffected.
+ *
+ * Control must run within a few milliseconds of every boot, and the warm
+ * reboot and the reconnect must take under a second.
+ *
+ *   bootsim [--scan-ms MS] [--dhcp-ms MS] [--fast-ms MS]   exit status 1 if a check fails
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "hal.h"
+#include "halHost.h"
+#include "scheduler.h"
+#include "climateControl.h"
+#include "heater.h"
+#include "mister.h"
+#include "actuators.h"
+#include "Lightsensor.h"
+#include "dht11Sensor.h"
+#include "wifiLink.h"
+#include "dataflow.h"
+
+static SharedState state;
+/// The control task must have run by then after a boot
+static const uint32_t CONTROL_START_MAX_MS = 100;
+
+static int8_t dhtTask = -1, wifiTask = -1, controlTask = -1;
+static uint32_t firstControlMs = 0;
+static bool controlRan = false;
+static uint32_t scanMs = 2500, dhcpMs = 1500, fastMs = 300;
+static bool ok = true;
+
+static void dhtTaskRun() {
+  schedulerWake(dhtTask, dht11Read(state));
+}
+
+static void wifiTaskRun() {
+  schedulerWake(wifiTask, wifiLinkRun());
+}
+
+static void controlTaskRun() {
+  if (!controlRan) {
+    controlRan = true;
+    firstControlMs = halMillis();
+  }
+  const uint32_t nextMs = climateControlUpdate(state);
+  if (nextMs != CLIMATE_CONTROL_IDLE) schedulerWake(controlTask, nextMs);
+}
+
+/**
+ * @brief Reset the board (RTC memory survives) and bring everything up as setup() does.
+ */
+static void boot() {
+  halHostReset();
+  halHostSerialSink(nullptr);
+  state = SharedState();
+  controlRan = false;
+  halHostSetDht(true, 55.0f, 22.0f);
+
+  dht11Begin();
+  actuatorsBegin();
+  lightInit();
+  heaterBegin();
+  misterInit();
+  climateControlBegin();
+  const WifiConfig config = {"greenhouse", "secret"};
+  wifiLinkBegin(config);
+
+  schedulerBegin();
+  flowBegin();
+  dhtTask = schedulerAdd("dht", dhtTaskRun, 0, SCHED_PRIO_HIGH, 1);
+  schedulerAdd("light", []() { lightUpdate(state); }, LIGHT_SAMPLE_MS, SCHED_PRIO_HIGH);
+  controlTask = schedulerAdd("control", controlTaskRun, 0, SCHED_PRIO_HIGH, 1);
+  flowSubscribe(controlTask, FLOW_BIT(FLOW_READINGS) | FLOW_BIT(FLOW_TARGETS));
+  wifiTask = schedulerAdd("wifi", wifiTaskRun, 0, SCHED_PRIO_LOW, 1);
+}
+
+/**
+ * @brief Run the scheduler until Wi-Fi is up or @p limitMs passed.
+ *
+ * @return Time it took (limitMs if it never came up).
+ */
+static uint32_t runUntilUp(uint32_t limitMs) {
+  const uint32_t start = halMillis();
+  while (!wifiLinkUp() && (uint32_t)(halMillis() - start) < limitMs) schedulerRun();
+  return halMillis() - start;
+}
+
+static void check(bool cond, const char *what) {
+  if (cond) return;
+  printf("  CHECK FAILED: %s\n", what);
+  ok = false;
+}
+
+static void report(const char *name, uint32_t tookMs) {
+  WifiMetrics m;
+  wifiLinkMetrics(m);
+  printf("%-20s control at %4u ms, wifi up after %6u ms (attempts %u, fast hits %u, fast misses %u, reconnects %u)\n",
+         name, firstControlMs, tookMs, m.attempts, m.fastHits, m.fastMisses, m.reconnects);
+  check(controlRan && firstControlMs <= CONTROL_START_MAX_MS, "control starts at boot, before the network");
+}
+
+int main(int argc, char **argv) {
+  for (int i = 1; i + 1 < argc; i += 2) {
+    const uint32_t v = (uint32_t)atoi(argv[i + 1]);
+    if (!strcmp(argv[i], "--scan-ms")) scanMs = v;
+    else if (!strcmp(argv[i], "--dhcp-ms")) dhcpMs = v;
+    else if (!strcmp(argv[i], "--fast-ms")) fastMs = v;
+    else {
+      fprintf(stderr, "usage: %s [--scan-ms MS] [--dhcp-ms MS] [--fast-ms MS]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  // Cold boot: power-on, nothing cached
+  halHostRtcClear();
+  halHostSetWifi(true, scanMs, dhcpMs, fastMs);
+  boot();
+  report("cold boot", runUntilUp(120000));
+  check(wifiLinkUp(), "cold boot connects");
+
+  // Warm reboot: the RTC cache from the previous boot makes it fast
+  boot();
+  uint32_t took = runUntilUp(120000);
+  report("warm reboot", took);
+  check(took < 1000, "warm reboot connects in under a second");
+
+  // The access point drops the station; the running board reconnects fast
+  for (uint32_t t = halMillis(); halMillis() - t < 5000;) schedulerRun();
+  halHostWifiDrop();
+  schedulerRun();
+  while (wifiLinkUp()) schedulerRun();
+  took = runUntilUp(120000);
+  report("link lost", took);
+  check(took < 1000, "reconnect takes under a second");
+
+  // The access point moved to another channel: the cache is stale
+  halHostWifiChannel(11);
+  boot();
+  took = runUntilUp(120000);
+  report("access point moved", took);
+  check(wifiLinkUp(), "falls back to a full connection");
+
+  // The access point is down at boot: control runs while Wi-Fi retries
+  halHostRtcClear();
+  halHostSetWifi(false, scanMs, dhcpMs, fastMs);
+  boot();
+  took = runUntilUp(30000);
+  halHostSetWifi(true, scanMs, dhcpMs, fastMs);
+  took += runUntilUp(120000);
+  report("access point down", took);
+  check(wifiLinkUp(), "connects once the access point is back");
+
+  return ok ? 0 : 1;
+}
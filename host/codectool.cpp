@@ -0,0 +1,281 @@
+/**
+ * @file codectool.cpp
+ * @brief Measure the series codec (seriesCodec.cpp) on a data log trace, and unpack downloads.
+ *
+ * @details
+ *   codectool TRACE.csv [--block BYTES] [--min-ratio R]
+ *       Encode the records of a /log CSV export (or "logtool DIR dump") into
+ *       packed blocks of at most BYTES, as dataLogReadPacked() would, decode
+ *       them again and check that every value comes back exactly. Prints the
+ *       size against the CSV, the 16-byte flash records and plain 32-bit
+ *       floats (4 + 6 x 4 bytes per record), and the encode/decode speed.
+ *       Exit status 1 on a mismatch or a ratio over floats below R.
+ *
+ *   codectool --unpack FILE
+ *       Print a /log?format=packed download (or "logtool DIR pack") as the
+ *       CSV /log would have served.
+ *
+ * A realistic trace: plantsim --days 4 --datalog DIR, then logtool DIR dump.
+ */
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "dataLog.h"
+#include "seriesCodec.h"
+
+static const char *CSV_HEADER = "time,tempC,humidityPct,lightHours,targetTempC,targetHumidityPct,lamp,heater,mister\n";
+static const size_t FLOAT_RECORD_BYTES = 4 + DATALOG_PACKED_COLUMNS * 4;
+
+static void toValues(const DataLogRecord &r, int16_t *v) {
+  v[0] = r.tempDeci;
+  v[1] = r.humidityDeci;
+  v[2] = (int16_t)r.lightCentiHours;
+  v[3] = r.targetTempDeci;
+  v[4] = r.targetHumidityPct;
+  v[5] = r.status;
+}
+
+static void fromValues(uint32_t time, const int16_t *v, DataLogRecord &r) {
+  r.timeSec = time;
+  r.tempDeci = v[0];
+  r.humidityDeci = v[1];
+  r.lightCentiHours = (uint16_t)v[2];
+  r.targetTempDeci = v[3];
+  r.targetHumidityPct = (uint8_t)v[4];
+  r.status = (uint8_t)v[5];
+}
+
+static bool sameRecord(const DataLogRecord &a, const DataLogRecord &b) {
+  return a.timeSec == b.timeSec && a.tempDeci == b.tempDeci && a.humidityDeci == b.humidityDeci &&
+         a.lightCentiHours == b.lightCentiHours && a.targetTempDeci == b.targetTempDeci &&
+         a.targetHumidityPct == b.targetHumidityPct && a.status == b.status;
+}
+
+/**
+ * @brief Parse a fixed-point CSV field ("-12.5", or empty for invalid) into units of 10^-decimals.
+ */
+static int16_t parseFixed(const char *&p, uint8_t decimals) {
+  if (*p == ',' || *p == '\n' || *p == '\0') {
+    if (*p == ',') p++;
+    return INT16_MIN;
+  }
+  const bool neg = *p == '-';
+  if (neg) p++;
+  long v = strtol(p, (char **)&p, 10);
+  uint8_t frac = 0;
+  if (*p == '.') {
+    p++;
+    while (*p >= '0' && *p <= '9') {
+      if (frac < decimals) {
+        v = v * 10 + (*p - '0');
+        frac++;
+      }
+      p++;
+    }
+  }
+  for (; frac < decimals; frac++) v *= 10;
+  if (*p == ',') p++;
+  return (int16_t)(neg ? -v : v);
+}
+
+static bool parseLine(const char *line, DataLogRecord &r) {
+  const char *p = line;
+  char *end;
+  r.timeSec = (uint32_t)strtoul(p, &end, 10);
+  if (end == p || *end != ',') return false;
+  p = end + 1;
+  r.tempDeci = parseFixed(p, 1);
+  r.humidityDeci = parseFixed(p, 1);
+  r.lightCentiHours = (uint16_t)parseFixed(p, 2);
+  r.targetTempDeci = parseFixed(p, 1);
+  unsigned hum, lamp, heater, mister;
+  if (sscanf(p, "%u,%u,%u,%u", &hum, &lamp, &heater, &mister) != 4) return false;
+  r.targetHumidityPct = (uint8_t)hum;
+  r.status = (uint8_t)((lamp ? 0x01 : 0) | (heater ? 0x02 : 0) | (mister ? 0x04 : 0));
+  return true;
+}
+
+static bool readTrace(const char *path, std::vector<DataLogRecord> &records, size_t &csvBytes) {
+  FILE *f = fopen(path, "r");
+  if (!f) {
+    perror(path);
+    return false;
+  }
+  char line[256];
+  csvBytes = 0;
+  while (fgets(line, sizeof(line), f)) {
+    csvBytes += strlen(line);
+    DataLogRecord r;
+    if (parseLine(line, r)) records.push_back(r);
+  }
+  fclose(f);
+  return true;
+}
+
+/**
+ * @brief Encode @p records into blocks of at most @p blockBytes (header included), appended to @p out.
+ */
+static void encodeAll(const std::vector<DataLogRecord> &records, size_t blockBytes, std::vector<uint8_t> &out) {
+  out.clear();
+  std::vector<uint8_t> block(blockBytes);
+  size_t i = 0;
+  while (i < records.size()) {
+    SeriesEncoder e;
+    seriesEncoderBegin(e, block.data() + DATALOG_PACKED_HEADER, blockBytes - DATALOG_PACKED_HEADER,
+                       DATALOG_PACKED_COLUMNS);
+    int16_t v[DATALOG_PACKED_COLUMNS];
+    for (; i < records.size() && e.count < UINT16_MAX; i++) {
+      toValues(records[i], v);
+      if (!seriesAppend(e, records[i].timeSec, v)) break;
+    }
+    const size_t bytes = seriesFinish(e);
+    block[0] = (uint8_t)e.count;
+    block[1] = (uint8_t)(e.count >> 8);
+    block[2] = (uint8_t)bytes;
+    block[3] = (uint8_t)(bytes >> 8);
+    out.insert(out.end(), block.begin(), block.begin() + DATALOG_PACKED_HEADER + bytes);
+    if (e.count == 0) break; // a record that fits no block
+  }
+}
+
+/**
+ * @brief Decode a sequence of packed blocks, calling @p fn for each record.
+ *
+ * @return false if a block is cut short or holds fewer records than its header says.
+ */
+template <typename Fn>
+static bool decodeAll(const uint8_t *p, size_t len, Fn fn) {
+  size_t pos = 0;
+  while (pos + DATALOG_PACKED_HEADER <= len) {
+    const uint16_t count = (uint16_t)(p[pos] | p[pos + 1] << 8);
+    const uint16_t bytes = (uint16_t)(p[pos + 2] | p[pos + 3] << 8);
+    pos += DATALOG_PACKED_HEADER;
+    if (pos + bytes > len) return false;
+    SeriesDecoder d;
+    seriesDecoderBegin(d, p + pos, bytes, DATALOG_PACKED_COLUMNS);
+    uint32_t time;
+    int16_t v[DATALOG_PACKED_COLUMNS];
+    while (seriesNext(d, time, v)) fn(time, v);
+    if (d.count != count || d.r.overrun) return false;
+    pos += bytes;
+  }
+  return pos == len;
+}
+
+static double secondsSince(std::chrono::steady_clock::time_point t0) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+static int measure(const char *path, size_t blockBytes, double minRatio) {
+  std::vector<DataLogRecord> records;
+  size_t csvBytes;
+  if (!readTrace(path, records, csvBytes)) return 2;
+  if (records.empty()) {
+    fprintf(stderr, "%s: no records\n", path);
+    return 2;
+  }
+
+  std::vector<uint8_t> packed;
+  encodeAll(records, blockBytes, packed);
+
+  size_t n = 0;
+  bool ok = true;
+  const bool complete = decodeAll(packed.data(), packed.size(), [&](uint32_t time, const int16_t *v) {
+    DataLogRecord r;
+    fromValues(time, v, r);
+    if (n >= records.size() || !sameRecord(r, records[n])) {
+      if (ok) fprintf(stderr, "mismatch at record %zu (time %u)\n", n, time);
+      ok = false;
+    }
+    n++;
+  });
+  if (!complete || n != records.size()) {
+    fprintf(stderr, "decoded %zu of %zu records%s\n", n, records.size(), complete ? "" : ", stream damaged");
+    ok = false;
+  }
+
+  // Throughput: repeat each direction for at least a quarter of a second
+  unsigned rounds = 0;
+  auto t0 = std::chrono::steady_clock::now();
+  std::vector<uint8_t> scratch;
+  do {
+    encodeAll(records, blockBytes, scratch);
+    rounds++;
+  } while (secondsSince(t0) < 0.25);
+  const double encodeRate = rounds * records.size() / secondsSince(t0);
+
+  rounds = 0;
+  volatile uint32_t sink = 0;
+  t0 = std::chrono::steady_clock::now();
+  do {
+    decodeAll(packed.data(), packed.size(), [&](uint32_t time, const int16_t *v) { sink = sink + time + v[0]; });
+    rounds++;
+  } while (secondsSince(t0) < 0.25);
+  const double decodeRate = rounds * records.size() / secondsSince(t0);
+
+  const size_t raw = records.size() * DATALOG_RECORD_BYTES;
+  const size_t floats = records.size() * FLOAT_RECORD_BYTES;
+  const double ratio = (double)floats / packed.size();
+  printf("records  %zu, %.2f days, blocks of %zu bytes\n", records.size(),
+         (records.back().timeSec - records.front().timeSec) / 86400.0, blockBytes);
+  printf("packed   %zu bytes, %.2f bits/record\n", packed.size(), packed.size() * 8.0 / records.size());
+  printf("vs csv    %9zu bytes  %6.1fx\n", csvBytes, (double)csvBytes / packed.size());
+  printf("vs flash  %9zu bytes  %6.1fx\n", raw, (double)raw / packed.size());
+  printf("vs float  %9zu bytes  %6.1fx\n", floats, ratio);
+  printf("encode   %.1f M records/s (%.0f MB/s of flash records)\n", encodeRate / 1e6, encodeRate * DATALOG_RECORD_BYTES / 1e6);
+  printf("decode   %.1f M records/s (%.0f MB/s of flash records)\n", decodeRate / 1e6, decodeRate * DATALOG_RECORD_BYTES / 1e6);
+  printf("roundtrip %s\n", ok ? "exact" : "FAILED");
+
+  if (minRatio > 0 && ratio < minRatio) {
+    printf("GATE FAIL: ratio %.1f < %.1f\n", ratio, minRatio);
+    ok = false;
+  }
+  return ok ? 0 : 1;
+}
+
+static int unpack(const char *path) {
+  FILE *f = fopen(path, "rb");
+  if (!f) {
+    perror(path);
+    return 2;
+  }
+  std::vector<uint8_t> data;
+  uint8_t buf[4096];
+  size_t n;
+  while ((n = fread(buf, 1, sizeof(buf), f)) > 0) data.insert(data.end(), buf, buf + n);
+  fclose(f);
+
+  fputs(CSV_HEADER, stdout);
+  const bool ok = decodeAll(data.data(), data.size(), [](uint32_t time, const int16_t *v) {
+    DataLogRecord r;
+    fromValues(time, v, r);
+    char line[96];
+    dataLogFormatCsv(r, line, sizeof(line));
+    fputs(line, stdout);
+  });
+  if (!ok) fprintf(stderr, "%s: damaged or truncated stream\n", path);
+  return ok ? 0 : 1;
+}
+
+int main(int argc, char **argv) {
+  if (argc == 3 && !strcmp(argv[1], "--unpack")) return unpack(argv[2]);
+
+  const char *trace = nullptr;
+  size_t blockBytes = 1436;
+  double minRatio = 0;
+  bool usage = false;
+  for (int i = 1; i < argc && !usage; i++) {
+    if (!strcmp(argv[i], "--block") && i + 1 < argc) blockBytes = strtoul(argv[++i], nullptr, 10);
+    else if (!strcmp(argv[i], "--min-ratio") && i + 1 < argc) minRatio = atof(argv[++i]);
+    else if (!trace && argv[i][0] != '-') trace = argv[i];
+    else usage = true;
+  }
+  if (usage || !trace || blockBytes < 64 || blockBytes > UINT16_MAX) {
+    fprintf(stderr, "usage: %s TRACE.csv [--block BYTES (64..65535)] [--min-ratio R] | --unpack FILE\n", argv[0]);
+    return 2;
+  }
+  return measure(trace, blockBytes, minRatio);
+}
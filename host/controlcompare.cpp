@@ -0,0 +1,293 @@
+/**
+ * @file controlcompare.cpp
+ * @brief Check the integer control engine against the float logic it replaced.
+ *
+ * @details Runs climateControlUpdate() and lightUpdate() on the simulated HAL
+ * and compares every on/off decision with a copy of the previous float code:
+ *
+ *  - heater and mister: every reading on the DHT's 0.1 grid against setpoints
+ *    swept in 0.01 steps plus NAN, infinities and far out-of-range values;
+ *    decisions must be identical.
+ *  - lamp: several simulated days of 1 s samples with jitter, clouds and
+ *    changing targets (the reference sees the LDR through a shadow of the sampler and the same filter). The float schedule is evaluated on the same light total;
+ *    the integer decision must equal the exact (integer arithmetic) one, and any
+ *    disagreement with the float one must be a case where float rounding itself
+ *    got the exact answer wrong.
+ *
+ * It also runs the old module (float accumulator, its own lamp decisions) beside
+ * the new one and prints how far its hoursToday drifted by the end of each day.
+ *
+ *   controlcompare [DAYS]     exit status 1 on any mismatch
+ */
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+#include "hal.h"
+#include "halHost.h"
+#include "climateControl.h"
+#include "heater.h"
+#include "mister.h"
+#include "actuators.h"
+#include "Lightsensor.h"
+
+/// Longer than the mister's minimum off time, shorter than its maximum on time
+static const uint32_t MIST_SETTLE_MS = 15000;
+
+// --- The float logic as it was before the integer engine -------------------
+
+static bool refHeater(bool on, float t, float target) {
+  const float TEMP_HYST = 0.5;
+  if (!on && t <= (target - TEMP_HYST)) return true;
+  if (on && t >= (target + TEMP_HYST)) return false;
+  return on;
+}
+
+static bool refMister(bool on, float h, float target) {
+  const float HUM_HYST = 3.0;
+  if (!on && h <= (target - HUM_HYST)) return true;
+  if (on && h >= (target + HUM_HYST)) return false;
+  return on;
+}
+
+static float refClamp(float x, float lo, float hi) {
+  if (x < lo) return lo;
+  if (x > hi) return hi;
+  return x;
+}
+
+/// Behind-schedule test of the old lightUpdate()
+static bool refLampFloat(float hoursToday, float target, uint32_t elapsedMs) {
+  const uint32_t dayLenMs = 24UL * 60UL * 60UL * 1000UL;
+  const float targetHrs = refClamp(target, 0.0, 24.0);
+  const float elapsedHrs = elapsedMs / 3600000.0;
+  const float dayLenHrs = dayLenMs / 3600000.0;
+  if (!(targetHrs > 0.0f && hoursToday < targetHrs)) return false;
+  float expectedSoFar = targetHrs * (elapsedHrs / dayLenHrs);
+  return hoursToday + 0.001f < expectedSoFar;
+}
+
+/// The same test in exact arithmetic (for targets that are whole milliseconds)
+static bool refLampExact(uint32_t lightMs, float target, uint32_t elapsedMs) {
+  const unsigned __int128 targetMs = (unsigned __int128)(refClamp(target, 0.0, 24.0) * 3600000.0);
+  if (!(targetMs > 0 && lightMs < targetMs)) return false;
+  // lightMs/h + 0.001 < target * elapsed/day, multiplied out by h * day
+  return (unsigned __int128)(lightMs + 3600u) * 86400000u < targetMs * elapsedMs;
+}
+
+// --- Climate -----------------------------------------------------------------
+
+static SharedState state;
+
+/**
+ * @brief Switch the mister to @p on through the controller, so its timers start
+ * at the switch as they do in the firmware (only the controller writes misterOn).
+ */
+static void seedMister(bool on) {
+  const float h = state.humidityPct[0];
+  const float target = state.targetHumidityPct[0];
+  state.targetHumidityPct[0] = 50.0f;
+  for (int step = 0; step <= (on ? 1 : 0); step++) {
+    state.humidityPct[0] = step ? 0.0f : 100.0f; // off first, then on past the minimum off time
+    halHostAdvanceMillis(MIST_SETTLE_MS);
+    stateChanged(state);
+    climateControlUpdate(state);
+  }
+  state.humidityPct[0] = h;
+  state.targetHumidityPct[0] = target;
+}
+
+static void runClimate(bool heaterOn, bool misterOn) {
+  climateControlBegin();
+  state.hasDht[0] = true;
+  seedMister(misterOn);
+  halHostAdvanceMillis(MIST_SETTLE_MS);
+  state.heaterOn[0] = heaterOn; // the heater has no timers
+  stateChanged(state);
+  climateControlUpdate(state);
+}
+
+static void targetSweep(float lo, float hi, float step, void (*fn)(float)) {
+  const float specials[] = {NAN, INFINITY, -INFINITY, 1e6f, -1e6f, 0.0f, -0.0f, 0.05f, 16.3f, 32.15f, 63.35f};
+  for (float s : specials) fn(s);
+  const long n = lroundf((hi - lo) / step);
+  for (long i = 0; i <= n; i++) fn(lo + i * step);
+}
+
+static uint64_t heaterCases = 0, heaterMismatches = 0;
+
+static void checkHeaterTarget(float target) {
+  state.targetTempC[0] = target;
+  state.humidityPct[0] = state.targetHumidityPct[0] = 60.0f;
+  for (int tDeci = -400; tDeci <= 800; tDeci++) {
+    const float t = tDeci / 10.0f; // as dht11Read() builds it
+    state.tempC[0] = t;
+    for (int on = 0; on < 2; on++) {
+      runClimate(on, false);
+      heaterCases++;
+      if (state.heaterOn[0] != refHeater(on, t, target)) {
+        if (heaterMismatches++ < 10) printf("heater mismatch: t=%.1f target=%.9g was %d -> %d\n", t, target, on, state.heaterOn[0]);
+      }
+    }
+  }
+}
+
+static uint64_t misterCases = 0, misterMismatches = 0;
+
+static void checkMisterTarget(float target) {
+  state.targetHumidityPct[0] = target;
+  state.tempC[0] = state.targetTempC[0] = 23.0f;
+  for (int hDeci = 0; hDeci <= 1000; hDeci++) {
+    const float h = hDeci / 10.0f;
+    state.humidityPct[0] = h;
+    for (int on = 0; on < 2; on++) {
+      runClimate(false, on);
+      misterCases++;
+      if (state.misterOn[0] != refMister(on, h, target)) {
+        if (misterMismatches++ < 10) printf("mister mismatch: h=%.1f target=%.9g was %d -> %d\n", h, target, on, state.misterOn[0]);
+      }
+    }
+  }
+}
+
+// --- Light -------------------------------------------------------------------
+
+static uint32_t rng = 12345;
+
+static uint32_t nextRandom() {
+  rng = rng * 1664525u + 1013904223u;
+  return rng >> 8;
+}
+
+struct LightStats {
+  uint64_t samples = 0;
+  uint64_t floatTies = 0;    ///< Float decision wrong by rounding, integer exact
+  uint64_t mismatches = 0;   ///< Integer decision differs from the exact one
+  uint64_t oldDiffers = 0;   ///< Old module (own loop, drifting accumulator) decided differently
+};
+
+static void runLight(int days, LightStats &st) {
+  static const float TARGETS[] = {6.0f, 12.5f, 18.25f, 0.0f, 24.0f, 4.0f, 9.75f};
+  const uint8_t LDR_PIN = A0;
+
+  halHostReset();
+  state = SharedState();
+  actuatorsBegin();
+  lightInit();
+
+  // Shadow of the day bookkeeping, with the exact light total
+  uint32_t start = halMillis(), last = start, dayStart = start, lightMs = 0;
+  // The old module, run in its own loop: the same bookkeeping with the float accumulator
+  float oldHours = 0.0f;
+  uint32_t oldLightMs = 0;
+
+  // The light module sees the LDR through the sampler's averages and its filter;
+  // so does the reference, from a shadow of the sampler (a reading every
+  // LDR_SAMPLE_MS of the level on the pin, one average per LDR_OVERSAMPLE readings).
+  SensorFilter ldr;
+  filterInit(ldr, LDR_FILTER);
+  uint32_t ldrSum = 0;
+  uint16_t ldrSummed = 0;
+  int held = 0;
+  int16_t level = 0;
+  bool levelValid = false;
+
+  uint32_t cloudUntil = 0;
+  uint8_t target = 0;
+  state.targetLightHoursToday[0] = TARGETS[0];
+  stateChanged(state);
+
+  const uint64_t total = (uint64_t)days * 86400u;
+  for (uint64_t i = 0; i < total; i++) {
+    const uint32_t before = halMillis();
+    halHostAdvanceMillis(1000 + nextRandom() % 30 - 10);
+    const uint32_t now = halMillis();
+    for (uint32_t tick = before / LDR_SAMPLE_MS; tick < now / LDR_SAMPLE_MS; tick++) {
+      ldrSum += held;
+      if (++ldrSummed < LDR_OVERSAMPLE) continue;
+      level = filterPush(ldr, (int16_t)((ldrSum + LDR_OVERSAMPLE / 2) / LDR_OVERSAMPLE));
+      levelValid = true;
+      ldrSum = 0;
+      ldrSummed = 0;
+    }
+
+    // Daylight from 07:00 to 17:00 of the simulated clock, with passing clouds
+    const uint32_t hourOfDay = (now / 3600000u) % 24;
+    if (now > cloudUntil && nextRandom() % 600 == 0) cloudUntil = now + 60000 + nextRandom() % 1200000;
+    const int raw = hourOfDay >= 7 && hourOfDay < 17 && now > cloudUntil ? 2000 : 300;
+    halHostSetAnalog(LDR_PIN, raw);
+    held = raw;
+    if (!levelValid) {
+      level = filterPush(ldr, (int16_t)raw); // no average yet: the module reads the pin once
+      levelValid = true;
+    }
+    const bool bright = level >= 1000;
+
+    if (i % (8 * 3600) == 0 && i) {
+      target = (uint8_t)((target + 1) % (sizeof(TARGETS) / sizeof(TARGETS[0])));
+      state.targetLightHoursToday[0] = TARGETS[target];
+      stateChanged(state);
+    }
+
+    if (now - dayStart >= 86400000u) {
+      printf("day ending at %5.1f h: integer %.6f h (exact); old float accumulator %.6f h for %.6f h (drift %+.2f s)\n",
+             now / 3600000.0, state.lightHoursToday[0], oldHours, oldLightMs / 3600000.0,
+             (oldHours - oldLightMs / 3600000.0) * 3600.0);
+      dayStart = now;
+      lightMs = 0;
+      oldHours = 0.0f;
+      oldLightMs = 0;
+    }
+    const uint32_t elapsedSample = now - last;
+    last = now;
+    const uint32_t elapsed = now - dayStart;
+    const float tgt = state.targetLightHoursToday[0];
+
+    const bool exact = refLampExact(lightMs, tgt, elapsed) && !bright;
+    const bool viaFloat = refLampFloat((float)(lightMs / 3600000.0), tgt, elapsed) && !bright;
+    const bool old = refLampFloat(oldHours, tgt, elapsed) && !bright;
+
+    lightUpdate(state);
+    st.samples++;
+    if (state.lampOn[0] != exact) {
+      if (st.mismatches++ < 10) printf("lamp mismatch at %u ms: light %u ms, elapsed %u ms, target %g\n", now, lightMs, elapsed, tgt);
+    } else if (viaFloat != exact) {
+      st.floatTies++;
+    }
+    if (old != state.lampOn[0]) st.oldDiffers++;
+
+    if ((bright || state.lampOn[0]) && elapsedSample > 0) {
+      lightMs += elapsedSample;
+      if (lightMs > 86400000u) lightMs = 86400000u;
+    }
+    if ((bright || old) && elapsedSample > 0) {
+      oldLightMs += elapsedSample;
+      oldHours += (elapsedSample / 1000.0f) / 3600.0f;
+      oldHours = refClamp(oldHours, 0.0f, 24.0f);
+    }
+    if (std::fabs(state.lightHoursToday[0] - (float)(lightMs / 3600000.0)) > 4e-6f) {
+      if (st.mismatches++ < 10) printf("lightHoursToday %.7f, expected %.7f\n", state.lightHoursToday[0], lightMs / 3600000.0);
+    }
+  }
+}
+
+int main(int argc, char **argv) {
+  const int days = argc > 1 ? atoi(argv[1]) : 3;
+
+  halHostReset();
+  actuatorsBegin();
+  heaterBegin();
+  misterInit();
+  targetSweep(-10.0f, 50.0f, 0.01f, checkHeaterTarget);
+  printf("heater: %llu cases, %llu mismatches\n", (unsigned long long)heaterCases, (unsigned long long)heaterMismatches);
+  targetSweep(0.0f, 100.0f, 0.01f, checkMisterTarget);
+  printf("mister: %llu cases, %llu mismatches\n", (unsigned long long)misterCases, (unsigned long long)misterMismatches);
+
+  LightStats st;
+  runLight(days, st);
+  printf("lamp: %llu samples, %llu mismatches, %llu float rounding ties, old module differed on %llu\n",
+         (unsigned long long)st.samples, (unsigned long long)st.mismatches, (unsigned long long)st.floatTies,
+         (unsigned long long)st.oldDiffers);
+
+  return (heaterMismatches || misterMismatches || st.mismatches) ? 1 : 0;
+}
@@ -0,0 +1,296 @@
+/**
+ * @file fleetProto.cpp
+ * @brief Wire formats shared by the fleet gateway and the node simulator.
+ */
+#include "fleetProto.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+/// Field sizes on the wire, in field order (see telemetry.h)
+static const uint8_t FIELD_BYTES[TELEMETRY_FIELDS] = {2, 2, 1, 2, 2, 2};
+
+// ---------------------------------------------------------------- SHA-1 / base64
+
+static uint32_t rol(uint32_t v, unsigned n) {
+  return (v << n) | (v >> (32 - n));
+}
+
+/**
+ * @brief SHA-1 of @p data (only used for the handshake's accept key).
+ */
+static void sha1(const uint8_t *data, size_t len, uint8_t digest[20]) {
+  uint32_t h[5] = {0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0};
+  std::string msg((const char *)data, len);
+  msg += (char)0x80;
+  while (msg.size() % 64 != 56) msg += (char)0;
+  const uint64_t bits = (uint64_t)len * 8;
+  for (int i = 7; i >= 0; i--) msg += (char)(bits >> (8 * i));
+
+  for (size_t block = 0; block < msg.size(); block += 64) {
+    uint32_t w[80];
+    for (int i = 0; i < 16; i++) {
+      const uint8_t *p = (const uint8_t *)msg.data() + block + 4 * i;
+      w[i] = (uint32_t)p[0] << 24 | (uint32_t)p[1] << 16 | (uint32_t)p[2] << 8 | p[3];
+    }
+    for (int i = 16; i < 80; i++) w[i] = rol(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+
+    uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4];
+    for (int i = 0; i < 80; i++) {
+      uint32_t f, k;
+      if (i < 20) { f = (b & c) | (~b & d); k = 0x5A827999; }
+      else if (i < 40) { f = b ^ c ^ d; k = 0x6ED9EBA1; }
+      else if (i < 60) { f = (b & c) | (b & d) | (c & d); k = 0x8F1BBCDC; }
+      else { f = b ^ c ^ d; k = 0xCA62C1D6; }
+      const uint32_t t = rol(a, 5) + f + e + k + w[i];
+      e = d; d = c; c = rol(b, 30); b = a; a = t;
+    }
+    h[0] += a; h[1] += b; h[2] += c; h[3] += d; h[4] += e;
+  }
+  for (int i = 0; i < 20; i++) digest[i] = (uint8_t)(h[i / 4] >> (24 - 8 * (i % 4)));
+}
+
+static std::string base64(const uint8_t *data, size_t len) {
+  static const char ALPHABET[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  std::string out;
+  for (size_t i = 0; i < len; i += 3) {
+    const uint32_t v = (uint32_t)data[i] << 16 | (i + 1 < len ? (uint32_t)data[i + 1] << 8 : 0) |
+                       (i + 2 < len ? data[i + 2] : 0);
+    out += ALPHABET[(v >> 18) & 63];
+    out += ALPHABET[(v >> 12) & 63];
+    out += i + 1 < len ? ALPHABET[(v >> 6) & 63] : '=';
+    out += i + 2 < len ? ALPHABET[v & 63] : '=';
+  }
+  return out;
+}
+
+// ---------------------------------------------------------------- WebSocket
+
+/**
+ * @brief Sec-WebSocket-Accept value for the client's Sec-WebSocket-Key.
+ */
+std::string wsAcceptKey(const std::string &key) {
+  const std::string s = key + "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+  uint8_t digest[20];
+  sha1((const uint8_t *)s.data(), s.size(), digest);
+  return base64(digest, sizeof(digest));
+}
+
+/**
+ * @brief A fresh Sec-WebSocket-Key for a client handshake.
+ */
+std::string wsRandomKey() {
+  uint8_t nonce[16];
+  for (uint8_t &b : nonce) b = (uint8_t)rand();
+  return base64(nonce, sizeof(nonce));
+}
+
+/**
+ * @brief Append one complete (FIN) frame to @p out.
+ *
+ * @param mask True for frames sent by a client, which must be masked.
+ */
+void wsAppendFrame(std::string &out, uint8_t opcode, const void *data, size_t len, bool mask) {
+  out += (char)(0x80 | opcode);
+  const uint8_t maskBit = mask ? 0x80 : 0;
+  if (len < 126) {
+    out += (char)(maskBit | len);
+  } else if (len <= 0xFFFF) {
+    out += (char)(maskBit | 126);
+    out += (char)(len >> 8);
+    out += (char)len;
+  } else {
+    out += (char)(maskBit | 127);
+    for (int i = 7; i >= 0; i--) out += (char)((uint64_t)len >> (8 * i));
+  }
+
+  const uint8_t *p = (const uint8_t *)data;
+  if (!mask) {
+    out.append((const char *)p, len);
+    return;
+  }
+  uint8_t key[4];
+  for (uint8_t &b : key) b = (uint8_t)rand();
+  out.append((const char *)key, 4);
+  for (size_t i = 0; i < len; i++) out += (char)(p[i] ^ key[i & 3]);
+}
+
+/**
+ * @brief Parse the frame starting at @p off in @p in.
+ *
+ * @return Bytes the frame occupies, 0 if it is not complete yet, -1 if it is
+ *         malformed or larger than WS_MAX_PAYLOAD.
+ */
+long wsParseFrame(const std::string &in, size_t off, WsFrame &frame) {
+  const uint8_t *p = (const uint8_t *)in.data() + off;
+  const size_t avail = in.size() - off;
+  if (avail < 2) return 0;
+
+  frame.fin = (p[0] & 0x80) != 0;
+  frame.opcode = p[0] & 0x0F;
+  const bool masked = (p[1] & 0x80) != 0;
+  uint64_t len = p[1] & 0x7F;
+  size_t n = 2;
+  if (len == 126) {
+    if (avail < 4) return 0;
+    len = (uint64_t)p[2] << 8 | p[3];
+    n = 4;
+  } else if (len == 127) {
+    if (avail < 10) return 0;
+    len = 0;
+    for (int i = 0; i < 8; i++) len = len << 8 | p[2 + i];
+    n = 10;
+  }
+  if (len > WS_MAX_PAYLOAD) return -1;
+
+  const uint8_t *key = p + n;
+  if (masked) n += 4;
+  if (avail < n + len) return 0;
+
+  frame.payload.assign((const char *)p + n, (size_t)len);
+  if (masked) {
+    for (size_t i = 0; i < len; i++) frame.payload[i] = (char)(frame.payload[i] ^ key[i & 3]);
+  }
+  return (long)(n + len);
+}
+
+// ---------------------------------------------------------------- HTTP
+
+/**
+ * @brief Length of the HTTP head in @p in, including the blank line (0 if incomplete).
+ */
+size_t httpHeaderEnd(const std::string &in) {
+  const size_t end = in.find("\r\n\r\n");
+  return end == std::string::npos ? 0 : end + 4;
+}
+
+/**
+ * @brief Value of header @p name in an HTTP head (case-insensitive name), "" if absent.
+ */
+std::string httpHeader(const std::string &head, const char *name) {
+  const size_t nameLen = strlen(name);
+  for (size_t line = head.find("\r\n"); line != std::string::npos; line = head.find("\r\n", line + 2)) {
+    const size_t start = line + 2;
+    if (start + nameLen + 1 > head.size()) break;
+    if (strncasecmp(head.c_str() + start, name, nameLen) != 0 || head[start + nameLen] != ':') continue;
+    size_t v = start + nameLen + 1;
+    while (v < head.size() && head[v] == ' ') v++;
+    const size_t e = head.find("\r\n", v);
+    return head.substr(v, e == std::string::npos ? std::string::npos : e - v);
+  }
+  return "";
+}
+
+// ---------------------------------------------------------------- telemetry frames
+
+/**
+ * @brief Merge one binary telemetry frame into @p t.
+ *
+ * A keyframe replaces the node's zones and values; a delta frame is applied
+ * only if it follows the last applied frame.
+ */
+FrameApply fleetApplyFrame(NodeTelemetry &t, const uint8_t *frame, size_t len) {
+  if (len < 5 || frame[0] != TELEMETRY_PROTO_VERSION) return FRAME_BAD;
+  const bool key = (frame[1] & TELEMETRY_FLAG_KEYFRAME) != 0;
+  const uint16_t seq = (uint16_t)(frame[2] | frame[3] << 8);
+  const uint8_t zones = frame[4];
+  if (zones >> ZONE_MAX) return FRAME_BAD;
+  if (!key && (!t.valid || seq != (uint16_t)(t.seq + 1))) return FRAME_GAP;
+
+  // Decode into a copy, so a truncated frame leaves the state untouched.
+  NodeTelemetry next = t;
+  size_t n = 5;
+  for (uint8_t z = 0; z < ZONE_MAX; z++) {
+    if (!(zones & (1 << z))) continue;
+    if (n >= len) return FRAME_BAD;
+    const uint8_t mask = frame[n++];
+    for (uint8_t i = 0; i < TELEMETRY_FIELDS; i++) {
+      if (!(mask & (1 << i))) continue;
+      if (n + FIELD_BYTES[i] > len) return FRAME_BAD;
+      next.v[z][i] = FIELD_BYTES[i] == 2 ? (int16_t)(frame[n] | frame[n + 1] << 8) : frame[n];
+      n += FIELD_BYTES[i];
+    }
+  }
+  if (key) next.zones = (uint8_t)(zones ? 32 - __builtin_clz(zones) : 0);
+  next.seq = seq;
+  next.valid = true;
+  t = next;
+  return FRAME_APPLIED;
+}
+
+/**
+ * @brief Write a frame with the fields of @p t selected per zone by @p masks.
+ *
+ * @return Frame length (at most TELEMETRY_FRAME_MAX).
+ */
+size_t fleetEncodeFrame(const NodeTelemetry &t, uint8_t flags, const uint8_t masks[ZONE_MAX], uint8_t *out) {
+  size_t n = 0;
+  out[n++] = TELEMETRY_PROTO_VERSION;
+  out[n++] = flags;
+  out[n++] = (uint8_t)(t.seq & 0xFF);
+  out[n++] = (uint8_t)(t.seq >> 8);
+  const size_t zoneBitmap = n++;
+  out[zoneBitmap] = 0;
+  for (uint8_t z = 0; z < t.zones; z++) {
+    if (masks[z] == 0) continue;
+    out[zoneBitmap] |= (uint8_t)(1 << z);
+    out[n++] = masks[z];
+    for (uint8_t i = 0; i < TELEMETRY_FIELDS; i++) {
+      if (!(masks[z] & (1 << i))) continue;
+      out[n++] = (uint8_t)(t.v[z][i] & 0xFF);
+      if (FIELD_BYTES[i] == 2) out[n++] = (uint8_t)((uint16_t)t.v[z][i] >> 8);
+    }
+  }
+  return n;
+}
+
+/**
+ * @brief Write a keyframe with every field of every zone, at the current sequence number.
+ */
+size_t fleetEncodeKeyframe(const NodeTelemetry &t, uint8_t *out) {
+  uint8_t masks[ZONE_MAX];
+  for (uint8_t &m : masks) m = (uint8_t)((1 << TELEMETRY_FIELDS) - 1);
+  return fleetEncodeFrame(t, TELEMETRY_FLAG_KEYFRAME, masks, out);
+}
+
+static void appendDeci(std::string &out, int16_t v, bool round) {
+  char buf[16];
+  if (v == TELEMETRY_INVALID) {
+    out += "null";
+    return;
+  }
+  if (round) snprintf(buf, sizeof(buf), "%ld", lroundf(v / 10.0f));
+  else snprintf(buf, sizeof(buf), "%g", v / 10.0);
+  out += buf;
+}
+
+static void appendZone(std::string &out, const int16_t v[TELEMETRY_FIELDS]) {
+  out += "\"temperature\":";
+  appendDeci(out, v[0], true);
+  out += ",\"humidity\":";
+  appendDeci(out, v[1], true);
+  out += (v[2] & 0x01) ? ",\"light\":true" : ",\"light\":false";
+  out += ",\"tempTarget\":";
+  appendDeci(out, v[3], false);
+  out += ",\"humiTarget\":";
+  appendDeci(out, v[4], false);
+  out += ",\"lightTarget\":";
+  appendDeci(out, v[5], false);
+}
+
+/**
+ * @brief The node's JSON text message, laid out like getSensorReadings().
+ */
+std::string fleetJson(const NodeTelemetry &t) {
+  std::string out = "{";
+  appendZone(out, t.v[0]);
+  out += ",\"zones\":[";
+  for (uint8_t z = 0; z < t.zones; z++) {
+    out += z ? ",{" : "{";
+    appendZone(out, t.v[z]);
+    out += "}";
+  }
+  out += "]}";
+  return out;
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+
+#include "telemetry.h"
+
+/**
+ * @file fleetProto.h
+ * @brief Wire formats shared by the fleet gateway and the node simulator.
+ *
+ * @details Just enough of RFC 6455 for the dashboard protocol (single-frame
+ * text and binary messages, ping/pong, close), the HTTP upgrade handshake, and
+ * a decoder/encoder for the binary telemetry frames described in telemetry.h.
+ */
+
+/// @name WebSocket opcodes
+///@{
+static const uint8_t WS_OP_TEXT = 0x1;
+static const uint8_t WS_OP_BINARY = 0x2;
+static const uint8_t WS_OP_CLOSE = 0x8;
+static const uint8_t WS_OP_PING = 0x9;
+static const uint8_t WS_OP_PONG = 0xA;
+///@}
+
+/// Largest message either side accepts (dashboard messages are tiny)
+static const size_t WS_MAX_PAYLOAD = 4096;
+
+/**
+ * @brief One received WebSocket frame (payload already unmasked).
+ */
+struct WsFrame {
+  uint8_t opcode;
+  bool fin;
+  std::string payload;
+};
+
+std::string wsAcceptKey(const std::string &key);
+std::string wsRandomKey();
+void wsAppendFrame(std::string &out, uint8_t opcode, const void *data, size_t len, bool mask);
+long wsParseFrame(const std::string &in, size_t off, WsFrame &frame);
+
+size_t httpHeaderEnd(const std::string &in);
+std::string httpHeader(const std::string &head, const char *name);
+
+/**
+ * @brief Latest telemetry of one node, rebuilt from its frames.
+ */
+struct NodeTelemetry {
+  bool valid = false;     ///< A keyframe has been applied since the last reset
+  uint8_t zones = 0;      ///< Zones the node reported in its last keyframe
+  uint16_t seq = 0;       ///< Sequence number of the last applied frame
+  int16_t v[ZONE_MAX][TELEMETRY_FIELDS] = {};
+};
+
+/// Result of fleetApplyFrame()
+enum FrameApply : uint8_t {
+  FRAME_APPLIED,    ///< Delta or keyframe merged
+  FRAME_GAP,        ///< Delta does not follow the last frame (or no keyframe yet)
+  FRAME_BAD         ///< Not a telemetry frame of this protocol version
+};
+
+FrameApply fleetApplyFrame(NodeTelemetry &t, const uint8_t *frame, size_t len);
+size_t fleetEncodeFrame(const NodeTelemetry &t, uint8_t flags, const uint8_t masks[ZONE_MAX], uint8_t *out);
+size_t fleetEncodeKeyframe(const NodeTelemetry &t, uint8_t *out);
+std::string fleetJson(const NodeTelemetry &t);
@@ -0,0 +1,758 @@
+/**
+ * @file gateway.cpp
+ * @brief Linux fleet gateway: one upstream WebSocket per node, many dashboards.
+ *
+ * @details An ESP8266 serves only a handful of WebSocket clients (WS_MAX_CLIENTS),
+ * so dashboards connect here instead. The gateway keeps one connection to each
+ * node's /ws, asks it for binary telemetry (TELEMETRY_PROTO_REQUEST) and relays
+ * it to every dashboard subscribed to that node, speaking the node's own protocol
+ * towards them: getReadings, proto:bin2, and batches of T/H/L setpoint commands,
+ * which are forwarded to the node unchanged and acknowledged by the gateway.
+ *
+ * Everything runs in one thread around a level-triggered epoll loop. For each
+ * frame a node sends, the outgoing WebSocket frame is built once and shared by
+ * reference between the send queues of all its subscribers; text (JSON)
+ * subscribers share one JSON frame the same way. The gateway merges the frames
+ * into the node's current values (fleetApplyFrame()), so it can hand a keyframe
+ * to a dashboard that joins mid-stream, without asking the node.
+ *
+ * A subscriber whose send queue exceeds --queue-kb loses its queued frames and
+ * gets a fresh keyframe instead, as the firmware does for slow clients. A node
+ * that drops its connection is retried with exponential backoff; its subscribers
+ * stay connected and get a keyframe once it is back.
+ *
+ *   gateway [--listen PORT] [--node HOST:PORT]... [--node-range HOST:PORT:COUNT]
+ *           [--queue-kb N] [--stats SEC]
+ *
+ * Dashboards connect to ws://gateway:PORT/ws/<n> for node n (/ws is node 0);
+ * GET /nodes lists the nodes and their state as JSON.
+ */
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <signal.h>
+#include <sys/epoll.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "fleetProto.h"
+#include "wsCommand.h"
+
+/// Time without any data from a node before it is pinged
+static const uint64_t UPSTREAM_PING_MS = 15000;
+/// Time without any data from a node before its connection is dropped
+static const uint64_t UPSTREAM_DEAD_MS = 45000;
+/// Reconnect backoff: first delay and upper limit
+static const uint32_t RETRY_MIN_MS = 1000;
+static const uint32_t RETRY_MAX_MS = 30000;
+/// Largest HTTP request head accepted from a dashboard
+static const size_t HTTP_HEAD_MAX = 8192;
+
+typedef std::shared_ptr<const std::string> SharedFrame;
+
+enum ConnKind : uint8_t { CONN_LISTEN, CONN_UPSTREAM, CONN_CLIENT };
+
+/**
+ * @brief One socket: the listener, a node link or a dashboard.
+ */
+struct Conn {
+  int fd = -1;
+  ConnKind kind = CONN_CLIENT;
+  std::string in;                 ///< Received bytes not parsed yet
+  std::deque<SharedFrame> out;    ///< Queued outgoing frames (shared between subscribers)
+  size_t outOff = 0;              ///< Bytes of out.front() already sent
+  size_t outBytes = 0;            ///< Unsent bytes in out
+  bool wantWrite = false;         ///< EPOLLOUT is armed
+  bool closeWhenFlushed = false;
+  int node = -1;                  ///< Node this link serves or this dashboard watches
+
+  // Dashboards
+  bool upgraded = false;          ///< WebSocket handshake done
+  bool binary = false;            ///< Asked for binary frames
+  bool synced = false;            ///< Has the node's keyframe; deltas may follow
+  size_t subIndex = 0;            ///< Position in its node's subscriber list
+};
+
+enum NodePhase : uint8_t { NODE_DOWN, NODE_CONNECTING, NODE_HANDSHAKE, NODE_OPEN };
+
+static const char *const PHASE_NAMES[] = {"down", "connecting", "handshake", "open"};
+
+/**
+ * @brief One greenhouse node and its subscribers.
+ */
+struct Node {
+  std::string name;               ///< host:port as given
+  sockaddr_in addr = {};
+  NodePhase phase = NODE_DOWN;
+  Conn *link = nullptr;
+  std::string handshakeKey;
+  uint64_t retryAtMs = 0;
+  uint32_t backoffMs = RETRY_MIN_MS;
+  uint64_t lastRxMs = 0;
+  bool pingSent = false;
+  NodeTelemetry tel;
+  std::vector<Conn *> subs;
+  uint64_t framesIn = 0;
+  uint32_t connects = 0;
+};
+
+struct Stats {
+  uint64_t framesIn = 0;
+  uint64_t framesOut = 0;
+  uint64_t bytesOut = 0;
+  uint64_t slowResyncs = 0;
+  uint64_t gaps = 0;
+  uint64_t commands = 0;
+};
+
+static int epfd = -1;
+static std::vector<Node> nodes;
+static std::vector<Conn *> graveyard;
+static size_t clientCount = 0;
+static size_t queueLimit = 256 * 1024;
+static Stats stats;
+
+static uint64_t nowMs() {
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000 + (uint64_t)ts.tv_nsec / 1000000;
+}
+
+static void setNonBlocking(int fd) {
+  fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+}
+
+static void watch(Conn *c, bool write) {
+  epoll_event ev = {};
+  ev.events = EPOLLIN | (write ? (uint32_t)EPOLLOUT : 0u);
+  ev.data.ptr = c;
+  epoll_ctl(epfd, EPOLL_CTL_MOD, c->fd, &ev);
+  c->wantWrite = write;
+}
+
+static Conn *addConn(int fd, ConnKind kind, bool write) {
+  Conn *c = new Conn;
+  c->fd = fd;
+  c->kind = kind;
+  c->wantWrite = write;
+  epoll_event ev = {};
+  ev.events = EPOLLIN | (write ? (uint32_t)EPOLLOUT : 0u);
+  ev.data.ptr = c;
+  epoll_ctl(epfd, EPOLL_CTL_ADD, fd, &ev);
+  return c;
+}
+
+static void unsubscribe(Conn *c) {
+  if (c->node < 0 || !c->upgraded) return;
+  std::vector<Conn *> &subs = nodes[c->node].subs;
+  Conn *last = subs.back();
+  subs[c->subIndex] = last;
+  last->subIndex = c->subIndex;
+  subs.pop_back();
+}
+
+static void nodeDown(Node &n, const char *why);
+
+/**
+ * @brief Close a connection; the Conn is freed after the current epoll batch.
+ */
+static void closeConn(Conn *c) {
+  if (c->fd < 0) return;
+  epoll_ctl(epfd, EPOLL_CTL_DEL, c->fd, nullptr);
+  close(c->fd);
+  c->fd = -1;
+  c->out.clear();
+  if (c->kind == CONN_CLIENT) {
+    unsubscribe(c);
+    clientCount--;
+  } else if (c->kind == CONN_UPSTREAM && c->node >= 0 && nodes[c->node].link == c) {
+    nodeDown(nodes[c->node], "closed");
+  }
+  graveyard.push_back(c);
+}
+
+/**
+ * @brief Send as much of the queue as the socket takes; arm EPOLLOUT for the rest.
+ */
+static void flush(Conn *c) {
+  while (!c->out.empty()) {
+    const std::string &f = *c->out.front();
+    const ssize_t n = send(c->fd, f.data() + c->outOff, f.size() - c->outOff, MSG_NOSIGNAL);
+    if (n < 0) {
+      if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+      closeConn(c);
+      return;
+    }
+    c->outOff += (size_t)n;
+    c->outBytes -= (size_t)n;
+    if (c->outOff < f.size()) break;
+    c->out.pop_front();
+    c->outOff = 0;
+  }
+  if (c->out.empty() && c->closeWhenFlushed) {
+    closeConn(c);
+    return;
+  }
+  if (c->wantWrite != !c->out.empty()) watch(c, !c->out.empty());
+}
+
+static void enqueue(Conn *c, const SharedFrame &f) {
+  if (c->fd < 0) return;
+  const bool idle = c->out.empty();
+  c->out.push_back(f);
+  c->outBytes += f->size();
+  stats.framesOut++;
+  stats.bytesOut += f->size();
+  if (idle) flush(c);
+}
+
+static SharedFrame makeFrame(uint8_t opcode, const void *data, size_t len, bool mask) {
+  std::shared_ptr<std::string> f = std::make_shared<std::string>();
+  wsAppendFrame(*f, opcode, data, len, mask);
+  return f;
+}
+
+static SharedFrame makeText(const std::string &s, bool mask) {
+  return makeFrame(WS_OP_TEXT, s.data(), s.size(), mask);
+}
+
+static SharedFrame makeKeyframe(const Node &n) {
+  uint8_t frame[TELEMETRY_FRAME_MAX];
+  return makeFrame(WS_OP_BINARY, frame, fleetEncodeKeyframe(n.tel, frame), false);
+}
+
+/**
+ * @brief Drop a slow subscriber's queued frames (keeping a partly sent one).
+ */
+static void dropQueued(Conn *c) {
+  if (c->out.empty()) return;
+  SharedFrame head = c->out.front();
+  const bool partial = c->outOff > 0;
+  c->out.clear();
+  c->outBytes = 0;
+  if (partial) {
+    c->out.push_back(head);
+    c->outBytes = head->size() - c->outOff;
+  } else {
+    c->outOff = 0;
+  }
+  c->synced = false;
+  stats.slowResyncs++;
+}
+
+// ---------------------------------------------------------------- nodes
+
+/**
+ * @brief Relay one applied telemetry frame of @p n to its subscribers.
+ */
+static void fanout(Node &n, const std::string &payload) {
+  SharedFrame forward, key, json;
+  // Backwards, since a subscriber whose socket fails is swapped out of the list.
+  for (size_t i = n.subs.size(); i-- > 0;) {
+    Conn *c = n.subs[i];
+    if (c->outBytes > queueLimit) dropQueued(c);
+    if (!c->binary) {
+      if (!json) json = makeText(fleetJson(n.tel), false);
+      enqueue(c, json);
+    } else if (c->synced) {
+      if (!forward) forward = makeFrame(WS_OP_BINARY, payload.data(), payload.size(), false);
+      enqueue(c, forward);
+    } else {
+      if (!key) key = makeKeyframe(n);
+      enqueue(c, key);
+      c->synced = true;
+    }
+  }
+}
+
+static void nodeDown(Node &n, const char *why) {
+  if (n.phase == NODE_OPEN) fprintf(stderr, "node %s: %s\n", n.name.c_str(), why);
+  n.phase = NODE_DOWN;
+  n.link = nullptr;
+  n.tel.valid = false;
+  for (Conn *c : n.subs) c->synced = false;
+  n.retryAtMs = nowMs() + n.backoffMs / 2 + (uint32_t)rand() % (n.backoffMs / 2 + 1);
+  n.backoffMs = n.backoffMs * 2 > RETRY_MAX_MS ? RETRY_MAX_MS : n.backoffMs * 2;
+}
+
+static void nodeConnect(Node &n) {
+  const int fd = socket(AF_INET, SOCK_STREAM, 0);
+  if (fd < 0) {
+    nodeDown(n, "socket");
+    return;
+  }
+  setNonBlocking(fd);
+  const int one = 1;
+  setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+  if (connect(fd, (const sockaddr *)&n.addr, sizeof(n.addr)) != 0 && errno != EINPROGRESS) {
+    close(fd);
+    nodeDown(n, "connect");
+    return;
+  }
+  n.link = addConn(fd, CONN_UPSTREAM, true);
+  n.link->node = (int)(&n - nodes.data());
+  n.phase = NODE_CONNECTING;
+  n.lastRxMs = nowMs();
+  n.pingSent = false;
+}
+
+static void sendUpstream(Node &n, const std::string &text) {
+  if (n.phase == NODE_OPEN) enqueue(n.link, makeText(text, true));
+}
+
+/**
+ * @brief Connect finished: send the WebSocket upgrade request.
+ */
+static void upstreamConnected(Node &n) {
+  int err = 0;
+  socklen_t len = sizeof(err);
+  getsockopt(n.link->fd, SOL_SOCKET, SO_ERROR, &err, &len);
+  if (err != 0) {
+    closeConn(n.link);
+    return;
+  }
+  n.phase = NODE_HANDSHAKE;
+  n.handshakeKey = wsRandomKey();
+  const std::string req = "GET /ws HTTP/1.1\r\nHost: " + n.name +
+                          "\r\nUpgrade: websocket\r\nConnection: Upgrade\r\nSec-WebSocket-Key: " + n.handshakeKey +
+                          "\r\nSec-WebSocket-Version: 13\r\n\r\n";
+  enqueue(n.link, std::make_shared<const std::string>(req));
+}
+
+static void upstreamMessage(Node &n, const WsFrame &f) {
+  if (f.opcode == WS_OP_PING) {
+    enqueue(n.link, makeFrame(WS_OP_PONG, f.payload.data(), f.payload.size(), true));
+    return;
+  }
+  if (f.opcode == WS_OP_CLOSE) {
+    closeConn(n.link);
+    return;
+  }
+  if (f.opcode != WS_OP_BINARY || !f.fin) return; // JSON text is not needed once binary is on
+
+  n.framesIn++;
+  stats.framesIn++;
+  switch (fleetApplyFrame(n.tel, (const uint8_t *)f.payload.data(), f.payload.size())) {
+    case FRAME_APPLIED:
+      fanout(n, f.payload);
+      break;
+    case FRAME_GAP:
+      stats.gaps++;
+      sendUpstream(n, "getReadings"); // the reply is a keyframe
+      break;
+    case FRAME_BAD:
+      break;
+  }
+}
+
+static void upstreamReadable(Node &n) {
+  Conn *c = n.link;
+  if (n.phase == NODE_HANDSHAKE) {
+    const size_t end = httpHeaderEnd(c->in);
+    if (end == 0) {
+      if (c->in.size() > HTTP_HEAD_MAX) closeConn(c);
+      return;
+    }
+    const std::string head = c->in.substr(0, end);
+    c->in.erase(0, end);
+    if (head.compare(0, 12, "HTTP/1.1 101") != 0 ||
+        httpHeader(head, "Sec-WebSocket-Accept") != wsAcceptKey(n.handshakeKey)) {
+      fprintf(stderr, "node %s: upgrade refused\n", n.name.c_str());
+      closeConn(c);
+      return;
+    }
+    n.phase = NODE_OPEN;
+    n.backoffMs = RETRY_MIN_MS;
+    n.connects++;
+    sendUpstream(n, TELEMETRY_PROTO_REQUEST); // the reply is a keyframe
+  }
+
+  size_t off = 0;
+  while (c->fd >= 0) {
+    WsFrame f;
+    const long used = wsParseFrame(c->in, off, f);
+    if (used < 0) {
+      closeConn(c);
+      return;
+    }
+    if (used == 0) break;
+    off += (size_t)used;
+    upstreamMessage(n, f);
+  }
+  if (c->fd >= 0) c->in.erase(0, off);
+}
+
+// ---------------------------------------------------------------- dashboards
+
+static void subscribe(Conn *c, int node) {
+  Node &n = nodes[node];
+  c->node = node;
+  c->upgraded = true;
+  c->subIndex = n.subs.size();
+  n.subs.push_back(c);
+}
+
+static void sendReadings(Conn *c) {
+  const Node &n = nodes[c->node];
+  if (!n.tel.valid) return; // sent with the node's first keyframe
+  if (c->binary) {
+    enqueue(c, makeKeyframe(n));
+    c->synced = true;
+  } else {
+    enqueue(c, makeText(fleetJson(n.tel), false));
+  }
+}
+
+static std::string nodesJson() {
+  std::string out = "[";
+  char buf[256];
+  for (size_t i = 0; i < nodes.size(); i++) {
+    const Node &n = nodes[i];
+    snprintf(buf, sizeof(buf), "%s{\"id\":%zu,\"node\":\"%s\",\"state\":\"%s\",\"zones\":%u,\"subscribers\":%zu,"
+             "\"frames\":%llu,\"connects\":%u}",
+             i ? "," : "", i, n.name.c_str(), PHASE_NAMES[n.phase], n.tel.valid ? n.tel.zones : 0, n.subs.size(),
+             (unsigned long long)n.framesIn, n.connects);
+    out += buf;
+  }
+  return out + "]";
+}
+
+static void httpReply(Conn *c, const char *status, const char *type, const std::string &body) {
+  char head[256];
+  snprintf(head, sizeof(head), "HTTP/1.1 %s\r\nContent-Type: %s\r\nContent-Length: %zu\r\nConnection: close\r\n\r\n",
+           status, type, body.size());
+  c->closeWhenFlushed = true;
+  enqueue(c, std::make_shared<const std::string>(head + body));
+}
+
+/**
+ * @brief Answer a dashboard's HTTP request: WebSocket upgrade or /nodes.
+ */
+static void clientRequest(Conn *c, const std::string &head) {
+  char path[128] = "";
+  if (sscanf(head.c_str(), "GET %127s HTTP/1.1", path) != 1) {
+    httpReply(c, "400 Bad Request", "text/plain", "bad request\n");
+    return;
+  }
+  if (!strcmp(path, "/nodes")) {
+    httpReply(c, "200 OK", "application/json", nodesJson());
+    return;
+  }
+
+  long node = -1;
+  if (!strcmp(path, "/ws")) {
+    node = 0;
+  } else if (!strncmp(path, "/ws/", 4)) {
+    char *end = nullptr;
+    node = strtol(path + 4, &end, 10);
+    if (end == path + 4 || *end) node = -1;
+  }
+  const std::string key = httpHeader(head, "Sec-WebSocket-Key");
+  if (node < 0 || node >= (long)nodes.size() || key.empty()) {
+    httpReply(c, "404 Not Found", "text/plain", "no such node\n");
+    return;
+  }
+
+  const std::string resp = "HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n"
+                           "Sec-WebSocket-Accept: " + wsAcceptKey(key) + "\r\n\r\n";
+  // Subscribe first: if the send fails, closeConn() takes the connection out of the list again.
+  subscribe(c, (int)node);
+  enqueue(c, std::make_shared<const std::string>(resp));
+}
+
+/**
+ * @brief Handle one message from a dashboard, as the firmware's wsServer does.
+ */
+static void clientMessage(Conn *c, const WsFrame &f) {
+  if (f.opcode == WS_OP_PING) {
+    enqueue(c, makeFrame(WS_OP_PONG, f.payload.data(), f.payload.size(), false));
+    return;
+  }
+  if (f.opcode == WS_OP_CLOSE) {
+    c->closeWhenFlushed = true;
+    enqueue(c, makeFrame(WS_OP_CLOSE, f.payload.data(), f.payload.size() < 2 ? f.payload.size() : 2, false));
+    return;
+  }
+  if (f.opcode != WS_OP_TEXT || !f.fin) return;
+
+  WsCommandBatch batch;
+  wsCommandParse((const uint8_t *)f.payload.data(), f.payload.size(), batch);
+  Node &n = nodes[c->node];
+  bool forward = false;
+  for (uint8_t i = 0; i < batch.count; i++) {
+    WsCommand &cmd = batch.cmds[i];
+    if (cmd.kind == WS_CMD_PROTO) {
+      c->binary = true;
+      c->synced = false;
+      sendReadings(c);
+    } else if (cmd.kind == WS_CMD_READINGS) {
+      sendReadings(c);
+    } else if (cmd.kind <= WS_CMD_LIGHT) {
+      if (n.tel.valid && cmd.zone >= n.tel.zones) {
+        batch.rejected++;
+        continue;
+      }
+      // Acknowledged with the value the node will apply; its reply reaches everyone as telemetry.
+      cmd.value = wsCommandClamp(cmd.kind, cmd.value);
+      cmd.applied = true;
+      forward = true;
+    }
+    // "rate:" is accepted and ignored: the gateway relays every frame the node sends.
+  }
+  if (forward) {
+    // The frame goes to the node unchanged; the node's own acknowledgement is not relayed.
+    stats.commands++;
+    sendUpstream(n, f.payload);
+  }
+  if (wsCommandNeedsAck(batch)) {
+    char ack[WS_ACK_MAX];
+    enqueue(c, makeFrame(WS_OP_TEXT, ack, wsCommandAck(batch, ack, sizeof(ack)), false));
+  }
+}
+
+static void clientReadable(Conn *c) {
+  if (!c->upgraded) {
+    const size_t end = httpHeaderEnd(c->in);
+    if (end == 0) {
+      if (c->in.size() > HTTP_HEAD_MAX) closeConn(c);
+      return;
+    }
+    const std::string head = c->in.substr(0, end);
+    c->in.erase(0, end);
+    clientRequest(c, head);
+    if (!c->upgraded) {
+      c->in.clear();
+      return;
+    }
+  }
+
+  size_t off = 0;
+  while (c->fd >= 0 && !c->closeWhenFlushed) {
+    WsFrame f;
+    const long used = wsParseFrame(c->in, off, f);
+    if (used < 0) {
+      closeConn(c);
+      return;
+    }
+    if (used == 0) break;
+    off += (size_t)used;
+    clientMessage(c, f);
+  }
+  if (c->fd >= 0) c->in.erase(0, off);
+}
+
+// ---------------------------------------------------------------- event loop
+
+static void acceptClients(int listenFd) {
+  for (;;) {
+    const int fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK);
+    if (fd < 0) {
+      if (errno == EMFILE || errno == ENFILE) fprintf(stderr, "gateway: out of file descriptors\n");
+      return;
+    }
+    const int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    addConn(fd, CONN_CLIENT, false);
+    clientCount++;
+  }
+}
+
+/**
+ * @brief Read everything the socket has; false if the peer closed or failed.
+ */
+static bool readInto(Conn *c) {
+  char buf[16384];
+  for (;;) {
+    const ssize_t n = recv(c->fd, buf, sizeof(buf), 0);
+    if (n > 0) {
+      c->in.append(buf, (size_t)n);
+      if (c->in.size() > 4 * WS_MAX_PAYLOAD + HTTP_HEAD_MAX) return false;
+      continue;
+    }
+    if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return true;
+    if (n < 0 && errno == EINTR) continue;
+    return false;
+  }
+}
+
+static void onEvent(Conn *c, uint32_t events, int listenFd) {
+  if (c->kind == CONN_LISTEN) {
+    acceptClients(listenFd);
+    return;
+  }
+  if (c->fd < 0) return;
+
+  if (c->kind == CONN_UPSTREAM) {
+    Node &n = nodes[c->node];
+    if (n.phase == NODE_CONNECTING && (events & (EPOLLOUT | EPOLLERR | EPOLLHUP))) {
+      upstreamConnected(n);
+      if (c->fd < 0) return;
+    }
+    if (events & EPOLLIN) {
+      const bool open = readInto(c);
+      n.lastRxMs = nowMs();
+      n.pingSent = false;
+      if (!c->in.empty()) upstreamReadable(n);
+      if (!open && c->fd >= 0) closeConn(c);
+      if (c->fd < 0) return;
+    }
+  } else if (events & EPOLLIN) {
+    const bool open = readInto(c);
+    if (!c->in.empty()) clientReadable(c);
+    if (!open && c->fd >= 0) closeConn(c);
+    if (c->fd < 0) return;
+  }
+  if ((events & EPOLLOUT) && c->fd >= 0) flush(c);
+  if ((events & (EPOLLERR | EPOLLHUP)) && c->fd >= 0 && !(events & EPOLLIN)) closeConn(c);
+}
+
+/**
+ * @brief Reconnect nodes that are due, ping quiet ones and drop dead ones.
+ */
+static void serviceNodes(uint64_t now) {
+  for (Node &n : nodes) {
+    if (n.phase == NODE_DOWN) {
+      if (now >= n.retryAtMs) nodeConnect(n);
+      continue;
+    }
+    const uint64_t quiet = now - n.lastRxMs;
+    if (quiet >= UPSTREAM_DEAD_MS) {
+      closeConn(n.link);
+    } else if (n.phase == NODE_OPEN && quiet >= UPSTREAM_PING_MS && !n.pingSent) {
+      enqueue(n.link, makeFrame(WS_OP_PING, nullptr, 0, true));
+      n.pingSent = true;
+    }
+  }
+}
+
+static void printStats(double seconds) {
+  size_t up = 0;
+  for (const Node &n : nodes) up += n.phase == NODE_OPEN;
+  fprintf(stderr, "nodes %zu/%zu up, %zu clients, in %.0f frames/s, out %.0f frames/s %.2f MB/s, "
+          "resyncs %llu, gaps %llu, commands %llu\n",
+          up, nodes.size(), clientCount, stats.framesIn / seconds, stats.framesOut / seconds,
+          stats.bytesOut / seconds / 1e6, (unsigned long long)stats.slowResyncs, (unsigned long long)stats.gaps,
+          (unsigned long long)stats.commands);
+  stats = Stats();
+}
+
+static bool addNode(const char *host, int port) {
+  addrinfo hints = {}, *res = nullptr;
+  hints.ai_family = AF_INET;
+  hints.ai_socktype = SOCK_STREAM;
+  if (getaddrinfo(host, nullptr, &hints, &res) != 0 || !res) {
+    fprintf(stderr, "gateway: cannot resolve %s\n", host);
+    return false;
+  }
+  Node n;
+  n.addr = *(const sockaddr_in *)res->ai_addr;
+  n.addr.sin_port = htons((uint16_t)port);
+  freeaddrinfo(res);
+  n.name = std::string(host) + ":" + std::to_string(port);
+  nodes.push_back(n);
+  return true;
+}
+
+/**
+ * @brief Parse "HOST:PORT" or "HOST:PORT:COUNT" (COUNT consecutive ports).
+ */
+static bool parseNodes(const char *spec, bool range) {
+  char host[128];
+  int port = 0, count = 1;
+  const int fields = sscanf(spec, "%127[^:]:%d:%d", host, &port, &count);
+  if (fields < 2 || (range && fields != 3) || port <= 0 || count <= 0 || port + count > 65536) {
+    fprintf(stderr, "gateway: bad node %s\n", spec);
+    return false;
+  }
+  for (int i = 0; i < count; i++) {
+    if (!addNode(host, port + i)) return false;
+  }
+  return true;
+}
+
+int main(int argc, char **argv) {
+  int port = 8081;
+  unsigned statsSec = 10;
+
+  for (int i = 1; i < argc; i++) {
+    const char *opt = argv[i];
+    const char *val = i + 1 < argc ? argv[i + 1] : nullptr;
+    if (!val) {
+      fprintf(stderr, "usage: %s [--listen PORT] [--node HOST:PORT]... [--node-range HOST:PORT:COUNT] "
+              "[--queue-kb N] [--stats SEC]\n", argv[0]);
+      return 2;
+    }
+    i++;
+    if (!strcmp(opt, "--listen")) port = atoi(val);
+    else if (!strcmp(opt, "--node")) { if (!parseNodes(val, false)) return 2; }
+    else if (!strcmp(opt, "--node-range")) { if (!parseNodes(val, true)) return 2; }
+    else if (!strcmp(opt, "--queue-kb")) queueLimit = (size_t)strtoul(val, nullptr, 10) * 1024;
+    else if (!strcmp(opt, "--stats")) statsSec = (unsigned)strtoul(val, nullptr, 10);
+    else {
+      fprintf(stderr, "unknown option %s\n", opt);
+      return 2;
+    }
+  }
+  if (nodes.empty()) {
+    fprintf(stderr, "gateway: no nodes given (--node or --node-range)\n");
+    return 2;
+  }
+  signal(SIGPIPE, SIG_IGN);
+  srand((unsigned)time(nullptr));
+
+  // Thousands of dashboards need more descriptors than the usual soft limit.
+  rlimit lim;
+  if (getrlimit(RLIMIT_NOFILE, &lim) == 0 && lim.rlim_cur < lim.rlim_max) {
+    lim.rlim_cur = lim.rlim_max;
+    setrlimit(RLIMIT_NOFILE, &lim);
+  }
+
+  epfd = epoll_create1(0);
+  const int srv = socket(AF_INET, SOCK_STREAM, 0);
+  const int one = 1;
+  setsockopt(srv, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+  sockaddr_in addr = {};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons((uint16_t)port);
+  addr.sin_addr.s_addr = htonl(INADDR_ANY);
+  if (bind(srv, (sockaddr *)&addr, sizeof(addr)) != 0 || listen(srv, 1024) != 0) {
+    perror("gateway");
+    return 1;
+  }
+  setNonBlocking(srv);
+  addConn(srv, CONN_LISTEN, false);
+  fprintf(stderr, "gateway listening on port %d for %zu nodes\n", port, nodes.size());
+
+  uint64_t lastService = 0, lastStats = nowMs();
+  epoll_event events[256];
+  for (;;) {
+    const int n = epoll_wait(epfd, events, 256, 100);
+    for (int i = 0; i < n; i++) onEvent((Conn *)events[i].data.ptr, events[i].events, srv);
+    for (Conn *c : graveyard) delete c;
+    graveyard.clear();
+
+    const uint64_t now = nowMs();
+    if (now - lastService >= 100) {
+      lastService = now;
+      serviceNodes(now);
+    }
+    if (statsSec && now - lastStats >= statsSec * 1000ULL) {
+      printStats((now - lastStats) / 1000.0);
+      lastStats = now;
+    }
+  }
+}
@@ -0,0 +1,572 @@
+/**
+ * @file halHost.cpp
+ * @brief Simulated clock, pins, ADC and DHT11 for the host build.
+ *
+ * @details Implements hal.h without any hardware: time only moves when the
+ * caller advances it, output pins just remember their last level, and the ADC
+ * returns whatever the caller fed in through halHost.h.
+ *
+ * A DHT11 is simulated on any pin that has a falling-edge interrupt attached:
+ * when the pin is released (INPUT_PULLUP) after being held LOW for at least
+ * the 18 ms start signal, the sensor's response is played back edge by edge,
+ * advancing the microsecond clock and calling the handler as real hardware would.
+ *
+ * The periodic timer (halTimerBegin()) fires whenever simulated time passes
+ * one of its deadlines, whichever call advances the clock.
+ *
+ * One access point is simulated: a connection is ready after its scan and DHCP
+ * times, or after the short fast-connect time when the hint names its BSSID
+ * and channel. RTC memory survives halHostReset() (a reboot), as on the chip;
+ * halHostRtcClear() simulates a power cycle.
+ *
+ * The flash filesystem is a directory on the host (halHostFsRoot(), default
+ * "fs" in the working directory); paths like "/log/1.bin" map below it.
+ *
+ * TCP uses real non-blocking sockets, so the firmware's network code can talk
+ * to local stand-in servers. Only name resolution blocks.
+ */
+#include "hal.h"
+#include "halHost.h"
+#include <Arduino.h>
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <sys/stat.h>
+#include <time.h>
+
+static uint64_t nowUs = 0;
+/// Wall clock: Unix seconds at simulated time epochAtUs (0 = not set)
+static uint32_t epochSec = 0;
+static uint64_t epochAtUs = 0;
+
+static uint8_t  pinModes[HAL_HOST_PINS];
+static uint8_t  pinLevels[HAL_HOST_PINS];
+static uint32_t pinWrites[HAL_HOST_PINS];
+static uint32_t gpioWrites = 0;
+static uint64_t pinLowSinceUs[HAL_HOST_PINS];
+static int      analogValues[HAL_HOST_PINS];
+static HalIsr   pinIsrs[HAL_HOST_PINS];
+
+/// Periodic timer: callback, period and next deadline
+static HalTimerFn timerFn = nullptr;
+static uint64_t   timerPeriodUs = 0;
+static uint64_t   timerNextUs = 0;
+
+/// Simulated access point and station
+static HalWifiLink wifiAp = {{0x02, 0x00, 0x5e, 0x10, 0x20, 0x30}, 6, 0x3201A8C0, 0x0101A8C0, 0x00FFFFFF, 0x0101A8C0};
+static bool     wifiApUp = true;
+static uint32_t wifiScanMs = 2500, wifiDhcpMs = 1500, wifiFastMs = 300;
+static uint8_t  wifiState = HAL_WIFI_IDLE;
+static bool     wifiWillFail = false;
+static uint64_t wifiReadyUs = 0;
+static uint32_t wifiBegins = 0;
+
+static uint8_t rtcMem[HAL_RTC_BYTES];
+
+/// What halMemInfo() reports
+static HalMemInfo memInfo = {40000, 32000, 5, 3000};
+
+/// What the simulated DHT11 on each pin reports
+static bool     dhtOk[HAL_HOST_PINS];
+static float    dhtHumidity[HAL_HOST_PINS];
+static float    dhtTemp[HAL_HOST_PINS];
+static uint32_t dhtFrames = 0;
+
+static std::string fsRoot = "fs";
+static std::string fsPathBuf;
+
+/// Files that may be open at the same time (as on the device)
+static const uint8_t HAL_HOST_FILES = 4;
+static FILE *files[HAL_HOST_FILES];
+
+/// Serial output goes here (nullptr discards it)
+static FILE *serialOut = stdout;
+/// Bytes the simulated UART accepts per halSerialWrite(), like a TX FIFO
+static const size_t HAL_HOST_SERIAL_ROOM = 128;
+
+/// TCP connections that may be open at the same time (as on the device)
+static const uint8_t HAL_HOST_SOCKETS = 2;
+
+struct HostSocket {
+  int fd;
+  uint8_t state;
+};
+
+static HostSocket sockets[HAL_HOST_SOCKETS] = {{-1, HAL_TCP_FAILED}, {-1, HAL_TCP_FAILED}};
+
+/// Minimum LOW time the host must hold before the DHT11 answers
+static const uint32_t DHT_START_MIN_US = 18000;
+
+/**
+ * @brief Put the simulated hardware back into its power-on state.
+ */
+void halHostReset() {
+  nowUs = 0;
+  epochSec = 0;
+  gpioWrites = 0;
+  for (uint8_t i = 0; i < HAL_HOST_PINS; i++) {
+    pinModes[i] = INPUT;
+    pinLevels[i] = HIGH;
+    pinWrites[i] = 0;
+    pinLowSinceUs[i] = 0;
+    analogValues[i] = 0;
+    pinIsrs[i] = nullptr;
+    dhtOk[i] = false;
+    dhtHumidity[i] = NAN;
+    dhtTemp[i] = NAN;
+  }
+  dhtFrames = 0;
+  timerFn = nullptr;
+  wifiState = HAL_WIFI_IDLE;
+  wifiBegins = 0;
+  for (uint8_t i = 0; i < HAL_HOST_FILES; i++) {
+    if (files[i]) fclose(files[i]);
+    files[i] = nullptr;
+  }
+  for (uint8_t i = 0; i < HAL_HOST_SOCKETS; i++) halTcpClose(i);
+}
+
+/**
+ * @brief Let @p us of simulated time pass, running the periodic timer on the way.
+ */
+static void advanceUs(uint64_t us) {
+  const uint64_t end = nowUs + us;
+  while (timerFn && timerNextUs <= end) {
+    nowUs = timerNextUs;
+    timerNextUs += timerPeriodUs;
+    timerFn();
+  }
+  nowUs = end;
+}
+
+/// Jump the clock to @p ms; the periodic timer restarts from there instead of catching up.
+void halHostSetMillis(uint32_t ms) {
+  nowUs = (uint64_t)ms * 1000;
+  timerNextUs = nowUs + timerPeriodUs;
+}
+
+/// Set the wall clock to @p epoch Unix seconds now (0 = unknown, as before SNTP); it runs with simulated time.
+void halHostSetEpoch(uint32_t epoch) {
+  epochSec = epoch;
+  epochAtUs = nowUs;
+}
+
+void halHostAdvanceMillis(uint32_t ms) { advanceUs((uint64_t)ms * 1000); }
+void halHostAdvanceMicros(uint32_t us) { advanceUs(us); }
+
+void halHostSetAnalog(uint8_t pin, int value) {
+  if (pin < HAL_HOST_PINS) analogValues[pin] = value;
+}
+
+int halHostPinLevel(uint8_t pin) { return pin < HAL_HOST_PINS ? pinLevels[pin] : 0; }
+uint8_t halHostPinMode(uint8_t pin) { return pin < HAL_HOST_PINS ? pinModes[pin] : 0; }
+uint32_t halHostPinWrites(uint8_t pin) { return pin < HAL_HOST_PINS ? pinWrites[pin] : 0; }
+uint32_t halHostGpioWrites() { return gpioWrites; }
+
+/**
+ * @brief Set what the simulated DHT11s on all pins report.
+ *
+ * @param ok          False makes the sensor stay silent (as if disconnected).
+ * @param humidityPct Relative humidity in %.
+ * @param tempC       Temperature in °C.
+ */
+void halHostSetDht(bool ok, float humidityPct, float tempC) {
+  for (uint8_t pin = 0; pin < HAL_HOST_PINS; pin++) halHostSetDhtPin(pin, ok, humidityPct, tempC);
+}
+
+/**
+ * @brief Set what the simulated DHT11 on @p pin reports (one per zone).
+ */
+void halHostSetDhtPin(uint8_t pin, bool ok, float humidityPct, float tempC) {
+  if (pin >= HAL_HOST_PINS) return;
+  dhtOk[pin] = ok;
+  dhtHumidity[pin] = humidityPct;
+  dhtTemp[pin] = tempC;
+}
+
+/// Number of complete frames the simulated DHT11 has sent.
+uint32_t halHostDhtFrames() { return dhtFrames; }
+
+/**
+ * @brief Set how the simulated access point behaves.
+ *
+ * @param up     False makes every connection attempt fail after the scan time.
+ * @param scanMs Time to find the access point without a hint.
+ * @param dhcpMs Time to get an address by DHCP.
+ * @param fastMs Time to associate with a correct hint (no scan, static address).
+ */
+void halHostSetWifi(bool up, uint32_t scanMs, uint32_t dhcpMs, uint32_t fastMs) {
+  wifiApUp = up;
+  wifiScanMs = scanMs;
+  wifiDhcpMs = dhcpMs;
+  wifiFastMs = fastMs;
+  if (!up && wifiState == HAL_WIFI_CONNECTED) wifiState = HAL_WIFI_IDLE;
+}
+
+/// Move the access point to another channel (cached hints go stale).
+void halHostWifiChannel(uint8_t channel) { wifiAp.channel = channel; }
+
+/// Drop the current association, as when the access point reboots.
+void halHostWifiDrop() {
+  if (wifiState == HAL_WIFI_CONNECTED) wifiState = HAL_WIFI_IDLE;
+}
+
+/// Number of halWifiBegin() calls since the last reset.
+uint32_t halHostWifiBegins() { return wifiBegins; }
+
+/// Forget the RTC memory, as a power cycle does.
+void halHostRtcClear() { memset(rtcMem, 0, sizeof(rtcMem)); }
+
+/**
+ * @brief Use directory @p dir as the root of the simulated flash filesystem.
+ */
+void halHostFsRoot(const char *dir) {
+  fsRoot = dir;
+}
+
+/**
+ * @brief Host path of flash path @p path (valid until the next call).
+ */
+const char *halHostFsPath(const char *path) {
+  fsPathBuf = fsRoot + path;
+  return fsPathBuf.c_str();
+}
+
+/**
+ * @brief Create every missing directory on the way to @p path.
+ */
+static void makeParents(const std::string &path) {
+  for (size_t i = 1; i < path.size(); i++) {
+    if (path[i] == '/') mkdir(path.substr(0, i).c_str(), 0755);
+  }
+}
+
+/**
+ * @brief Play one DHT11 answer on @p pin: response pulse, 40 data bits, end pulse.
+ *
+ * Only falling edges are delivered, since that is all the driver listens to.
+ */
+static void playDhtFrame(uint8_t pin) {
+  const float h = dhtHumidity[pin] < 0 ? 0 : dhtHumidity[pin];
+  const float t = dhtTemp[pin];
+  const uint16_t hDeci = (uint16_t)lroundf(h * 10.0f);
+  const uint16_t tDeci = (uint16_t)lroundf(fabsf(t) * 10.0f);
+
+  uint8_t data[5];
+  data[0] = (uint8_t)(hDeci / 10);
+  data[1] = (uint8_t)(hDeci % 10);
+  data[2] = (uint8_t)(tDeci / 10);
+  data[3] = (uint8_t)((tDeci % 10) | (t < 0 ? 0x80 : 0));
+  data[4] = (uint8_t)(data[0] + data[1] + data[2] + data[3]);
+
+  HalIsr isr = pinIsrs[pin];
+
+  nowUs += 30;           // sensor waits, then pulls the line low
+  isr();
+  nowUs += 80 + 80;      // 80 us low + 80 us high response
+  isr();                 // start of bit 0
+  for (uint8_t i = 0; i < 40; i++) {
+    const bool one = data[i / 8] & (0x80 >> (i % 8));
+    nowUs += 50 + (one ? 70 : 26);
+    isr();               // start of next bit, or the final end pulse
+  }
+  pinLevels[pin] = HIGH;
+  dhtFrames++;
+}
+
+// ---------------------------------------------------------------- hal.h
+
+uint32_t halMillis() {
+  return (uint32_t)(nowUs / 1000);
+}
+
+uint32_t halMicros() {
+  return (uint32_t)nowUs;
+}
+
+/**
+ * @brief Cycle counter of the host CPU, in nanoseconds of the monotonic clock.
+ *
+ * Unlike halMicros() this is real time, so benchmarks and profiles measure the
+ * code that ran rather than the simulated clock.
+ */
+uint32_t halCycles() {
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint32_t)((uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec);
+}
+
+uint32_t halCpuHz() {
+  return 1000000000u;
+}
+
+uint32_t halEpochSec() {
+  return epochSec ? epochSec + (uint32_t)((nowUs - epochAtUs) / 1000000) : 0;
+}
+
+void halMemInfo(HalMemInfo &out) {
+  out = memInfo;
+}
+
+/**
+ * @brief Set what halMemInfo() reports.
+ */
+void halHostSetMem(uint32_t freeHeap, uint32_t maxBlock, uint8_t fragmentPct, uint32_t freeStack) {
+  memInfo = {freeHeap, maxBlock, fragmentPct, freeStack};
+}
+
+/**
+ * @brief Idling on the host simply lets simulated time pass.
+ */
+void halIdle(uint32_t ms) {
+  advanceUs((uint64_t)ms * 1000);
+}
+
+void halPinMode(uint8_t pin, uint8_t mode) {
+  if (pin >= HAL_HOST_PINS) return;
+
+  const bool released = (mode == INPUT_PULLUP && pinModes[pin] == OUTPUT && pinLevels[pin] == LOW);
+  pinModes[pin] = mode;
+  if (!released) return;
+
+  const bool startSignal = (nowUs - pinLowSinceUs[pin]) >= DHT_START_MIN_US;
+  pinLevels[pin] = HIGH;
+  if (startSignal && pinIsrs[pin] && dhtOk[pin]) {
+    playDhtFrame(pin);
+  }
+}
+
+void halDigitalWrite(uint8_t pin, uint8_t level) {
+  if (pin >= HAL_HOST_PINS) return;
+  const uint8_t v = level ? HIGH : LOW;
+  if (v == LOW && pinLevels[pin] != LOW) pinLowSinceUs[pin] = nowUs;
+  pinLevels[pin] = v;
+  pinWrites[pin]++;
+}
+
+void halGpioWrite(uint32_t setMask, uint32_t clearMask) {
+  gpioWrites++;
+  for (uint8_t pin = 0; pin < HAL_HOST_PINS && pin <= 16; pin++) {
+    if (setMask & (1u << pin)) halDigitalWrite(pin, HIGH);
+    else if (clearMask & (1u << pin)) halDigitalWrite(pin, LOW);
+  }
+}
+
+int halAnalogRead(uint8_t pin) {
+  return pin < HAL_HOST_PINS ? analogValues[pin] : 0;
+}
+
+void halAttachFallingInterrupt(uint8_t pin, HalIsr isr) {
+  if (pin < HAL_HOST_PINS) pinIsrs[pin] = isr;
+}
+
+void halDetachInterrupt(uint8_t pin) {
+  if (pin < HAL_HOST_PINS) pinIsrs[pin] = nullptr;
+}
+
+void halTimerBegin(uint32_t periodMs, HalTimerFn fn) {
+  timerFn = fn;
+  timerPeriodUs = (uint64_t)(periodMs ? periodMs : 1) * 1000;
+  timerNextUs = nowUs + timerPeriodUs;
+}
+
+void halTimerStop() {
+  timerFn = nullptr;
+}
+
+bool halRtcRead(void *buf, size_t len) {
+  if (len > HAL_RTC_BYTES) return false;
+  memcpy(buf, rtcMem, len);
+  return true;
+}
+
+bool halRtcWrite(const void *buf, size_t len) {
+  if (len > HAL_RTC_BYTES) return false;
+  memcpy(rtcMem, buf, len);
+  return true;
+}
+
+void halWifiBegin(const char *ssid, const char *password, const HalWifiLink *hint) {
+  (void)ssid;
+  (void)password;
+  wifiBegins++;
+  const bool fast = hint && hint->channel == wifiAp.channel && !memcmp(hint->bssid, wifiAp.bssid, sizeof(wifiAp.bssid));
+  if (hint && !fast) {
+    // The station waits on the wrong channel and never finds the access point
+    wifiState = HAL_WIFI_CONNECTING;
+    wifiWillFail = false;
+    wifiReadyUs = UINT64_MAX;
+    return;
+  }
+  wifiState = HAL_WIFI_CONNECTING;
+  wifiWillFail = !wifiApUp;
+  wifiReadyUs = nowUs + (uint64_t)1000 * (fast ? wifiFastMs : wifiScanMs + (wifiApUp ? wifiDhcpMs : 0));
+}
+
+uint8_t halWifiState() {
+  if (wifiState == HAL_WIFI_CONNECTING && nowUs >= wifiReadyUs) {
+    wifiState = wifiWillFail ? HAL_WIFI_FAILED : HAL_WIFI_CONNECTED;
+  }
+  return wifiState;
+}
+
+bool halWifiLinkInfo(HalWifiLink &out) {
+  if (halWifiState() != HAL_WIFI_CONNECTED) return false;
+  out = wifiAp;
+  return true;
+}
+
+void halWifiDisconnect() {
+  wifiState = HAL_WIFI_IDLE;
+}
+
+/**
+ * @brief Send simulated serial output to @p out (nullptr discards it).
+ */
+void halHostSerialSink(FILE *out) {
+  serialOut = out;
+}
+
+size_t halSerialWritable() {
+  return HAL_HOST_SERIAL_ROOM;
+}
+
+size_t halSerialWrite(const uint8_t *buf, size_t len) {
+  if (len > HAL_HOST_SERIAL_ROOM) len = HAL_HOST_SERIAL_ROOM;
+  if (serialOut) fwrite(buf, 1, len, serialOut);
+  return len;
+}
+
+bool halFsBegin() {
+  makeParents(fsRoot + "/");
+  struct stat st;
+  return stat(fsRoot.c_str(), &st) == 0 && S_ISDIR(st.st_mode);
+}
+
+HalFile halFsOpen(const char *path, bool append) {
+  for (uint8_t i = 0; i < HAL_HOST_FILES; i++) {
+    if (files[i]) continue;
+    const std::string full = fsRoot + path;
+    if (append) makeParents(full);
+    files[i] = fopen(full.c_str(), append ? "a+b" : "rb");
+    return files[i] ? (HalFile)i : HAL_FILE_NONE;
+  }
+  return HAL_FILE_NONE;
+}
+
+size_t halFsRead(HalFile f, uint32_t offset, void *buf, size_t len) {
+  if (f < 0 || f >= HAL_HOST_FILES || !files[f]) return 0;
+  if (fseek(files[f], offset, SEEK_SET) != 0) return 0;
+  return fread(buf, 1, len, files[f]);
+}
+
+size_t halFsWrite(HalFile f, const void *buf, size_t len) {
+  if (f < 0 || f >= HAL_HOST_FILES || !files[f]) return 0;
+  return fwrite(buf, 1, len, files[f]);
+}
+
+uint32_t halFsSize(HalFile f) {
+  if (f < 0 || f >= HAL_HOST_FILES || !files[f]) return 0;
+  fseek(files[f], 0, SEEK_END);
+  return (uint32_t)ftell(files[f]);
+}
+
+void halFsClose(HalFile f) {
+  if (f < 0 || f >= HAL_HOST_FILES || !files[f]) return;
+  fclose(files[f]);
+  files[f] = nullptr;
+}
+
+bool halFsRemove(const char *path) {
+  return remove((fsRoot + path).c_str()) == 0;
+}
+
+void halFsList(const char *dir, HalFsListFn fn, void *ctx) {
+  const std::string full = fsRoot + dir;
+  DIR *d = opendir(full.c_str());
+  if (!d) return;
+  while (struct dirent *e = readdir(d)) {
+    struct stat st;
+    if (stat((full + "/" + e->d_name).c_str(), &st) != 0 || !S_ISREG(st.st_mode)) continue;
+    fn(e->d_name, (uint32_t)st.st_size, ctx);
+  }
+  closedir(d);
+}
+
+HalTcp halTcpConnect(const char *host, uint16_t port) {
+  for (uint8_t i = 0; i < HAL_HOST_SOCKETS; i++) {
+    HostSocket &s = sockets[i];
+    if (s.fd >= 0) continue;
+
+    struct addrinfo hints = {};
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    struct addrinfo *res = nullptr;
+    char portStr[8];
+    snprintf(portStr, sizeof(portStr), "%u", port);
+    if (getaddrinfo(host, portStr, &hints, &res) != 0 || !res) return HAL_TCP_NONE;
+
+    s.fd = socket(res->ai_family, res->ai_socktype, res->ai_protocol);
+    if (s.fd < 0) {
+      freeaddrinfo(res);
+      return HAL_TCP_NONE;
+    }
+    fcntl(s.fd, F_SETFL, fcntl(s.fd, F_GETFL) | O_NONBLOCK);
+    const int rc = connect(s.fd, res->ai_addr, res->ai_addrlen);
+    freeaddrinfo(res);
+
+    if (rc == 0) s.state = HAL_TCP_CONNECTED;
+    else if (errno == EINPROGRESS) s.state = HAL_TCP_CONNECTING;
+    else s.state = HAL_TCP_FAILED;
+    return (HalTcp)i;
+  }
+  return HAL_TCP_NONE;
+}
+
+uint8_t halTcpState(HalTcp c) {
+  if (c < 0 || c >= HAL_HOST_SOCKETS || sockets[c].fd < 0) return HAL_TCP_FAILED;
+  HostSocket &s = sockets[c];
+
+  if (s.state == HAL_TCP_CONNECTING) {
+    struct pollfd p = {s.fd, POLLOUT, 0};
+    if (poll(&p, 1, 0) > 0) {
+      int err = 0;
+      socklen_t len = sizeof(err);
+      getsockopt(s.fd, SOL_SOCKET, SO_ERROR, &err, &len);
+      s.state = err == 0 ? HAL_TCP_CONNECTED : HAL_TCP_FAILED;
+    }
+  } else if (s.state == HAL_TCP_CONNECTED) {
+    // Peer closed: readable with nothing left to read.
+    char b;
+    const ssize_t n = recv(s.fd, &b, 1, MSG_PEEK | MSG_DONTWAIT);
+    if (n == 0) s.state = HAL_TCP_CLOSED;
+    else if (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK) s.state = HAL_TCP_FAILED;
+  }
+  return s.state;
+}
+
+size_t halTcpWrite(HalTcp c, const void *buf, size_t len) {
+  if (halTcpState(c) != HAL_TCP_CONNECTED) return 0;
+  const ssize_t n = send(sockets[c].fd, buf, len, MSG_DONTWAIT | MSG_NOSIGNAL);
+  return n > 0 ? (size_t)n : 0;
+}
+
+size_t halTcpRead(HalTcp c, void *buf, size_t len) {
+  if (c < 0 || c >= HAL_HOST_SOCKETS || sockets[c].fd < 0) return 0;
+  const ssize_t n = recv(sockets[c].fd, buf, len, MSG_DONTWAIT);
+  return n > 0 ? (size_t)n : 0;
+}
+
+void halTcpClose(HalTcp c) {
+  if (c < 0 || c >= HAL_HOST_SOCKETS || sockets[c].fd < 0) return;
+  close(sockets[c].fd);
+  sockets[c].fd = -1;
+  sockets[c].state = HAL_TCP_FAILED;
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include <stdint.h>
+#include <stdio.h>
+
+/**
+ * @file halHost.h
+ * @brief Control surface of the simulated HAL used by the host build.
+ *
+ * Benchmarks and tools drive the virtual clock, feed ADC/DHT values, steer the
+ * simulated access point and inspect output pins through these functions.
+ */
+
+/// Number of simulated GPIO/ADC pins (covers GPIO0..16 and A0 = 17)
+static const uint8_t HAL_HOST_PINS = 18;
+
+void halHostReset();
+
+void     halHostSetMillis(uint32_t ms);
+void     halHostSetEpoch(uint32_t epochSec);
+void     halHostAdvanceMillis(uint32_t ms);
+void     halHostAdvanceMicros(uint32_t us);
+
+void     halHostSetMem(uint32_t freeHeap, uint32_t maxBlock, uint8_t fragmentPct, uint32_t freeStack);
+
+void     halHostSetAnalog(uint8_t pin, int value);
+int      halHostPinLevel(uint8_t pin);
+uint8_t  halHostPinMode(uint8_t pin);
+uint32_t halHostPinWrites(uint8_t pin);
+uint32_t halHostGpioWrites();
+
+void     halHostSetDht(bool ok, float humidityPct, float tempC);
+void     halHostSetDhtPin(uint8_t pin, bool ok, float humidityPct, float tempC);
+uint32_t halHostDhtFrames();
+
+void     halHostSetWifi(bool up, uint32_t scanMs, uint32_t dhcpMs, uint32_t fastMs);
+void     halHostWifiChannel(uint8_t channel);
+void     halHostWifiDrop();
+uint32_t halHostWifiBegins();
+void     halHostRtcClear();
+
+void        halHostFsRoot(const char *dir);
+const char *halHostFsPath(const char *path);
+
+void        halHostSerialSink(FILE *out);
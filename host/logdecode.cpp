@@ -0,0 +1,61 @@
+/**
+ * @file logdecode.cpp
+ * @brief Turn a captured binary event-log serial stream into text.
+ *
+ * @details Reads the bytes the firmware wrote to Serial with
+ * EVENTLOG_BINARY_SERIAL set (see eventLog.h) and prints each frame with the
+ * same formatter the device uses in text mode. Bytes outside valid frames,
+ * such as boot messages printed before logging starts, are copied unchanged.
+ *
+ * Usage: logdecode [CAPTURE]   (reads stdin without an argument)
+ */
+#include <cstdio>
+#include <vector>
+
+#include "eventLog.h"
+
+/**
+ * @brief Check for a complete, valid frame at @p p.
+ *
+ * @return Frame length, or 0 if @p p does not start one.
+ */
+static size_t frameAt(const uint8_t *p, size_t avail) {
+  if (avail < 3 || p[0] != EVENTLOG_SYNC) return 0;
+  const uint8_t len = p[1];
+  if (len < EVENTLOG_HEADER_BYTES || len > EVENTLOG_RECORD_MAX || avail < (size_t)len + 3) return 0;
+
+  const uint8_t *rec = p + 2;
+  if (rec[4] >= LOG_EVENT_COUNT || len != EVENTLOG_HEADER_BYTES + 4u * rec[5]) return 0;
+  uint8_t x = 0;
+  for (uint8_t i = 0; i < len; i++) x ^= rec[i];
+  return x == rec[len] ? (size_t)len + 3 : 0;
+}
+
+int main(int argc, char **argv) {
+  FILE *in = argc > 1 ? fopen(argv[1], "rb") : stdin;
+  if (!in) {
+    perror(argv[1]);
+    return 1;
+  }
+
+  std::vector<uint8_t> data;
+  uint8_t buf[4096];
+  size_t n;
+  while ((n = fread(buf, 1, sizeof(buf), in)) > 0) data.insert(data.end(), buf, buf + n);
+
+  unsigned frames = 0;
+  char line[160];
+  for (size_t i = 0; i < data.size();) {
+    const size_t len = frameAt(&data[i], data.size() - i);
+    if (len == 0) {
+      putchar(data[i++]);
+      continue;
+    }
+    eventLogFormat(&data[i + 2], len - 3, line, sizeof(line));
+    fputs(line, stdout);
+    frames++;
+    i += len;
+  }
+  fprintf(stderr, "%u frames\n", frames);
+  return 0;
+}
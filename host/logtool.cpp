@@ -0,0 +1,125 @@
+/**
+ * @file logtool.cpp
+ * @brief Drive the persistent data log (dataLog.cpp) against a host directory.
+ *
+ * @details Each invocation is one "boot" of the log on the simulated flash in
+ * DIR, so a sequence of invocations exercises recovery the way resets do:
+ *
+ *   logtool DIR fill N       boot, log N samples DATALOG_SAMPLE_MS apart, reset
+ *   logtool DIR tear BYTES   cut BYTES off the tail segment (a torn write)
+ *   logtool DIR dump [FROM [TO]]  boot and print the range as CSV
+ *   logtool DIR pack [FROM [TO]]  boot and write the range as packed blocks
+ *   logtool DIR stats        boot and print the recovery counters and segments
+ *
+ * "fill" ends without flushing the page buffer, like a power cut.
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <dirent.h>
+#include <unistd.h>
+
+#include "hal.h"
+#include "halHost.h"
+#include "dataLog.h"
+
+static void boot(const char *root) {
+  halHostReset();
+  halHostFsRoot(root);
+  dataLogBegin();
+}
+
+static int fill(uint32_t n) {
+  SharedState state;
+  state.targetTempC[0] = 23.0f;
+  state.targetHumidityPct[0] = 55.0f;
+  for (uint32_t i = 0; i < n; i++) {
+    state.tempC[0] = 20.0f + (i % 50) * 0.1f;
+    state.humidityPct[0] = 50.0f + (i % 20) * 0.5f;
+    state.lampOn[0] = (i / 30) % 2;
+    state.heaterOn[0] = state.tempC[0] < 22.5f;
+    state.lightHoursToday[0] = i * DATALOG_SAMPLE_MS / 3600000.0f;
+    halHostAdvanceMillis(DATALOG_SAMPLE_MS);
+    dataLogAppend(state);
+  }
+  DataLogStats st;
+  dataLogStats(st);
+  printf("appended %u, now %u, segments %u, page writes %u\n", n, dataLogNowSec(), st.segments, st.pageWrites);
+  return 0;
+}
+
+/**
+ * @brief Truncate the newest segment file in DIR/log by @p bytes.
+ */
+static int tear(const char *root, long bytes) {
+  const std::string dir = std::string(root) + "/log";
+  DIR *d = opendir(dir.c_str());
+  if (!d) return 1;
+  std::string newest;
+  while (struct dirent *e = readdir(d)) {
+    if (strstr(e->d_name, ".bin") && e->d_name > newest) newest = e->d_name;
+  }
+  closedir(d);
+  if (newest.empty()) return 1;
+
+  const std::string path = dir + "/" + newest;
+  FILE *f = fopen(path.c_str(), "rb");
+  fseek(f, 0, SEEK_END);
+  const long size = ftell(f);
+  fclose(f);
+  const long keep = size > bytes ? size - bytes : 0;
+  if (truncate(path.c_str(), keep) != 0) return 1;
+  printf("%s: %ld -> %ld bytes\n", newest.c_str(), size, keep);
+  return 0;
+}
+
+static int dump(uint32_t from, uint32_t to) {
+  DataLogCursor c;
+  dataLogSeek(c, from, to);
+  char buf[97]; // odd size so lines get split across calls, as in a chunked response
+  size_t n;
+  while ((n = dataLogReadCsv(c, buf, sizeof(buf))) > 0) fwrite(buf, 1, n, stdout);
+  return 0;
+}
+
+static int pack(uint32_t from, uint32_t to) {
+  DataLogCursor c;
+  dataLogSeek(c, from, to);
+  // Chunk sizes of a TCP window that opens and closes, small ones included
+  static const size_t CHUNKS[] = {1436, 40, 700, 9, 2920, 63};
+  uint8_t buf[2920];
+  size_t n;
+  for (unsigned i = 0; (n = dataLogReadPacked(c, buf, CHUNKS[i % 6])) > 0; i++) fwrite(buf, 1, n, stdout);
+  return 0;
+}
+
+static int stats() {
+  DataLogStats st;
+  dataLogStats(st);
+  printf("segments=%u recovered=%u tornTail=%d now=%u\n", st.segments, st.recovered, st.tornTail ? 1 : 0, dataLogNowSec());
+  return 0;
+}
+
+int main(int argc, char **argv) {
+  if (argc < 3) {
+    fprintf(stderr, "usage: %s DIR fill N | tear BYTES | dump [FROM [TO]] | pack [FROM [TO]] | stats\n", argv[0]);
+    return 2;
+  }
+  const char *root = argv[1];
+  const char *cmd = argv[2];
+
+  if (!strcmp(cmd, "tear") && argc == 4) return tear(root, strtol(argv[3], nullptr, 10));
+
+  boot(root);
+  if (!strcmp(cmd, "fill") && argc == 4) return fill((uint32_t)strtoul(argv[3], nullptr, 10));
+  if (!strcmp(cmd, "dump") || !strcmp(cmd, "pack")) {
+    const uint32_t from = argc > 3 ? (uint32_t)strtoul(argv[3], nullptr, 10) : 0;
+    const uint32_t to = argc > 4 ? (uint32_t)strtoul(argv[4], nullptr, 10) : UINT32_MAX;
+    return !strcmp(cmd, "dump") ? dump(from, to) : pack(from, to);
+  }
+  if (!strcmp(cmd, "stats")) return stats();
+
+  fprintf(stderr, "unknown command %s\n", cmd);
+  return 2;
+}
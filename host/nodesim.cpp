@@ -0,0 +1,430 @@
+/**
+ * @file nodesim.cpp
+ * @brief Stand-in for a fleet of greenhouse nodes, for gateway load tests.
+ *
+ * @details Every simulated node listens on its own port (--port, --port + 1, ...)
+ * and answers at /ws like the firmware's wsServer: JSON text by default, binary
+ * protocol-2 frames after TELEMETRY_PROTO_REQUEST, a snapshot on getReadings,
+ * and batches of T/H/L setpoints with an acknowledgement (wsCommand.h). Each node's readings take
+ * a small random step every --period ms and are sent as a delta frame, with a
+ * keyframe every TELEMETRY_KEYFRAME_EVERY frames. Like the ESP8266, a node
+ * accepts at most --max-clients WebSocket clients.
+ *
+ *   nodesim [--nodes N] [--port P] [--zones Z] [--period MS] [--max-clients C]
+ *           [--seed S] [--stats SEC]
+ */
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <signal.h>
+#include <sys/epoll.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "fleetProto.h"
+#include "wsCommand.h"
+
+/**
+ * @brief One accepted connection, or a node's listening socket (node >= 0, listener).
+ */
+struct SimConn {
+  int fd = -1;
+  int node = -1;
+  bool listener = false;
+  bool upgraded = false;
+  bool binary = false;
+  std::string in;
+  std::string out;      ///< Unsent bytes
+};
+
+struct SimNode {
+  NodeTelemetry tel;
+  uint64_t nextMs = 0;
+  uint8_t framesSinceKey = 0;
+  std::vector<SimConn *> conns;  ///< Upgraded WebSocket clients
+};
+
+static int epfd = -1;
+static std::vector<SimNode> nodes;
+static std::vector<SimConn *> graveyard;
+static uint8_t zones = 1;
+static uint32_t periodMs = 1000;
+static unsigned maxClients = 8;
+static uint64_t framesSent = 0, bytesSent = 0, commands = 0, refused = 0;
+
+static uint64_t nowMs() {
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000 + (uint64_t)ts.tv_nsec / 1000000;
+}
+
+static void arm(SimConn *c, bool write) {
+  epoll_event ev = {};
+  ev.events = EPOLLIN | (write ? (uint32_t)EPOLLOUT : 0u);
+  ev.data.ptr = c;
+  epoll_ctl(epfd, EPOLL_CTL_MOD, c->fd, &ev);
+}
+
+static void closeConn(SimConn *c) {
+  if (c->fd < 0) return;
+  epoll_ctl(epfd, EPOLL_CTL_DEL, c->fd, nullptr);
+  close(c->fd);
+  c->fd = -1;
+  if (c->upgraded) {
+    std::vector<SimConn *> &v = nodes[c->node].conns;
+    for (size_t i = 0; i < v.size(); i++) {
+      if (v[i] == c) {
+        v[i] = v.back();
+        v.pop_back();
+        break;
+      }
+    }
+  }
+  graveyard.push_back(c);
+}
+
+static void flush(SimConn *c) {
+  const bool had = !c->out.empty();
+  while (!c->out.empty()) {
+    const ssize_t n = send(c->fd, c->out.data(), c->out.size(), MSG_NOSIGNAL);
+    if (n < 0) {
+      if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+      closeConn(c);
+      return;
+    }
+    c->out.erase(0, (size_t)n);
+  }
+  if (had || !c->out.empty()) arm(c, !c->out.empty());
+}
+
+static void sendFrame(SimConn *c, uint8_t opcode, const void *data, size_t len) {
+  if (c->fd < 0) return;
+  wsAppendFrame(c->out, opcode, data, len, false);
+  framesSent++;
+  bytesSent += len;
+  flush(c);
+}
+
+// ---------------------------------------------------------------- node model
+
+static int16_t clampDeci(long v, long lo, long hi) {
+  return (int16_t)(v < lo ? lo : v > hi ? hi : v);
+}
+
+static void initNode(SimNode &n, size_t index) {
+  n.tel.valid = true;
+  n.tel.zones = zones;
+  for (uint8_t z = 0; z < zones; z++) {
+    int16_t *v = n.tel.v[z];
+    v[0] = (int16_t)(200 + rand() % 60);
+    v[1] = (int16_t)(500 + rand() % 200);
+    v[2] = 0;
+    v[3] = 230;
+    v[4] = 550;
+    v[5] = 120;
+  }
+  // Spread the nodes over one period so their frames do not arrive in bursts.
+  n.nextMs = nowMs() + (index * 7919) % (periodMs ? periodMs : 1);
+}
+
+/**
+ * @brief Move the readings one step, as the DHT would (whole degrees and percent).
+ *
+ * @param masks Set to the fields that changed, per zone.
+ */
+static void stepNode(SimNode &n, uint8_t masks[ZONE_MAX]) {
+  for (uint8_t z = 0; z < ZONE_MAX; z++) masks[z] = 0;
+  for (uint8_t z = 0; z < n.tel.zones; z++) {
+    int16_t *v = n.tel.v[z];
+    if (rand() % 3 == 0) {
+      const int16_t t = clampDeci(v[0] + (v[0] < v[3] ? 10 : -10) * (rand() % 2), -100, 500);
+      if (t != v[0]) masks[z] |= 0x01;
+      v[0] = t;
+    }
+    if (rand() % 3 == 0) {
+      const int16_t h = clampDeci(v[1] + (rand() % 3 - 1) * 10, 0, 1000);
+      if (h != v[1]) masks[z] |= 0x02;
+      v[1] = h;
+    }
+    const int16_t status = (int16_t)((v[0] < v[3] ? 0x02 : 0) | (v[1] < v[4] ? 0x04 : 0) | (rand() % 2 ? 0x01 : 0));
+    if (status != v[2]) masks[z] |= 0x04;
+    v[2] = status;
+  }
+}
+
+/**
+ * @brief Send the next frame (delta or periodic keyframe) to every client of @p n.
+ */
+static void publish(SimNode &n, uint8_t masks[ZONE_MAX]) {
+  bool changed = false;
+  for (uint8_t z = 0; z < ZONE_MAX; z++) changed |= masks[z] != 0;
+  if (!changed) return;
+
+  const bool key = n.framesSinceKey + 1 >= TELEMETRY_KEYFRAME_EVERY;
+  if (key) {
+    for (uint8_t z = 0; z < ZONE_MAX; z++) masks[z] = (uint8_t)((1 << TELEMETRY_FIELDS) - 1);
+  }
+  n.tel.seq++;
+  n.framesSinceKey = key ? 0 : n.framesSinceKey + 1;
+
+  uint8_t frame[TELEMETRY_FRAME_MAX];
+  const size_t len = fleetEncodeFrame(n.tel, key ? TELEMETRY_FLAG_KEYFRAME : 0, masks, frame);
+  std::string json;
+  for (size_t i = n.conns.size(); i-- > 0;) {
+    SimConn *c = n.conns[i];
+    if (c->binary) {
+      sendFrame(c, WS_OP_BINARY, frame, len);
+    } else {
+      if (json.empty()) json = fleetJson(n.tel);
+      sendFrame(c, WS_OP_TEXT, json.data(), json.size());
+    }
+  }
+}
+
+static void sendSnapshot(SimConn *c) {
+  const SimNode &n = nodes[c->node];
+  if (c->binary) {
+    uint8_t frame[TELEMETRY_FRAME_MAX];
+    sendFrame(c, WS_OP_BINARY, frame, fleetEncodeKeyframe(n.tel, frame));
+  } else {
+    const std::string json = fleetJson(n.tel);
+    sendFrame(c, WS_OP_TEXT, json.data(), json.size());
+  }
+}
+
+/**
+ * @brief Apply the setpoints of @p batch like the firmware's wsCommandApply().
+ */
+static void applySetpoints(SimNode &n, WsCommandBatch &batch) {
+  uint8_t masks[ZONE_MAX] = {0};
+  for (uint8_t i = 0; i < batch.count; i++) {
+    WsCommand &cmd = batch.cmds[i];
+    if (cmd.kind > WS_CMD_LIGHT) continue;
+    if (cmd.zone >= n.tel.zones) {
+      batch.rejected++;
+      continue;
+    }
+    cmd.value = wsCommandClamp(cmd.kind, cmd.value);
+    const uint8_t field = (uint8_t)(3 + cmd.kind); // tempTarget, humiTarget, lightTarget
+    n.tel.v[cmd.zone][field] = (int16_t)lroundf(cmd.value * 10.0f);
+    masks[cmd.zone] |= (uint8_t)(1 << field);
+    cmd.applied = true;
+    commands++;
+  }
+  publish(n, masks);
+}
+
+// ---------------------------------------------------------------- connections
+
+static void onMessage(SimConn *c, const WsFrame &f) {
+  if (f.opcode == WS_OP_PING) {
+    sendFrame(c, WS_OP_PONG, f.payload.data(), f.payload.size());
+    return;
+  }
+  if (f.opcode == WS_OP_CLOSE) {
+    closeConn(c);
+    return;
+  }
+  if (f.opcode != WS_OP_TEXT) return;
+
+  WsCommandBatch batch;
+  wsCommandParse((const uint8_t *)f.payload.data(), f.payload.size(), batch);
+  applySetpoints(nodes[c->node], batch);
+  for (uint8_t i = 0; i < batch.count; i++) {
+    if (batch.cmds[i].kind == WS_CMD_PROTO) c->binary = true;
+    if (batch.cmds[i].kind == WS_CMD_PROTO || batch.cmds[i].kind == WS_CMD_READINGS) sendSnapshot(c);
+  }
+  if (wsCommandNeedsAck(batch)) {
+    char ack[WS_ACK_MAX];
+    sendFrame(c, WS_OP_TEXT, ack, wsCommandAck(batch, ack, sizeof(ack)));
+  }
+}
+
+static void upgrade(SimConn *c, const std::string &head) {
+  const std::string key = httpHeader(head, "Sec-WebSocket-Key");
+  SimNode &n = nodes[c->node];
+  if (head.compare(0, 7, "GET /ws") != 0 || key.empty() || n.conns.size() >= maxClients) {
+    refused++;
+    const char *resp = "HTTP/1.1 503 Service Unavailable\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+    send(c->fd, resp, strlen(resp), MSG_NOSIGNAL);
+    closeConn(c);
+    return;
+  }
+  c->out += "HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\nConnection: Upgrade\r\nSec-WebSocket-Accept: " +
+            wsAcceptKey(key) + "\r\n\r\n";
+  c->upgraded = true;
+  n.conns.push_back(c);
+  flush(c);
+}
+
+static void onReadable(SimConn *c) {
+  char buf[8192];
+  for (;;) {
+    const ssize_t r = recv(c->fd, buf, sizeof(buf), 0);
+    if (r > 0) {
+      c->in.append(buf, (size_t)r);
+      continue;
+    }
+    if (r < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+    closeConn(c);
+    return;
+  }
+
+  if (!c->upgraded) {
+    const size_t end = httpHeaderEnd(c->in);
+    if (end == 0) return;
+    const std::string head = c->in.substr(0, end);
+    c->in.erase(0, end);
+    upgrade(c, head);
+    if (c->fd < 0) return;
+  }
+
+  size_t off = 0;
+  while (c->fd >= 0) {
+    WsFrame f;
+    const long used = wsParseFrame(c->in, off, f);
+    if (used < 0) {
+      closeConn(c);
+      return;
+    }
+    if (used == 0) break;
+    off += (size_t)used;
+    onMessage(c, f);
+  }
+  if (c->fd >= 0) c->in.erase(0, off);
+}
+
+static void onAccept(SimConn *l) {
+  for (;;) {
+    const int fd = accept4(l->fd, nullptr, nullptr, SOCK_NONBLOCK);
+    if (fd < 0) return;
+    const int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    SimConn *c = new SimConn;
+    c->fd = fd;
+    c->node = l->node;
+    epoll_event ev = {};
+    ev.events = EPOLLIN;
+    ev.data.ptr = c;
+    epoll_ctl(epfd, EPOLL_CTL_ADD, fd, &ev);
+  }
+}
+
+static void usage(const char *argv0) {
+  fprintf(stderr, "usage: %s [--nodes N] [--port P] [--zones Z] [--period MS] [--max-clients C] "
+          "[--seed S] [--stats SEC]\n", argv0);
+}
+
+int main(int argc, char **argv) {
+  unsigned count = 10, basePort = 9000, seed = 1, statsSec = 10;
+
+  for (int i = 1; i < argc; i++) {
+    const char *opt = argv[i];
+    const char *val = i + 1 < argc ? argv[++i] : nullptr;
+    if (!val) {
+      usage(argv[0]);
+      return 2;
+    }
+    const unsigned v = (unsigned)strtoul(val, nullptr, 10);
+    if (!strcmp(opt, "--nodes")) count = v;
+    else if (!strcmp(opt, "--port")) basePort = v;
+    else if (!strcmp(opt, "--zones")) zones = (uint8_t)(v < 1 ? 1 : v > ZONE_MAX ? ZONE_MAX : v);
+    else if (!strcmp(opt, "--period")) periodMs = v;
+    else if (!strcmp(opt, "--max-clients")) maxClients = v;
+    else if (!strcmp(opt, "--seed")) seed = v;
+    else if (!strcmp(opt, "--stats")) statsSec = v;
+    else {
+      fprintf(stderr, "unknown option %s\n", opt);
+      usage(argv[0]);
+      return 2;
+    }
+  }
+  if (count == 0 || basePort + count > 65536 || periodMs == 0) {
+    fprintf(stderr, "nodesim: bad --nodes/--port/--period\n");
+    return 2;
+  }
+  signal(SIGPIPE, SIG_IGN);
+  srand(seed);
+
+  rlimit lim;
+  if (getrlimit(RLIMIT_NOFILE, &lim) == 0 && lim.rlim_cur < lim.rlim_max) {
+    lim.rlim_cur = lim.rlim_max;
+    setrlimit(RLIMIT_NOFILE, &lim);
+  }
+
+  epfd = epoll_create1(0);
+  nodes.resize(count);
+  for (unsigned i = 0; i < count; i++) {
+    initNode(nodes[i], i);
+    const int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+    const int one = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons((uint16_t)(basePort + i));
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (fd < 0 || bind(fd, (sockaddr *)&addr, sizeof(addr)) != 0 || listen(fd, 16) != 0) {
+      perror("nodesim");
+      return 1;
+    }
+    SimConn *l = new SimConn;
+    l->fd = fd;
+    l->node = (int)i;
+    l->listener = true;
+    epoll_event ev = {};
+    ev.events = EPOLLIN;
+    ev.data.ptr = l;
+    epoll_ctl(epfd, EPOLL_CTL_ADD, fd, &ev);
+  }
+  fprintf(stderr, "nodesim: %u nodes on 127.0.0.1:%u..%u, %u zones, a frame every %u ms\n", count, basePort,
+          basePort + count - 1, zones, periodMs);
+
+  uint64_t lastStats = nowMs();
+  epoll_event events[256];
+  for (;;) {
+    const int n = epoll_wait(epfd, events, 256, 5);
+    for (int i = 0; i < n; i++) {
+      SimConn *c = (SimConn *)events[i].data.ptr;
+      if (c->fd < 0) continue;
+      if (c->listener) {
+        onAccept(c);
+        continue;
+      }
+      if (events[i].events & (EPOLLIN | EPOLLERR | EPOLLHUP)) onReadable(c);
+      if (c->fd >= 0 && (events[i].events & EPOLLOUT)) flush(c);
+    }
+    for (SimConn *c : graveyard) delete c;
+    graveyard.clear();
+
+    const uint64_t now = nowMs();
+    for (SimNode &node : nodes) {
+      if (now < node.nextMs) continue;
+      node.nextMs += periodMs;
+      if (node.nextMs <= now) node.nextMs = now + periodMs;
+      uint8_t masks[ZONE_MAX];
+      stepNode(node, masks);
+      publish(node, masks);
+    }
+
+    if (statsSec && now - lastStats >= statsSec * 1000ULL) {
+      size_t clients = 0;
+      for (const SimNode &node : nodes) clients += node.conns.size();
+      const double s = (now - lastStats) / 1000.0;
+      fprintf(stderr, "nodesim: %zu clients, %.0f frames/s, %.0f payload bytes/s, %llu commands, %llu refused\n",
+              clients, framesSent / s, bytesSent / s, (unsigned long long)commands, (unsigned long long)refused);
+      framesSent = bytesSent = 0;
+      lastStats = now;
+    }
+  }
+}
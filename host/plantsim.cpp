@@ -0,0 +1,352 @@
+/**
+ * @file plantsim.cpp
+ * @brief Faster-than-real-time greenhouse simulator around the real controllers.
+ *
+ * @details A small physical model of the greenhouse (air temperature, relative
+ * humidity, daylight with clouds) is coupled to the unmodified dht11Read(),
+ * lightUpdate() and climateControlUpdate() through the simulated HAL: the model
+ * feeds the DHT frames and the LDR input, and reads the heater, mister and lamp
+ * back from the shared state. The sketch's task set runs on the real scheduler,
+ * whose idling advances the virtual clock, so a simulated month takes seconds.
+ *
+ * The model is deterministic for a given --seed. At the end it prints actuator
+ * switch counts and duty, the share of time the air was outside the target
+ * bands, and the daily light-hour error. The --max-* options turn the report
+ * into a regression gate: the exit status is 1 if any limit is exceeded.
+ *
+ * Usage: plantsim [--days N] [--seed S] [--temp C] [--hum PCT] [--light H]
+ *                 [--temp-band C] [--hum-band PCT] [--day-length H] [--spikes PCT]
+ *                 [--max-temp-out PCT] [--max-hum-out PCT]
+ *                 [--max-switches N] [--max-light-error H] [--metrics FILE]
+ *                 [--datalog DIR]
+ *
+ * --max-switches limits the switches per day of each actuator. --spikes replaces
+ * that share of DHT frames and LDR samples with glitches (sensor noise).
+ * --metrics writes the /metrics page the sketch would serve (real host timings
+ * of the profiled stages) to FILE, or to stdout for "-". --datalog runs the
+ * data log task on the simulated flash in DIR, for "logtool DIR dump" to
+ * export as a realistic trace afterwards.
+ */
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "hal.h"
+#include "halHost.h"
+#include "scheduler.h"
+#include "climateControl.h"
+#include "heater.h"
+#include "mister.h"
+#include "actuators.h"
+#include "Lightsensor.h"
+#include "dht11Sensor.h"
+#include "adcSampler.h"
+#include "profiler.h"
+#include "dataLog.h"
+#include "dataflow.h"
+
+/// Model step (the plant task period)
+static const uint32_t PLANT_STEP_MS = 100;
+static const uint32_t DAY_SEC = 86400;
+
+/// @name Greenhouse model
+///@{
+static const double TEMP_LOSS_TAU_S   = 1800.0;  ///< Time constant towards the outside temperature
+static const double HEATER_C_PER_S    = 0.010;   ///< Heating rate at full power
+static const double SOLAR_C_PER_S     = 0.002;   ///< Heating by full sunlight
+static const double OUTSIDE_MEAN_C    = 15.0;
+static const double OUTSIDE_SWING_C   = 6.0;     ///< Half the daily outside range, warmest at 15:00
+static const double HUM_LOSS_TAU_S    = 1200.0;  ///< Time constant towards the outside humidity
+static const double MISTER_PCT_PER_S  = 0.12;
+static const double HEATER_DRY_PCT_PER_S = 0.004; ///< Heated air dries out
+static const double OUTSIDE_HUM_MEAN  = 50.0;
+static const double OUTSIDE_HUM_SWING = 12.0;    ///< Most humid at dawn
+static const double USEFUL_LIGHT      = 0.3;     ///< Irradiance the plants count as light
+///@}
+
+struct Options {
+  unsigned days = 30;
+  unsigned seed = 1;
+  double targetTemp = 23.0;
+  double targetHum = 55.0;
+  double targetLight = 12.0;
+  double tempBand = 1.0;
+  double humBand = 5.0;
+  double dayLength = 12.0;
+  double spikes = 0;   ///< Share of sensor samples (%) replaced by a glitch
+  double maxTempOut = -1, maxHumOut = -1, maxSwitches = -1, maxLightError = -1;
+  const char *metrics = nullptr;
+  const char *datalog = nullptr;
+};
+
+struct Actuator {
+  const char *name;
+  bool last = false;
+  uint32_t switches = 0;
+  uint64_t onMs = 0;
+};
+
+static Options opt;
+static SharedState state;
+static int8_t dhtTask = -1, controlTask = -1;
+
+/// Model state
+static double airTemp = 18.0;
+static double airHum = 50.0;
+static double irradiance = 0.0;
+static double cloud = 1.0;       ///< Share of sunlight getting through
+static double cloudTarget = 1.0;
+static uint32_t lastPlantMs = 0;
+static uint32_t rng = 1;
+
+/// Results
+static Actuator heater = {"heater"}, mister = {"mister"}, lamp = {"lamp"};
+static uint64_t tempOutMs = 0, humOutMs = 0, simMs = 0;
+static double tempMin = 1e9, tempMax = -1e9, humMin = 1e9, humMax = -1e9;
+static double actualLightMs = 0;
+static double lightErrSum = 0, lightErrMax = 0, actualLightSum = 0;
+static uint32_t lightDays = 0;
+static float lastLightHours = 0;
+
+static double uniform() {
+  rng = rng * 1664525u + 1013904223u;
+  return (rng >> 8) / 16777216.0;
+}
+
+static void track(Actuator &a, bool on, uint32_t dtMs) {
+  if (on != a.last) a.switches++;
+  a.last = on;
+  if (on) a.onMs += dtMs;
+}
+
+/**
+ * @brief Advance the model to the current time and feed the sensors.
+ */
+static void plantStep() {
+  const uint32_t now = halMillis();
+  const uint32_t dtMs = now - lastPlantMs;
+  lastPlantMs = now;
+  const double dt = dtMs / 1000.0;
+  const double daySec = fmod(now / 1000.0, DAY_SEC);
+  const double hour = daySec / 3600.0;
+
+  // Sun: half a sine between sunrise and sunset, clouds drift between targets
+  const double sunrise = 12.0 - opt.dayLength / 2, sunset = 12.0 + opt.dayLength / 2;
+  const double sun = (hour > sunrise && hour < sunset) ? sin(M_PI * (hour - sunrise) / opt.dayLength) : 0.0;
+  if (uniform() < dt / 900.0) cloudTarget = uniform() < 0.5 ? 1.0 : 0.2 + 0.5 * uniform();
+  cloud += (cloudTarget - cloud) * (dt / 120.0 < 1 ? dt / 120.0 : 1);
+  irradiance = sun * cloud;
+
+  const double outTemp = OUTSIDE_MEAN_C + OUTSIDE_SWING_C * cos(2 * M_PI * (hour - 15.0) / 24.0);
+  const double outHum = OUTSIDE_HUM_MEAN + OUTSIDE_HUM_SWING * cos(2 * M_PI * (hour - 5.0) / 24.0);
+
+  airTemp += dt * ((outTemp - airTemp) / TEMP_LOSS_TAU_S + (state.heaterOn[0] ? HEATER_C_PER_S : 0) +
+                   SOLAR_C_PER_S * irradiance);
+  airHum += dt * ((outHum - airHum) / HUM_LOSS_TAU_S + (state.misterOn[0] ? MISTER_PCT_PER_S : 0) -
+                  (state.heaterOn[0] ? HEATER_DRY_PCT_PER_S : 0));
+  if (airHum < 0) airHum = 0;
+  if (airHum > 100) airHum = 100;
+
+  // The DHT11 resolves whole degrees and percent. With --spikes, some samples are
+  // replaced by a glitch (a frame that passes the checksum, a spike on the LDR).
+  double dhtHum = lround(airHum), dhtTemp = lround(airTemp);
+  int ldr = (int)lround(1023 * irradiance);
+  if (uniform() * 100 < opt.spikes) {
+    dhtTemp += (uniform() < 0.5 ? -1 : 1) * lround(5 + 20 * uniform());
+    dhtHum = lround(100 * uniform());
+  }
+  if (uniform() * 100 < opt.spikes) ldr = uniform() < 0.5 ? 0 : 1023;
+  halHostSetDht(true, (float)dhtHum, (float)dhtTemp);
+  halHostSetAnalog(A0, ldr);
+
+  // Statistics for the interval that just ended
+  simMs += dtMs;
+  track(heater, state.heaterOn[0], dtMs);
+  track(mister, state.misterOn[0], dtMs);
+  track(lamp, state.lampOn[0], dtMs);
+  if (fabs(airTemp - opt.targetTemp) > opt.tempBand) tempOutMs += dtMs;
+  if (fabs(airHum - opt.targetHum) > opt.humBand) humOutMs += dtMs;
+  if (airTemp < tempMin) tempMin = airTemp;
+  if (airTemp > tempMax) tempMax = airTemp;
+  if (airHum < humMin) humMin = airHum;
+  if (airHum > humMax) humMax = airHum;
+  if (irradiance >= USEFUL_LIGHT || state.lampOn[0]) actualLightMs += dtMs;
+}
+
+/**
+ * @brief Close a day when lightUpdate() reset its counter.
+ */
+static void lightTask() {
+  const uint32_t t = profStart();
+  lightUpdate(state);
+  profEnd(PROF_LIGHT, t);
+  if (state.lightHoursToday[0] < lastLightHours) {
+    const double err = lastLightHours - opt.targetLight;
+    lightErrSum += fabs(err);
+    if (fabs(err) > lightErrMax) lightErrMax = fabs(err);
+    actualLightSum += actualLightMs / 3600000.0;
+    actualLightMs = 0;
+    lightDays++;
+  }
+  lastLightHours = state.lightHoursToday[0];
+}
+
+static void dhtTaskRun() {
+  const uint32_t t = profStart();
+  const uint32_t nextMs = dht11Read(state);
+  profEnd(PROF_DHT, t);
+  schedulerWake(dhtTask, nextMs);
+}
+
+static void controlTaskRun() {
+  const uint32_t t = profStart();
+  const uint32_t nextMs = climateControlUpdate(state);
+  profEnd(PROF_CONTROL, t);
+  if (nextMs != CLIMATE_CONTROL_IDLE) schedulerWake(controlTask, nextMs);
+}
+
+static bool parseArgs(int argc, char **argv) {
+  for (int i = 1; i + 1 < argc; i += 2) {
+    const char *k = argv[i];
+    if (!strcmp(k, "--metrics")) {
+      opt.metrics = argv[i + 1];
+      continue;
+    }
+    if (!strcmp(k, "--datalog")) {
+      opt.datalog = argv[i + 1];
+      continue;
+    }
+    const double v = atof(argv[i + 1]);
+    if (!strcmp(k, "--days")) opt.days = (unsigned)v;
+    else if (!strcmp(k, "--seed")) opt.seed = (unsigned)v;
+    else if (!strcmp(k, "--temp")) opt.targetTemp = v;
+    else if (!strcmp(k, "--hum")) opt.targetHum = v;
+    else if (!strcmp(k, "--light")) opt.targetLight = v;
+    else if (!strcmp(k, "--temp-band")) opt.tempBand = v;
+    else if (!strcmp(k, "--hum-band")) opt.humBand = v;
+    else if (!strcmp(k, "--day-length")) opt.dayLength = v;
+    else if (!strcmp(k, "--spikes")) opt.spikes = v;
+    else if (!strcmp(k, "--max-temp-out")) opt.maxTempOut = v;
+    else if (!strcmp(k, "--max-hum-out")) opt.maxHumOut = v;
+    else if (!strcmp(k, "--max-switches")) opt.maxSwitches = v;
+    else if (!strcmp(k, "--max-light-error")) opt.maxLightError = v;
+    else return false;
+  }
+  return (argc % 2) == 1 && opt.days > 0 && opt.days <= 45 && opt.dayLength > 0 && opt.dayLength < 24;
+}
+
+static bool gate(const char *what, double value, double limit) {
+  if (limit < 0 || value <= limit) return true;
+  printf("GATE FAIL: %s %.3f > %.3f\n", what, value, limit);
+  return false;
+}
+
+int main(int argc, char **argv) {
+  if (!parseArgs(argc, argv)) {
+    fprintf(stderr,
+            "usage: %s [--days N (1..45)] [--seed S] [--temp C] [--hum PCT] [--light H]\n"
+            "          [--temp-band C] [--hum-band PCT] [--day-length H]\n"
+            "          [--max-temp-out PCT] [--max-hum-out PCT] [--max-switches N] [--max-light-error H]\n"
+            "          [--metrics FILE] [--datalog DIR]\n",
+            argv[0]);
+    return 2;
+  }
+  rng = opt.seed;
+  airTemp = opt.targetTemp;
+  airHum = opt.targetHum;
+
+  // Boot as setup() does; the simulated clock starts at midnight.
+  halHostReset();
+  dht11Begin();
+  actuatorsBegin();
+  lightInit();
+  heaterBegin();
+  misterInit();
+  climateControlBegin();
+  profBegin();
+  state.targetTempC[0] = (float)opt.targetTemp;
+  state.targetHumidityPct[0] = (float)opt.targetHum;
+  state.targetLightHoursToday[0] = (float)opt.targetLight;
+  stateChanged(state);
+  lastPlantMs = halMillis();
+  plantStep();
+
+  schedulerBegin();
+  flowBegin();
+  schedulerAdd("plant", plantStep, PLANT_STEP_MS, SCHED_PRIO_HIGH);
+  dhtTask = schedulerAdd("dht", dhtTaskRun, 0, SCHED_PRIO_HIGH, 1);
+  schedulerAdd("light", lightTask, LIGHT_SAMPLE_MS, SCHED_PRIO_HIGH);
+  controlTask = schedulerAdd("control", controlTaskRun, 0, SCHED_PRIO_HIGH, 1);
+  flowSubscribe(controlTask, FLOW_BIT(FLOW_READINGS) | FLOW_BIT(FLOW_TARGETS));
+  schedulerAdd("metrics", profSample, PROF_SAMPLE_MS, SCHED_PRIO_LOW, PROF_SAMPLE_MS);
+  if (opt.datalog) {
+    halHostFsRoot(opt.datalog);
+    dataLogBegin();
+    schedulerAdd("datalog", []() { dataLogAppend(state); }, DATALOG_SAMPLE_MS, SCHED_PRIO_LOW);
+  }
+
+  const uint32_t start = halMillis();
+  const uint32_t runMs = opt.days * DAY_SEC * 1000u + 2 * LIGHT_SAMPLE_MS; // + the last day's reset
+  while ((uint32_t)(halMillis() - start) < runMs) {
+    profLoop();
+    schedulerRun();
+  }
+
+  const double days = simMs / 86400000.0;
+  printf("simulated %.2f days, targets %.1f C, %.1f %%, %.1f h light\n", days, opt.targetTemp, opt.targetHum,
+         opt.targetLight);
+  double maxPerDay = 0;
+  for (const Actuator *a : {&heater, &mister, &lamp}) {
+    printf("%-7s %8u switches (%7.1f/day), on %5.1f %%\n", a->name, a->switches, a->switches / days,
+           100.0 * a->onMs / simMs);
+    if (a->switches / days > maxPerDay) maxPerDay = a->switches / days;
+  }
+  const double tempOut = 100.0 * tempOutMs / simMs, humOut = 100.0 * humOutMs / simMs;
+  printf("temp     %.2f .. %.2f C, outside +-%.1f C for %.2f %% of the time\n", tempMin, tempMax, opt.tempBand, tempOut);
+  printf("humidity %.2f .. %.2f %%, outside +-%.1f %% for %.2f %% of the time\n", humMin, humMax, opt.humBand, humOut);
+  const double lightErrMean = lightDays ? lightErrSum / lightDays : 0;
+  printf("light    %u days: counted hours off target by %.3f h mean, %.3f h max; actual light %.2f h/day\n",
+         lightDays, lightErrMean, lightErrMax, lightDays ? actualLightSum / lightDays : 0.0);
+  // The actuator layer counts committed pin changes; they must match what the model saw
+  bool countsAgree = true;
+  printf("gpio    ");
+  for (uint8_t k = 0; k < ACT_KINDS; k++) {
+    const Actuator *a = k == ACT_HEATER ? &heater : k == ACT_MISTER ? &mister : &lamp;
+    ActuatorStats st;
+    actuatorStats(0, k, st);
+    printf(" %s %u,", actuatorName(k), st.switches);
+    countsAgree &= st.switches == a->switches;
+  }
+  printf(" switches in %u register writes\n", halHostGpioWrites());
+  TaskStats control;
+  schedulerStats(controlTask, control);
+  printf("control  %u runs (%.0f/day), woken by %u readings and timers\n", control.runs, control.runs / days,
+         flowVersion(FLOW_READINGS));
+  AdcSamplerStats adc;
+  adcSamplerStats(adc);
+  printf("ldr      %u readings, %u averages, %u lost, %u overruns\n", adc.samples, adc.averages, adc.lost, adc.overruns);
+
+  if (opt.metrics) {
+    FILE *out = strcmp(opt.metrics, "-") ? fopen(opt.metrics, "w") : stdout;
+    if (!out) {
+      perror(opt.metrics);
+      return 2;
+    }
+    ProfCursor cursor;
+    profMetricsBegin(cursor);
+    char chunk[512];
+    while (size_t n = profMetricsRead(cursor, chunk, sizeof(chunk))) fwrite(chunk, 1, n, out);
+    if (out != stdout) fclose(out);
+  }
+
+  bool ok = gate("time outside temperature band (%)", tempOut, opt.maxTempOut);
+  ok &= gate("time outside humidity band (%)", humOut, opt.maxHumOut);
+  ok &= gate("switches per day", maxPerDay, opt.maxSwitches);
+  ok &= gate("light-hour error (h)", lightErrMax, opt.maxLightError);
+  if (!countsAgree) {
+    printf("GATE FAIL: actuator switch counts differ from the model's\n");
+    ok = false;
+  }
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,56 @@
+#pragma once
+/**
+ * @file Arduino.h
+ * @brief Host stand-in for the parts of the ESP8266 Arduino core the modules use.
+ *
+ * Only types, pin names and String are provided here. Clock, GPIO and ADC access
+ * must go through hal.h, so a module that still calls millis() or digitalWrite()
+ * directly fails to link in the host build.
+ */
+#include <stdint.h>
+#include <stddef.h>
+#include <math.h>
+#include <string.h>
+#include <string>
+
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT        0x00
+#define INPUT_PULLUP 0x02
+#define OUTPUT       0x01
+
+#define PROGMEM
+#define IRAM_ATTR
+
+// NodeMCU pin names -> ESP8266 GPIO numbers
+static const uint8_t D0 = 16;
+static const uint8_t D1 = 5;
+static const uint8_t D2 = 4;
+static const uint8_t D3 = 0;
+static const uint8_t D4 = 2;
+static const uint8_t D5 = 14;
+static const uint8_t D6 = 12;
+static const uint8_t D7 = 13;
+static const uint8_t D8 = 15;
+static const uint8_t A0 = 17;
+
+/**
+ * @brief Minimal Arduino String backed by std::string.
+ *
+ * Allocation behaviour is close enough to WString for the benchmarks: one heap
+ * buffer per non-trivial string.
+ */
+class String {
+public:
+  String() {}
+  String(const char *s) : s_(s ? s : "") {}
+  String(const std::string &s) : s_(s) {}
+
+  const char *c_str() const { return s_.c_str(); }
+  unsigned int length() const { return (unsigned int)s_.size(); }
+  bool operator==(const String &o) const { return s_ == o.s_; }
+
+private:
+  std::string s_;
+};
@@ -0,0 +1,146 @@
+/**
+ * @file statestress.cpp
+ * @brief Check the stateSync guarantees with truly parallel threads.
+ *
+ * @details On the ESP8266 the network callbacks and loop() take turns, so a
+ * torn read cannot happen there; this runs the same code on several cores:
+ *
+ *  - a "loop" thread owns SharedState: it applies the queued command frames
+ *    (wsCommandApply()), rewrites every reading of every zone to one common
+ *    value, and publishes a snapshot after each step;
+ *  - a "network" thread posts frames that set all three targets of every zone
+ *    to one common value ("#n;T:v;H:v;L:v;T1:v;...");
+ *  - reader threads take snapshots with stateSyncRead().
+ *
+ * A consistent snapshot has all readings equal, all targets equal and a
+ * generation that never goes backwards. With --unprotected the readers copy
+ * the live SharedState instead (a deliberate data race), to show the torn
+ * reads the seqlock prevents.
+ *
+ *   statestress [--seconds S] [--readers N] [--unprotected]   exit status 1 on any torn snapshot
+ */
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "stateSync.h"
+#include "wsCommand.h"
+
+static SharedState live;
+static std::atomic<bool> running(true);
+static bool unprotected = false;
+
+static std::atomic<uint64_t> reads(0), retries(0), torn(0), posted(0), refused(0), applied(0);
+
+/**
+ * @brief The loop() side: apply commands, write readings, publish.
+ */
+static void loopThread() {
+  live.zoneCount = ZONE_MAX;
+  float reading = 0.0f;
+  while (running.load(std::memory_order_relaxed)) {
+    StateCommand cmd;
+    while (stateSyncTake(cmd)) applied += wsCommandApply(cmd.batch, live);
+
+    // One multi-field update: every reading of every zone gets the same value
+    reading = reading >= 1000.0f ? 0.0f : reading + 1.0f;
+    for (uint8_t z = 0; z < live.zoneCount; z++) {
+      live.tempC[z] = reading;
+      live.humidityPct[z] = reading;
+      live.lightHoursToday[z] = reading;
+    }
+    stateChanged(live);
+    stateSyncPublish(live);
+  }
+}
+
+/**
+ * @brief The network side: post frames that set every target of every zone at once.
+ */
+static void networkThread() {
+  uint32_t seq = 0;
+  char text[WS_MESSAGE_MAX];
+  while (running.load(std::memory_order_relaxed)) {
+    const unsigned v = seq % 24; // inside every setpoint range, so nothing is clamped
+    int n = snprintf(text, sizeof(text), "#%u", (unsigned)seq);
+    for (uint8_t z = 0; z < ZONE_MAX; z++) n += snprintf(text + n, sizeof(text) - n, ";T%u:%u;H%u:%u;L%u:%u", z, v, z, v, z, v);
+    StateCommand cmd;
+    cmd.client = 0;
+    wsCommandParse((const uint8_t *)text, (size_t)n, cmd.batch);
+    if (stateSyncPost(cmd)) {
+      posted++;
+      seq++;
+    } else {
+      refused++;
+      std::this_thread::yield();
+    }
+  }
+}
+
+static bool consistent(const SharedState &s) {
+  for (uint8_t z = 0; z < ZONE_MAX; z++) {
+    if (s.tempC[z] != s.tempC[0] || s.humidityPct[z] != s.tempC[0] || s.lightHoursToday[z] != s.tempC[0]) return false;
+    if (s.targetTempC[z] != s.targetTempC[0] || s.targetHumidityPct[z] != s.targetTempC[0] ||
+        s.targetLightHoursToday[z] != s.targetTempC[0]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static void readerThread() {
+  SharedState view;
+  uint32_t lastGeneration = 0;
+  uint64_t myReads = 0, myRetries = 0, myTorn = 0;
+  while (running.load(std::memory_order_relaxed)) {
+    if (unprotected) memcpy((void *)&view, (const void *)&live, sizeof(view)); // racy on purpose
+    else myRetries += stateSyncRead(view);
+    myReads++;
+    if (!consistent(view) || (int32_t)(view.generation - lastGeneration) < 0) myTorn++;
+    lastGeneration = view.generation;
+  }
+  reads += myReads;
+  retries += myRetries;
+  torn += myTorn;
+}
+
+int main(int argc, char **argv) {
+  double seconds = 2.0;
+  unsigned readers = 3;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--seconds") && i + 1 < argc) seconds = atof(argv[++i]);
+    else if (!strcmp(argv[i], "--readers") && i + 1 < argc) readers = (unsigned)atoi(argv[++i]);
+    else if (!strcmp(argv[i], "--unprotected")) unprotected = true;
+    else {
+      fprintf(stderr, "usage: %s [--seconds S] [--readers N] [--unprotected]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  // Start from a consistent state: equal readings and targets in every zone
+  live.zoneCount = ZONE_MAX;
+  for (uint8_t z = 0; z < ZONE_MAX; z++) {
+    live.tempC[z] = live.humidityPct[z] = live.lightHoursToday[z] = 0.0f;
+    live.targetTempC[z] = live.targetHumidityPct[z] = live.targetLightHoursToday[z] = 0.0f;
+  }
+  stateSyncBegin(live);
+
+  std::vector<std::thread> threads;
+  threads.emplace_back(loopThread);
+  threads.emplace_back(networkThread);
+  for (unsigned i = 0; i < readers; i++) threads.emplace_back(readerThread);
+  std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+  running = false;
+  for (std::thread &t : threads) t.join();
+
+  printf("%s: %llu snapshots, %llu torn, %llu reader retries; %llu frames posted, %llu refused (queue full), %llu setpoints applied\n",
+         unprotected ? "unprotected" : "seqlock", (unsigned long long)reads.load(), (unsigned long long)torn.load(),
+         (unsigned long long)retries.load(), (unsigned long long)posted.load(), (unsigned long long)refused.load(),
+         (unsigned long long)applied.load());
+  return torn ? 1 : 0;
+}
@@ -0,0 +1,126 @@
+/**
+ * @file tsStub.cpp
+ * @brief Local stand-in for the ThingSpeak bulk-update endpoint.
+ *
+ * @details Accepts one connection at a time on 127.0.0.1, reads a complete
+ * HTTP request and answers like ThingSpeak (202 {"success":true}), after an
+ * optional delay. Failures can be injected: a share of requests gets a 500,
+ * and another share is dropped by closing the connection without an answer.
+ * Each request is logged as one line: request number, points, outcome.
+ *
+ * Usage: tsStub [--port N] [--latency MS] [--fail PCT] [--drop PCT]
+ *               [--down-after N --down-for M] [--seed S]
+ *
+ * --down-after/--down-for refuse M requests (close on accept) after the first
+ * N, as if the uplink went away for a while.
+ */
+#include <arpa/inet.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <netinet/in.h>
+#include <string>
+#include <sys/socket.h>
+#include <unistd.h>
+
+static bool readRequest(int fd, std::string &req) {
+  char buf[1024];
+  size_t bodyStart = std::string::npos;
+  size_t contentLength = 0;
+  for (;;) {
+    if (bodyStart == std::string::npos) {
+      bodyStart = req.find("\r\n\r\n");
+      if (bodyStart != std::string::npos) {
+        bodyStart += 4;
+        const size_t cl = req.find("Content-Length:");
+        if (cl != std::string::npos) contentLength = strtoul(req.c_str() + cl + 15, nullptr, 10);
+      }
+    }
+    if (bodyStart != std::string::npos && req.size() >= bodyStart + contentLength) return true;
+    const ssize_t n = recv(fd, buf, sizeof(buf), 0);
+    if (n <= 0) return false;
+    req.append(buf, (size_t)n);
+  }
+}
+
+static unsigned countPoints(const std::string &req) {
+  unsigned n = 0;
+  for (size_t pos = req.find("\"created_at\""); pos != std::string::npos; pos = req.find("\"created_at\"", pos + 1)) n++;
+  return n;
+}
+
+int main(int argc, char **argv) {
+  int port = 8080;
+  unsigned latencyMs = 0, failPct = 0, dropPct = 0, downAfter = 0, downFor = 0, seed = 1;
+
+  for (int i = 1; i + 1 < argc; i += 2) {
+    const char *opt = argv[i];
+    const unsigned v = (unsigned)strtoul(argv[i + 1], nullptr, 10);
+    if (!strcmp(opt, "--port")) port = (int)v;
+    else if (!strcmp(opt, "--latency")) latencyMs = v;
+    else if (!strcmp(opt, "--fail")) failPct = v;
+    else if (!strcmp(opt, "--drop")) dropPct = v;
+    else if (!strcmp(opt, "--down-after")) downAfter = v;
+    else if (!strcmp(opt, "--down-for")) downFor = v;
+    else if (!strcmp(opt, "--seed")) seed = v;
+    else {
+      fprintf(stderr, "unknown option %s\n", opt);
+      return 2;
+    }
+  }
+  srand(seed);
+
+  const int srv = socket(AF_INET, SOCK_STREAM, 0);
+  const int one = 1;
+  setsockopt(srv, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+  sockaddr_in addr = {};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons((uint16_t)port);
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  if (bind(srv, (sockaddr *)&addr, sizeof(addr)) != 0 || listen(srv, 4) != 0) {
+    perror("tsStub");
+    return 1;
+  }
+  fprintf(stderr, "tsStub listening on 127.0.0.1:%d\n", port);
+
+  unsigned requests = 0, points = 0;
+  for (;;) {
+    const int fd = accept(srv, nullptr, nullptr);
+    if (fd < 0) continue;
+    requests++;
+
+    if (downFor > 0 && requests > downAfter && requests <= downAfter + downFor) {
+      printf("%u down\n", requests);
+      fflush(stdout);
+      close(fd);
+      continue;
+    }
+
+    std::string req;
+    if (!readRequest(fd, req)) {
+      close(fd);
+      continue;
+    }
+    if (latencyMs) usleep(latencyMs * 1000);
+
+    const unsigned n = countPoints(req);
+    const unsigned roll = (unsigned)(rand() % 100);
+    const char *outcome;
+    if (roll < dropPct) {
+      outcome = "dropped";
+    } else if (roll < dropPct + failPct || req.find("\"write_api_key\"") == std::string::npos) {
+      outcome = "500";
+      const char *resp = "HTTP/1.1 500 Internal Server Error\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+      send(fd, resp, strlen(resp), MSG_NOSIGNAL);
+    } else {
+      outcome = "202";
+      points += n;
+      const char *resp = "HTTP/1.1 202 Accepted\r\nContent-Type: application/json\r\nContent-Length: 16\r\n"
+                         "Connection: close\r\n\r\n{\"success\":true}";
+      send(fd, resp, strlen(resp), MSG_NOSIGNAL);
+    }
+    printf("%u points=%u %s total=%u\n", requests, n, outcome, points);
+    fflush(stdout);
+    close(fd);
+  }
+}
@@ -0,0 +1,754 @@
+/**
+ * @file wsload.cpp
+ * @brief Load generator for a node's /ws endpoint: message rates, losses and latency percentiles.
+ *
+ * @details Opens --clients concurrent WebSocket clients against a node (the
+ * ESP8266, or nodesim on the host) and has each send --rate messages per
+ * second: --mix percent of them getReadings, the others a setpoint (T, H and L
+ * in turn, zone 0). Every message carries a sequence number (`#n`, see
+ * wsCommand.h), so its acknowledgement gives the command's round trip.
+ *
+ * Each setpoint is also a marker: its value is unique among the recent ones
+ * (a step of 0.1 within --band of the base target), so when a client receives
+ * an update showing that value, the time since it was sent is that client's
+ * broadcast latency. The server coalesces updates (a client gets only the
+ * newest state), so a client may skip markers; those are counted as
+ * coalesced, not lost. Lost are messages never acknowledged within
+ * --timeout ms, and stale the clients that did not get the final state within
+ * --timeout ms after the last setpoint.
+ *
+ * A run is one step of --seconds, or with --ramp a series of them, adding
+ * --step clients (or --step messages per second per client) at each step
+ * until one saturates: a refused or dropped connection, a stale client, a
+ * broadcast p99 above --max-p99 ms or more than --max-drop percent lost.
+ * With --metrics the node's /metrics is read before and after each step, for
+ * the loop rate and the mean time of the control and WebSocket stages under
+ * that load. Each step is a row of --csv. The base targets are set back at
+ * the end.
+ *
+ *   wsload [--target HOST:PORT] [--clients N] [--rate R] [--mix PCT] [--seconds S] [--binary]
+ *          [--ramp clients|rate] [--step N] [--steps K] [--max-p99 MS] [--max-drop PCT]
+ *          [--timeout MS] [--band V] [--targets T,H,L] [--metrics] [--csv FILE] [--seed S]
+ *
+ * Exit status 1 if a single run saturates or no client connects.
+ */
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <signal.h>
+#include <sys/epoll.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "fleetProto.h"
+#include "telemetry.h"
+
+/// Setpoint kinds used as markers, in wsCommand order (T, H, L)
+static const uint8_t MARK_KINDS = 3;
+static const char MARK_LETTERS[MARK_KINDS] = {'T', 'H', 'L'};
+static const char *const MARK_KEYS[MARK_KINDS] = {"\"tempTarget\":", "\"humiTarget\":", "\"lightTarget\":"};
+/// Accepted setpoint ranges, in tenths (wsCommand.h)
+static const int MARK_MIN[MARK_KINDS] = {0, 0, 0};
+static const int MARK_MAX[MARK_KINDS] = {500, 1000, 240};
+
+/// Send queue above which a client counts as backed up and stops sending
+static const size_t CLIENT_BACKLOG_MAX = 64 * 1024;
+
+/**
+ * @brief The latest setpoint sent with one marker value.
+ */
+struct Marker {
+  uint64_t sentUs = 0;
+  uint32_t id = 0;   ///< 0 = never sent
+};
+
+enum ClientPhase : uint8_t {
+  CLIENT_CONNECTING,
+  CLIENT_HANDSHAKE,
+  CLIENT_OPEN,
+  CLIENT_CLOSED
+};
+
+/**
+ * @brief One simulated dashboard.
+ */
+struct LoadClient {
+  int fd = -1;
+  ClientPhase phase = CLIENT_CONNECTING;
+  std::string key;
+  std::string in;
+  std::string out;                     ///< Unsent bytes
+  uint64_t nextSendUs = 0;
+  uint32_t seenId[MARK_KINDS] = {};    ///< Newest marker this client has seen, per kind
+  NodeTelemetry tel;                   ///< Binary clients: the state rebuilt from the frames
+};
+
+/**
+ * @brief What one step measured.
+ */
+struct StepStats {
+  uint64_t sent = 0, acked = 0, lost = 0, updates = 0;
+  uint64_t expected = 0, delivered = 0;  ///< Marker deliveries due and seen
+  unsigned refused = 0, closed = 0, stale = 0, backlogged = 0;
+  std::vector<uint32_t> ackUs, broadcastUs;
+};
+
+/**
+ * @brief Values read from the node's /metrics.
+ */
+struct NodeMetrics {
+  bool ok = false;
+  double loopHz = 0;
+  double sum[2] = {}, count[2] = {};   ///< control, ws stage seconds and runs
+};
+
+static const char *const METRIC_STAGES[2] = {"control", "ws"};
+
+static int epfd = -1;
+static sockaddr_in target;
+static std::string targetName = "127.0.0.1:80";
+static std::vector<LoadClient *> clients;
+static std::unordered_map<int32_t, uint64_t> pendingAcks;  ///< Sequence number -> send time
+static int32_t nextSeq = 1;
+static uint32_t nextMarkerId = 0;
+static uint32_t lastMarkerId[MARK_KINDS] = {};
+static uint8_t nextKind = 0;
+static std::vector<Marker> markers[MARK_KINDS];
+static int markerLo[MARK_KINDS], markerHi[MARK_KINDS];
+static int baseTenths[MARK_KINDS] = {270, 650, 60};
+static StepStats step;
+
+static double ratePerClient = 2.0;
+static unsigned mixPct = 50;
+static bool binaryClients = false;
+static uint32_t timeoutMs = 2000;
+
+static uint64_t nowUs() {
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000 + (uint64_t)ts.tv_nsec / 1000;
+}
+
+static void arm(LoadClient *c, bool write) {
+  epoll_event ev = {};
+  ev.events = EPOLLIN | (write ? (uint32_t)EPOLLOUT : 0u);
+  ev.data.ptr = c;
+  epoll_ctl(epfd, EPOLL_CTL_MOD, c->fd, &ev);
+}
+
+static void closeClient(LoadClient *c) {
+  if (c->fd < 0) return;
+  if (c->phase == CLIENT_OPEN) step.closed++;
+  else step.refused++;
+  epoll_ctl(epfd, EPOLL_CTL_DEL, c->fd, nullptr);
+  close(c->fd);
+  c->fd = -1;
+  c->phase = CLIENT_CLOSED;
+}
+
+static void flush(LoadClient *c) {
+  const bool had = !c->out.empty();
+  while (!c->out.empty()) {
+    const ssize_t n = send(c->fd, c->out.data(), c->out.size(), MSG_NOSIGNAL);
+    if (n < 0) {
+      if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+      closeClient(c);
+      return;
+    }
+    c->out.erase(0, (size_t)n);
+  }
+  if (had || !c->out.empty()) arm(c, !c->out.empty());
+}
+
+static void sendText(LoadClient *c, const char *text, size_t len) {
+  wsAppendFrame(c->out, WS_OP_TEXT, text, len, true);
+  flush(c);
+}
+
+static size_t openClients() {
+  size_t n = 0;
+  for (const LoadClient *c : clients) n += c->phase == CLIENT_OPEN;
+  return n;
+}
+
+// ---------------------------------------------------------------- markers
+
+/**
+ * @brief Record that @p c shows value @p tenths for marker kind @p k.
+ */
+static void observe(LoadClient *c, uint8_t k, long tenths, uint64_t now) {
+  if (tenths < markerLo[k] || tenths > markerHi[k]) return;
+  const Marker &m = markers[k][tenths - markerLo[k]];
+  if (m.id == 0 || m.id <= c->seenId[k]) return;
+  c->seenId[k] = m.id;
+  step.delivered++;
+  step.broadcastUs.push_back((uint32_t)std::min<uint64_t>(now - m.sentUs, UINT32_MAX));
+}
+
+/**
+ * @brief Zone 0 targets of a JSON readings message.
+ */
+static void observeJson(LoadClient *c, const std::string &text, uint64_t now) {
+  for (uint8_t k = 0; k < MARK_KINDS; k++) {
+    const size_t at = text.find(MARK_KEYS[k]);
+    if (at == std::string::npos) continue;
+    const char *v = text.c_str() + at + strlen(MARK_KEYS[k]);
+    char *end = nullptr;
+    const double value = strtod(v, &end);
+    if (end != v) observe(c, k, lround(value * 10.0), now);
+  }
+}
+
+/**
+ * @brief Acknowledgement `{"ack":n,...}`: the round trip of message n.
+ */
+static void onAck(const std::string &text, uint64_t now) {
+  const char *p = text.c_str() + 7;
+  if (!isdigit((unsigned char)*p)) return; // "ack":null
+  const auto it = pendingAcks.find((int32_t)strtol(p, nullptr, 10));
+  if (it == pendingAcks.end()) return; // already counted as lost
+  step.acked++;
+  step.ackUs.push_back((uint32_t)std::min<uint64_t>(now - it->second, UINT32_MAX));
+  pendingAcks.erase(it);
+}
+
+static void onMessage(LoadClient *c, const WsFrame &f, uint64_t now) {
+  if (f.opcode == WS_OP_PING) {
+    wsAppendFrame(c->out, WS_OP_PONG, f.payload.data(), f.payload.size(), true);
+    flush(c);
+    return;
+  }
+  if (f.opcode == WS_OP_CLOSE) {
+    closeClient(c);
+    return;
+  }
+  if (f.opcode == WS_OP_TEXT) {
+    if (f.payload.compare(0, 7, "{\"ack\":") == 0) {
+      onAck(f.payload, now);
+      return;
+    }
+    step.updates++;
+    observeJson(c, f.payload, now);
+    return;
+  }
+  if (f.opcode != WS_OP_BINARY) return;
+  step.updates++;
+  if (fleetApplyFrame(c->tel, (const uint8_t *)f.payload.data(), f.payload.size()) != FRAME_APPLIED) return;
+  for (uint8_t k = 0; k < MARK_KINDS; k++) observe(c, k, c->tel.v[0][3 + k], now);
+}
+
+// ---------------------------------------------------------------- sending
+
+/**
+ * @brief Send @p c's next message: getReadings or the next setpoint marker.
+ */
+static void sendCommand(LoadClient *c, uint64_t now) {
+  char text[48];
+  const int32_t seq = nextSeq++;
+  int len;
+  if ((unsigned)(rand() % 100) < mixPct) {
+    len = snprintf(text, sizeof(text), "#%d;getReadings", seq);
+  } else {
+    const uint8_t k = nextKind;
+    nextKind = (uint8_t)((nextKind + 1) % MARK_KINDS);
+    // Walk the band in order, so a value comes back as late as possible.
+    const uint32_t id = ++nextMarkerId;
+    const int span = markerHi[k] - markerLo[k] + 1;
+    const int tenths = markerLo[k] + (int)(id % (uint32_t)span);
+    Marker &m = markers[k][tenths - markerLo[k]];
+    m.sentUs = now;
+    m.id = id;
+    lastMarkerId[k] = id;
+    step.expected += openClients();
+    len = snprintf(text, sizeof(text), "#%d;%c:%d.%d", seq, MARK_LETTERS[k], tenths / 10, tenths % 10);
+  }
+  pendingAcks[seq] = now;
+  step.sent++;
+  sendText(c, text, (size_t)len);
+}
+
+/**
+ * @brief Count the messages whose acknowledgement is overdue as lost.
+ */
+static void expireAcks(uint64_t now) {
+  for (auto it = pendingAcks.begin(); it != pendingAcks.end();) {
+    if (now - it->second >= timeoutMs * 1000ULL) {
+      step.lost++;
+      it = pendingAcks.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+static bool isStale(const LoadClient *c) {
+  for (uint8_t k = 0; k < MARK_KINDS; k++) {
+    if (c->seenId[k] < lastMarkerId[k]) return true;
+  }
+  return false;
+}
+
+// ---------------------------------------------------------------- connections
+
+static void startClient() {
+  LoadClient *c = new LoadClient;
+  clients.push_back(c);
+  c->fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+  const int one = 1;
+  setsockopt(c->fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+  if (c->fd < 0 || (connect(c->fd, (const sockaddr *)&target, sizeof(target)) != 0 && errno != EINPROGRESS)) {
+    if (c->fd >= 0) close(c->fd);
+    c->fd = -1;
+    c->phase = CLIENT_CLOSED;
+    step.refused++;
+    return;
+  }
+  epoll_event ev = {};
+  ev.events = EPOLLIN | EPOLLOUT;
+  ev.data.ptr = c;
+  epoll_ctl(epfd, EPOLL_CTL_ADD, c->fd, &ev);
+}
+
+/**
+ * @brief Connect finished: send the WebSocket upgrade request.
+ */
+static void onConnected(LoadClient *c) {
+  int err = 0;
+  socklen_t len = sizeof(err);
+  getsockopt(c->fd, SOL_SOCKET, SO_ERROR, &err, &len);
+  if (err != 0) {
+    closeClient(c);
+    return;
+  }
+  c->phase = CLIENT_HANDSHAKE;
+  c->key = wsRandomKey();
+  c->out = "GET /ws HTTP/1.1\r\nHost: " + targetName +
+           "\r\nUpgrade: websocket\r\nConnection: Upgrade\r\nSec-WebSocket-Key: " + c->key +
+           "\r\nSec-WebSocket-Version: 13\r\n\r\n";
+  flush(c);
+}
+
+static void onReadable(LoadClient *c, uint64_t now) {
+  char buf[8192];
+  for (;;) {
+    const ssize_t r = recv(c->fd, buf, sizeof(buf), 0);
+    if (r > 0) {
+      c->in.append(buf, (size_t)r);
+      continue;
+    }
+    if (r < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+    closeClient(c);
+    return;
+  }
+
+  if (c->phase == CLIENT_HANDSHAKE) {
+    const size_t end = httpHeaderEnd(c->in);
+    if (end == 0) return;
+    const std::string head = c->in.substr(0, end);
+    c->in.erase(0, end);
+    if (head.compare(0, 12, "HTTP/1.1 101") != 0 || httpHeader(head, "Sec-WebSocket-Accept") != wsAcceptKey(c->key)) {
+      closeClient(c); // counted as refused
+      return;
+    }
+    c->phase = CLIENT_OPEN;
+    // A dashboard starts from the current targets.
+    for (uint8_t k = 0; k < MARK_KINDS; k++) c->seenId[k] = lastMarkerId[k];
+    if (binaryClients) sendText(c, TELEMETRY_PROTO_REQUEST, strlen(TELEMETRY_PROTO_REQUEST));
+  }
+
+  size_t off = 0;
+  while (c->fd >= 0) {
+    WsFrame f;
+    const long used = wsParseFrame(c->in, off, f);
+    if (used < 0) {
+      closeClient(c);
+      return;
+    }
+    if (used == 0) break;
+    off += (size_t)used;
+    onMessage(c, f, now);
+  }
+  if (c->fd >= 0) c->in.erase(0, off);
+}
+
+/**
+ * @brief Run the event loop until @p untilUs, or until @p done returns true.
+ *
+ * @param sending Clients send their messages meanwhile.
+ */
+static void pump(uint64_t untilUs, bool sending, bool (*done)() = nullptr) {
+  const uint64_t intervalUs = (uint64_t)(1e6 / ratePerClient);
+  uint64_t lastExpire = nowUs();
+  epoll_event events[256];
+  for (;;) {
+    const int n = epoll_wait(epfd, events, 256, 1);
+    uint64_t now = nowUs();
+    for (int i = 0; i < n; i++) {
+      LoadClient *c = (LoadClient *)events[i].data.ptr;
+      if (c->fd < 0) continue;
+      if (c->phase == CLIENT_CONNECTING) {
+        if (events[i].events & (EPOLLOUT | EPOLLERR | EPOLLHUP)) onConnected(c);
+        continue;
+      }
+      if (events[i].events & (EPOLLIN | EPOLLERR | EPOLLHUP)) onReadable(c, now);
+      if (c->fd >= 0 && (events[i].events & EPOLLOUT)) flush(c);
+    }
+
+    now = nowUs();
+    if (sending) {
+      for (LoadClient *c : clients) {
+        if (c->phase != CLIENT_OPEN || now < c->nextSendUs) continue;
+        if (c->out.size() > CLIENT_BACKLOG_MAX) continue; // the server stopped reading
+        sendCommand(c, now);
+        c->nextSendUs += intervalUs;
+        if (c->nextSendUs <= now) c->nextSendUs = now + intervalUs; // fell behind: do not burst
+      }
+    }
+    if (now - lastExpire >= 50000) {
+      expireAcks(now);
+      lastExpire = now;
+    }
+    if (now >= untilUs || (done && done())) return;
+  }
+}
+
+static bool allSettled() {
+  for (const LoadClient *c : clients) {
+    if (c->phase == CLIENT_CONNECTING || c->phase == CLIENT_HANDSHAKE) return false;
+  }
+  return true;
+}
+
+static bool allDrained() {
+  if (!pendingAcks.empty()) return false;
+  for (const LoadClient *c : clients) {
+    if (c->phase == CLIENT_OPEN && isStale(c)) return false;
+  }
+  return true;
+}
+
+// ---------------------------------------------------------------- /metrics
+
+/**
+ * @brief Read the node's /metrics (blocking, HTTP/1.0 so the body is not chunked).
+ */
+static bool scrapeMetrics(NodeMetrics &m) {
+  m = NodeMetrics();
+  const int fd = socket(AF_INET, SOCK_STREAM, 0);
+  if (fd < 0) return false;
+  timeval tv = {2, 0};
+  setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+  setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+  std::string body;
+  if (connect(fd, (const sockaddr *)&target, sizeof(target)) == 0) {
+    const std::string req = "GET /metrics HTTP/1.0\r\nHost: " + targetName + "\r\n\r\n";
+    if (send(fd, req.data(), req.size(), MSG_NOSIGNAL) == (ssize_t)req.size()) {
+      char buf[4096];
+      ssize_t r;
+      while ((r = recv(fd, buf, sizeof(buf), 0)) > 0) body.append(buf, (size_t)r);
+    }
+  }
+  close(fd);
+  if (body.compare(0, 12, "HTTP/1.1 200") != 0 && body.compare(0, 12, "HTTP/1.0 200") != 0) return false;
+
+  for (size_t line = 0; line < body.size();) {
+    size_t end = body.find('\n', line);
+    if (end == std::string::npos) end = body.size();
+    const std::string l = body.substr(line, end - line);
+    line = end + 1;
+    double v;
+    char stage[16];
+    if (sscanf(l.c_str(), "greenhouse_loop_rate_hz %lf", &v) == 1) {
+      m.loopHz = v;
+      m.ok = true;
+      continue;
+    }
+    const bool isSum = sscanf(l.c_str(), "greenhouse_stage_seconds_sum{stage=\"%15[^\"]\"} %lf", stage, &v) == 2;
+    if (!isSum && sscanf(l.c_str(), "greenhouse_stage_seconds_count{stage=\"%15[^\"]\"} %lf", stage, &v) != 2) continue;
+    for (uint8_t s = 0; s < 2; s++) {
+      if (strcmp(stage, METRIC_STAGES[s]) != 0) continue;
+      if (isSum) m.sum[s] = v;
+      else m.count[s] = v;
+    }
+  }
+  return m.ok;
+}
+
+/**
+ * @brief Mean run time of stage @p s between two scrapes, in ms (-1 without runs).
+ */
+static double stageMeanMs(const NodeMetrics &before, const NodeMetrics &after, uint8_t s) {
+  const double runs = after.count[s] - before.count[s];
+  return runs > 0 ? (after.sum[s] - before.sum[s]) / runs * 1000.0 : -1.0;
+}
+
+// ---------------------------------------------------------------- report
+
+/**
+ * @brief Nearest-rank percentile @p p (0..1) of sorted @p v, in ms.
+ */
+static double percentileMs(const std::vector<uint32_t> &v, double p) {
+  if (v.empty()) return 0;
+  size_t rank = (size_t)ceil(p * v.size());
+  if (rank < 1) rank = 1;
+  return v[rank - 1] / 1000.0;
+}
+
+static void csvHeader(FILE *f) {
+  fprintf(f, "step,clients,rate,offered_per_s,sent_per_s,acked,lost,lost_pct,ack_p50_ms,ack_p99_ms,ack_p999_ms,"
+             "updates_per_s,broadcast_p50_ms,broadcast_p99_ms,broadcast_p999_ms,coalesced_pct,stale,refused,closed,"
+             "backlogged,loop_hz,control_ms,ws_ms,saturated\n");
+}
+
+static bool parseTarget(const char *spec) {
+  char host[128];
+  int port = 0;
+  if (sscanf(spec, "%127[^:]:%d", host, &port) != 2 || port <= 0 || port > 65535) {
+    fprintf(stderr, "wsload: bad target %s\n", spec);
+    return false;
+  }
+  addrinfo hints = {}, *res = nullptr;
+  hints.ai_family = AF_INET;
+  hints.ai_socktype = SOCK_STREAM;
+  if (getaddrinfo(host, nullptr, &hints, &res) != 0 || !res) {
+    fprintf(stderr, "wsload: cannot resolve %s\n", host);
+    return false;
+  }
+  target = *(const sockaddr_in *)res->ai_addr;
+  target.sin_port = htons((uint16_t)port);
+  freeaddrinfo(res);
+  targetName = spec;
+  return true;
+}
+
+/**
+ * @brief Parse "T,H,L" base targets (values in the wsCommand ranges).
+ */
+static bool parseTargets(const char *spec) {
+  float v[MARK_KINDS];
+  if (sscanf(spec, "%f,%f,%f", &v[0], &v[1], &v[2]) != 3) return false;
+  for (uint8_t k = 0; k < MARK_KINDS; k++) {
+    baseTenths[k] = (int)lroundf(v[k] * 10.0f);
+    if (baseTenths[k] < MARK_MIN[k] || baseTenths[k] > MARK_MAX[k]) return false;
+  }
+  return true;
+}
+
+static void usage(const char *argv0) {
+  fprintf(stderr,
+          "usage: %s [--target HOST:PORT] [--clients N] [--rate R] [--mix PCT] [--seconds S] [--binary]\n"
+          "          [--ramp clients|rate] [--step N] [--steps K] [--max-p99 MS] [--max-drop PCT]\n"
+          "          [--timeout MS] [--band V] [--targets T,H,L] [--metrics] [--csv FILE] [--seed S]\n",
+          argv0);
+}
+
+int main(int argc, char **argv) {
+  unsigned clientCount = 4, seconds = 10, steps = 20, seed = 1;
+  double stepSize = 0, maxP99Ms = 1000, maxDropPct = 1, band = 2.5;
+  bool metrics = false;
+  const char *ramp = nullptr;
+  const char *csvPath = nullptr;
+  if (!parseTarget("127.0.0.1:80")) return 2;
+
+  for (int i = 1; i < argc; i++) {
+    const char *opt = argv[i];
+    if (!strcmp(opt, "--binary")) {
+      binaryClients = true;
+      continue;
+    }
+    if (!strcmp(opt, "--metrics")) {
+      metrics = true;
+      continue;
+    }
+    const char *val = i + 1 < argc ? argv[++i] : nullptr;
+    if (!val) {
+      usage(argv[0]);
+      return 2;
+    }
+    if (!strcmp(opt, "--target")) { if (!parseTarget(val)) return 2; }
+    else if (!strcmp(opt, "--clients")) clientCount = (unsigned)atoi(val);
+    else if (!strcmp(opt, "--rate")) ratePerClient = atof(val);
+    else if (!strcmp(opt, "--mix")) mixPct = (unsigned)atoi(val);
+    else if (!strcmp(opt, "--seconds")) seconds = (unsigned)atoi(val);
+    else if (!strcmp(opt, "--ramp")) ramp = val;
+    else if (!strcmp(opt, "--step")) stepSize = atof(val);
+    else if (!strcmp(opt, "--steps")) steps = (unsigned)atoi(val);
+    else if (!strcmp(opt, "--max-p99")) maxP99Ms = atof(val);
+    else if (!strcmp(opt, "--max-drop")) maxDropPct = atof(val);
+    else if (!strcmp(opt, "--timeout")) timeoutMs = (uint32_t)atoi(val);
+    else if (!strcmp(opt, "--band")) band = atof(val);
+    else if (!strcmp(opt, "--targets")) {
+      if (!parseTargets(val)) {
+        fprintf(stderr, "wsload: bad --targets %s\n", val);
+        return 2;
+      }
+    }
+    else if (!strcmp(opt, "--csv")) csvPath = val;
+    else if (!strcmp(opt, "--seed")) seed = (unsigned)atoi(val);
+    else {
+      usage(argv[0]);
+      return 2;
+    }
+  }
+  const bool rampClients = ramp && !strcmp(ramp, "clients");
+  if ((ramp && !rampClients && strcmp(ramp, "rate") != 0) || clientCount == 0 || ratePerClient <= 0 ||
+      mixPct > 100 || seconds == 0 || band < 0.1) {
+    usage(argv[0]);
+    return 2;
+  }
+  if (stepSize <= 0) stepSize = rampClients ? clientCount : ratePerClient;
+  if (!ramp) steps = 1;
+
+  signal(SIGPIPE, SIG_IGN);
+  srand(seed);
+  rlimit lim;
+  if (getrlimit(RLIMIT_NOFILE, &lim) == 0 && lim.rlim_cur < lim.rlim_max) {
+    lim.rlim_cur = lim.rlim_max;
+    setrlimit(RLIMIT_NOFILE, &lim);
+  }
+
+  const int bandTenths = (int)lround(band * 10.0);
+  for (uint8_t k = 0; k < MARK_KINDS; k++) {
+    markerLo[k] = std::max(MARK_MIN[k], baseTenths[k] - bandTenths);
+    markerHi[k] = std::min(MARK_MAX[k], baseTenths[k] + bandTenths);
+    markers[k].assign((size_t)(markerHi[k] - markerLo[k] + 1), Marker());
+  }
+
+  FILE *csv = nullptr;
+  if (csvPath) {
+    csv = strcmp(csvPath, "-") ? fopen(csvPath, "w") : stdout;
+    if (!csv) {
+      perror(csvPath);
+      return 1;
+    }
+    csvHeader(csv);
+  }
+
+  epfd = epoll_create1(0);
+  fprintf(stderr, "wsload: %s, %u clients x %.1f msg/s, %u%% getReadings, %u s per step%s\n", targetName.c_str(),
+          clientCount, ratePerClient, mixPct, seconds, binaryClients ? ", binary" : "");
+
+  int lastGood = -1;
+  unsigned goodClients = 0;
+  double goodRate = 0;
+  const char *why = nullptr;
+  for (unsigned s = 0; s < steps; s++) {
+    if (s > 0) {
+      if (rampClients) clientCount += (unsigned)stepSize;
+      else ratePerClient += stepSize;
+    }
+    step = StepStats();
+    pendingAcks.clear();
+
+    // Bring the client count up to this step's, then start everyone at a random phase.
+    while (clients.size() < clientCount) startClient();
+    pump(nowUs() + timeoutMs * 1000ULL, false, allSettled);
+    for (LoadClient *c : clients) {
+      if (c->phase == CLIENT_CONNECTING || c->phase == CLIENT_HANDSHAKE) closeClient(c); // counted as refused
+    }
+    if (openClients() == 0) {
+      fprintf(stderr, "wsload: no client could connect to %s\n", targetName.c_str());
+      return 1;
+    }
+    const uint64_t start = nowUs();
+    const uint64_t intervalUs = (uint64_t)(1e6 / ratePerClient);
+    for (LoadClient *c : clients) c->nextSendUs = start + (uint64_t)rand() % intervalUs;
+
+    NodeMetrics before, after;
+    if (metrics) scrapeMetrics(before);
+    pump(start + seconds * 1000000ULL, true);
+    const double elapsed = (nowUs() - start) / 1e6;
+    pump(nowUs() + timeoutMs * 1000ULL, false, allDrained);
+    if (metrics) scrapeMetrics(after);
+    expireAcks(UINT64_MAX);
+
+    for (const LoadClient *c : clients) {
+      if (c->phase != CLIENT_OPEN) continue;
+      if (isStale(c)) step.stale++;
+      if (c->out.size() > CLIENT_BACKLOG_MAX) step.backlogged++;
+    }
+    std::sort(step.ackUs.begin(), step.ackUs.end());
+    std::sort(step.broadcastUs.begin(), step.broadcastUs.end());
+    const double lostPct = step.sent ? 100.0 * step.lost / step.sent : 0;
+    const double coalescedPct = step.expected ? 100.0 * (1.0 - (double)step.delivered / step.expected) : 0;
+    const double p99 = percentileMs(step.broadcastUs, 0.99);
+    const unsigned open = (unsigned)openClients();
+
+    why = step.refused ? "connections refused"
+        : step.closed ? "connections dropped"
+        : step.stale ? "stale clients"
+        : step.backlogged ? "server stopped reading"
+        : lostPct > maxDropPct ? "messages lost"
+        : p99 > maxP99Ms ? "broadcast p99 over the limit"
+        : nullptr;
+
+    const bool haveMetrics = before.ok && after.ok;
+    printf("step %2u: %3u clients x %5.1f msg/s: sent %6.0f/s, lost %.2f %%, ack p50 %.1f p99 %.1f p999 %.1f ms; "
+           "%.0f updates/s, broadcast p50 %.1f p99 %.1f p999 %.1f ms, %.0f %% coalesced; "
+           "%u stale, %u refused, %u closed",
+           s + 1, open, ratePerClient, step.sent / elapsed, lostPct, percentileMs(step.ackUs, 0.5),
+           percentileMs(step.ackUs, 0.99), percentileMs(step.ackUs, 0.999), step.updates / elapsed,
+           percentileMs(step.broadcastUs, 0.5), p99, percentileMs(step.broadcastUs, 0.999), coalescedPct,
+           step.stale, step.refused, step.closed);
+    if (haveMetrics) {
+      printf("; node loop %.0f Hz, control %.3f ms, ws %.3f ms", after.loopHz, stageMeanMs(before, after, 0),
+             stageMeanMs(before, after, 1));
+    }
+    printf("%s\n", why ? " SATURATED" : "");
+    fflush(stdout);
+
+    if (csv) {
+      fprintf(csv, "%u,%u,%.2f,%.1f,%.1f,%llu,%llu,%.3f,%.3f,%.3f,%.3f,%.1f,%.3f,%.3f,%.3f,%.1f,%u,%u,%u,%u,", s + 1,
+              open, ratePerClient, open * ratePerClient, step.sent / elapsed, (unsigned long long)step.acked,
+              (unsigned long long)step.lost, lostPct, percentileMs(step.ackUs, 0.5), percentileMs(step.ackUs, 0.99),
+              percentileMs(step.ackUs, 0.999), step.updates / elapsed, percentileMs(step.broadcastUs, 0.5), p99,
+              percentileMs(step.broadcastUs, 0.999), coalescedPct, step.stale, step.refused, step.closed,
+              step.backlogged);
+      if (haveMetrics) {
+        fprintf(csv, "%.1f,%.4f,%.4f,", after.loopHz, stageMeanMs(before, after, 0), stageMeanMs(before, after, 1));
+      } else {
+        fprintf(csv, ",,,");
+      }
+      fprintf(csv, "%s\n", why ? why : "");
+      fflush(csv);
+    }
+    if (why) break;
+    lastGood = (int)s;
+    goodClients = open;
+    goodRate = ratePerClient;
+  }
+
+  // Put the base targets back, through any client still open.
+  for (LoadClient *c : clients) {
+    if (c->phase != CLIENT_OPEN) continue;
+    char text[64];
+    const int len = snprintf(text, sizeof(text), "T:%d.%d;H:%d.%d;L:%d.%d", baseTenths[0] / 10, baseTenths[0] % 10,
+                             baseTenths[1] / 10, baseTenths[1] % 10, baseTenths[2] / 10, baseTenths[2] % 10);
+    sendText(c, text, (size_t)len);
+    pump(nowUs() + 200000, false);
+    break;
+  }
+
+  if (ramp) {
+    if (lastGood < 0) printf("saturated at the first step (%s)\n", why);
+    else if (why) printf("saturation after step %d: %u clients x %.1f msg/s = %.0f msg/s sustained; next step: %s\n",
+                         lastGood + 1, goodClients, goodRate, goodClients * goodRate, why);
+    else printf("no saturation up to %u clients x %.1f msg/s\n", goodClients, goodRate);
+  }
+  if (csv && csv != stdout) fclose(csv);
+  return !ramp && why ? 1 : 0;
+}
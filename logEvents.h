@@ -0,0 +1,33 @@
+#pragma once
+
+/**
+ * @file logEvents.h
+ * @brief Table of event log messages.
+ *
+ * Each entry: X(id, level, argument count, format). Records on the wire carry
+ * only the id and the integer arguments; the format is applied when the record
+ * is printed (eventLogFormat()), on the device or by host/logdecode.
+ *
+ * Format conversions (one 32-bit argument each):
+ *  - %u unsigned, %d signed, %x hex
+ *  - %D signed tenths (231 -> 23.1), %C signed hundredths (125 -> 1.25)
+ *  - %B boolean (true/false), %I IPv4 address (first octet in the low byte)
+ *
+ * Append new events at the end so ids in existing captures keep their meaning.
+ */
+
+#define LOG_EVENTS(X) \
+  X(EV_LOG_DROPPED,   LOG_WARN, 1, "log: %u records dropped") \
+  X(EV_STATUS,        LOG_INFO, 6, "tempC=%D hum=%D heaterOn=%B misterOn=%B lampOn=%B lightHoursToday=%C") \
+  X(EV_TARGETS,       LOG_INFO, 3, "Desired temp=%D humidity=%D hours of light=%D") \
+  X(EV_TASK_STATS,    LOG_INFO, 4, "task %u runs=%u overruns=%u maxLateMs=%u") \
+  X(EV_WS_CONNECT,    LOG_INFO, 2, "WebSocket client #%u connected from %I") \
+  X(EV_WS_DISCONNECT, LOG_INFO, 1, "WebSocket client #%u disconnected") \
+  X(EV_DHT_MISSING,   LOG_WARN, 0, "Failed to read DHT sensor!") \
+  X(EV_ZONE_STATUS,   LOG_INFO, 6, "zone %u tempC=%D hum=%D heaterOn=%B misterOn=%B lampOn=%B") \
+  X(EV_ZONE_TARGETS,  LOG_INFO, 5, "zone %u lightHoursToday=%C desired temp=%D humidity=%D hours of light=%D") \
+  X(EV_ADC_STATS,     LOG_INFO, 4, "adc: samples=%u averages=%u lost=%u overruns=%u") \
+  X(EV_WIFI_UP,       LOG_INFO, 4, "wifi: up after %u ms (fast=%B, attempt %u) ip=%I") \
+  X(EV_WIFI_DOWN,     LOG_WARN, 0, "wifi: connection lost") \
+  X(EV_WIFI_RETRY,    LOG_WARN, 2, "wifi: attempt %u failed, retrying in %u ms") \
+  X(EV_HEAP_ALLOC,    LOG_ERROR, 3, "heap: task %d allocated %u bytes from 0x%x")
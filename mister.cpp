@@ -2,36 +2,37 @@
  * @file mister.cpp
  * @brief Initalises and controls the mister
  * @section Mister_var Internal state varible
- * - MISTER_ACTIVE_LOW: True if the mister control is active-low (LOW = ON, HIGH = OFF).
- * The
+ * - Each zone's mister pin, and whether it is active-low (LOW = ON, HIGH = OFF),
+ *   comes from zonePins() (zones.h).
  */
 #include "mister.h"
-
-#define MISTERPIN D1
-static const bool MISTER_ACTIVE_LOW = true;
+#include "hal.h"
+#include "zones.h"
+#include "actuators.h"
 
 /**
- * @brief Initializes the mister control pin and sets it to a safe OFF state.
- * @details Configures MISTERPIN as OUTPUT and writes the inactive level,
- *          (OFF) depending on whether the hardware is active: low or active: high.
+ * @brief Initializes the mister control pins and sets them to a safe OFF state.
+ * @details Attaches every zone's mister pin to the actuator layer with its polarity
+ *          (active: low or active: high), which makes it an OUTPUT and writes the
+ *          inactive level (OFF).
  */
 void misterInit() {
-    pinMode(MISTERPIN, OUTPUT);
-    digitalWrite(MISTERPIN, MISTER_ACTIVE_LOW ? HIGH : LOW);
+  for (uint8_t z = 0; z < zoneCount(); z++) {
+    const ZonePins &pins = zonePins(z);
+    actuatorAttach(z, ACT_MISTER, pins.mister, pins.misterActiveLow);
+  }
 }
 
 /**
- * @brief Turns the mister on or off. Handles unknown states by turning the mister off.  
- * 
- * @param on can be true or false, to turn on or off the mister. It is inverted.
+ * @brief Turns the mister on or off.
+ *
+ * @details Sets the zone's mister in the actuator shadow; the actuator layer
+ * applies the polarity and drives the pin at the next actuatorsCommit().
+ *
+ * @param zone Zone whose mister to switch.
+ * @param on can be true or false, to turn on or off the mister.
  */
 
-void misterState(bool on) {
-  if (MISTER_ACTIVE_LOW) {
-    digitalWrite(MISTERPIN, on ? LOW : HIGH);   
-  } else {
-    digitalWrite(MISTERPIN, on ? HIGH : LOW);  
-  }
-
-
-}
\ No newline at end of file
+void misterState(uint8_t zone, bool on) {
+  actuatorSet(zone, ACT_MISTER, on);
+}
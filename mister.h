@@ -3,4 +3,4 @@
 
 
 void misterInit();
-void misterState(bool command);
+void misterState(uint8_t zone, bool command);
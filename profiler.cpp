@@ -0,0 +1,306 @@
+/**
+ * @file profiler.cpp
+ * @brief Cycle histograms and memory margins, and their Prometheus text rendering.
+ *
+ * @details A duration d > 2^PROF_FIRST_SHIFT goes into bucket
+ * ceil(log2(d)) - PROF_FIRST_SHIFT, found from the leading zeros of d - 1, so
+ * bucket i holds exactly the durations with 2^(PROF_FIRST_SHIFT+i-1) < d <=
+ * 2^(PROF_FIRST_SHIFT+i), matching Prometheus' inclusive "le" bounds.
+ *
+ * The response is produced one item at a time into the cursor's line buffer
+ * and copied out as the HTTP stack asks for it, as dataLogReadCsv() does.
+ */
+#include "profiler.h"
+#include "heapGuard.h"
+#include "actuators.h"
+#include <stdio.h>
+#include <string.h>
+
+static const char *const STAGE_NAMES[PROF_STAGES] = {"dht", "light", "control", "readings", "ws", "upload"};
+
+static ProfHistogram hist[PROF_STAGES];
+static ProfSample sampled;
+static uint32_t loopsAtSample = 0;
+static uint32_t lastSampleMs = 0;
+
+/**
+ * @brief Clear all histograms and take a first memory sample.
+ */
+void profBegin() {
+  memset(hist, 0, sizeof(hist));
+  memset(&sampled, 0, sizeof(sampled));
+  loopsAtSample = 0;
+  lastSampleMs = halMillis();
+  halMemInfo(sampled.mem);
+  sampled.minFreeHeap = sampled.mem.freeHeap;
+  sampled.minFreeStack = sampled.mem.freeStack;
+}
+
+/**
+ * @brief Stop timing @p stage, started with profStart().
+ */
+void profEnd(uint8_t stage, uint32_t startCycles) {
+  const uint32_t d = halCycles() - startCycles;
+  if (stage >= PROF_STAGES) return;
+  ProfHistogram &h = hist[stage];
+  uint8_t b = 0;
+  if (d > (1u << PROF_FIRST_SHIFT)) {
+    const uint8_t bits = (uint8_t)(32 - __builtin_clz(d - 1)); // ceil(log2(d))
+    b = bits - PROF_FIRST_SHIFT;
+    if (b >= PROF_BUCKETS) b = PROF_BUCKETS - 1;
+  }
+  h.buckets[b]++;
+  h.count++;
+  h.sumCycles += d;
+  if (d > h.maxCycles) h.maxCycles = d;
+}
+
+/**
+ * @brief Count one loop() iteration.
+ */
+void profLoop() {
+  sampled.loops++;
+}
+
+/**
+ * @brief Sample the loop rate and the memory margins (call every PROF_SAMPLE_MS).
+ */
+void profSample() {
+  const uint32_t now = halMillis();
+  const uint32_t elapsed = now - lastSampleMs;
+  if (elapsed > 0) sampled.loopRateHz = (uint32_t)((uint64_t)(sampled.loops - loopsAtSample) * 1000 / elapsed);
+  loopsAtSample = sampled.loops;
+  lastSampleMs = now;
+
+  halMemInfo(sampled.mem);
+  if (sampled.mem.freeHeap < sampled.minFreeHeap) sampled.minFreeHeap = sampled.mem.freeHeap;
+  if (sampled.mem.freeStack < sampled.minFreeStack) sampled.minFreeStack = sampled.mem.freeStack;
+}
+
+/**
+ * @brief Label of @p stage in the metrics ("?" if out of range).
+ */
+const char *profStageName(uint8_t stage) {
+  return stage < PROF_STAGES ? STAGE_NAMES[stage] : "?";
+}
+
+/**
+ * @brief Copy the histogram of @p stage.
+ *
+ * @return false if @p stage is out of range.
+ */
+bool profHistogram(uint8_t stage, ProfHistogram &out) {
+  if (stage >= PROF_STAGES) return false;
+  out = hist[stage];
+  return true;
+}
+
+/**
+ * @brief Copy the latest profSample() results.
+ */
+void profSampled(ProfSample &out) {
+  out = sampled;
+}
+
+/// @name Response sections, in order
+///@{
+enum : uint8_t {
+  ITEM_HIST_HEAD,
+  ITEM_HIST,      ///< Buckets, sum and count of each stage
+  ITEM_MAX_HEAD,
+  ITEM_MAX,       ///< Longest run of each stage
+  ITEM_SWITCHES_HEAD,
+  ITEM_SWITCHES,  ///< Switch count of each attached actuator
+  ITEM_ON_HEAD,
+  ITEM_ON,        ///< Time on of each attached actuator
+  ITEM_SCALARS,   ///< One item per entry of SCALARS
+};
+///@}
+
+/**
+ * @brief A single-valued metric.
+ */
+struct Scalar {
+  const char *name;
+  const char *type;
+  const char *help;
+};
+
+static const Scalar SCALARS[] = {
+  {"greenhouse_loop_iterations_total", "counter", "loop() iterations since boot."},
+  {"greenhouse_loop_rate_hz", "gauge", "loop() iterations per second over the last second."},
+  {"greenhouse_heap_free_bytes", "gauge", "Free heap."},
+  {"greenhouse_heap_free_min_bytes", "gauge", "Lowest free heap seen since boot."},
+  {"greenhouse_heap_max_block_bytes", "gauge", "Largest free heap block."},
+  {"greenhouse_heap_fragmentation_ratio", "gauge", "Heap fragmentation, 0 (one free block) to 1."},
+  {"greenhouse_stack_free_bytes", "gauge", "loop() stack never used."},
+  {"greenhouse_stack_free_min_bytes", "gauge", "Lowest loop() stack margin seen since boot."},
+  {"greenhouse_heap_unexpected_allocs_total", "counter", "Allocations after setup() in tasks or callbacks (HEAP_GUARD builds)."},
+  {"greenhouse_cpu_hz", "gauge", "CPU clock."},
+  {"greenhouse_uptime_seconds", "gauge", "Time since boot."},
+};
+
+static const uint8_t SCALAR_COUNT = sizeof(SCALARS) / sizeof(SCALARS[0]);
+
+static int scalarValue(uint8_t i, char *out, size_t max) {
+  switch (i) {
+    case 0: return snprintf(out, max, "%lu", (unsigned long)sampled.loops);
+    case 1: return snprintf(out, max, "%lu", (unsigned long)sampled.loopRateHz);
+    case 2: return snprintf(out, max, "%lu", (unsigned long)sampled.mem.freeHeap);
+    case 3: return snprintf(out, max, "%lu", (unsigned long)sampled.minFreeHeap);
+    case 4: return snprintf(out, max, "%lu", (unsigned long)sampled.mem.maxBlock);
+    case 5: return snprintf(out, max, "%u.%02u", sampled.mem.fragmentPct / 100, sampled.mem.fragmentPct % 100);
+    case 6: return snprintf(out, max, "%lu", (unsigned long)sampled.mem.freeStack);
+    case 7: return snprintf(out, max, "%lu", (unsigned long)sampled.minFreeStack);
+    case 8: {
+      HeapGuardStats guard;
+      heapGuardStats(guard);
+      return snprintf(out, max, "%lu", (unsigned long)guard.unexpected);
+    }
+    case 9: return snprintf(out, max, "%lu", (unsigned long)halCpuHz());
+    default: return snprintf(out, max, "%.3f", halMillis() / 1000.0);
+  }
+}
+
+/**
+ * @brief Start a /metrics response.
+ */
+void profMetricsBegin(ProfCursor &c) {
+  memset(&c, 0, sizeof(c));
+}
+
+/**
+ * @brief Format the next item of the response into c.line.
+ *
+ * @return false once everything was written.
+ */
+static bool nextItem(ProfCursor &c) {
+  char *line = c.line;
+  const size_t max = sizeof(c.line);
+  const double hz = (double)halCpuHz();
+  int n = 0;
+
+  switch (c.item) {
+    case ITEM_HIST_HEAD:
+      n = snprintf(line, max,
+                   "# HELP greenhouse_stage_seconds Time spent in each instrumented stage.\n"
+                   "# TYPE greenhouse_stage_seconds histogram\n");
+      c.item = ITEM_HIST;
+      c.stage = 0;
+      c.bucket = 0;
+      break;
+
+    case ITEM_HIST: {
+      const char *name = STAGE_NAMES[c.stage];
+      if (c.bucket == 0) {
+        c.snap = hist[c.stage];
+        c.cumulative = 0;
+      }
+      if (c.bucket < PROF_BUCKETS) {
+        c.cumulative += c.snap.buckets[c.bucket];
+        if (c.bucket == PROF_BUCKETS - 1) {
+          n = snprintf(line, max, "greenhouse_stage_seconds_bucket{stage=\"%s\",le=\"+Inf\"} %lu\n", name,
+                       (unsigned long)c.cumulative);
+        } else {
+          const double le = (double)(1u << (PROF_FIRST_SHIFT + c.bucket)) / hz;
+          n = snprintf(line, max, "greenhouse_stage_seconds_bucket{stage=\"%s\",le=\"%.3g\"} %lu\n", name, le,
+                       (unsigned long)c.cumulative);
+        }
+        c.bucket++;
+      } else {
+        n = snprintf(line, max,
+                     "greenhouse_stage_seconds_sum{stage=\"%s\"} %.9g\n"
+                     "greenhouse_stage_seconds_count{stage=\"%s\"} %lu\n",
+                     name, (double)c.snap.sumCycles / hz, name, (unsigned long)c.snap.count);
+        c.bucket = 0;
+        if (++c.stage == PROF_STAGES) c.item = ITEM_MAX_HEAD;
+      }
+      break;
+    }
+
+    case ITEM_MAX_HEAD:
+      n = snprintf(line, max,
+                   "# HELP greenhouse_stage_max_seconds Longest run of each stage since boot.\n"
+                   "# TYPE greenhouse_stage_max_seconds gauge\n");
+      c.item = ITEM_MAX;
+      c.stage = 0;
+      break;
+
+    case ITEM_MAX:
+      n = snprintf(line, max, "greenhouse_stage_max_seconds{stage=\"%s\"} %.9g\n", STAGE_NAMES[c.stage],
+                   (double)hist[c.stage].maxCycles / hz);
+      if (++c.stage == PROF_STAGES) c.item = ITEM_SWITCHES_HEAD;
+      break;
+
+    case ITEM_SWITCHES_HEAD:
+    case ITEM_ON_HEAD: {
+      const bool sw = c.item == ITEM_SWITCHES_HEAD;
+      const char *family = sw ? "greenhouse_actuator_switches_total" : "greenhouse_actuator_on_seconds_total";
+      n = snprintf(line, max, "# HELP %s %s\n# TYPE %s counter\n", family,
+                   sw ? "Committed changes of each output (relay wear)." : "Time each output was on; its rate is the duty cycle.",
+                   family);
+      c.item++;
+      c.stage = 0; // zone * ACT_KINDS + kind
+      break;
+    }
+
+    case ITEM_SWITCHES:
+    case ITEM_ON: {
+      ActuatorStats st;
+      while (c.stage < ZONE_MAX * ACT_KINDS && !actuatorStats(c.stage / ACT_KINDS, c.stage % ACT_KINDS, st)) c.stage++;
+      if (c.stage == ZONE_MAX * ACT_KINDS) {
+        c.item++;
+        break;
+      }
+      const unsigned zone = c.stage / ACT_KINDS;
+      const char *name = actuatorName(c.stage % ACT_KINDS);
+      if (c.item == ITEM_SWITCHES) {
+        n = snprintf(line, max, "greenhouse_actuator_switches_total{zone=\"%u\",actuator=\"%s\"} %lu\n", zone, name,
+                     (unsigned long)st.switches);
+      } else {
+        n = snprintf(line, max, "greenhouse_actuator_on_seconds_total{zone=\"%u\",actuator=\"%s\"} %.3f\n", zone,
+                     name, st.onMs / 1000.0);
+      }
+      c.stage++;
+      break;
+    }
+
+    default: {
+      const uint8_t i = (uint8_t)(c.item - ITEM_SCALARS);
+      if (i >= SCALAR_COUNT) return false;
+      const Scalar &s = SCALARS[i];
+      n = snprintf(line, max, "# HELP %s %s\n# TYPE %s %s\n%s ", s.name, s.help, s.name, s.type, s.name);
+      if (n > 0 && (size_t)n < max) n += scalarValue(i, line + n, max - n);
+      if (n > 0 && (size_t)n + 1 < max) line[n++] = '\n';
+      c.item++;
+      break;
+    }
+  }
+
+  if (n < 0) n = 0;
+  if ((size_t)n >= max) n = (int)max - 1;
+  c.lineLen = (uint8_t)n;
+  c.lineOff = 0;
+  return true;
+}
+
+/**
+ * @brief Copy up to @p maxLen bytes of the /metrics response into @p out.
+ *
+ * @return Bytes written; 0 once the response is complete.
+ */
+size_t profMetricsRead(ProfCursor &c, char *out, size_t maxLen) {
+  size_t n = 0;
+  while (n < maxLen) {
+    if (c.lineOff < c.lineLen) {
+      const size_t left = (size_t)(c.lineLen - c.lineOff);
+      const size_t take = left < maxLen - n ? left : maxLen - n;
+      memcpy(out + n, c.line + c.lineOff, take);
+      c.lineOff += take;
+      n += take;
+      continue;
+    }
+    if (!nextItem(c)) break;
+  }
+  return n;
+}
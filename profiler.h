@@ -0,0 +1,107 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include "hal.h"
+
+/**
+ * @file profiler.h
+ * @brief Per-stage cycle histograms, loop rate and memory margins, served as Prometheus metrics.
+ *
+ * @details A stage is timed by reading the cycle counter before and after it:
+ *
+ *   const uint32_t t = profStart();
+ *   climateControlUpdate(state);
+ *   profEnd(PROF_CONTROL, t);
+ *
+ * profEnd() adds the duration to the stage's histogram: fixed log2 buckets,
+ * the first ending at 2^PROF_FIRST_SHIFT cycles and each next one twice as
+ * wide, the last one open-ended. That is a count-leading-zeros and three
+ * increments, so timing costs a few dozen cycles and never allocates.
+ *
+ * profSample() (every PROF_SAMPLE_MS) records the loop rate, the free heap,
+ * the largest free block, the fragmentation and the free stack, with the
+ * lowest free heap and stack seen since boot.
+ *
+ * profMetricsRead() writes everything, with the actuator counters of
+ * actuators.h, in the Prometheus text exposition format (durations in
+ * seconds), a piece at a time for a chunked HTTP response. Each
+ * stage's histogram is copied into the cursor before its lines are written,
+ * so its buckets, sum and count always agree.
+ *
+ * profEnd(), profLoop() and profSample() run in loop() context only.
+ */
+
+/// Instrumented stages
+enum ProfStage : uint8_t {
+  PROF_DHT,      ///< dht11Read()
+  PROF_LIGHT,    ///< lightUpdate()
+  PROF_CONTROL,  ///< climateControlUpdate()
+  PROF_READINGS, ///< getSensorReadings() for the WebSocket fanout
+  PROF_WS,       ///< wsServerFanout(): commands, JSON and binary frames, sends
+  PROF_UPLOAD,   ///< uploaderRun() (ThingSpeak)
+  PROF_STAGES
+};
+
+/// Histogram buckets per stage (the last one is +Inf)
+static const uint8_t PROF_BUCKETS = 20;
+
+/// The first bucket ends at 2^PROF_FIRST_SHIFT cycles (3.2 us at 80 MHz)
+static const uint8_t PROF_FIRST_SHIFT = 8;
+
+/// Period at which profSample() should be called
+static const uint32_t PROF_SAMPLE_MS = 1000;
+
+/**
+ * @brief Durations of one stage since boot.
+ */
+struct ProfHistogram {
+  uint32_t buckets[PROF_BUCKETS]; ///< Runs per bucket (not cumulative)
+  uint32_t count;                 ///< Runs
+  uint64_t sumCycles;             ///< Total cycles
+  uint32_t maxCycles;             ///< Longest run
+};
+
+/**
+ * @brief Latest profSample() results.
+ */
+struct ProfSample {
+  uint32_t loops;        ///< profLoop() calls since boot
+  uint32_t loopRateHz;   ///< loop() iterations per second over the last sample period
+  HalMemInfo mem;        ///< Margins at the last sample
+  uint32_t minFreeHeap;  ///< Lowest free heap seen
+  uint32_t minFreeStack; ///< Lowest free stack seen
+};
+
+/**
+ * @brief Position of a /metrics response being written.
+ */
+struct ProfCursor {
+  uint8_t item;         ///< Section being written
+  uint8_t stage;
+  uint8_t bucket;
+  uint32_t cumulative;  ///< Runs in the buckets written so far
+  ProfHistogram snap;   ///< Copy of the stage being written
+  char line[240];       ///< Formatted text not yet fully copied out
+  uint8_t lineLen;
+  uint8_t lineOff;
+};
+
+void profBegin();
+
+/**
+ * @brief Start timing a stage: the cycle counter to pass to profEnd().
+ */
+static inline uint32_t profStart() {
+  return halCycles();
+}
+
+void profEnd(uint8_t stage, uint32_t startCycles);
+void profLoop();
+void profSample();
+
+const char *profStageName(uint8_t stage);
+bool profHistogram(uint8_t stage, ProfHistogram &out);
+void profSampled(ProfSample &out);
+
+void   profMetricsBegin(ProfCursor &c);
+size_t profMetricsRead(ProfCursor &c, char *out, size_t maxLen);
@@ -0,0 +1,220 @@
+/**
+ * @file scheduler.cpp
+ * @brief Deadline-driven cooperative task scheduler.
+ *
+ * @details
+ * Tasks are kept in a binary min-heap ordered by deadline, then priority. loop() calls
+ * schedulerRun(), which starts every task whose deadline has passed and then idles the
+ * CPU until the next deadline instead of spinning.
+ *
+ * - Periodic tasks (periodMs > 0) are re-armed at deadline + period, so their rate does
+ *   not drift with execution time. If a task starts a whole period late, the missed
+ *   activations are dropped and counted as overruns instead of being run back to back.
+ * - One-shot tasks (periodMs == 0) run once per schedulerWake().
+ *
+ * Deadlines are compared with wrap-safe signed differences, so millis() overflow after
+ * ~49 days is harmless. No memory is allocated.
+ */
+#include "scheduler.h"
+#include "hal.h"
+#include "heapGuard.h"
+
+struct Task {
+  const char *name;
+  TaskFn fn;
+  uint32_t periodMs;
+  uint32_t dueMs;
+  uint8_t priority;
+  int8_t heapPos;     ///< Index in heap[], or -1 while not armed
+  uint32_t runs;
+  uint32_t overruns;
+  uint32_t maxLateMs;
+};
+
+/// Internal state
+static Task tasks[SCHED_MAX_TASKS];
+static uint8_t taskCount = 0;
+static uint8_t heap[SCHED_MAX_TASKS];
+static uint8_t heapSize = 0;
+
+/**
+ * @brief Heap order: earlier deadline first, then higher priority.
+ */
+static bool before(uint8_t a, uint8_t b) {
+  const int32_t d = (int32_t)(tasks[a].dueMs - tasks[b].dueMs);
+  if (d != 0) return d < 0;
+  return tasks[a].priority < tasks[b].priority;
+}
+
+static void heapPlace(uint8_t pos, uint8_t id) {
+  heap[pos] = id;
+  tasks[id].heapPos = (int8_t)pos;
+}
+
+static void siftUp(uint8_t pos) {
+  const uint8_t id = heap[pos];
+  while (pos > 0) {
+    const uint8_t parent = (uint8_t)((pos - 1) / 2);
+    if (!before(id, heap[parent])) break;
+    heapPlace(pos, heap[parent]);
+    pos = parent;
+  }
+  heapPlace(pos, id);
+}
+
+static void siftDown(uint8_t pos) {
+  const uint8_t id = heap[pos];
+  for (;;) {
+    uint8_t child = (uint8_t)(2 * pos + 1);
+    if (child >= heapSize) break;
+    if (child + 1 < heapSize && before(heap[child + 1], heap[child])) child++;
+    if (!before(heap[child], id)) break;
+    heapPlace(pos, heap[child]);
+    pos = child;
+  }
+  heapPlace(pos, id);
+}
+
+static void heapPush(uint8_t id) {
+  heapPlace(heapSize, id);
+  siftUp(heapSize++);
+}
+
+static void heapRemove(uint8_t id) {
+  const uint8_t pos = (uint8_t)tasks[id].heapPos;
+  tasks[id].heapPos = -1;
+  heapSize--;
+  if (pos == heapSize) return;
+
+  heapPlace(pos, heap[heapSize]);
+  if (pos > 0 && before(heap[pos], heap[(pos - 1) / 2])) siftUp(pos);
+  else siftDown(pos);
+}
+
+/**
+ * @brief Remove all tasks.
+ *
+ * Call once in setup() before registering tasks.
+ */
+void schedulerBegin() {
+  taskCount = 0;
+  heapSize = 0;
+}
+
+/**
+ * @brief Register a task.
+ *
+ * @param name         Name used in statistics (must outlive the scheduler).
+ * @param fn           Task body.
+ * @param periodMs     Period in milliseconds, or 0 for a one-shot task.
+ * @param priority     SCHED_PRIO_* tie-break for tasks due at the same time.
+ * @param firstDelayMs Delay until the first run. One-shot tasks are only armed
+ *                     if this is non-zero; otherwise they wait for schedulerWake().
+ * @return Task id, or -1 if the task table is full.
+ */
+int8_t schedulerAdd(const char *name, TaskFn fn, uint32_t periodMs, uint8_t priority, uint32_t firstDelayMs) {
+  if (taskCount >= SCHED_MAX_TASKS) return -1;
+
+  const uint8_t id = taskCount++;
+  Task &t = tasks[id];
+  t.name = name;
+  t.fn = fn;
+  t.periodMs = periodMs;
+  t.dueMs = halMillis() + firstDelayMs;
+  t.priority = priority;
+  t.heapPos = -1;
+  t.runs = 0;
+  t.overruns = 0;
+  t.maxLateMs = 0;
+
+  if (periodMs > 0 || firstDelayMs > 0) heapPush(id);
+  return (int8_t)id;
+}
+
+/**
+ * @brief (Re)arm a task to run @p delayMs from now.
+ *
+ * Works for both kinds of task; a periodic task continues with its normal
+ * period after that run. May be called from inside the task itself.
+ */
+void schedulerWake(int8_t id, uint32_t delayMs) {
+  if (id < 0 || id >= taskCount) return;
+
+  Task &t = tasks[id];
+  if (t.heapPos >= 0) heapRemove((uint8_t)id);
+  t.dueMs = halMillis() + delayMs;
+  heapPush((uint8_t)id);
+}
+
+/**
+ * @brief Disarm a task until the next schedulerWake().
+ */
+void schedulerCancel(int8_t id) {
+  if (id < 0 || id >= taskCount) return;
+  if (tasks[id].heapPos >= 0) heapRemove((uint8_t)id);
+}
+
+/**
+ * @brief Run all due tasks, then idle until the next deadline.
+ *
+ * Call from loop(). Each task runs at most once per call, so a task that is
+ * always due cannot starve the others or the WiFi stack. The idle time is
+ * capped at SCHED_MAX_IDLE_MS.
+ */
+void schedulerRun() {
+  uint8_t budget = taskCount;
+
+  while (heapSize > 0 && budget-- > 0) {
+    const uint32_t now = halMillis();
+    const uint8_t id = heap[0];
+    Task &t = tasks[id];
+    if ((int32_t)(now - t.dueMs) < 0) break;
+
+    const uint32_t late = now - t.dueMs;
+    if (late > t.maxLateMs) t.maxLateMs = late;
+
+    heapRemove(id);
+    if (t.periodMs > 0) {
+      uint32_t next = t.dueMs + t.periodMs;
+      if ((int32_t)(now - next) >= 0) {
+        t.overruns++;
+        next = now + t.periodMs;
+      }
+      t.dueMs = next;
+      heapPush(id);
+    }
+
+    t.runs++;
+    heapGuardEnter((int8_t)id);
+    t.fn();
+    heapGuardLeave();
+  }
+
+  uint32_t idleMs = SCHED_MAX_IDLE_MS;
+  if (heapSize > 0) {
+    const int32_t wait = (int32_t)(tasks[heap[0]].dueMs - halMillis());
+    if (wait <= 0) return;
+    if ((uint32_t)wait < idleMs) idleMs = (uint32_t)wait;
+  }
+  halIdle(idleMs);
+}
+
+uint8_t schedulerTaskCount() {
+  return taskCount;
+}
+
+/**
+ * @brief Copy the counters of task @p id into @p out.
+ *
+ * @return False if @p id is not a registered task.
+ */
+bool schedulerStats(int8_t id, TaskStats &out) {
+  if (id < 0 || id >= taskCount) return false;
+
+  const Task &t = tasks[id];
+  out.name = t.name;
+  out.runs = t.runs;
+  out.overruns = t.overruns;
+  out.maxLateMs = t.maxLateMs;
+  return true;
+}
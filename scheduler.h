@@ -0,0 +1,38 @@
+#pragma once
+#include <stdint.h>
+
+/**
+ * @file scheduler.h
+ * @brief Deadline-driven cooperative task scheduler.
+ */
+
+/// Task body. Runs to completion in loop() context.
+typedef void (*TaskFn)();
+
+/// Maximum number of registered tasks
+static const uint8_t SCHED_MAX_TASKS = 16;
+
+/// Longest single idle period, so network callbacks that change targets are picked up quickly
+static const uint32_t SCHED_MAX_IDLE_MS = 20;
+
+/// Tie-break between tasks due at the same time (lower runs first)
+static const uint8_t SCHED_PRIO_HIGH   = 0;
+static const uint8_t SCHED_PRIO_NORMAL = 1;
+static const uint8_t SCHED_PRIO_LOW    = 2;
+
+/// Per-task counters reported by schedulerStats()
+struct TaskStats {
+  const char *name;
+  uint32_t runs;      ///< Number of times the task ran
+  uint32_t overruns;  ///< Activations skipped because the task ran a full period late
+  uint32_t maxLateMs; ///< Largest observed delay between deadline and start
+};
+
+void   schedulerBegin();
+int8_t schedulerAdd(const char *name, TaskFn fn, uint32_t periodMs, uint8_t priority, uint32_t firstDelayMs = 0);
+void   schedulerWake(int8_t id, uint32_t delayMs);
+void   schedulerCancel(int8_t id);
+void   schedulerRun();
+
+uint8_t schedulerTaskCount();
+bool    schedulerStats(int8_t id, TaskStats &out);
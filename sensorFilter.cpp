@@ -0,0 +1,124 @@
+/**
+ * @file sensorFilter.cpp
+ * @brief Sliding-window median / MAD outlier rejection and EMA for sensor samples.
+ *
+ * @details The window is kept twice: in arrival order (to know which sample
+ * leaves next) and sorted (for the order statistics). Removing the oldest
+ * sample and inserting the new one are a binary search and a short memmove
+ * each, so the median is read directly. The deviations |x - median| of a
+ * sorted window form two sorted runs, one on each side of the median, so the
+ * MAD is the k-th smallest of two sorted sequences and is found by binary
+ * search, without sorting the deviations.
+ */
+#include "sensorFilter.h"
+#include <string.h>
+
+/**
+ * @brief Set up @p f with @p cfg and an empty window.
+ */
+void filterInit(SensorFilter &f, const FilterConfig &cfg) {
+  f.cfg = cfg;
+  if (f.cfg.window < 1) f.cfg.window = 1;
+  if (f.cfg.window > FILTER_WINDOW_MAX) f.cfg.window = FILTER_WINDOW_MAX;
+  if (f.cfg.emaShift > 8) f.cfg.emaShift = 8;
+  f.rejected = 0;
+  filterReset(f);
+}
+
+/**
+ * @brief Forget the window and the average (e.g. after the sensor was lost).
+ */
+void filterReset(SensorFilter &f) {
+  f.count = 0;
+  f.head = 0;
+  f.ema = 0;
+}
+
+/// First position in sorted[0..n) whose value is not less than @p v
+static uint8_t lowerBound(const int16_t *sorted, uint8_t n, int16_t v) {
+  uint8_t lo = 0, hi = n;
+  while (lo < hi) {
+    const uint8_t mid = (uint8_t)((lo + hi) / 2);
+    if (sorted[mid] < v) lo = (uint8_t)(mid + 1);
+    else hi = mid;
+  }
+  return lo;
+}
+
+/**
+ * @brief Median of the window (the lower one for an even count); 0 if empty.
+ */
+int16_t filterMedian(const SensorFilter &f) {
+  return f.count ? f.sorted[(f.count - 1) / 2] : 0;
+}
+
+/**
+ * @brief Median absolute deviation of the window (lower median for an even count).
+ */
+int32_t filterMad(const SensorFilter &f) {
+  if (f.count == 0) return 0;
+  const uint8_t m = (uint8_t)((f.count - 1) / 2);
+  const int32_t med = f.sorted[m];
+  // Deviations below the median, ascending: a(i) = med - sorted[m - 1 - i], i < m.
+  // Deviations from the median up, ascending:  b(j) = sorted[m + j] - med.
+  const uint8_t na = m, nb = (uint8_t)(f.count - m);
+  auto a = [&](int i) { return med - f.sorted[m - 1 - i]; };
+  auto b = [&](int j) { return (int32_t)f.sorted[m + j] - med; };
+
+  // k-th smallest of the union: take i from a and k + 1 - i from b.
+  const int k = (f.count - 1) / 2;
+  int lo = k + 1 > nb ? k + 1 - nb : 0;
+  int hi = k + 1 < na ? k + 1 : na;
+  while (lo < hi) {
+    const int i = (lo + hi) / 2;
+    const int j = k + 1 - i;
+    if (j > 0 && b(j - 1) > a(i)) lo = i + 1; // a(i) belongs below the k-th: take more of a
+    else hi = i;
+  }
+  const int i = lo, j = k + 1 - lo;
+  const int32_t fromA = i > 0 ? a(i - 1) : INT32_MIN;
+  const int32_t fromB = j > 0 ? b(j - 1) : INT32_MIN;
+  return fromA > fromB ? fromA : fromB;
+}
+
+/**
+ * @brief Filter one sample.
+ *
+ * @return The filtered value, in the unit of @p sample.
+ */
+int16_t filterPush(SensorFilter &f, int16_t sample) {
+  const bool first = f.count == 0;
+  int16_t clean = sample;
+  if (f.count >= FILTER_MIN_SAMPLES) {
+    const int32_t med = filterMedian(f);
+    const int32_t mad = filterMad(f);
+    int32_t limit = mad * f.cfg.madMultiple;
+    if (limit < f.cfg.minDeviation) limit = f.cfg.minDeviation;
+    const int32_t dev = sample > med ? sample - med : med - sample;
+    if (dev > limit) {
+      clean = (int16_t)med;
+      f.rejected++;
+    }
+  }
+
+  // Slide the window: drop the oldest sample from the sorted copy, insert the new one.
+  if (f.count == f.cfg.window) {
+    const uint8_t old = lowerBound(f.sorted, f.count, f.ring[f.head]);
+    memmove(f.sorted + old, f.sorted + old + 1, (size_t)(f.count - old - 1) * sizeof(int16_t));
+    f.count--;
+    f.ring[f.head] = sample;
+    if (++f.head == f.cfg.window) f.head = 0;
+  } else {
+    f.ring[f.count] = sample; // head stays 0 until the window is full
+  }
+  const uint8_t pos = lowerBound(f.sorted, f.count, sample);
+  memmove(f.sorted + pos + 1, f.sorted + pos, (size_t)(f.count - pos) * sizeof(int16_t));
+  f.sorted[pos] = sample;
+  f.count++;
+
+  // EMA in 1/256 units; the first sample starts it.
+  const int32_t x = (int32_t)clean * 256;
+  if (first) f.ema = x;
+  else f.ema += (x - f.ema) / (1 << f.cfg.emaShift);
+  return (int16_t)((f.ema + (f.ema >= 0 ? 128 : -128)) / 256);
+}
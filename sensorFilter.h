@@ -0,0 +1,57 @@
+#pragma once
+#include <stdint.h>
+
+/**
+ * @file sensorFilter.h
+ * @brief Sliding-window filter stage between the sensor drivers and SharedState.
+ *
+ * @details Every sample passes two steps:
+ *  1. Outlier rejection (Hampel filter): a sample further from the window's median
+ *     than max(minDeviation, madMultiple * MAD) is replaced by the median. MAD is
+ *     the median absolute deviation of the window.
+ *  2. Exponential moving average with weight 1 / 2^emaShift.
+ *
+ * The raw sample enters the window either way, so a real step change is
+ * followed once it has lasted for half a window, while a single bad frame or
+ * spike never reaches the output.
+ *
+ * Samples are integers in the sensor's own unit (tenths of a degree, ADC
+ * counts). A filter holds no pointers and never allocates. Per sample it costs
+ * O(log w) comparisons (binary searches for the median, the MAD and the
+ * insertion point) plus one memmove of at most w - 1 entries.
+ */
+
+/// Largest window a filter can hold
+static const uint8_t FILTER_WINDOW_MAX = 9;
+
+/**
+ * @brief Tuning of one filter.
+ */
+struct FilterConfig {
+  uint8_t window;       ///< Samples in the window (1 .. FILTER_WINDOW_MAX; odd is best)
+  uint8_t emaShift;     ///< EMA weight 1 / 2^emaShift; 0 passes the cleaned sample through
+  uint8_t madMultiple;  ///< Rejection distance in MADs
+  int16_t minDeviation; ///< Rejection distance never below this (the MAD of a flat signal is 0)
+};
+
+/**
+ * @brief State of one filter (one sensor channel).
+ */
+struct SensorFilter {
+  FilterConfig cfg;
+  int16_t ring[FILTER_WINDOW_MAX];   ///< Samples in arrival order
+  int16_t sorted[FILTER_WINDOW_MAX]; ///< The same samples in ascending order
+  uint8_t count;                     ///< Samples in the window
+  uint8_t head;                      ///< Ring position of the oldest sample
+  int32_t ema;                       ///< Average in 1/256 units
+  uint32_t rejected;                 ///< Samples replaced by the median so far
+};
+
+/// Samples needed before outliers are rejected
+static const uint8_t FILTER_MIN_SAMPLES = 3;
+
+void filterInit(SensorFilter &f, const FilterConfig &cfg);
+void filterReset(SensorFilter &f);
+int16_t filterPush(SensorFilter &f, int16_t sample);
+int16_t filterMedian(const SensorFilter &f);
+int32_t filterMad(const SensorFilter &f);
@@ -0,0 +1,251 @@
+/**
+ * @file seriesCodec.cpp
+ * @brief Bit writer/reader and the delta-of-delta / zigzag-delta series codec.
+ *
+ * @details Every record, the first one included, is coded against the
+ * previous one, starting from time 0, delta 0 and all values 0; the first
+ * record simply falls into the widest codes. So an empty block is just the
+ * end marker and the decoder needs no special first step.
+ */
+#include "seriesCodec.h"
+#include <string.h>
+
+/// Bits of the end marker, kept free by seriesAppend()
+static const uint8_t END_BITS = 4 + 32;
+static const int32_t END_MARK = INT32_MIN;
+
+/**
+ * @brief Start writing into @p buf (@p len bytes).
+ */
+void bitWriterBegin(BitWriter &w, uint8_t *buf, size_t len) {
+  w.buf = buf;
+  w.capBits = len * 8;
+  w.bitPos = 0;
+  w.overflow = false;
+}
+
+/**
+ * @brief Append the low @p bits bits of @p value (at most 32), most significant first.
+ *
+ * Bits already in the buffer at those positions are overwritten, so a writer
+ * can be rewound by resetting bitPos. A write that does not fit sets overflow
+ * and writes nothing.
+ */
+void bitWrite(BitWriter &w, uint32_t value, uint8_t bits) {
+  if (w.bitPos + bits > w.capBits) {
+    w.overflow = true;
+    return;
+  }
+  size_t pos = w.bitPos;
+  while (bits > 0) {
+    const uint8_t room = (uint8_t)(8 - (pos & 7));
+    const uint8_t take = bits < room ? bits : room;
+    const uint8_t shift = (uint8_t)(room - take);
+    const uint8_t mask = (uint8_t)(((1u << take) - 1) << shift);
+    const uint8_t chunk = (uint8_t)(((value >> (bits - take)) << shift) & mask);
+    uint8_t &b = w.buf[pos >> 3];
+    b = (uint8_t)((b & ~mask) | chunk);
+    pos += take;
+    bits = (uint8_t)(bits - take);
+  }
+  w.bitPos = pos;
+}
+
+/**
+ * @brief Bytes used so far (the last one may be partly filled).
+ */
+size_t bitWriterBytes(const BitWriter &w) {
+  return (w.bitPos + 7) / 8;
+}
+
+/**
+ * @brief Start reading @p len bytes at @p buf.
+ */
+void bitReaderBegin(BitReader &r, const uint8_t *buf, size_t len) {
+  r.buf = buf;
+  r.lenBits = len * 8;
+  r.bitPos = 0;
+  r.overrun = false;
+}
+
+/**
+ * @brief Take the next @p bits bits (at most 32).
+ *
+ * Away from the end of the buffer this is one unaligned 64-bit load.
+ */
+uint32_t bitRead(BitReader &r, uint8_t bits) {
+  if (bits == 0) return 0;
+  if (r.bitPos + bits > r.lenBits) {
+    r.overrun = true;
+    r.bitPos = r.lenBits;
+    return 0;
+  }
+  const size_t byte = r.bitPos >> 3;
+  const uint8_t skip = (uint8_t)(r.bitPos & 7);
+  r.bitPos += bits;
+  if (byte + 8 <= (r.lenBits >> 3)) {
+    uint64_t window;
+    memcpy(&window, r.buf + byte, sizeof(window));
+    window = __builtin_bswap64(window);
+    return (uint32_t)((window << skip) >> (64 - bits));
+  }
+  // Near the end: byte by byte
+  uint64_t acc = 0;
+  const size_t last = (r.bitPos + 7) >> 3;
+  for (size_t i = byte; i < last; i++) acc = (acc << 8) | r.buf[i];
+  const uint8_t spare = (uint8_t)(((last - byte) * 8) - skip - bits);
+  return (uint32_t)((acc >> spare) & (bits == 32 ? 0xFFFFFFFFu : ((1u << bits) - 1)));
+}
+
+/// Sign-extend the low @p bits bits of @p v
+static int32_t signExtend(uint32_t v, uint8_t bits) {
+  return (int32_t)(v << (32 - bits)) >> (32 - bits);
+}
+
+static void writeDod(BitWriter &w, int32_t dod) {
+  if (dod == 0) bitWrite(w, 0, 1);
+  else if (dod >= -64 && dod <= 63) bitWrite(w, (0x2u << 7) | ((uint32_t)dod & 0x7F), 9);
+  else if (dod >= -256 && dod <= 255) bitWrite(w, (0x6u << 9) | ((uint32_t)dod & 0x1FF), 12);
+  else if (dod >= -2048 && dod <= 2047) bitWrite(w, (0xEu << 12) | ((uint32_t)dod & 0xFFF), 16);
+  else {
+    bitWrite(w, 0xF, 4);
+    bitWrite(w, (uint32_t)dod, 32);
+  }
+}
+
+static void writeValue(BitWriter &w, int16_t prev, int16_t v) {
+  const int32_t d = (int32_t)v - prev;
+  const uint32_t z = ((uint32_t)d << 1) ^ (uint32_t)(d >> 31);
+  if (z == 0) bitWrite(w, 0, 1);
+  else if (z <= 4) bitWrite(w, (0x2u << 2) | (z - 1), 4);
+  else if (z <= 20) bitWrite(w, (0x6u << 4) | (z - 5), 7);
+  else if (z <= 276) bitWrite(w, (0xEu << 8) | (z - 21), 12);
+  else bitWrite(w, (0xFu << 16) | (uint16_t)v, 20);
+}
+
+/**
+ * @brief Number of leading 1 bits of the next code (0 .. 4); consumes them and the terminating 0.
+ */
+static uint8_t readPrefix(BitReader &r) {
+  uint8_t ones = 0;
+  while (ones < 4 && bitRead(r, 1)) ones++;
+  return ones;
+}
+
+/**
+ * @brief Start an empty block of @p columns values per record in @p buf.
+ */
+void seriesEncoderBegin(SeriesEncoder &e, uint8_t *buf, size_t len, uint8_t columns) {
+  bitWriterBegin(e.w, buf, len);
+  e.columns = columns > SERIES_MAX_COLUMNS ? SERIES_MAX_COLUMNS : columns;
+  e.count = 0;
+  e.prevTime = 0;
+  e.prevDelta = 0;
+  memset(e.prev, 0, sizeof(e.prev));
+  e.finished = false;
+}
+
+/**
+ * @brief Add one record: @p time and e.columns @p values.
+ *
+ * @return false, leaving the block unchanged, if the record would not fit
+ * (room for the end marker is always kept) or the block was finished.
+ */
+bool seriesAppend(SeriesEncoder &e, uint32_t time, const int16_t *values) {
+  if (e.finished) return false;
+  const int32_t delta = (int32_t)(time - e.prevTime);
+  const int32_t dod = (int32_t)((uint32_t)delta - (uint32_t)e.prevDelta);
+  if (dod == END_MARK) return false;
+
+  const size_t start = e.w.bitPos;
+  writeDod(e.w, dod);
+  for (uint8_t c = 0; c < e.columns; c++) writeValue(e.w, e.prev[c], values[c]);
+  if (e.w.overflow || e.w.bitPos + END_BITS > e.w.capBits) {
+    e.w.bitPos = start;
+    e.w.overflow = false;
+    return false;
+  }
+
+  e.prevDelta = delta;
+  e.prevTime = time;
+  memcpy(e.prev, values, e.columns * sizeof(int16_t));
+  e.count++;
+  return true;
+}
+
+/**
+ * @brief Close the block with the end marker.
+ *
+ * @return Length of the block in bytes (the unused bits of the last byte are 0).
+ */
+size_t seriesFinish(SeriesEncoder &e) {
+  if (!e.finished) {
+    bitWrite(e.w, 0xF, 4);
+    bitWrite(e.w, (uint32_t)END_MARK, 32);
+    const uint8_t pad = (uint8_t)((8 - (e.w.bitPos & 7)) & 7);
+    if (pad) bitWrite(e.w, 0, pad);
+    e.finished = true;
+  }
+  return bitWriterBytes(e.w);
+}
+
+/**
+ * @brief Start decoding the block of @p len bytes at @p buf.
+ */
+void seriesDecoderBegin(SeriesDecoder &d, const uint8_t *buf, size_t len, uint8_t columns) {
+  bitReaderBegin(d.r, buf, len);
+  d.columns = columns > SERIES_MAX_COLUMNS ? SERIES_MAX_COLUMNS : columns;
+  d.count = 0;
+  d.prevTime = 0;
+  d.prevDelta = 0;
+  memset(d.prev, 0, sizeof(d.prev));
+  d.done = false;
+}
+
+/**
+ * @brief Decode the next record.
+ *
+ * @return false at the end marker, or if the block is cut short.
+ */
+bool seriesNext(SeriesDecoder &d, uint32_t &time, int16_t *values) {
+  if (d.done) return false;
+
+  int32_t dod;
+  switch (readPrefix(d.r)) {
+    case 0: dod = 0; break;
+    case 1: dod = signExtend(bitRead(d.r, 7), 7); break;
+    case 2: dod = signExtend(bitRead(d.r, 9), 9); break;
+    case 3: dod = signExtend(bitRead(d.r, 12), 12); break;
+    default: dod = (int32_t)bitRead(d.r, 32); break;
+  }
+  if (dod == END_MARK || d.r.overrun) {
+    d.done = true;
+    return false;
+  }
+
+  for (uint8_t c = 0; c < d.columns; c++) {
+    uint32_t z;
+    switch (readPrefix(d.r)) {
+      case 0: z = 0; break;
+      case 1: z = bitRead(d.r, 2) + 1; break;
+      case 2: z = bitRead(d.r, 4) + 5; break;
+      case 3: z = bitRead(d.r, 8) + 21; break;
+      default:
+        d.prev[c] = (int16_t)bitRead(d.r, 16);
+        continue;
+    }
+    const int32_t delta = (int32_t)(z >> 1) ^ -(int32_t)(z & 1);
+    d.prev[c] = (int16_t)(d.prev[c] + delta);
+  }
+  if (d.r.overrun) {
+    d.done = true;
+    return false;
+  }
+
+  d.prevDelta = (int32_t)((uint32_t)d.prevDelta + (uint32_t)dod);
+  d.prevTime += (uint32_t)d.prevDelta;
+  time = d.prevTime;
+  memcpy(values, d.prev, d.columns * sizeof(int16_t));
+  d.count++;
+  return true;
+}
@@ -0,0 +1,111 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @file seriesCodec.h
+ * @brief Gorilla-style compression of time series of fixed-point readings.
+ *
+ * @details A block holds records of one timestamp and up to SERIES_MAX_COLUMNS
+ * int16 values (the fixed-point units of history.h and dataLog.h), as one
+ * MSB-first bit stream:
+ *
+ *  - per record: the time's delta-of-delta, then each value's delta from
+ *    the same column in the previous record. The first record is coded
+ *    against time 0 and values 0, so it simply takes the widest codes;
+ *  - an end marker (time code '1111' with delta-of-delta INT32_MIN), then
+ *    zero bits up to the next byte.
+ *
+ * Delta-of-delta codes (d = (t - t1) - (t1 - t2), as in the Gorilla paper):
+ *
+ * | code   | payload             | range            |
+ * |--------|---------------------|------------------|
+ * | 0      | -                   | d = 0            |
+ * | 10     | 7 bits, signed      | -64 .. 63        |
+ * | 110    | 9 bits, signed      | -256 .. 255      |
+ * | 1110   | 12 bits, signed     | -2048 .. 2047    |
+ * | 1111   | 32 bits, signed     | anything else    |
+ *
+ * Value codes. The readings sit on a fixed grid (a DHT11 reports whole
+ * units), so instead of Gorilla's XOR of floats each value is stored as the
+ * difference from the previous one, zigzag-mapped (0, -1, 1, -2, ... ->
+ * 0, 1, 2, 3, ...) into z:
+ *
+ * | code   | payload             | z                |
+ * |--------|---------------------|------------------|
+ * | 0      | -                   | 0 (unchanged)    |
+ * | 10     | 2 bits, z - 1       | 1 .. 4           |
+ * | 110    | 4 bits, z - 5       | 5 .. 20          |
+ * | 1110   | 8 bits, z - 21      | 21 .. 276        |
+ * | 1111   | 16 bits             | the value itself |
+ *
+ * A steady sensor sampled at a fixed period costs one bit for the time and
+ * one per value. seriesAppend() never writes half a record: when a record
+ * (plus the end marker) does not fit, the block is left as it was and false
+ * is returned, so a block can be filled to the last byte of a fixed buffer.
+ *
+ * The decoder reads 64-bit windows where the buffer allows, so it is fast on
+ * the host; the encoder writes byte by byte and suits the ESP8266.
+ */
+
+/// Most values per record
+static const uint8_t SERIES_MAX_COLUMNS = 8;
+
+/**
+ * @brief Append-only MSB-first bit writer over a fixed buffer.
+ */
+struct BitWriter {
+  uint8_t *buf;
+  size_t capBits;   ///< Buffer size in bits
+  size_t bitPos;    ///< Bits written
+  bool overflow;    ///< A write did not fit (bitPos is unchanged by it)
+};
+
+/**
+ * @brief MSB-first bit reader.
+ */
+struct BitReader {
+  const uint8_t *buf;
+  size_t lenBits;
+  size_t bitPos;
+  bool overrun;     ///< A read went past the end (it returned 0)
+};
+
+void     bitWriterBegin(BitWriter &w, uint8_t *buf, size_t len);
+void     bitWrite(BitWriter &w, uint32_t value, uint8_t bits);
+size_t   bitWriterBytes(const BitWriter &w);
+void     bitReaderBegin(BitReader &r, const uint8_t *buf, size_t len);
+uint32_t bitRead(BitReader &r, uint8_t bits);
+
+/**
+ * @brief Encoder of one block.
+ */
+struct SeriesEncoder {
+  BitWriter w;
+  uint8_t columns;
+  uint32_t count;          ///< Records appended
+  uint32_t prevTime;
+  int32_t prevDelta;
+  int16_t prev[SERIES_MAX_COLUMNS];
+  bool finished;
+};
+
+/**
+ * @brief Decoder of one block.
+ */
+struct SeriesDecoder {
+  BitReader r;
+  uint8_t columns;
+  uint32_t count;          ///< Records returned
+  uint32_t prevTime;
+  int32_t prevDelta;
+  int16_t prev[SERIES_MAX_COLUMNS];
+  bool done;
+};
+
+void   seriesEncoderBegin(SeriesEncoder &e, uint8_t *buf, size_t len, uint8_t columns);
+bool   seriesAppend(SeriesEncoder &e, uint32_t time, const int16_t *values);
+size_t seriesFinish(SeriesEncoder &e);
+
+void seriesDecoderBegin(SeriesDecoder &d, const uint8_t *buf, size_t len, uint8_t columns);
+bool seriesNext(SeriesDecoder &d, uint32_t &time, int16_t *values);
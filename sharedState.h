@@ -6,25 +6,73 @@
  * @brief Shared state container for sensors + actuators.
  *
  * Modules write/read to/from this struct to coordinate behavior.
+ *
+ * One board can drive several greenhouse zones (benches). Every per-zone value
+ * is an array indexed by zone, so the control kernels can update all zones in
+ * one pass over contiguous memory; only zones 0 .. zoneCount-1 are in use.
+ * The pins of each zone are set up in zones.h.
+ *
+ * Only loop() writes it; the network callbacks read published snapshots and
+ * queue their changes through stateSync.h.
  */
+
+/// Largest number of zones one board can drive
+static const uint8_t ZONE_MAX = 4;
+
 struct SharedState {
+  uint8_t zoneCount = 1;      ///< Zones in use
+
   // --- DHT11: Temperature and humidity ---
-  float tempC = NAN;          ///< Latest temperature in °C (NAN if invalid)
-  float humidityPct = NAN;    ///< Latest humidity in % (NAN if invalid)
-  bool  hasDht = false;       ///< True if last DHT read succeeded
+  float tempC[ZONE_MAX];          ///< Latest temperature in °C (NAN if invalid)
+  float humidityPct[ZONE_MAX];    ///< Latest humidity in % (NAN if invalid)
+  bool  hasDht[ZONE_MAX];         ///< True while the DHT delivers good frames
+  uint32_t dhtSampleMs[ZONE_MAX]; ///< halMillis() time of the latest good DHT frame
+  uint32_t dhtSeq[ZONE_MAX];      ///< Incremented on every new DHT sample
+  uint32_t dhtErrors[ZONE_MAX];   ///< DHT frames lost to timeouts or checksum errors
 
   // --- Light module ---
-  float lightHoursToday = 0.0f; ///< Accumulated hours of effective light today
-  bool  lampOn = false;        ///< True when lamp LED output is ON
+  float lightHoursToday[ZONE_MAX]; ///< Accumulated hours of effective light today
+  bool  lampOn[ZONE_MAX];          ///< True when lamp LED output is ON
 
   uint32_t dayStartMs = 0;
 
   // --- Actuator states ---
-  bool heaterOn = false;      ///< True when heater output is ON
-  bool misterOn = false;      ///< True when mister output is ON
+  bool heaterOn[ZONE_MAX];    ///< True when heater output is ON
+  bool misterOn[ZONE_MAX];    ///< True when mister output is ON
 
   // --- Targets (set by main / controller) ---
-  float targetTempC = 27.0f;        ///< Desired temperature (°C)
-  float targetHumidityPct = 65.0f;  ///< Desired humidity (%)
-  float targetLightHoursToday = 6.0f;      ///< Desired light hours per day
+  float targetTempC[ZONE_MAX];           ///< Desired temperature (°C)
+  float targetHumidityPct[ZONE_MAX];     ///< Desired humidity (%)
+  float targetLightHoursToday[ZONE_MAX]; ///< Desired light hours per day
+
+  // --- Change tracking ---
+  uint32_t generation = 0;    ///< Incremented whenever a value shown on the dashboard changes
+
+  SharedState() {
+    for (uint8_t z = 0; z < ZONE_MAX; z++) {
+      tempC[z] = NAN;
+      humidityPct[z] = NAN;
+      hasDht[z] = false;
+      dhtSampleMs[z] = 0;
+      dhtSeq[z] = 0;
+      dhtErrors[z] = 0;
+      lightHoursToday[z] = 0.0f;
+      lampOn[z] = false;
+      heaterOn[z] = false;
+      misterOn[z] = false;
+      targetTempC[z] = 27.0f;
+      targetHumidityPct[z] = 65.0f;
+      targetLightHoursToday[z] = 6.0f;
+    }
+  }
 };
+
+/**
+ * @brief Record that a dashboard-visible value in @p state changed.
+ *
+ * Writers call this after changing readings, actuator states or targets, so
+ * consumers can compare generations instead of polling every field.
+ */
+inline void stateChanged(SharedState &state) {
+  state.generation++;
+}
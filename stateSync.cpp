@@ -0,0 +1,114 @@
+/**
+ * @file stateSync.cpp
+ * @brief Seqlock-published SharedState snapshots and the network command queue.
+ *
+ * @details Seqlock: the writer makes the sequence odd, stores the copy and makes
+ * it even again; a reader copies between two loads of the sequence and retries
+ * if it was odd or moved. The copy is kept as relaxed atomic words, with fences
+ * ordering them against the sequence, so a racing read is well defined and
+ * merely discarded.
+ *
+ * Queue: head and tail are free-running counters, published with release
+ * order after the slot is written or read, as in eventLog.cpp.
+ */
+#include "stateSync.h"
+#include <atomic>
+#include <string.h>
+
+static_assert((STATE_QUEUE_SLOTS & (STATE_QUEUE_SLOTS - 1)) == 0, "queue size must be a power of two");
+
+static const size_t SNAPSHOT_WORDS = (sizeof(SharedState) + 3) / 4;
+
+static std::atomic<uint32_t> snapshotSeq(0);
+static std::atomic<uint32_t> snapshot[SNAPSHOT_WORDS];
+static uint32_t publishedGeneration = 0;   ///< Writer side only
+
+static StateCommand queue[STATE_QUEUE_SLOTS];
+static std::atomic<uint32_t> head(0);      ///< Written by the producer
+static std::atomic<uint32_t> tail(0);      ///< Written by loop()
+static std::atomic<uint32_t> dropped(0);
+
+/**
+ * @brief Empty the queue and publish the first snapshot (call in setup()).
+ */
+void stateSyncBegin(const SharedState &state) {
+  head.store(0, std::memory_order_relaxed);
+  tail.store(0, std::memory_order_relaxed);
+  dropped.store(0, std::memory_order_relaxed);
+  publishedGeneration = state.generation - 1;
+  stateSyncPublish(state);
+}
+
+/**
+ * @brief Publish @p state for stateSyncRead() if its generation changed (loop() only).
+ *
+ * @return True if a new snapshot was published.
+ */
+bool stateSyncPublish(const SharedState &state) {
+  if (state.generation == publishedGeneration) return false;
+  publishedGeneration = state.generation;
+
+  uint32_t words[SNAPSHOT_WORDS] = {0};
+  memcpy(words, &state, sizeof(SharedState));
+
+  const uint32_t seq = snapshotSeq.load(std::memory_order_relaxed);
+  snapshotSeq.store(seq + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  for (size_t i = 0; i < SNAPSHOT_WORDS; i++) snapshot[i].store(words[i], std::memory_order_relaxed);
+  snapshotSeq.store(seq + 2, std::memory_order_release);
+  return true;
+}
+
+/**
+ * @brief Copy the latest published snapshot into @p out (any context).
+ *
+ * @return Number of retries because the writer was busy (0 on the ESP8266).
+ */
+uint32_t stateSyncRead(SharedState &out) {
+  uint32_t words[SNAPSHOT_WORDS];
+  for (uint32_t retries = 0;; retries++) {
+    const uint32_t before = snapshotSeq.load(std::memory_order_acquire);
+    if (before & 1) continue;
+    for (size_t i = 0; i < SNAPSHOT_WORDS; i++) words[i] = snapshot[i].load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (snapshotSeq.load(std::memory_order_relaxed) != before) continue;
+    memcpy(&out, words, sizeof(SharedState));
+    return retries;
+  }
+}
+
+/**
+ * @brief Queue a command frame for loop() (from the network side).
+ *
+ * @return False, and the frame is counted as dropped, if the queue is full.
+ */
+bool stateSyncPost(const StateCommand &cmd) {
+  const uint32_t h = head.load(std::memory_order_relaxed);
+  if (h - tail.load(std::memory_order_acquire) >= STATE_QUEUE_SLOTS) {
+    dropped.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  queue[h & (STATE_QUEUE_SLOTS - 1)] = cmd;
+  head.store(h + 1, std::memory_order_release);
+  return true;
+}
+
+/**
+ * @brief Take the oldest queued command frame (loop() only).
+ *
+ * @return False if the queue is empty.
+ */
+bool stateSyncTake(StateCommand &cmd) {
+  const uint32_t t = tail.load(std::memory_order_relaxed);
+  if (t == head.load(std::memory_order_acquire)) return false;
+  cmd = queue[t & (STATE_QUEUE_SLOTS - 1)];
+  tail.store(t + 1, std::memory_order_release);
+  return true;
+}
+
+/**
+ * @brief Command frames dropped on a full queue.
+ */
+uint32_t stateSyncDropped() {
+  return dropped.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include <stdint.h>
+#include "sharedState.h"
+#include "wsCommand.h"
+
+/**
+ * @file stateSync.h
+ * @brief Hand-over of SharedState between loop() and the network callbacks.
+ *
+ * loop() owns SharedState: only its tasks write it. The other contexts use
+ * two lock-free channels instead of touching it:
+ *  - Snapshots (seqlock): loop() publishes a copy with stateSyncPublish();
+ *    any context reads a consistent copy with stateSyncRead(), never a
+ *    half-written one, and nobody disables interrupts.
+ *  - Commands (bounded SPSC queue): the network callbacks post parsed command
+ *    frames with stateSyncPost(); loop() takes them with stateSyncTake() and
+ *    applies each frame in one go, so no reader sees half a frame applied.
+ *
+ * On the ESP8266 the AsyncTCP callbacks and loop() take turns, so together
+ * the callbacks are the queue's single producer, and the seqlock never has
+ * to retry. The guarantees also hold when they truly run in parallel (see
+ * host/statestress).
+ */
+
+/// Command frames the queue holds (power of two)
+static const uint8_t STATE_QUEUE_SLOTS = 8;
+
+/**
+ * @brief One command frame on its way from a network callback to loop().
+ */
+struct StateCommand {
+  uint32_t client;        ///< Id of the client to acknowledge (0 = none)
+  WsCommandBatch batch;
+};
+
+void     stateSyncBegin(const SharedState &state);
+bool     stateSyncPublish(const SharedState &state);
+uint32_t stateSyncRead(SharedState &out);
+
+bool     stateSyncPost(const StateCommand &cmd);
+bool     stateSyncTake(StateCommand &cmd);
+uint32_t stateSyncDropped();
@@ -0,0 +1,241 @@
+/**
+ * @file telemetry.cpp
+ * @brief Serialization of the shared state for the WebSocket dashboard.
+ *
+ * @details Two encodings are offered:
+ *  - getSensorReadings(): the original JSON text, kept for older dashboards. The
+ *    top-level keys describe zone 0; "zones" holds the same keys for every zone.
+ *    It is written straight into the caller's buffer with snprintf, so it never
+ *    touches the heap (it used to build a JSONVar tree and a String each time).
+ *  - telemetryEncodeDelta()/telemetryEncodeSnapshot(): the compact binary frame
+ *    described in telemetry.h, with fixed-point values and only changed fields.
+ *
+ * The binary encoder keeps one delta stream shared by all binary clients: the
+ * values of the last broadcast frame are the baseline for the next one.
+ */
+#include "telemetry.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+/// Size in bytes of each binary field
+static const uint8_t FIELD_BYTES[TELEMETRY_FIELDS] = {2, 2, 1, 2, 2, 2};
+
+/// Binary delta stream state
+static int16_t baseline[ZONE_MAX][TELEMETRY_FIELDS];
+static uint8_t baselineZones = 0;
+static bool hasBaseline = false;
+static uint16_t seq = 0;
+static uint8_t framesSinceKey = 0;
+
+/**
+ * @brief Bounded appends to a text buffer; the text is always terminated.
+ */
+struct JsonOut {
+  char *buf;
+  size_t max;
+  size_t n;
+
+  void put(const char *fmt, ...) __attribute__((format(printf, 2, 3))) {
+    if (n + 1 >= max) return;
+    va_list args;
+    va_start(args, fmt);
+    const int written = vsnprintf(buf + n, max - n, fmt, args);
+    va_end(args);
+    if (written > 0) n += (size_t)written;
+    if (n >= max) n = max - 1;
+  }
+};
+
+/**
+ * @brief A measured value rounded to an integer, as the dashboard shows it (null if unknown).
+ */
+static void putRounded(JsonOut &o, const char *key, float v) {
+  if (isnan(v)) {
+    o.put("\"%s\":null", key);
+    return;
+  }
+  if (v < -32767.0f) v = -32767.0f;
+  if (v > 32767.0f) v = 32767.0f;
+  o.put("\"%s\":%ld", key, lroundf(v));
+}
+
+/**
+ * @brief A target with up to two decimals and no trailing zeros, from an integer (no float printf).
+ */
+static void putTarget(JsonOut &o, const char *key, float v) {
+  if (isnan(v)) {
+    o.put("\"%s\":null", key);
+    return;
+  }
+  if (v < -32767.0f) v = -32767.0f;
+  if (v > 32767.0f) v = 32767.0f;
+  const long hundredths = lroundf(v * 100.0f);
+  const long mag = hundredths < 0 ? -hundredths : hundredths;
+  const char *sign = hundredths < 0 ? "-" : "";
+  if (mag % 100 == 0) o.put("\"%s\":%s%ld", key, sign, mag / 100);
+  else if (mag % 10 == 0) o.put("\"%s\":%s%ld.%ld", key, sign, mag / 100, (mag % 100) / 10);
+  else o.put("\"%s\":%s%ld.%02ld", key, sign, mag / 100, mag % 100);
+}
+
+/**
+ * @brief The JSON members of zone @p z, without braces.
+ */
+static void putZone(JsonOut &o, const SharedState &state, uint8_t z) {
+  putRounded(o, "temperature", state.tempC[z]); // actual measured temp
+  o.put(",");
+  putRounded(o, "humidity", state.humidityPct[z]); // actual measured humidity
+  o.put(",\"light\":%s,", state.lampOn[z] ? "true" : "false"); // actual lamp state
+  putTarget(o, "tempTarget", state.targetTempC[z]); // desired temp
+  o.put(",");
+  putTarget(o, "humiTarget", state.targetHumidityPct[z]); // desired humidity
+  o.put(",");
+  putTarget(o, "lightTarget", state.targetLightHoursToday[z]); // desired lamp hours
+}
+
+/**
+ * @brief Collect current sensor readings and targets.
+ *
+ * @details
+ * Writes a JSON object with measured values and configured targets
+ * from the shared system state into @p out.
+ *
+ * @param state  Shared state to serialize.
+ * @param out    Text buffer; TELEMETRY_JSON_MAX bytes always fit.
+ * @param maxLen Size of @p out.
+ * @return Length of the JSON text (always terminated).
+ */
+size_t getSensorReadings(const SharedState &state, char *out, size_t maxLen) {
+  if (maxLen == 0) return 0;
+  JsonOut o = {out, maxLen, 0};
+  out[0] = '\0';
+  o.put("{");
+  putZone(o, state, 0);
+  o.put(",\"zones\":[");
+  for (uint8_t z = 0; z < state.zoneCount; z++) {
+    o.put(z ? ",{" : "{");
+    putZone(o, state, z);
+    o.put("}");
+  }
+  o.put("]}");
+  return o.n;
+}
+
+/**
+ * @brief Convert a value to tenths, saturating to the int16 range.
+ */
+static int16_t toDeci(float v) {
+  if (isnan(v)) return TELEMETRY_INVALID;
+  const float d = roundf(v * 10.0f);
+  if (d <= -32767.0f) return -32767;
+  if (d >= 32767.0f) return 32767;
+  return (int16_t)d;
+}
+
+/**
+ * @brief Take the fixed-point field values of every zone from the state.
+ */
+static void sampleFields(const SharedState &state, int16_t v[ZONE_MAX][TELEMETRY_FIELDS]) {
+  for (uint8_t z = 0; z < state.zoneCount; z++) {
+    v[z][0] = toDeci(state.tempC[z]);
+    v[z][1] = toDeci(state.humidityPct[z]);
+    v[z][2] = (int16_t)((state.lampOn[z] ? 0x01 : 0) | (state.heaterOn[z] ? 0x02 : 0) | (state.misterOn[z] ? 0x04 : 0));
+    v[z][3] = toDeci(state.targetTempC[z]);
+    v[z][4] = toDeci(state.targetHumidityPct[z]);
+    v[z][5] = toDeci(state.targetLightHoursToday[z]);
+  }
+}
+
+/**
+ * @brief Write a frame containing, for each zone, the fields selected by @p masks.
+ *
+ * Zones with an empty mask are left out.
+ *
+ * @return Number of bytes written (at most TELEMETRY_FRAME_MAX).
+ */
+static size_t writeFrame(uint8_t *out, uint8_t flags, const uint8_t masks[ZONE_MAX], uint8_t zones,
+                         const int16_t v[ZONE_MAX][TELEMETRY_FIELDS]) {
+  size_t n = 0;
+  out[n++] = TELEMETRY_PROTO_VERSION;
+  out[n++] = flags;
+  out[n++] = (uint8_t)(seq & 0xFF);
+  out[n++] = (uint8_t)(seq >> 8);
+  const size_t zoneBitmap = n++;
+  out[zoneBitmap] = 0;
+
+  for (uint8_t z = 0; z < zones; z++) {
+    if (masks[z] == 0) continue;
+    out[zoneBitmap] |= (uint8_t)(1 << z);
+    out[n++] = masks[z];
+    for (uint8_t i = 0; i < TELEMETRY_FIELDS; i++) {
+      if (!(masks[z] & (1 << i))) continue;
+      out[n++] = (uint8_t)(v[z][i] & 0xFF);
+      if (FIELD_BYTES[i] == 2) out[n++] = (uint8_t)((uint16_t)v[z][i] >> 8);
+    }
+  }
+  return n;
+}
+
+/**
+ * @brief Encode the next frame of the shared binary stream.
+ *
+ * @details Compares the state against the previous frame and emits only the
+ * changed fields, or every field when a keyframe is due. Advances the sequence
+ * number and the baseline.
+ *
+ * @param state Shared state to serialize.
+ * @param out   Buffer of at least TELEMETRY_FRAME_MAX bytes.
+ * @return Frame length, or 0 if nothing changed (no frame is produced then).
+ */
+size_t telemetryEncodeDelta(const SharedState &state, uint8_t *out) {
+  int16_t v[ZONE_MAX][TELEMETRY_FIELDS];
+  sampleFields(state, v);
+
+  const bool key = !hasBaseline || baselineZones != state.zoneCount || framesSinceKey + 1 >= TELEMETRY_KEYFRAME_EVERY;
+  uint8_t masks[ZONE_MAX] = {0};
+  bool changed = false;
+  for (uint8_t z = 0; z < state.zoneCount; z++) {
+    for (uint8_t i = 0; i < TELEMETRY_FIELDS; i++) {
+      if (key || v[z][i] != baseline[z][i]) masks[z] |= (uint8_t)(1 << i);
+    }
+    changed |= masks[z] != 0;
+  }
+  if (!changed) return 0;
+
+  seq++;
+  framesSinceKey = key ? 0 : framesSinceKey + 1;
+  memcpy(baseline, v, sizeof(baseline));
+  baselineZones = state.zoneCount;
+  hasBaseline = true;
+
+  return writeFrame(out, key ? TELEMETRY_FLAG_KEYFRAME : 0, masks, baselineZones, baseline);
+}
+
+/**
+ * @brief Encode a keyframe for a single client joining or resyncing the stream.
+ *
+ * @details The keyframe repeats the last broadcast values under the current
+ * sequence number, so the next delta frame applies cleanly on top of it. Before
+ * the first broadcast the current state becomes the baseline.
+ *
+ * @param state Shared state, used only before the first broadcast.
+ * @param out   Buffer of at least TELEMETRY_FRAME_MAX bytes.
+ * @return Frame length.
+ */
+size_t telemetryEncodeSnapshot(const SharedState &state, uint8_t *out) {
+  if (!hasBaseline) {
+    sampleFields(state, baseline);
+    baselineZones = state.zoneCount;
+    hasBaseline = true;
+  }
+  uint8_t masks[ZONE_MAX];
+  for (uint8_t z = 0; z < ZONE_MAX; z++) masks[z] = (uint8_t)((1 << TELEMETRY_FIELDS) - 1);
+  return writeFrame(out, TELEMETRY_FLAG_KEYFRAME, masks, baselineZones, baseline);
+}
+
+/**
+ * @brief Sequence number of the latest frame in the binary stream.
+ */
+uint16_t telemetrySeq() {
+  return seq;
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <Arduino.h>
+#include "sharedState.h"
+
+/**
+ * @file telemetry.h
+ * @brief Serialization of the shared state for the WebSocket dashboard.
+ *
+ * Binary frame, protocol version 2 (all integers little-endian):
+ *
+ * | offset | size | content                                          |
+ * |--------|------|--------------------------------------------------|
+ * | 0      | 1    | version (TELEMETRY_PROTO_VERSION)                |
+ * | 1      | 1    | flags (TELEMETRY_FLAG_KEYFRAME)                  |
+ * | 2      | 2    | sequence number                                  |
+ * | 4      | 1    | zone bitmap, bit z = a block for zone z follows  |
+ * | 5      | ...  | zone blocks in zone order                        |
+ *
+ * Zone block: presence bitmap (1 byte, bit i = field i follows), then the
+ * present fields in field order.
+ *
+ * Fields: 0 temperature, 1 humidity, 3 tempTarget, 4 humiTarget, 5 lightTarget
+ * as int16 in tenths (TELEMETRY_INVALID when unknown); 2 status as uint8
+ * (bit0 lamp, bit1 heater, bit2 mister).
+ *
+ * A delta frame carries only the zones and fields that changed since the previous
+ * frame and has sequence number previous + 1. A keyframe carries every field of
+ * every zone in use, so its zone bitmap also tells the client how many zones exist.
+ */
+
+static const uint8_t  TELEMETRY_PROTO_VERSION = 2;
+static const uint8_t  TELEMETRY_FLAG_KEYFRAME = 0x01;
+static const int16_t  TELEMETRY_INVALID = INT16_MIN;
+static const uint8_t  TELEMETRY_FIELDS = 6;
+static const size_t   TELEMETRY_ZONE_MAX_BYTES = 12;
+static const size_t   TELEMETRY_FRAME_MAX = 5 + ZONE_MAX * TELEMETRY_ZONE_MAX_BYTES;
+/// Every n-th broadcast frame is a keyframe
+static const uint8_t  TELEMETRY_KEYFRAME_EVERY = 30;
+
+/// Text command a dashboard sends to switch its connection to binary frames
+#define TELEMETRY_PROTO_REQUEST "proto:bin2"
+
+/// Buffer size that always holds the getSensorReadings() text of every zone
+static const size_t   TELEMETRY_JSON_MAX = 160 * (ZONE_MAX + 1) + 16;
+
+size_t getSensorReadings(const SharedState &state, char *out, size_t maxLen);
+
+size_t telemetryEncodeDelta(const SharedState &state, uint8_t *out);
+size_t telemetryEncodeSnapshot(const SharedState &state, uint8_t *out);
+uint16_t telemetrySeq();
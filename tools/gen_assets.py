@@ -0,0 +1,154 @@
+#!/usr/bin/env python3
+"""Build webFiles.cpp from the dashboard sources in web/.
+
+Each asset is minified, gzipped and stored as a PROGMEM byte array together
+with a strong ETag derived from its content hash (see webFiles.h). References
+to the other assets in index.html are rewritten to "name?v=<hash>", so those
+files can be cached forever and index.html itself only needs revalidation.
+
+Usage (from the sketch directory):  python3 tools/gen_assets.py
+
+Run it after editing anything in web/ and commit the regenerated webFiles.cpp;
+the Arduino build itself does not run this script.
+"""
+
+import gzip
+import hashlib
+import os
+import re
+import sys
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+WEB = os.path.join(ROOT, "web")
+OUT = os.path.join(ROOT, "webFiles.cpp")
+
+# (file in web/, URL path, content type). index.html must come last so it can
+# reference the hashes of the others.
+ASSETS = [
+    ("style.css", "/style.css", "text/css"),
+    ("chart-lite.js", "/chart-lite.js", "application/javascript"),
+    ("script.js", "/script.js", "application/javascript"),
+    ("index.html", "/", "text/html"),
+]
+
+
+def strip_js_comments(src):
+    """Remove // and /* */ comments outside of string and template literals."""
+    out = []
+    i, n = 0, len(src)
+    quote = None
+    while i < n:
+        c = src[i]
+        if quote:
+            out.append(c)
+            if c == "\\" and i + 1 < n:
+                out.append(src[i + 1])
+                i += 2
+                continue
+            if c == quote:
+                quote = None
+            i += 1
+        elif c in "\"'`":
+            quote = c
+            out.append(c)
+            i += 1
+        elif src.startswith("//", i):
+            while i < n and src[i] != "\n":
+                i += 1
+        elif src.startswith("/*", i):
+            end = src.find("*/", i + 2)
+            i = n if end < 0 else end + 2
+        else:
+            out.append(c)
+            i += 1
+    return "".join(out)
+
+
+def squeeze_lines(src):
+    """Trim every line and drop empty ones (newlines are kept for ASI safety)."""
+    return "\n".join(line.strip() for line in src.splitlines() if line.strip()) + "\n"
+
+
+def minify_js(src):
+    return squeeze_lines(strip_js_comments(src))
+
+
+def minify_css(src):
+    src = re.sub(r"/\*.*?\*/", "", src, flags=re.S)
+    src = re.sub(r"\s+", " ", src)
+    src = re.sub(r"\s*([{}:;,>])\s*", r"\1", src)
+    return src.replace(";}", "}").strip() + "\n"
+
+
+def minify_html(src):
+    src = re.sub(r"<!--.*?-->", "", src, flags=re.S)
+    return squeeze_lines(src)
+
+
+MINIFIERS = {".js": minify_js, ".css": minify_css, ".html": minify_html}
+
+
+def c_array(data):
+    lines = []
+    for i in range(0, len(data), 16):
+        lines.append("  " + ", ".join("0x%02x" % b for b in data[i:i + 16]) + ",")
+    return "\n".join(lines)
+
+
+def main():
+    hashes = {}
+    built = []
+    for name, path, ctype in ASSETS:
+        with open(os.path.join(WEB, name), encoding="utf-8") as f:
+            src = f.read()
+        if name == "index.html":
+            for other, h in hashes.items():
+                src = re.sub(r'(["\'])%s\1' % re.escape(other), r"\g<1>%s?v=%s\g<1>" % (other, h), src)
+        text = MINIFIERS[os.path.splitext(name)[1]](src).encode("utf-8")
+        digest = hashlib.sha256(text).hexdigest()[:16]
+        hashes[name] = digest
+        packed = gzip.compress(text, compresslevel=9, mtime=0)
+        built.append((name, path, ctype, digest, packed, len(src.encode("utf-8")), len(text)))
+
+    out = [
+        "/**",
+        " * @file webFiles.cpp",
+        " * @brief Dashboard assets, minified and gzipped.",
+        " *",
+        " * @details Generated by tools/gen_assets.py from web/ - do not edit.",
+        " */",
+        "",
+        '#include "webFiles.h"',
+        "",
+    ]
+    for name, path, ctype, digest, packed, _, _ in built:
+        ident = "ASSET_" + re.sub(r"\W", "_", name).upper()
+        out.append("// %s" % name)
+        out.append("static const uint8_t %s[] PROGMEM = {" % ident)
+        out.append(c_array(packed))
+        out.append("};")
+        out.append("")
+    out.append("const WebAsset WEB_ASSETS[] = {")
+    for name, path, ctype, digest, packed, _, _ in built:
+        ident = "ASSET_" + re.sub(r"\W", "_", name).upper()
+        immutable = "false" if name == "index.html" else "true"
+        out.append('  {"%s", "%s", %s, sizeof(%s), "\\"%s\\"", %s},' % (path, ctype, ident, ident, digest, immutable))
+    out.append("};")
+    out.append("")
+    out.append("const uint8_t WEB_ASSET_COUNT = sizeof(WEB_ASSETS) / sizeof(WEB_ASSETS[0]);")
+    out.append("")
+
+    with open(OUT, "w", encoding="utf-8", newline="\n") as f:
+        f.write("\n".join(out))
+
+    total_src = total_gz = 0
+    for name, _, _, digest, packed, src_len, min_len in built:
+        print("%-14s %6d -> %6d minified -> %6d gzip  %s" % (name, src_len, min_len, len(packed), digest))
+        total_src += src_len
+        total_gz += len(packed)
+    print("%-14s %6d -> %6d bytes" % ("total", total_src, total_gz))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,407 @@
+/**
+ * @file uploader.cpp
+ * @brief Non-blocking, batched ThingSpeak uploader with an offline queue.
+ *
+ * @details
+ * uploaderEnqueue() only stores a small fixed-point sample in a RAM ring; it
+ * never touches the network. uploaderRun() drives one HTTP request at a time
+ * through a state machine (connect, send, wait for the status line) using the
+ * non-blocking TCP calls of the HAL, so no call takes longer than a few copies.
+ *
+ * Each request is a ThingSpeak bulk update (POST /channels/<id>/bulk_update.json)
+ * carrying up to UPLOAD_BATCH_MAX samples, each with its absolute UTC time
+ * (created_at): the sample's age on the caller's clock, subtracted from the
+ * wall clock (halEpochSec()). Nothing is sent until the wall clock is known,
+ * so batches replayed after an outage keep the time they were measured at.
+ * Spill files carry no wall-clock time: a batch spilled before a power cut is
+ * dated later by the time the board was off.
+ * Samples leave the queue only once the server answered 2xx. A failed or timed
+ * out request is retried after an exponential backoff (UPLOAD_BACKOFF_MIN_MS
+ * doubling to UPLOAD_BACKOFF_MAX_MS).
+ *
+ * When the RAM ring is full (e.g. offline for a while), its oldest
+ * UPLOAD_BATCH_MAX samples are written to a spill file /upload/NNNNNNNN.bin on
+ * flash. Spill files are older than anything in RAM, so they are sent first, and
+ * each is deleted once acknowledged. They survive reboots.
+ */
+#include "uploader.h"
+#include "hal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+static const char *const SPILL_DIR = "/upload";
+/// Poll period while a request is in progress
+static const uint32_t POLL_MS = 20;
+/// Poll period while idle with nothing to send
+static const uint32_t IDLE_MS = 1000;
+
+/**
+ * @brief One queued sample (8 bytes, also the spill file record).
+ */
+struct Sample {
+  uint32_t timeSec;
+  int16_t tempDeci;
+  int16_t humidityDeci;
+};
+
+enum Phase : uint8_t { UP_IDLE, UP_CONNECTING, UP_SENDING, UP_WAITING };
+
+static UploaderConfig cfg;
+static UploaderStats stats;
+
+/// RAM queue (ring, oldest at qHead)
+static Sample queue[UPLOAD_QUEUE_LEN];
+static uint8_t qHead = 0;
+static uint8_t qCount = 0;
+
+/// Spill files spillFirst .. spillNext-1 are waiting on flash
+static bool spillReady = false;
+static uint32_t spillFirst = 1;
+static uint32_t spillNext = 1;
+
+/// Request in flight
+static Phase phase = UP_IDLE;
+static HalTcp conn = HAL_TCP_NONE;
+static bool batchFromSpill = false;
+static uint32_t batchFile = 0;
+static uint8_t batchCount = 0;
+static uint32_t phaseStartMs = 0;
+static uint32_t nextAttemptMs = 0;
+
+static char header[192];
+static char body[96 + UPLOAD_BATCH_MAX * 80];
+static size_t headerLen = 0;
+static size_t bodyLen = 0;
+static size_t sentLen = 0;
+static char response[64];
+static uint8_t responseLen = 0;
+
+// ---------------------------------------------------------------- spill files
+
+static void spillPath(uint32_t number, char *out, size_t len) {
+  snprintf(out, len, "%s/%08lu.bin", SPILL_DIR, (unsigned long)number);
+}
+
+/**
+ * @brief halFsList() callback: find the range of spill file numbers.
+ */
+static void collectSpill(const char *name, uint32_t, void *ctx) {
+  if (strlen(name) != 12 || strcmp(name + 8, ".bin") != 0) return;
+  for (uint8_t i = 0; i < 8; i++) {
+    if (name[i] < '0' || name[i] > '9') return;
+  }
+  const uint32_t number = (uint32_t)strtoul(name, nullptr, 10);
+  bool &any = *(bool *)ctx;
+  if (!any || number < spillFirst) spillFirst = number;
+  if (!any || number >= spillNext) spillNext = number + 1;
+  any = true;
+}
+
+static void removeSpill(uint32_t number) {
+  char path[32];
+  spillPath(number, path, sizeof(path));
+  halFsRemove(path);
+}
+
+/**
+ * @brief Move the oldest UPLOAD_BATCH_MAX queued samples to a new spill file.
+ */
+static void spillOldest() {
+  const uint8_t n = qCount < UPLOAD_BATCH_MAX ? qCount : UPLOAD_BATCH_MAX;
+  Sample batch[UPLOAD_BATCH_MAX];
+  for (uint8_t i = 0; i < n; i++) batch[i] = queue[(qHead + i) % UPLOAD_QUEUE_LEN];
+  qHead = (uint8_t)((qHead + n) % UPLOAD_QUEUE_LEN);
+  qCount -= n;
+
+  if (!spillReady) {
+    stats.dropped += n;
+    return;
+  }
+  if (spillNext - spillFirst >= UPLOAD_SPILL_MAX_FILES) {
+    // Retention: give up the oldest spilled batch, unless it is being sent.
+    if (phase != UP_IDLE && batchFromSpill && batchFile == spillFirst) {
+      stats.dropped += n;
+      return;
+    }
+    removeSpill(spillFirst++);
+    stats.dropped += UPLOAD_BATCH_MAX;
+  }
+
+  char path[32];
+  spillPath(spillNext, path, sizeof(path));
+  const HalFile f = halFsOpen(path, true);
+  const size_t written = halFsWrite(f, batch, n * sizeof(Sample));
+  halFsClose(f);
+  if (written != n * sizeof(Sample)) {
+    removeSpill(spillNext);
+    stats.dropped += n;
+    return;
+  }
+  spillNext++;
+  stats.spilled += n;
+}
+
+// ---------------------------------------------------------------- request
+
+/**
+ * @brief Append @p v / 10 to the body as a JSON number.
+ */
+static int formatDeci(char *out, size_t len, int16_t v) {
+  const int a = v < 0 ? -v : v;
+  return snprintf(out, len, "%s%d.%d", v < 0 ? "-" : "", a / 10, a % 10);
+}
+
+/**
+ * @brief Append the ISO 8601 UTC time @p epoch to the body.
+ */
+static int formatTime(char *out, size_t len, uint32_t epoch) {
+  const time_t t = (time_t)epoch;
+  struct tm tm;
+  gmtime_r(&t, &tm);
+  return snprintf(out, len, "%04d-%02d-%02dT%02d:%02d:%02dZ", tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday,
+                  tm.tm_hour, tm.tm_min, tm.tm_sec);
+}
+
+/**
+ * @brief Build the request for the oldest waiting batch (spill file first).
+ *
+ * @param nowSec Now, on the clock of the samples' timeSec.
+ * @param epoch  Now, in Unix seconds.
+ * @return False if there is nothing to send.
+ */
+static bool buildRequest(uint32_t nowSec, uint32_t epoch) {
+  Sample batch[UPLOAD_BATCH_MAX];
+  batchCount = 0;
+  batchFromSpill = false;
+
+  while (spillFirst < spillNext && batchCount == 0) {
+    char path[32];
+    spillPath(spillFirst, path, sizeof(path));
+    const HalFile f = halFsOpen(path, false);
+    const size_t got = halFsRead(f, 0, batch, sizeof(batch));
+    halFsClose(f);
+    batchCount = (uint8_t)(got / sizeof(Sample));
+    if (batchCount == 0) {
+      removeSpill(spillFirst++);  // missing or empty
+    } else {
+      batchFromSpill = true;
+      batchFile = spillFirst;
+    }
+  }
+  if (!batchFromSpill) {
+    batchCount = qCount < UPLOAD_BATCH_MAX ? qCount : UPLOAD_BATCH_MAX;
+    for (uint8_t i = 0; i < batchCount; i++) batch[i] = queue[(qHead + i) % UPLOAD_QUEUE_LEN];
+  }
+  if (batchCount == 0) return false;
+
+  int n = snprintf(body, sizeof(body), "{\"write_api_key\":\"%s\",\"updates\":[", cfg.apiKey);
+  for (uint8_t i = 0; i < batchCount; i++) {
+    const Sample &s = batch[i];
+    const uint32_t age = (int32_t)(nowSec - s.timeSec) > 0 ? nowSec - s.timeSec : 0;
+    n += snprintf(body + n, sizeof(body) - n, "%s{\"created_at\":\"", i ? "," : "");
+    n += formatTime(body + n, sizeof(body) - n, epoch - age);
+    n += snprintf(body + n, sizeof(body) - n, "\",\"field1\":");
+    n += formatDeci(body + n, sizeof(body) - n, s.tempDeci);
+    n += snprintf(body + n, sizeof(body) - n, ",\"field2\":");
+    n += formatDeci(body + n, sizeof(body) - n, s.humidityDeci);
+    n += snprintf(body + n, sizeof(body) - n, "}");
+  }
+  n += snprintf(body + n, sizeof(body) - n, "]}");
+  bodyLen = (size_t)n;
+
+  headerLen = (size_t)snprintf(header, sizeof(header),
+    "POST /channels/%lu/bulk_update.json HTTP/1.1\r\n"
+    "Host: %s\r\n"
+    "Content-Type: application/json\r\n"
+    "Content-Length: %u\r\n"
+    "Connection: close\r\n\r\n",
+    cfg.channelId, cfg.host, (unsigned)bodyLen);
+  sentLen = 0;
+  responseLen = 0;
+  return true;
+}
+
+/**
+ * @brief The server acknowledged the batch: drop it from flash or RAM.
+ */
+static void batchDone(uint32_t now) {
+  if (batchFromSpill) {
+    if (batchFile >= spillFirst) {
+      removeSpill(batchFile);
+      if (batchFile == spillFirst) spillFirst++;
+    }
+  } else {
+    qHead = (uint8_t)((qHead + batchCount) % UPLOAD_QUEUE_LEN);
+    qCount -= batchCount;
+  }
+  stats.uploaded += batchCount;
+  stats.backoffMs = 0;
+
+  const bool backlog = spillFirst < spillNext || qCount >= UPLOAD_BATCH_MAX;
+  nextAttemptMs = now + (backlog ? UPLOAD_CATCHUP_MS : UPLOAD_INTERVAL_MS);
+}
+
+static void finish(uint32_t now, bool ok) {
+  halTcpClose(conn);
+  conn = HAL_TCP_NONE;
+  phase = UP_IDLE;
+
+  if (ok) {
+    batchDone(now);
+    return;
+  }
+  stats.failures++;
+  stats.backoffMs = stats.backoffMs == 0 ? UPLOAD_BACKOFF_MIN_MS : stats.backoffMs * 2;
+  if (stats.backoffMs > UPLOAD_BACKOFF_MAX_MS) stats.backoffMs = UPLOAD_BACKOFF_MAX_MS;
+  nextAttemptMs = now + stats.backoffMs;
+}
+
+/**
+ * @brief Check the HTTP status line once it is complete.
+ *
+ * @return 1 for 2xx, 0 for any other status, -1 while incomplete.
+ */
+static int8_t parseStatus() {
+  response[responseLen] = '\0';
+  if (!strstr(response, "\r\n")) return responseLen == sizeof(response) - 1 ? 0 : -1;
+  if (strncmp(response, "HTTP/1.", 7) != 0) return 0;
+  const char *code = strchr(response, ' ');
+  return (code && code[1] == '2') ? 1 : 0;
+}
+
+// ---------------------------------------------------------------- public
+
+/**
+ * @brief Set the upload target and pick up batches spilled before a reboot.
+ *
+ * Call once in setup(), after the filesystem is usable (halFsBegin()).
+ */
+void uploaderBegin(const UploaderConfig &config) {
+  cfg = config;
+  memset(&stats, 0, sizeof(stats));
+  qHead = 0;
+  qCount = 0;
+  phase = UP_IDLE;
+  conn = HAL_TCP_NONE;
+  nextAttemptMs = halMillis();
+
+  spillFirst = 1;
+  spillNext = 1;
+  spillReady = halFsBegin();
+  if (spillReady) {
+    bool any = false;
+    halFsList(SPILL_DIR, collectSpill, &any);
+  }
+}
+
+/**
+ * @brief Queue the current temperature and humidity for upload.
+ *
+ * Samples without a valid DHT reading are ignored. Only zone 0 is uploaded;
+ * the ThingSpeak channel has one temperature and one humidity field.
+ *
+ * @param state   Shared state to sample.
+ * @param timeSec Sample time in seconds, on a clock that keeps increasing across
+ *                reboots; uploaderRun() is given the same clock.
+ */
+void uploaderEnqueue(const SharedState &state, uint32_t timeSec) {
+  if (isnan(state.tempC[0]) || isnan(state.humidityPct[0])) return;
+
+  if (qCount == UPLOAD_QUEUE_LEN) {
+    // The oldest RAM samples cannot be spilled while they are being sent.
+    if (phase != UP_IDLE && !batchFromSpill) {
+      stats.dropped++;
+      return;
+    }
+    spillOldest();
+  }
+
+  Sample &s = queue[(qHead + qCount) % UPLOAD_QUEUE_LEN];
+  s.timeSec = timeSec;
+  s.tempDeci = (int16_t)lroundf(state.tempC[0] * 10.0f);
+  s.humidityDeci = (int16_t)lroundf(state.humidityPct[0] * 10.0f);
+  qCount++;
+  stats.enqueued++;
+}
+
+/**
+ * @brief Advance the upload state machine.
+ *
+ * @param nowSec Now, on the clock passed to uploaderEnqueue().
+ * @return Milliseconds until it next needs to run.
+ */
+uint32_t uploaderRun(uint32_t nowSec) {
+  const uint32_t now = halMillis();
+
+  if (phase == UP_IDLE) {
+    const int32_t wait = (int32_t)(nextAttemptMs - now);
+    if (wait > 0) return (uint32_t)wait;
+    const uint32_t epoch = halEpochSec();
+    if (epoch == 0 || !buildRequest(nowSec, epoch)) { // no wall clock yet, or nothing to send
+      nextAttemptMs = now + IDLE_MS;
+      return IDLE_MS;
+    }
+    stats.requests++;
+    conn = halTcpConnect(cfg.host, cfg.port);
+    if (conn == HAL_TCP_NONE) {
+      finish(now, false);
+      return stats.backoffMs;
+    }
+    phase = UP_CONNECTING;
+    phaseStartMs = now;
+    return POLL_MS;
+  }
+
+  if ((uint32_t)(now - phaseStartMs) > UPLOAD_TIMEOUT_MS) {
+    finish(now, false);
+    return stats.backoffMs;
+  }
+
+  const uint8_t st = halTcpState(conn);
+  switch (phase) {
+    case UP_CONNECTING:
+      if (st == HAL_TCP_CONNECTED) phase = UP_SENDING;
+      else if (st != HAL_TCP_CONNECTING) finish(now, false);
+      break;
+
+    case UP_SENDING:
+      if (st != HAL_TCP_CONNECTED) {
+        finish(now, false);
+        break;
+      }
+      while (sentLen < headerLen + bodyLen) {
+        const bool inHeader = sentLen < headerLen;
+        const char *p = inHeader ? header + sentLen : body + (sentLen - headerLen);
+        const size_t left = inHeader ? headerLen - sentLen : headerLen + bodyLen - sentLen;
+        const size_t n = halTcpWrite(conn, p, left);
+        if (n == 0) break;  // send window full, continue next run
+        sentLen += n;
+      }
+      if (sentLen == headerLen + bodyLen) phase = UP_WAITING;
+      break;
+
+    case UP_WAITING: {
+      responseLen += (uint8_t)halTcpRead(conn, response + responseLen, sizeof(response) - 1 - responseLen);
+      const int8_t status = parseStatus();
+      if (status >= 0) finish(now, status == 1);
+      else if (st == HAL_TCP_CLOSED || st == HAL_TCP_FAILED) finish(now, false);
+      break;
+    }
+
+    case UP_IDLE:
+      break;
+  }
+
+  if (phase != UP_IDLE) return POLL_MS;
+  const int32_t wait = (int32_t)(nextAttemptMs - now);
+  return wait > 0 ? (uint32_t)wait : 0;
+}
+
+void uploaderStats(UploaderStats &out) {
+  out = stats;
+  out.queued = qCount;
+  out.spillFiles = (uint16_t)(spillNext - spillFirst);
+}
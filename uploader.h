@@ -0,0 +1,54 @@
+#pragma once
+#include <stdint.h>
+#include "sharedState.h"
+
+/**
+ * @file uploader.h
+ * @brief Non-blocking, batched ThingSpeak uploader with an offline queue.
+ */
+
+/// Samples held in RAM
+static const uint8_t  UPLOAD_QUEUE_LEN = 64;
+/// Most samples sent in one bulk-update request (and stored per spill file)
+static const uint8_t  UPLOAD_BATCH_MAX = 32;
+/// Time between two requests while there is no backlog
+static const uint32_t UPLOAD_INTERVAL_MS = 60000;
+/// Time between two requests while catching up (ThingSpeak allows one update per 15 s)
+static const uint32_t UPLOAD_CATCHUP_MS = 15000;
+/// First retry delay after a failure; doubles up to UPLOAD_BACKOFF_MAX_MS
+static const uint32_t UPLOAD_BACKOFF_MIN_MS = 15000;
+static const uint32_t UPLOAD_BACKOFF_MAX_MS = 600000;
+/// Give up on a request that has not completed after this long
+static const uint32_t UPLOAD_TIMEOUT_MS = 10000;
+/// Oldest spill files are deleted beyond this many
+static const uint16_t UPLOAD_SPILL_MAX_FILES = 256;
+
+/**
+ * @brief Where and as whom to upload.
+ */
+struct UploaderConfig {
+  const char *host;      ///< e.g. "api.thingspeak.com"
+  uint16_t port;
+  unsigned long channelId;
+  const char *apiKey;    ///< Channel write API key
+};
+
+/**
+ * @brief Counters for diagnostics.
+ */
+struct UploaderStats {
+  uint32_t enqueued;
+  uint32_t uploaded;     ///< Samples acknowledged by the server
+  uint32_t requests;
+  uint32_t failures;     ///< Requests that failed or timed out
+  uint32_t spilled;      ///< Samples moved from RAM to flash
+  uint32_t dropped;      ///< Samples lost because RAM and flash were full
+  uint8_t  queued;       ///< Samples waiting in RAM
+  uint16_t spillFiles;   ///< Batches waiting on flash
+  uint32_t backoffMs;    ///< Current retry delay (0 while healthy)
+};
+
+void     uploaderBegin(const UploaderConfig &config);
+void     uploaderEnqueue(const SharedState &state, uint32_t timeSec);
+uint32_t uploaderRun(uint32_t nowSec);
+void     uploaderStats(UploaderStats &stats);
@@ -0,0 +1,96 @@
+// chart-lite.js - minimal line chart with the subset of the Chart.js API the
+// dashboard uses: new Chart(ctx, {type: 'line', data: {labels, datasets}, options})
+// and chart.update() after changing chart.data. Null values leave gaps.
+// Served from the ESP so the dashboard works without internet access.
+
+class Chart {
+    constructor(ctx, config) {
+        this.ctx = ctx;
+        this.canvas = ctx.canvas;
+        this.data = config.data;
+        this.options = config.options || {};
+        if (this.options.responsive !== false) {
+            window.addEventListener('resize', () => this.update());
+        }
+        this.update();
+    }
+
+    update() {
+        const canvas = this.canvas;
+        const ctx = this.ctx;
+        const ratio = window.devicePixelRatio || 1;
+        const width = canvas.parentElement ? canvas.parentElement.clientWidth : canvas.width;
+        const height = Math.round(width / 2);
+
+        canvas.style.width = width + 'px';
+        canvas.style.height = height + 'px';
+        canvas.width = width * ratio;
+        canvas.height = height * ratio;
+        ctx.setTransform(ratio, 0, 0, ratio, 0, 0);
+        ctx.clearRect(0, 0, width, height);
+
+        let min = Infinity, max = -Infinity;
+        for (const ds of this.data.datasets) {
+            for (const v of ds.data) {
+                if (v === null || Number.isNaN(v)) continue;
+                min = Math.min(min, v);
+                max = Math.max(max, v);
+            }
+        }
+        if (min === Infinity) return;
+        if (min === max) { min -= 1; max += 1; }
+
+        const left = 40, right = 8, top = 8, bottom = 8;
+        const plotW = width - left - right, plotH = height - top - bottom;
+        const count = this.data.labels.length;
+        const x = i => left + (count > 1 ? i * plotW / (count - 1) : plotW / 2);
+        const y = v => top + (max - v) * plotH / (max - min);
+
+        // Axis with min, middle and max labels
+        ctx.font = '11px sans-serif';
+        ctx.fillStyle = '#666';
+        ctx.strokeStyle = '#ddd';
+        ctx.lineWidth = 1;
+        ctx.textAlign = 'right';
+        ctx.textBaseline = 'middle';
+        for (const v of [min, (min + max) / 2, max]) {
+            ctx.beginPath();
+            ctx.moveTo(left, y(v));
+            ctx.lineTo(width - right, y(v));
+            ctx.stroke();
+            ctx.fillText(v.toFixed(1), left - 4, y(v));
+        }
+
+        for (const ds of this.data.datasets) {
+            // Split into runs of valid values so gaps stay visible
+            const runs = [];
+            let run = [];
+            ds.data.forEach((v, i) => {
+                if (v === null || Number.isNaN(v)) {
+                    if (run.length) runs.push(run);
+                    run = [];
+                } else {
+                    run.push([x(i), y(v)]);
+                }
+            });
+            if (run.length) runs.push(run);
+
+            for (const pts of runs) {
+                ctx.beginPath();
+                ctx.moveTo(pts[0][0], pts[0][1]);
+                for (const p of pts.slice(1)) ctx.lineTo(p[0], p[1]);
+                ctx.strokeStyle = ds.borderColor || '#333';
+                ctx.lineWidth = 2;
+                ctx.stroke();
+
+                if (ds.fill) {
+                    ctx.lineTo(pts[pts.length - 1][0], top + plotH);
+                    ctx.lineTo(pts[0][0], top + plotH);
+                    ctx.closePath();
+                    ctx.fillStyle = ds.backgroundColor || 'rgba(0, 0, 0, 0.1)';
+                    ctx.fill();
+                }
+            }
+        }
+    }
+}
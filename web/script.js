@@ -0,0 +1,285 @@
+var gateway = `ws://${window.location.hostname}/ws`;
+var websocket;
+
+window.addEventListener('load', onload);
+
+function onload(event) {
+    document.getElementById("zone").addEventListener("change", e => {
+        selectedZone = parseInt(e.target.value, 10);
+        if (zoneValues[selectedZone]) showReadings(zoneValues[selectedZone]);
+    });
+    initWebSocket();
+}
+function getReadings(){
+    websocket.send("getReadings");
+}
+
+// ********** Animation click
+function animateButton(btn) {
+    btn.classList.remove("sent");
+    void btn.offsetWidth;
+    btn.classList.add("sent");
+}
+
+// ********** Zones: one board can drive several greenhouse zones
+var selectedZone = 0;
+var zoneValues = [];   // latest values of every zone, as shown by showReadings()
+
+// Show the zone selector only when there is more than one zone.
+function setZoneCount(count) {
+    const select = document.getElementById("zone");
+    if (select.options.length === count) return;
+    select.innerHTML = "";
+    for (let z = 0; z < count; z++) select.add(new Option("Zone " + (z + 1), z));
+    if (selectedZone >= count) selectedZone = 0;
+    select.value = selectedZone;
+    select.hidden = count < 2;
+    zoneValues.length = count;
+}
+
+// Setpoint command for the selected zone: "T:23" for zone 0, "T1:23" for zone 1.
+// Each frame starts with "#<seq>"; the board acknowledges it with the values it applied.
+var commandSeq = 0;
+const SETPOINT_INPUTS = {T: "setTemp", H: "setHum", L: "setLight"};
+
+function sendSetpoint(kind, inputId, btn) {
+    const value = document.getElementById(inputId).value;
+    commandSeq++;
+    websocket.send("#" + commandSeq + ";" + kind + (selectedZone ? selectedZone : "") + ":" + value);
+    animateButton(btn);
+}
+
+// Show the value the board actually applied (it clamps out-of-range setpoints).
+function onAck(ack) {
+    if (ack.rejected) console.log("command #" + ack.ack + ": " + ack.rejected + " rejected");
+    for (const a of ack.applied) {
+        if (a.z === selectedZone && SETPOINT_INPUTS[a.c]) document.getElementById(SETPOINT_INPUTS[a.c]).value = a.v;
+    }
+}
+
+function sendTemp(btn) {
+    sendSetpoint("T", "setTemp", btn);
+}
+
+function sendHum(btn) {
+    sendSetpoint("H", "setHum", btn);
+}
+
+function sendLight(btn) {
+    sendSetpoint("L", "setLight", btn);
+}
+
+function initWebSocket() {
+    console.log('Trying to open a WebSocket connection…');
+    websocket = new WebSocket(gateway);
+    websocket.binaryType = 'arraybuffer';
+    websocket.onopen = onOpen;
+    websocket.onclose = onClose;
+    websocket.onmessage = onMessage;
+}
+function onOpen(event) {
+    console.log('Connection opened');
+    lastSeq = -1;
+    keyframeRequested = true;
+    websocket.send("proto:bin2"); // ask for binary frames; the reply is a full keyframe
+}
+function onClose(event) {
+    console.log('Connection closed');
+    setTimeout(initWebSocket, 2000);
+}
+function updateIndicator(elementId, value, min, max) {
+    const element = document.getElementById(elementId);
+    if (!element) return;
+    
+    const percentage = ((value - min) / (max - min)) * 100;
+    const clampedPercentage = Math.max(0, Math.min(100, percentage));
+    element.style.setProperty('--indicator-width', `${clampedPercentage}%`);
+}
+
+function onMessage(event) {
+    if (typeof event.data === "string") {
+        // text protocol (older firmware): top-level keys are zone 0
+        const myObj = JSON.parse(event.data);
+        if (myObj.applied) {
+            onAck(myObj);
+        } else if (myObj.zones) {
+            setZoneCount(myObj.zones.length);
+            zoneValues = myObj.zones;
+            showReadings(zoneValues[selectedZone]);
+        } else {
+            showReadings(myObj);
+        }
+    } else {
+        decodeFrame(event.data);
+    }
+}
+
+function showReadings(myObj) {
+    var keys = Object.keys(myObj);
+    for (var i = 0; i < keys.length; i++){
+        var key = keys[i];
+        var element = document.getElementById(key);
+        if (key === "temperature") {
+            updateIndicator("temp-indicator", myObj[key], 10, 35); // 0-50°C range
+        }
+         if (key === "humidity") {
+            updateIndicator("hum-indicator", myObj[key], 0, 100); // range
+        }
+        if (!element) continue;
+         if (key === "light") {
+            element.innerHTML = myObj[key] ? "On" : "Off";
+        } else {
+            element.innerHTML = myObj[key];
+        }
+    }
+}
+
+// ********** Binary telemetry (protocol version 2, see telemetry.h)
+// [version u8][flags u8][seq u16][zone bitmap u8] then per present zone
+// [presence u8] and the present fields, little-endian.
+const FRAME_VERSION = 2;
+const FLAG_KEYFRAME = 0x01;
+const INVALID = -32768;
+const FIELDS = [
+    { key: "temperature", size: 2, round: true },
+    { key: "humidity", size: 2, round: true },
+    { key: "status", size: 1 },
+    { key: "tempTarget", size: 2 },
+    { key: "humiTarget", size: 2 },
+    { key: "lightTarget", size: 2 }
+];
+var lastSeq = -1;
+var keyframeRequested = false; // one getReadings per gap
+
+function decodeFrame(buffer) {
+    const view = new DataView(buffer);
+    if (view.byteLength < 5 || view.getUint8(0) !== FRAME_VERSION) return;
+
+    const keyframe = (view.getUint8(1) & FLAG_KEYFRAME) !== 0;
+    const seq = view.getUint16(2, true);
+    const zones = view.getUint8(4);
+
+    // A lost delta frame leaves us out of date: wait for a keyframe and ask for one, once.
+    if (!keyframe && (lastSeq < 0 || seq !== ((lastSeq + 1) & 0xFFFF))) {
+        lastSeq = -1;
+        if (!keyframeRequested) {
+            keyframeRequested = true;
+            websocket.send("getReadings");
+        }
+        return;
+    }
+    lastSeq = seq;
+    if (keyframe) keyframeRequested = false;
+
+    // A keyframe lists every zone in use.
+    if (keyframe) setZoneCount(32 - Math.clz32(zones));
+
+    let offset = 5;
+    for (let z = 0; z < 8; z++) {
+        if (!(zones & (1 << z))) continue;
+        if (offset >= view.byteLength) return;
+        const present = view.getUint8(offset++);
+        const values = zoneValues[z] || (zoneValues[z] = {});
+        for (let i = 0; i < FIELDS.length; i++) {
+            if (!(present & (1 << i))) continue;
+            const field = FIELDS[i];
+            if (field.size === 1) {
+                values[field.key] = view.getUint8(offset);
+            } else {
+                const raw = view.getInt16(offset, true);
+                const value = raw === INVALID ? NaN : raw / 10;
+                values[field.key] = field.round ? Math.round(value) : value;
+            }
+            offset += field.size;
+        }
+        if ("status" in values) {
+            values.light = (values.status & 0x01) !== 0;
+            delete values.status;
+        }
+    }
+    if (zones & (1 << selectedZone)) showReadings(zoneValues[selectedZone]);
+}
+
+
+let chartField1, chartField2;
+
+let historyTier = "raw";
+
+// Load one series from the device's own history (/history). The body is a packed
+// little-endian int16 array; aggregate tiers hold min, mean, max per record and
+// only the mean is plotted. The time axis comes from the X-History-* headers.
+async function fetchHistory(series) {
+    const response = await fetch(`/history?series=${series}&tier=${historyTier}`);
+    if (!response.ok) throw new Error(`history ${series}: ${response.status}`);
+
+    const values = new Int16Array(await response.arrayBuffer());
+    const header = name => parseInt(response.headers.get(`X-History-${name}`), 10);
+    const now = header("Now"), start = header("Start"), step = header("Step");
+    const scale = header("Scale"), stride = header("Values");
+    const mean = stride === 3 ? 1 : 0;
+    const nowMs = Date.now();
+
+    const labels = [], data = [];
+    for (let i = mean; i < values.length; i += stride) {
+        const t = start + ((i - mean) / stride) * step;
+        labels.push(new Date(nowMs - (now - t) * 1000).toLocaleTimeString());
+        data.push(values[i] === INVALID ? null : values[i] / scale);
+    }
+    return { labels, data };
+}
+
+async function fetchHistoryData() {
+    try {
+        const [temp, hum] = await Promise.all([fetchHistory("temp"), fetchHistory("humidity")]);
+
+        if (!chartField1) {
+            chartField1 = renderSingleChart('historyChartTemp', '-', temp.labels, temp.data, 'rgba(255, 99, 132, 1)');
+            chartField2 = renderSingleChart('historyChartHumidity', '-', hum.labels, hum.data, 'rgba(5, 158, 138, 1)');
+        } else {
+            chartField1.data.labels = temp.labels;
+            chartField1.data.datasets[0].data = temp.data;
+            chartField1.update();
+
+            chartField2.data.labels = hum.labels;
+            chartField2.data.datasets[0].data = hum.data;
+            chartField2.update();
+        }
+    } catch (error) {
+        console.error("Error fetching history:", error);
+    }
+}
+
+function renderSingleChart(canvasId, label, labels, data, color) {
+    const ctx = document.getElementById(canvasId).getContext('2d');
+    return new Chart(ctx, {
+        type: 'line',
+        data: {
+            labels: labels,
+            datasets: [{
+                label: label,
+                data: data,
+                borderColor: color,
+                backgroundColor: color.replace('1)', '0.2)'),
+                fill: true,
+                tension: 0.3
+            }]
+        },
+        options: {
+            responsive: true,
+            scales: {
+                x: { ticks: { display: false } },
+                y: { title: { display: true, text: 'Value' } }
+            }
+        }
+    });
+}
+
+// Initial load
+window.addEventListener('load', () => {
+    document.getElementById("historyTier").addEventListener("change", e => {
+        historyTier = e.target.value;
+        fetchHistoryData();
+    });
+    fetchHistoryData();
+    setInterval(fetchHistoryData, 10000); //10 seconds request new load
+});
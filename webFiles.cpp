@@ -1,441 +1,373 @@
 /**
  * @file webFiles.cpp
- * @brief Server
+ * @brief Dashboard assets, minified and gzipped.
+ *
+ * @details Generated by tools/gen_assets.py from web/ - do not edit.
  */
 
 #include "webFiles.h"
 
-const char INDEX_HTML[] PROGMEM = R"rawliteral(
-<!DOCTYPE html>
-<html>
-
-<head>
-    <title>Smart Greenhouse</title>
-    <meta name="viewport" content="width=device-width, initial-scale=1">
-    <link rel="stylesheet" type="text/css" href="style.css">
-    <script src="https://cdn.jsdelivr.net/npm/chart.js"></script>
-
-</head>
-<meta charset="UTF-8">
-
-<body>
-
-    <div class="topnav">
-        <div class="plant-greeting">
-            <p style="margin: 0; font-size: 1.2rem; color: white;">
-                <strong>Smart Greenhouse</strong>
-            </p>
-        </div>
-    </div>
-
-    <div class="topnav2">
-        <h1>Change Setpoint ⚙️</h1>
-    </div>
-    <div class="content">
-        <div class="card-grid">
-            <div class="card">
-                <p class="card-title">Humidity</p>
-                <p class="switch">
-                    <input type="number" id="setHum" min="0" max="100" step="5">
-                    <button onclick="sendHum(this)">Set</button>
-                </p>
-            </div>
-            <div class="card">
-                <p class="card-title">Light</p>
-                <p class="switch">
-                    <input type="number" id="setLight" min="0" max="100" step="5">
-                    <button onclick="sendLight(this)">Set</button>
-                </p>
-            </div>
-            <div class="card">
-                <p class="card-title">Temperature</p>
-                <p class="switch">
-                    <input type="number" id="setTemp" min="10" max="30" step="1">
-                    <button onclick="sendTemp(this)">Set</button>
-                </p>
-            </div>
-        </div>
-    </div>
-
-    <div class="topnav2">
-        <h1>Sensor Readings 📊</h1>
-    </div>
-    <div class="content">
-        <div class="card-grid">
-            <div class="card">
-                <p class="card-title"> Humidity 💧</p>
-                <p class="reading"><span id="humidity"></span> &percnt;</p>
-                <div id="hum-indicator" class="hum_visual-indicator"></div>
-            </div>
-            <div class="card">
-                <p class="card-title"> Light ☀️</p>
-                <p class="reading"><span id="light"></span></p>
-            </div>
-            <div class="card">
-                <p class="card-title"><i class="fas fa-thermometer-threequarters" style="color:#059e8a;"></i>
-                    Temperature 🌡️</p>
-                <p class="reading"><span id="temperature"></span> &deg;C</p>
-                <div id="temp-indicator" class="temp_visual-indicator"></div>
-            </div>
-        </div>
-    </div>
-
-    <div class="topnav2">
-        <h1>ThingSpeak Graph 📈 📉</h1>
-    </div>
-    <div class="content">
-        <div class="card-grid">
-            <div class="card">
-                <p class="card-title">Humidity</p>
-                <canvas id="thingspeakChart2"></canvas>
-            </div>
-            <div class="card">
-                <p class="card-title">Temperature</p>
-                <canvas id="thingspeakChart1"></canvas>
-            </div>
-        </div>
-    </div>
-
-    <script src="script.js"></script>
-
-</body>
-
-</html>
-
-)rawliteral";
-
-const char STYLE_CSS[] PROGMEM = R"rawliteral(
-html {
-    font-family: "Inter", "Segoe UI", Arial, sans-serif;
-    background: #eef5f0;
-}
-
-body {
-    margin: 0;
-}
-
-/* ===== HEADER ===== */
-.topnav {
-    background: linear-gradient(135deg, #1b5e20, #33691e);
-    padding: 16px 24px;
-    display: flex;
-    align-items: center;
-    gap: 16px;
-    box-shadow: 0 6px 16px rgba(0,0,0,0.25);
-}
-
-.topnav h1 {
-    font-size: 2rem;
-    letter-spacing: 1px;
-}
-
-/* ===== SECTION HEADERS ===== */
-.topnav2 {
-    max-width: 1100px;
-    margin: 40px auto 10px;
-    background: none;
-    box-shadow: none;
-    padding: 0 10px;
-}
-
-.topnav2 h1 {
-    color: #1b5e20;
-    text-align: left;
-    font-size: 1.6rem;
-    border-left: 6px solid #43a047;
-    padding-left: 14px;
-}
-
-/* ===== CONTENT ===== */
-.content {
-    padding: 10px 20px 40px;
-}
-
-/* ===== GRID ===== */
-.card-grid {
-    max-width: 1100px;
-    margin: auto;
-    display: grid;
-    gap: 24px;
-    grid-template-columns: repeat(auto-fit, minmax(260px, 1fr));
-}
-
-/* ===== CARDS ===== */
-.card {
-    background: #ffffff;
-    border-radius: 18px;
-    padding: 26px;
-    box-shadow: 0 12px 28px rgba(0,0,0,0.12);
-    position: relative;
-    overflow: hidden;
-}
-
-/* decorative greenhouse line */
-.card::before {
-    content: "";
-    position: absolute;
-    top: 0;
-    left: 0;
-    height: 6px;
-    width: 100%;
-    background: linear-gradient(90deg, #66bb6a, #aed581);
-}
-
-.card-title {
-    font-size: 1.2rem;
-    font-weight: 600;
-    color: #2e7d32;
-    margin-bottom: 14px;
-}
-
-/* ===== SENSOR VALUES ===== */
-.reading {
-    font-size: 2.4rem;
-    font-weight: 700;
-    color: #1b5e20;
-    text-align: center;
-}
-
-
-/* ===== CONTROL PANEL ===== */
-.switch {
-    display: flex;
-    justify-content: space-between;
-    align-items: center;
-    gap: 12px;
-}
-
-.switch input {
-    width: 90px;
-    padding: 10px;
-    border-radius: 10px;
-    border: 1px solid #c8e6c9;
-    font-size: 16px;
-}
-
-.switch button {
-    background: #43a047;
-    color: white;
-    border: none;
-    border-radius: 10px;
-    padding: 10px 18px;
-    font-weight: 600;
-    cursor: pointer;
-    transition: background 0.2s;
-}
-
-.switch button:hover {
-    background: #2e7d32;
-}
-
-/* ===== TEMP BAR ===== */
-.temp_visual-indicator {
-    height: 10px;
-    margin-top: 16px;
-    border-radius: 10px;
-    background: linear-gradient(
-        to right,
-        rgba(255, 99, 132, 1) var(--indicator-width, 0%),
-        #e0e0e0 var(--indicator-width, 0%) 100%
-    );
-}
-.hum_visual-indicator {
-    height: 10px;
-    margin-top: 16px;
-    border-radius: 10px;
-    background: linear-gradient(
-        to right,
-        rgba(5, 158, 138, 1) var(--indicator-width, 0%),
-        #e0e0e0 var(--indicator-width, 0%) 100%
-    );
-}
-
-/* ===== GRAPHS ===== */
-canvas {
-    margin-top: 14px;
-    max-height: 260px;
-}
-
-/* ===== RESPONSIVE ===== */
-@media (max-width: 600px) {
-    .reading {
-        font-size: 2rem;
-    }
-}
-
-/* ********** button animation
-/* click press */
-.switch button:active {
-    transform: scale(0.95);
-}
-/* success animation */
-.switch button.sent {
-    animation: sentPulse 0.55s ease;
-}
-
-@keyframes sentPulse {
-    0% {
-        transform: scale(1);
-        box-shadow: 0 0 0 0 rgba(67,160,71,0.6);
-    }
-    50% {
-        transform: scale(1.1);
-        box-shadow: 0 0 0 8px rgba(50, 124, 53, 0);
-    }
-    100% {
-        transform: scale(1);
-        box-shadow: none;
-    }
-}
-
-)rawliteral";
-
-const char SCRIPT_JS[] PROGMEM = R"rawliteral(
-var gateway = `ws://${window.location.hostname}/ws`;
-var websocket;
-
-window.addEventListener('load', onload);
-
-function onload(event) {
-    initWebSocket();
-}
-function getReadings(){
-    websocket.send("getReadings");
-}
-
-// ********** Animation click
-function animateButton(btn) {
-    btn.classList.remove("sent");
-    void btn.offsetWidth;
-    btn.classList.add("sent");
-}
-
-function sendTemp(btn) {
-    const value = document.getElementById("setTemp").value;
-    websocket.send("T:" + value);
-    animateButton(btn);
-}
-
-function sendHum(btn) {
-    const value = document.getElementById("setHum").value;
-    websocket.send("H:" + value);
-    animateButton(btn);
-}
-
-function sendLight(btn) {
-    const value = document.getElementById("setLight").value;
-    websocket.send("L:" + value);
-    animateButton(btn);
-}
-
-function initWebSocket() {
-    console.log('Trying to open a WebSocket connection…');
-    websocket = new WebSocket(gateway);
-    websocket.onopen = onOpen;
-    websocket.onclose = onClose;
-    websocket.onmessage = onMessage;
-}
-function onOpen(event) {
-    console.log('Connection opened');
-    getReadings();
-    getTime();
-}
-function onClose(event) {
-    console.log('Connection closed');
-    setTimeout(initWebSocket, 2000);
-}
-function updateIndicator(elementId, value, min, max) {
-    const element = document.getElementById(elementId);
-    if (!element) return;
-    
-    const percentage = ((value - min) / (max - min)) * 100;
-    const clampedPercentage = Math.max(0, Math.min(100, percentage));
-    element.style.setProperty('--indicator-width', `${clampedPercentage}%`);
-}
-
-function onMessage(event) {
-    console.log(event.data);
-    var myObj = JSON.parse(event.data);
-    var keys = Object.keys(myObj);
-    for (var i = 0; i < keys.length; i++){
-        var key = keys[i];
-        document.getElementById(key).innerHTML = myObj[key];
-        if (key === "temperature") {
-            updateIndicator("temp-indicator", myObj[key], 10, 35); // 0-50°C range
-        }
-         if (key === "humidity") {
-            updateIndicator("hum-indicator", myObj[key], 0, 100); // range
-        }
-         if (key === "light") {
-          document.getElementById("light").innerHTML =
-                myObj[key] ? "On" : "Off";
-        } else {
-            document.getElementById(key).innerHTML = myObj[key];
-        }
-    }
-}
-
-
-let chartField1, chartField2;
-
-async function fetchThingSpeakData() {
-    const url = "https://api.thingspeak.com/channels/3226727/feeds.json?api_key=IGWBQXHCQF1OJ3R1&results=20";
-
-    try {
-        const response = await fetch(url);
-        const data = await response.json();
-        const feeds = data.feeds;
-
-        const labels = feeds.map(f => f.created_at);
-        const field1Values = feeds.map(f => parseFloat(f.field1) || 0);
-        const field2Values = feeds.map(f => parseFloat(f.field2) || 0);
-
-        if (!chartField1) {
-            chartField1 = renderSingleChart('thingspeakChart1', '-', labels, field1Values, 'rgba(255, 99, 132, 1)');
-            chartField2 = renderSingleChart('thingspeakChart2', '-', labels, field2Values, 'rgba(5, 158, 138, 1)');
-        } else {
-            chartField1.data.labels = labels;
-            chartField1.data.datasets[0].data = field1Values;
-            chartField1.update();
-
-            chartField2.data.labels = labels;
-            chartField2.data.datasets[0].data = field2Values;
-            chartField2.update();
-        }
-    } catch (error) {
-        console.error("Error fetching ThingSpeak data:", error);
-    }
-}
-
-function renderSingleChart(canvasId, label, labels, data, color) {
-    const ctx = document.getElementById(canvasId).getContext('2d');
-    return new Chart(ctx, {
-        type: 'line',
-        data: {
-            labels: labels,
-            datasets: [{
-                label: label,
-                data: data,
-                borderColor: color,
-                backgroundColor: color.replace('1)', '0.2)'),
-                fill: true,
-                tension: 0.3
-            }]
-        },
-        options: {
-            responsive: true,
-            scales: {
-                x: { ticks: { display: false } },
-                y: { title: { display: true, text: 'Value' } }
-            }
-        }
-    });
-}
-
-// Initial load
-window.addEventListener('load', () => {
-    fetchThingSpeakData();
-    setInterval(fetchThingSpeakData, 10000); //10 seconds request new load
-});
-
-)rawliteral";
+// style.css
+static const uint8_t ASSET_STYLE_CSS[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xbd, 0x55, 0xc1, 0xae, 0xab, 0x36,
+  0x10, 0xdd, 0xf7, 0x2b, 0x50, 0xa2, 0x2b, 0x05, 0xc9, 0x44, 0x36, 0x09, 0x24, 0x81, 0xcd, 0xeb,
+  0xf2, 0xed, 0x2a, 0x55, 0x5d, 0x57, 0x06, 0x06, 0x70, 0x1f, 0xd8, 0xc8, 0x36, 0x49, 0x6e, 0x11,
+  0xff, 0x5e, 0xdb, 0x90, 0x84, 0xdc, 0xdc, 0xfb, 0xba, 0xa9, 0x1a, 0x4b, 0x51, 0xc0, 0xf6, 0xcc,
+  0x99, 0x33, 0xe7, 0x4c, 0x6a, 0xdd, 0x36, 0x43, 0x29, 0xb8, 0x0e, 0x4a, 0xda, 0xb2, 0xe6, 0x3d,
+  0x59, 0x7d, 0xe7, 0x1a, 0xe4, 0x0a, 0xad, 0x7e, 0x87, 0x4a, 0x80, 0xf7, 0xc7, 0xf7, 0x15, 0xfa,
+  0x55, 0x32, 0xda, 0x20, 0x45, 0xb9, 0x0a, 0x14, 0x48, 0x56, 0xa6, 0x19, 0xcd, 0x7f, 0x54, 0x52,
+  0xf4, 0xbc, 0x48, 0xd6, 0x00, 0x65, 0x54, 0xe2, 0x31, 0x13, 0xc5, 0xfb, 0xd0, 0x52, 0x59, 0x31,
+  0x9e, 0xe0, 0x71, 0xab, 0x45, 0xc7, 0xe9, 0x79, 0x58, 0x1c, 0x6c, 0x18, 0x07, 0x2a, 0x83, 0x4a,
+  0xd2, 0x82, 0x01, 0xd7, 0x1b, 0xb2, 0x8b, 0x0a, 0xa8, 0xd0, 0x9a, 0x64, 0x11, 0x84, 0x18, 0xad,
+  0x77, 0xbb, 0xf8, 0x44, 0xc0, 0x4f, 0x3b, 0x5a, 0x14, 0x8c, 0x57, 0x09, 0x89, 0xbb, 0xab, 0x17,
+  0xee, 0xbb, 0x6b, 0x5a, 0x30, 0xd5, 0x35, 0xf4, 0x3d, 0x29, 0x1b, 0xb8, 0xa6, 0xb4, 0x61, 0x15,
+  0x0f, 0x98, 0x86, 0x56, 0x25, 0x39, 0x58, 0xa8, 0x69, 0x45, 0x3b, 0x77, 0x3a, 0xcd, 0xc4, 0x35,
+  0x50, 0x35, 0x2d, 0xc4, 0x25, 0xc1, 0x9e, 0xbd, 0xee, 0x62, 0xc8, 0x2a, 0xa3, 0x1b, 0x8c, 0xdc,
+  0xda, 0x86, 0x91, 0x7f, 0x03, 0xe7, 0xd5, 0x64, 0x2a, 0x5c, 0xb1, 0xbf, 0x21, 0x09, 0x25, 0xb4,
+  0x69, 0x03, 0xda, 0x04, 0x0c, 0x54, 0x47, 0x73, 0x07, 0xa1, 0xbb, 0xde, 0x0e, 0x87, 0xa6, 0xb6,
+  0x6b, 0x70, 0x61, 0x85, 0xae, 0x13, 0x42, 0x30, 0x36, 0xd9, 0xe6, 0x62, 0xf7, 0xe6, 0xb7, 0x47,
+  0x7b, 0x2d, 0x3c, 0x62, 0xdf, 0x2e, 0x2a, 0xe6, 0x82, 0xc3, 0x12, 0x93, 0x7b, 0xbe, 0x95, 0x87,
+  0xdd, 0xf1, 0x7b, 0x78, 0x0b, 0x26, 0x17, 0x8d, 0x90, 0xc9, 0x4c, 0x48, 0xaa, 0xe1, 0xaa, 0x03,
+  0x57, 0x6d, 0xd2, 0x40, 0xa9, 0xd3, 0x07, 0x54, 0xb2, 0x8d, 0x2d, 0xd8, 0x4c, 0xc8, 0xc2, 0x80,
+  0xb5, 0x9b, 0x89, 0xad, 0x53, 0x89, 0x86, 0x15, 0xde, 0x7a, 0xbf, 0xa3, 0x78, 0x7f, 0xb8, 0xe5,
+  0x99, 0xb6, 0xc9, 0xde, 0xa6, 0xca, 0x4d, 0x04, 0xc3, 0xd8, 0x70, 0x67, 0xd8, 0x22, 0x0f, 0xed,
+  0xd7, 0xde, 0x41, 0xc9, 0xa9, 0x2c, 0x4c, 0x7f, 0x58, 0xf1, 0x65, 0xad, 0xb6, 0xcc, 0x7b, 0x3b,
+  0xec, 0x49, 0xc7, 0xbd, 0x6b, 0x92, 0x7d, 0x0a, 0x4c, 0x57, 0xcc, 0x96, 0x86, 0xc0, 0x94, 0xd2,
+  0xb7, 0x5c, 0x25, 0x12, 0x3a, 0xa0, 0x7a, 0x63, 0xef, 0x05, 0x25, 0xd3, 0xa8, 0x65, 0xdc, 0xc4,
+  0xde, 0x84, 0xb1, 0x09, 0x8a, 0x48, 0x29, 0x7d, 0x7f, 0x4a, 0xbb, 0x14, 0xca, 0xba, 0x74, 0x9f,
+  0x5b, 0x7d, 0x56, 0x2f, 0xbd, 0x4a, 0xc8, 0xd1, 0x24, 0xb9, 0x21, 0x0f, 0x5f, 0xba, 0x4d, 0x42,
+  0x5b, 0xcb, 0xf1, 0x63, 0xbb, 0x49, 0x68, 0x04, 0x25, 0x14, 0xd3, 0x4c, 0x70, 0x03, 0xc6, 0x60,
+  0x63, 0x67, 0x48, 0xc5, 0x19, 0x64, 0xd9, 0x98, 0x7b, 0x35, 0x2b, 0x0a, 0xe0, 0x13, 0x84, 0x24,
+  0xc9, 0xa0, 0x14, 0x12, 0x86, 0x99, 0xa6, 0x64, 0xb5, 0x7a, 0x5c, 0xa5, 0x99, 0x61, 0xb7, 0xd7,
+  0x90, 0x9a, 0x76, 0x25, 0x38, 0x75, 0xa4, 0xe2, 0xb4, 0x06, 0x56, 0xd5, 0x8e, 0xfc, 0x74, 0x66,
+  0x0b, 0xe3, 0xb7, 0xf4, 0x27, 0x9a, 0x3f, 0x61, 0x27, 0xf9, 0x38, 0xce, 0xb2, 0x98, 0xa2, 0x35,
+  0x85, 0x22, 0x3a, 0x92, 0x99, 0x82, 0x40, 0x33, 0xdd, 0xc0, 0xb0, 0x6c, 0xb3, 0xd3, 0xa4, 0x7b,
+  0x71, 0x99, 0x33, 0x61, 0x9c, 0xce, 0x2a, 0x09, 0xe1, 0x50, 0xec, 0xc2, 0xb9, 0x31, 0x41, 0x26,
+  0xb4, 0x16, 0xed, 0xdc, 0x67, 0x09, 0xd4, 0xb2, 0xb4, 0x14, 0xf7, 0x76, 0xff, 0x31, 0xd4, 0xe1,
+  0x11, 0xea, 0x55, 0x70, 0x93, 0xb1, 0xc6, 0xad, 0xba, 0x30, 0x9d, 0xd7, 0xc3, 0x93, 0x01, 0xff,
+  0xea, 0x95, 0x66, 0xe5, 0x7b, 0x70, 0xa3, 0xc9, 0x9a, 0x05, 0x82, 0x0c, 0xf4, 0x05, 0x80, 0x7f,
+  0x69, 0xcf, 0xd0, 0x02, 0x9b, 0xc2, 0x79, 0x8c, 0x77, 0xbd, 0x1e, 0x26, 0xc6, 0x4e, 0x78, 0xd1,
+  0xd6, 0xc9, 0x40, 0xcf, 0x6d, 0x7f, 0xbc, 0xb2, 0x76, 0xbc, 0x89, 0x3c, 0x3f, 0x42, 0x9c, 0x9f,
+  0x96, 0x9e, 0x88, 0x17, 0x09, 0xb2, 0xde, 0xb0, 0xc1, 0x9f, 0x34, 0x35, 0xbb, 0x62, 0xaa, 0xf8,
+  0x52, 0x1b, 0x80, 0xb7, 0xa8, 0xb3, 0x4b, 0x5f, 0x92, 0x3e, 0xb9, 0xc4, 0xa9, 0xef, 0xa5, 0x13,
+  0xbd, 0x54, 0x26, 0x5a, 0x27, 0x98, 0xab, 0x53, 0x4b, 0x33, 0x20, 0x27, 0xb9, 0x3c, 0x32, 0x7b,
+  0x66, 0xe4, 0xa8, 0x0f, 0xc0, 0x92, 0xda, 0x0a, 0xf0, 0x09, 0xde, 0xd4, 0x4d, 0x33, 0x0d, 0x8c,
+  0x81, 0xfe, 0x3c, 0x33, 0xd5, 0xd3, 0x26, 0x60, 0xbc, 0x60, 0x39, 0xd5, 0x42, 0x0e, 0xb3, 0xce,
+  0xc8, 0xc3, 0x89, 0x81, 0xd5, 0xe1, 0x3c, 0xf3, 0x5e, 0xe9, 0xfa, 0x5a, 0x80, 0x9e, 0x19, 0x53,
+  0xd2, 0x06, 0x43, 0xce, 0x26, 0x61, 0x14, 0xa1, 0xd3, 0x09, 0x91, 0x5d, 0x88, 0x88, 0xef, 0x9d,
+  0xa9, 0xdc, 0x04, 0x8f, 0xb4, 0xd3, 0x04, 0x40, 0xf8, 0xcd, 0x47, 0x6b, 0xc0, 0x76, 0x7d, 0x7d,
+  0xc2, 0xb3, 0xca, 0xf7, 0x8c, 0x92, 0xeb, 0xbe, 0xfd, 0x1f, 0xf1, 0x47, 0x88, 0x44, 0x47, 0x03,
+  0xff, 0xf8, 0x1f, 0xc1, 0xcf, 0x29, 0x3f, 0x53, 0x35, 0x2c, 0x31, 0xee, 0x1d, 0xe6, 0x6b, 0x30,
+  0xd7, 0xe0, 0x26, 0xd7, 0xf8, 0xad, 0x85, 0x82, 0x51, 0x6f, 0xf3, 0x98, 0x93, 0xb1, 0x1d, 0x93,
+  0xfe, 0xf0, 0x99, 0xf7, 0x8c, 0xf3, 0xc6, 0x8f, 0x0a, 0xa0, 0xb9, 0x1d, 0x44, 0x83, 0x93, 0x8c,
+  0x19, 0x3a, 0x6d, 0xa2, 0x72, 0xda, 0xc0, 0x06, 0x6f, 0x4f, 0xf6, 0xff, 0xe9, 0xe9, 0xec, 0x56,
+  0xd9, 0x99, 0x4d, 0x39, 0x6b, 0xa9, 0xd3, 0x96, 0x7d, 0xfc, 0xad, 0x6f, 0x14, 0x18, 0x69, 0x45,
+  0x91, 0xf2, 0x80, 0x2a, 0x18, 0xbf, 0xfd, 0x80, 0xf7, 0x52, 0xd2, 0x16, 0x94, 0x77, 0xdf, 0x1f,
+  0xf0, 0xdb, 0x4b, 0x02, 0xe2, 0x3f, 0x8f, 0xcd, 0x69, 0x39, 0x2e, 0xe3, 0x03, 0x22, 0x31, 0x46,
+  0x07, 0x62, 0xc6, 0x66, 0xec, 0x8f, 0xd1, 0x67, 0xb7, 0xb7, 0x9f, 0xdd, 0xbf, 0x0f, 0xdd, 0x08,
+  0x23, 0x12, 0xee, 0x51, 0xb4, 0x43, 0xd8, 0x1f, 0x2d, 0xa3, 0xff, 0x92, 0xde, 0x3a, 0x6f, 0x1c,
+  0x7f, 0xf9, 0x07, 0xa5, 0x53, 0x2f, 0x06, 0x82, 0x08, 0x00, 0x00,
+};
+
+// chart-lite.js
+static const uint8_t ASSET_CHART_LITE_JS[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x8d, 0x55, 0x5b, 0x6f, 0xdb, 0x36,
+  0x14, 0x7e, 0xf7, 0xaf, 0xe0, 0xd0, 0x07, 0x51, 0x8d, 0xa4, 0x56, 0x4d, 0x11, 0x0c, 0x33, 0xdc,
+  0x61, 0x2b, 0x32, 0x74, 0xc0, 0x16, 0x14, 0x5d, 0x80, 0x3c, 0x04, 0x7e, 0xa0, 0x25, 0xda, 0x26,
+  0x4a, 0x8b, 0x02, 0x49, 0x2b, 0xce, 0x5a, 0xff, 0xf7, 0x9e, 0x73, 0x48, 0x5a, 0x8a, 0x53, 0xa0,
+  0x85, 0x65, 0x8b, 0x3c, 0x97, 0x8f, 0xe7, 0xf2, 0x1d, 0xba, 0xd1, 0xc2, 0x39, 0xf6, 0x7e, 0x2b,
+  0xac, 0x67, 0x5f, 0x66, 0x8d, 0xe9, 0x9c, 0xb7, 0xfb, 0xc6, 0x1b, 0xcb, 0x1b, 0x7f, 0x28, 0x18,
+  0x08, 0xd6, 0x6a, 0x93, 0x83, 0xca, 0x6f, 0x95, 0xab, 0x40, 0xc6, 0x16, 0x0c, 0x7e, 0xe7, 0x71,
+  0x2f, 0xba, 0x41, 0xb8, 0x20, 0x8a, 0x9b, 0xa8, 0x69, 0x85, 0x17, 0x28, 0x27, 0x7f, 0xda, 0x45,
+  0x85, 0xe9, 0xbd, 0x82, 0x53, 0x46, 0x5d, 0x12, 0x7c, 0xfd, 0xca, 0xbe, 0x1c, 0xe7, 0x33, 0xb5,
+  0x66, 0x7c, 0x6a, 0x58, 0x59, 0xe9, 0x7a, 0x78, 0xab, 0x41, 0xb2, 0x5f, 0x16, 0x0b, 0xb6, 0x16,
+  0xda, 0x49, 0x0c, 0xe8, 0x41, 0x75, 0xad, 0x79, 0xa8, 0x44, 0xdb, 0x5e, 0x0f, 0xb2, 0xf3, 0xff,
+  0x28, 0xe7, 0x65, 0x27, 0x2d, 0xcf, 0xc0, 0x41, 0xfd, 0x2f, 0xb3, 0x82, 0xf1, 0x9c, 0x2d, 0xde,
+  0x31, 0x02, 0xdb, 0xf7, 0x10, 0x82, 0xe4, 0x79, 0x3e, 0x9f, 0x1d, 0x67, 0x4f, 0x24, 0x28, 0x48,
+  0xeb, 0x54, 0x01, 0x76, 0xca, 0x6b, 0x92, 0xe5, 0x3c, 0xe9, 0xa8, 0x06, 0xa9, 0x1c, 0x49, 0x6a,
+  0x05, 0x44, 0x0b, 0xf2, 0x18, 0x55, 0x2b, 0x07, 0xd5, 0xc8, 0x8f, 0xea, 0x20, 0xf5, 0x27, 0xd2,
+  0x40, 0x76, 0x75, 0xb2, 0x7d, 0x50, 0xad, 0xdf, 0x62, 0x01, 0x08, 0xb7, 0xea, 0x85, 0x85, 0xf8,
+  0xaf, 0xb5, 0xdc, 0xc1, 0x8b, 0xfd, 0xfe, 0x5d, 0x71, 0xd5, 0x68, 0x05, 0xaf, 0x3b, 0xf2, 0xfc,
+  0x2d, 0x99, 0x10, 0x50, 0x42, 0xdd, 0x4a, 0xb5, 0xd9, 0x7a, 0x80, 0xfd, 0x57, 0xf8, 0x6d, 0x65,
+  0xcd, 0xbe, 0x6b, 0x79, 0x38, 0xe9, 0x15, 0x7b, 0x03, 0x69, 0x46, 0x1f, 0xe7, 0x1f, 0xb5, 0xac,
+  0x52, 0x08, 0xe1, 0x7d, 0xc1, 0xb2, 0xfe, 0x90, 0x9d, 0x99, 0x9c, 0xf0, 0xe2, 0xe2, 0xcc, 0xe8,
+  0x29, 0xc2, 0xcb, 0x50, 0x80, 0x93, 0xf6, 0xdc, 0x79, 0xd4, 0x03, 0x51, 0x9c, 0xf4, 0xb7, 0x56,
+  0x74, 0x6e, 0x6d, 0xec, 0x8e, 0x93, 0xbc, 0x60, 0xaf, 0xe9, 0x99, 0x6c, 0xf2, 0x60, 0xdb, 0x68,
+  0x29, 0xec, 0x27, 0xd9, 0x78, 0x1e, 0x2c, 0xe8, 0xb8, 0x22, 0xc2, 0x82, 0x8d, 0x96, 0x9e, 0xed,
+  0x54, 0x07, 0x27, 0xfd, 0x0d, 0x6c, 0xea, 0x94, 0x7f, 0x2c, 0xd8, 0x4e, 0x60, 0x87, 0xca, 0x24,
+  0x98, 0xcf, 0xe0, 0x20, 0xc6, 0x43, 0x95, 0x5a, 0xc7, 0xcc, 0x9a, 0x9d, 0x28, 0x4a, 0x3f, 0x10,
+  0x8f, 0xc3, 0xde, 0x4f, 0xcc, 0x06, 0xb4, 0x6a, 0x83, 0x0d, 0xaa, 0x90, 0x95, 0x03, 0x5b, 0x00,
+  0xff, 0xba, 0xbd, 0xd6, 0xd8, 0xcd, 0x9b, 0xfd, 0x6e, 0x25, 0x6d, 0xa5, 0xdc, 0x8d, 0xb8, 0xe1,
+  0x43, 0x9e, 0x23, 0x9d, 0xbd, 0xea, 0xf6, 0x72, 0x3e, 0x0b, 0xf1, 0x50, 0x1b, 0x60, 0xc9, 0xe1,
+  0x5b, 0xb0, 0x01, 0x62, 0x0d, 0x71, 0x05, 0xb9, 0x38, 0x70, 0xf8, 0x06, 0xf9, 0x11, 0x3e, 0x78,
+  0x00, 0xf9, 0x2d, 0xc6, 0x4c, 0x72, 0x66, 0xa5, 0xdf, 0xdb, 0x6e, 0xfe, 0x44, 0x0b, 0x6e, 0x10,
+  0x11, 0x25, 0x5d, 0x2e, 0x80, 0x54, 0x94, 0xee, 0x05, 0xad, 0x8e, 0x91, 0x0a, 0x5a, 0xae, 0xb1,
+  0xf6, 0x6f, 0xb1, 0xa2, 0xb1, 0x0f, 0xbf, 0x16, 0xcc, 0x9b, 0x3e, 0x2c, 0x56, 0xc6, 0x7b, 0xb3,
+  0xc3, 0x75, 0xe2, 0x4e, 0xaf, 0x8d, 0xbf, 0x3b, 0x35, 0xb3, 0x0c, 0x00, 0x65, 0x70, 0x2e, 0x48,
+  0xfb, 0x61, 0xec, 0x65, 0x49, 0x48, 0x65, 0x84, 0x39, 0x8d, 0x05, 0x10, 0xce, 0xa7, 0xc1, 0xa0,
+  0xd2, 0x6a, 0xb1, 0x92, 0xda, 0x55, 0x5a, 0x76, 0x9b, 0x91, 0xa5, 0x58, 0x01, 0x85, 0x63, 0x49,
+  0x47, 0x5c, 0x60, 0xbd, 0xd1, 0xef, 0x1d, 0xab, 0x81, 0xf9, 0x0a, 0x78, 0x12, 0x42, 0x79, 0x95,
+  0x14, 0x25, 0xab, 0x73, 0x20, 0x7c, 0x92, 0x12, 0x91, 0x09, 0xe8, 0x11, 0x80, 0x06, 0x9a, 0x6f,
+  0x08, 0x06, 0x70, 0xb0, 0x0a, 0x25, 0x94, 0x33, 0x42, 0x7c, 0x40, 0x88, 0x20, 0x83, 0x4a, 0x45,
+  0x32, 0xad, 0x0d, 0x85, 0x98, 0xd5, 0x75, 0x7f, 0x60, 0x0e, 0x18, 0x58, 0x3a, 0x69, 0xd5, 0x3a,
+  0x8b, 0x5a, 0xa5, 0xf5, 0x7f, 0x48, 0x7d, 0x34, 0x79, 0x71, 0x75, 0x75, 0x15, 0xe5, 0x70, 0x23,
+  0x9a, 0xcf, 0x72, 0xd4, 0xb4, 0x6d, 0x1b, 0x35, 0x5a, 0x75, 0xf2, 0x2e, 0xce, 0x41, 0x1d, 0x44,
+  0x5e, 0x1e, 0xfc, 0x1f, 0x5a, 0x6d, 0x90, 0x01, 0x19, 0xd5, 0x2f, 0x1b, 0x15, 0x7f, 0x02, 0xd5,
+  0xd0, 0x07, 0x75, 0x3b, 0xd5, 0xb6, 0x5a, 0x66, 0xf3, 0x67, 0xac, 0xbb, 0x27, 0xbe, 0x50, 0xbb,
+  0x2f, 0x42, 0xb3, 0x21, 0x6d, 0x22, 0xf5, 0x92, 0x2e, 0x28, 0xc0, 0x5a, 0xc9, 0x8d, 0xea, 0x3e,
+  0x02, 0x8f, 0x78, 0x4c, 0x6c, 0x67, 0x06, 0x79, 0x6b, 0x38, 0xd6, 0xb4, 0x60, 0x8f, 0x48, 0xc7,
+  0x31, 0x40, 0x90, 0xa7, 0xb6, 0xc6, 0x7e, 0x4e, 0x0c, 0x42, 0x6e, 0x09, 0x06, 0x2b, 0x70, 0x0b,
+  0x71, 0xf2, 0xa1, 0xf2, 0xe6, 0x2f, 0xb8, 0xbc, 0x5a, 0x5e, 0xe7, 0x45, 0x62, 0xc3, 0xdb, 0x93,
+  0xe7, 0xf1, 0x67, 0x27, 0x2a, 0xde, 0x8d, 0x7b, 0xba, 0xef, 0xef, 0x97, 0x61, 0x5c, 0x61, 0x1b,
+  0x77, 0x71, 0xc0, 0xa0, 0x2f, 0xf6, 0x5a, 0x34, 0x5b, 0xce, 0x87, 0x82, 0x29, 0xba, 0xb4, 0x7f,
+  0x6a, 0xe2, 0x82, 0x11, 0xc0, 0x45, 0x8e, 0xe5, 0x74, 0x52, 0xd5, 0xef, 0xdd, 0x16, 0xa5, 0x10,
+  0xe8, 0x78, 0xd4, 0x91, 0x01, 0x17, 0x25, 0xb8, 0xa0, 0x39, 0x59, 0xdc, 0x1f, 0xb8, 0xca, 0x43,
+  0x4a, 0xcb, 0x30, 0x84, 0xf9, 0xfc, 0x87, 0x80, 0x93, 0xbc, 0x7b, 0x4f, 0x89, 0xa3, 0xc5, 0x8f,
+  0xfa, 0x02, 0xa6, 0xf7, 0xaf, 0x97, 0xf0, 0x14, 0x2c, 0x2e, 0xeb, 0xe5, 0x19, 0x18, 0x42, 0x81,
+  0xae, 0x72, 0x1a, 0xfe, 0x37, 0xa0, 0xea, 0x39, 0x9b, 0xf4, 0xaf, 0x0f, 0xae, 0xc1, 0xeb, 0x39,
+  0x25, 0xa1, 0x8c, 0x2b, 0x63, 0x5b, 0x69, 0xdf, 0x1b, 0x0d, 0x90, 0x50, 0xaa, 0xec, 0xc5, 0xe5,
+  0xe5, 0xe5, 0x77, 0x48, 0xfa, 0xe6, 0xbc, 0xeb, 0x98, 0x2f, 0xb8, 0x63, 0xe3, 0x53, 0x12, 0xe9,
+  0x4c, 0x08, 0x14, 0x03, 0x0a, 0x95, 0xc0, 0x39, 0x0c, 0x09, 0x84, 0x71, 0xa3, 0x11, 0x7b, 0x4a,
+  0xb2, 0x49, 0x92, 0xcf, 0x6d, 0x1a, 0x6d, 0x9c, 0x9c, 0x56, 0x66, 0x3a, 0x6c, 0x18, 0xbf, 0x68,
+  0x3e, 0x6f, 0xe8, 0x3f, 0x6b, 0xcc, 0xc1, 0x6e, 0x56, 0x22, 0xde, 0xfa, 0xf8, 0x54, 0x75, 0x3e,
+  0x19, 0x54, 0x1e, 0xef, 0xcd, 0xf0, 0xf9, 0x06, 0xd1, 0xf0, 0x87, 0x49, 0xc6, 0x08, 0x00, 0x00,
+};
+
+// script.js
+static const uint8_t ASSET_SCRIPT_JS[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x95, 0x19, 0x7f, 0x53, 0xdb, 0xc8,
+  0xf5, 0x7f, 0x7f, 0x8a, 0x8d, 0x9a, 0xc6, 0xab, 0xc3, 0x08, 0xdb, 0x94, 0x2b, 0x67, 0x87, 0x64,
+  0x08, 0x21, 0x87, 0x5b, 0x02, 0x99, 0xc0, 0xe5, 0xda, 0x32, 0x4c, 0x10, 0xd2, 0x1a, 0xef, 0x21,
+  0x4b, 0x3e, 0x69, 0x8d, 0x31, 0x9c, 0x67, 0xfa, 0x69, 0xfa, 0xc1, 0xfa, 0x49, 0xfa, 0xde, 0xdb,
+  0x95, 0xb4, 0x6b, 0x3b, 0x90, 0x66, 0x26, 0x46, 0xbb, 0xfb, 0x7e, 0xff, 0xdc, 0x27, 0xdd, 0x85,
+  0x39, 0xbb, 0x09, 0x95, 0x98, 0x85, 0x73, 0xb6, 0xc7, 0xae, 0x66, 0x45, 0x6f, 0x6b, 0xeb, 0xe5,
+  0xe3, 0x4c, 0xa6, 0x71, 0x36, 0x0b, 0x92, 0x2c, 0x0a, 0x95, 0xcc, 0xd2, 0x60, 0x94, 0x15, 0x2a,
+  0x0d, 0xc7, 0x62, 0xb1, 0x35, 0x2b, 0xae, 0xfa, 0x8d, 0x3b, 0x40, 0x9a, 0x89, 0xeb, 0x22, 0x8b,
+  0x6e, 0x85, 0xea, 0x37, 0x0c, 0x74, 0x18, 0xc7, 0x87, 0x77, 0x22, 0x55, 0xc7, 0xb2, 0x50, 0x22,
+  0x15, 0x39, 0x6f, 0x26, 0x59, 0x18, 0x37, 0x5b, 0x2c, 0x4b, 0xf1, 0xc1, 0xef, 0x37, 0x86, 0xd3,
+  0x34, 0x42, 0x7a, 0x66, 0x87, 0x0b, 0x04, 0xf7, 0xd9, 0x63, 0x23, 0xce, 0xa2, 0xe9, 0x18, 0x9e,
+  0x83, 0x1b, 0xa1, 0x0e, 0x13, 0x81, 0x8f, 0xef, 0xe6, 0x83, 0x98, 0x7b, 0x0f, 0x59, 0x2a, 0x3c,
+  0x7f, 0x95, 0xb4, 0x17, 0x8d, 0xc2, 0xf4, 0x46, 0x78, 0x2d, 0x26, 0xd8, 0xde, 0x1b, 0xa0, 0x50,
+  0x88, 0x44, 0x44, 0x4a, 0xc4, 0xff, 0x02, 0x04, 0x50, 0x64, 0x12, 0xe6, 0x85, 0x18, 0xa4, 0x8a,
+  0x8b, 0x40, 0x85, 0x39, 0x50, 0x0d, 0xee, 0xc2, 0x64, 0x2a, 0x5a, 0xac, 0xd3, 0x06, 0x39, 0xe4,
+  0x90, 0x71, 0xa4, 0xfc, 0x05, 0xf7, 0x8a, 0x0b, 0x1b, 0xf7, 0xd2, 0x67, 0xc5, 0x28, 0x9b, 0x7d,
+  0x16, 0x61, 0x2c, 0xd3, 0x9b, 0xe2, 0xdb, 0x60, 0xfd, 0xc6, 0x02, 0x29, 0xa5, 0x52, 0xfd, 0x2a,
+  0xae, 0xcf, 0xc8, 0x12, 0x1c, 0x37, 0x6b, 0x25, 0x81, 0x6b, 0x45, 0xc6, 0x7f, 0x6c, 0x54, 0x06,
+  0x0b, 0x0a, 0x91, 0x82, 0x6a, 0xd6, 0xb1, 0xe7, 0x22, 0x86, 0xa9, 0x1c, 0x83, 0x4b, 0xde, 0x4d,
+  0x95, 0xca, 0x52, 0x7e, 0xad, 0x52, 0x34, 0x11, 0xfc, 0x09, 0xa2, 0x24, 0x2c, 0x0a, 0xb4, 0x41,
+  0x90, 0x8b, 0x71, 0x76, 0x27, 0xb8, 0x07, 0xa4, 0x14, 0x62, 0xdf, 0x65, 0x32, 0x66, 0x08, 0x92,
+  0x0d, 0x87, 0x85, 0x50, 0xbf, 0xca, 0x58, 0x8d, 0xfa, 0x4b, 0x38, 0x60, 0xc4, 0x1a, 0x61, 0x41,
+  0x4e, 0x5c, 0xb2, 0x5a, 0x5b, 0xbb, 0xb6, 0xd6, 0x19, 0xf6, 0x2e, 0x2e, 0x2d, 0xbf, 0x01, 0x69,
+  0x04, 0x3d, 0xc8, 0xa6, 0x60, 0xda, 0x08, 0x7f, 0x51, 0xb4, 0x28, 0x4b, 0x0b, 0x65, 0x68, 0x01,
+  0xc6, 0x33, 0xce, 0xd4, 0xe6, 0xd7, 0xd0, 0x41, 0x36, 0x41, 0xba, 0x45, 0x90, 0x88, 0xf4, 0x46,
+  0x8d, 0xd8, 0xde, 0xde, 0x1e, 0x33, 0x64, 0x73, 0xa1, 0xa6, 0x79, 0xda, 0x37, 0x8e, 0x0d, 0x64,
+  0x0a, 0x6e, 0x3f, 0x3a, 0xff, 0x78, 0x0c, 0x0c, 0x3c, 0x0f, 0x44, 0xca, 0x72, 0xc6, 0x13, 0xa1,
+  0xd8, 0x03, 0xc9, 0x0d, 0x7f, 0x5e, 0x6b, 0x4c, 0x78, 0xdc, 0xd8, 0xf0, 0x8d, 0x34, 0xa4, 0x73,
+  0x2a, 0x66, 0xec, 0x94, 0xf8, 0x70, 0x8f, 0x14, 0xf5, 0xd8, 0x06, 0xf8, 0x1f, 0x7e, 0x3a, 0x7e,
+  0x8b, 0x3d, 0xf8, 0x8e, 0x44, 0xc6, 0x16, 0x6f, 0x2a, 0x39, 0x56, 0x4d, 0x64, 0x48, 0x53, 0x40,
+  0xc1, 0x8e, 0x0d, 0x50, 0x1d, 0x8e, 0x64, 0x1c, 0x8b, 0x94, 0x19, 0x2a, 0x20, 0x5b, 0xb7, 0xdf,
+  0xa8, 0xcd, 0x5a, 0xa9, 0x6b, 0x44, 0x36, 0xde, 0x88, 0xb2, 0xf1, 0x38, 0x4c, 0xe3, 0x33, 0xf1,
+  0xbb, 0x66, 0xa4, 0xed, 0x7a, 0x76, 0x78, 0xfe, 0xe9, 0x74, 0x70, 0x72, 0xfe, 0x75, 0x70, 0xf2,
+  0xe9, 0x97, 0xf3, 0x33, 0x38, 0x7a, 0x3c, 0xef, 0x31, 0x70, 0xa4, 0x3a, 0x17, 0xe3, 0x09, 0x64,
+  0xc0, 0x91, 0x5e, 0x1d, 0x4d, 0xc7, 0xb0, 0x38, 0xd6, 0x8b, 0x63, 0x79, 0x33, 0x52, 0xde, 0xc2,
+  0x71, 0x1d, 0x52, 0x56, 0x93, 0x4c, 0x82, 0xeb, 0x6e, 0x21, 0x63, 0x5b, 0x4c, 0xa6, 0x93, 0xa9,
+  0x1a, 0xc0, 0x83, 0x09, 0x31, 0xcd, 0xaf, 0xd4, 0xeb, 0x5b, 0x6e, 0x34, 0x58, 0xbe, 0x36, 0x00,
+  0x4a, 0x59, 0x4a, 0xbd, 0xb1, 0xd1, 0x5f, 0x89, 0xf2, 0x3f, 0xa1, 0xb1, 0x2d, 0xc5, 0x36, 0x98,
+  0xd7, 0xc7, 0x2d, 0x94, 0x00, 0xdd, 0xe0, 0x98, 0xf7, 0xad, 0x6b, 0x6d, 0x50, 0xc5, 0xf3, 0x11,
+  0xa3, 0x87, 0x18, 0xc4, 0x0e, 0x7c, 0xb5, 0x9a, 0x1d, 0x4e, 0xf2, 0x64, 0xe9, 0x7e, 0x74, 0xcb,
+  0xc3, 0xe8, 0x16, 0x35, 0x42, 0xbf, 0xc2, 0x23, 0xa4, 0xcb, 0x6f, 0x44, 0xd6, 0x67, 0xa8, 0x63,
+  0x96, 0x08, 0x28, 0x6d, 0x37, 0x50, 0x44, 0xb4, 0x5c, 0x8c, 0x84, 0x44, 0x38, 0xf8, 0x4f, 0xfc,
+  0x58, 0xb9, 0x51, 0x22, 0xe2, 0x2e, 0x2b, 0x17, 0x18, 0xc3, 0x14, 0x7f, 0xda, 0x60, 0x21, 0xcb,
+  0x86, 0x1a, 0x7b, 0x32, 0x49, 0x24, 0x32, 0x31, 0x8c, 0x83, 0x07, 0x0a, 0x68, 0x47, 0xa7, 0x57,
+  0xaf, 0x96, 0x1d, 0x7a, 0x11, 0x06, 0x11, 0x54, 0x9d, 0x6f, 0x99, 0x7b, 0x2d, 0x74, 0x15, 0x7c,
+  0x61, 0x70, 0x87, 0xda, 0x2f, 0x5c, 0x3f, 0x63, 0x60, 0x94, 0x75, 0xc3, 0xf1, 0xbb, 0x77, 0x0e,
+  0x21, 0x62, 0x85, 0xce, 0x8a, 0xf5, 0x10, 0x1a, 0x02, 0x69, 0x3d, 0xf2, 0x91, 0x41, 0xd6, 0x91,
+  0xb6, 0x16, 0x97, 0xe2, 0x6e, 0x3d, 0xf6, 0xb1, 0xc1, 0xd6, 0xa1, 0xb9, 0x06, 0x7f, 0xa9, 0x96,
+  0x9a, 0x80, 0x2c, 0x9d, 0xd5, 0x3c, 0xcf, 0xe7, 0x50, 0x2b, 0x99, 0xca, 0x58, 0x36, 0x81, 0xd4,
+  0x0a, 0x59, 0x05, 0x8b, 0x4e, 0x4d, 0x05, 0x11, 0xf9, 0xef, 0xbf, 0xff, 0xd3, 0xf4, 0xad, 0x28,
+  0x04, 0x13, 0x61, 0xfa, 0xd7, 0x64, 0x4d, 0xaf, 0xb3, 0x61, 0x82, 0x6b, 0x99, 0x86, 0xf9, 0xfc,
+  0x7c, 0x3e, 0x41, 0x8b, 0x36, 0xc3, 0x3c, 0x0f, 0xe7, 0xd7, 0xd3, 0xe1, 0x50, 0xe4, 0x4d, 0x1b,
+  0x2a, 0x4b, 0x89, 0xef, 0x1e, 0x44, 0xd8, 0x29, 0x3c, 0xb8, 0x47, 0x51, 0x92, 0x15, 0x82, 0xce,
+  0x0e, 0xf0, 0xc9, 0x3d, 0x1c, 0x8b, 0xa2, 0x08, 0x6f, 0xf4, 0xf1, 0x47, 0xfd, 0xbc, 0x14, 0xb2,
+  0x48, 0xb0, 0xee, 0x86, 0x8e, 0xda, 0x07, 0x95, 0x6e, 0xa4, 0xb7, 0x88, 0x51, 0x3f, 0xa8, 0xe9,
+  0x4a, 0x97, 0x89, 0xcd, 0x4e, 0xbf, 0x71, 0x2b, 0xe6, 0xc3, 0x1c, 0xba, 0xf3, 0x67, 0xf1, 0x3b,
+  0x14, 0x17, 0x8c, 0xd6, 0x3d, 0xa6, 0xf2, 0xa9, 0x58, 0xcd, 0xc6, 0x49, 0x9e, 0xa9, 0xac, 0x07,
+  0xfa, 0x76, 0xbd, 0xe5, 0xac, 0x21, 0xb9, 0x9f, 0x97, 0x81, 0x14, 0x25, 0x19, 0x30, 0x8a, 0xe4,
+  0x58, 0x64, 0x53, 0xc5, 0x1d, 0xcf, 0xb5, 0x58, 0xb7, 0xdd, 0x6e, 0xbb, 0xe4, 0xa7, 0x93, 0x18,
+  0xec, 0x3e, 0x48, 0x63, 0x09, 0x17, 0x8a, 0x2c, 0xe7, 0x42, 0x07, 0x38, 0xd6, 0x1e, 0xd3, 0x97,
+  0xc7, 0x32, 0x85, 0x9f, 0xf0, 0xbe, 0xae, 0x43, 0x06, 0xe6, 0x89, 0x4a, 0x54, 0x51, 0x31, 0x15,
+  0xfc, 0x85, 0xd9, 0xa8, 0x9b, 0x87, 0xa6, 0x34, 0x11, 0x79, 0x04, 0xdb, 0xda, 0x05, 0x9c, 0xeb,
+  0xdc, 0xd9, 0x44, 0x96, 0x3e, 0xdb, 0x62, 0x1c, 0xb8, 0x9a, 0x95, 0xcf, 0x7e, 0x80, 0x0b, 0x42,
+  0x55, 0x79, 0xa1, 0x75, 0x8e, 0x27, 0x22, 0xfe, 0x64, 0xa3, 0x7f, 0x0c, 0xd5, 0x28, 0x00, 0x0c,
+  0xde, 0x6e, 0x99, 0x67, 0x99, 0x72, 0xc0, 0x69, 0x59, 0x5c, 0xb0, 0xa3, 0x18, 0x51, 0x82, 0x42,
+  0xcd, 0xc1, 0x8a, 0x60, 0xab, 0x4f, 0x39, 0xb8, 0x2f, 0x57, 0x73, 0xde, 0xdc, 0xdc, 0x94, 0xa5,
+  0x21, 0x36, 0x67, 0xd8, 0xa8, 0xe1, 0x8a, 0x74, 0xf5, 0xf2, 0x71, 0x85, 0xdb, 0xe2, 0xcf, 0x57,
+  0xcb, 0x4e, 0x32, 0xd1, 0x53, 0xbb, 0x09, 0xd5, 0x56, 0x10, 0xb8, 0x50, 0x81, 0x68, 0x2f, 0x00,
+  0x3b, 0x87, 0x54, 0x75, 0xbc, 0x42, 0xe5, 0x90, 0x2f, 0x5e, 0x6d, 0xd0, 0xf1, 0xfc, 0xf4, 0xfa,
+  0x37, 0x50, 0xe1, 0x6f, 0x67, 0xa7, 0x27, 0x01, 0x5d, 0x90, 0x78, 0x8d, 0x63, 0x4c, 0x48, 0x30,
+  0x76, 0x21, 0xd3, 0xe5, 0x94, 0xb6, 0x51, 0x18, 0xf0, 0x0a, 0xc4, 0x79, 0x0d, 0x89, 0x3d, 0xad,
+  0xd0, 0xb9, 0x6e, 0xdd, 0x0c, 0xac, 0x33, 0xd3, 0xea, 0x7c, 0xbb, 0xfd, 0x81, 0x0c, 0x16, 0x04,
+  0x44, 0xd2, 0xf7, 0x5e, 0xb8, 0x34, 0xf7, 0x47, 0x17, 0xa1, 0x92, 0xad, 0x3e, 0x8f, 0x45, 0x94,
+  0xc5, 0xe2, 0x03, 0xe6, 0x84, 0xab, 0xa2, 0x5b, 0x29, 0x57, 0xa9, 0x00, 0x2e, 0x36, 0x62, 0x48,
+  0x28, 0x14, 0x12, 0x76, 0xb0, 0x97, 0xe3, 0xaa, 0xe2, 0x42, 0x75, 0x1f, 0x61, 0xa4, 0xbe, 0x77,
+  0x48, 0xe8, 0xed, 0x08, 0x60, 0xf4, 0x84, 0x0d, 0xb8, 0x7d, 0x54, 0x54, 0x00, 0x06, 0x0f, 0x2f,
+  0xe4, 0xa5, 0xbe, 0x59, 0x3d, 0x1f, 0xd3, 0x00, 0x6e, 0x5c, 0x41, 0xe8, 0xe8, 0x48, 0x05, 0xb5,
+  0x5a, 0xe4, 0x21, 0x44, 0xb4, 0x20, 0x6f, 0x2e, 0x27, 0x13, 0x01, 0xd4, 0x31, 0x05, 0xa5, 0x95,
+  0x84, 0xbd, 0x00, 0x02, 0x97, 0x78, 0xe1, 0x6d, 0xb1, 0xed, 0x1d, 0xd2, 0xdd, 0xa1, 0x3a, 0x9a,
+  0x8e, 0x65, 0x2c, 0xd5, 0x7c, 0x3d, 0x49, 0x38, 0xfd, 0x26, 0xc5, 0x36, 0x12, 0x6d, 0x57, 0x14,
+  0xeb, 0xac, 0x83, 0x30, 0x53, 0x32, 0xc5, 0xba, 0xe3, 0x70, 0x4a, 0xa8, 0xe0, 0x23, 0x9b, 0x32,
+  0x29, 0xec, 0xcb, 0x5c, 0x4d, 0x19, 0xda, 0xbf, 0x77, 0x9a, 0x7a, 0xd8, 0xf6, 0x4f, 0x87, 0x43,
+  0xcf, 0xf2, 0xf7, 0xd3, 0x78, 0xda, 0xad, 0x0b, 0x13, 0xe5, 0x1f, 0x3e, 0xef, 0x7f, 0x3c, 0xfc,
+  0xfa, 0xe5, 0xf0, 0xf3, 0xd9, 0xe0, 0xf4, 0x04, 0xe0, 0xba, 0x65, 0x36, 0x7f, 0x38, 0xde, 0xff,
+  0xf9, 0xeb, 0xdf, 0x0f, 0xff, 0x49, 0x00, 0xe8, 0xbc, 0xfb, 0x76, 0xa7, 0x3c, 0x1b, 0x9c, 0x7c,
+  0xd9, 0x3f, 0x1e, 0xbc, 0xc7, 0x7a, 0xba, 0xdd, 0xfd, 0xeb, 0x8f, 0xbb, 0x15, 0xce, 0xe0, 0xf0,
+  0xf8, 0x3d, 0x5e, 0xb9, 0x2e, 0x1a, 0x8f, 0xe8, 0xc9, 0x9e, 0xeb, 0x8d, 0x16, 0x2b, 0xe4, 0x83,
+  0xe8, 0xb1, 0x6e, 0x8b, 0xe5, 0x10, 0xf8, 0x71, 0x8f, 0xca, 0x2e, 0x5b, 0xb4, 0x2a, 0xe8, 0xca,
+  0xca, 0xcf, 0x83, 0x16, 0x0a, 0x88, 0x16, 0x15, 0x60, 0xc7, 0x3e, 0x43, 0xa6, 0xe7, 0x34, 0xc7,
+  0xd4, 0x84, 0x96, 0xd9, 0x3c, 0x75, 0x4e, 0x2e, 0x58, 0x05, 0x68, 0x98, 0xb0, 0x74, 0xdb, 0x89,
+  0x89, 0xdd, 0x95, 0x96, 0x32, 0x0c, 0x13, 0xec, 0x6c, 0x55, 0xfe, 0xd8, 0x59, 0xa6, 0xfb, 0xa5,
+  0x75, 0x89, 0x94, 0xd0, 0x75, 0x75, 0xef, 0x7d, 0x0f, 0xa9, 0xf7, 0x05, 0x96, 0x25, 0x8c, 0x8e,
+  0x0e, 0x04, 0x08, 0xae, 0xe7, 0x4a, 0x1c, 0xeb, 0xab, 0xf0, 0x6b, 0xb6, 0xc3, 0xfe, 0xf8, 0x83,
+  0xf0, 0x30, 0x25, 0x7e, 0x81, 0x2b, 0xc3, 0x2e, 0x6f, 0xfb, 0xec, 0x05, 0x44, 0x90, 0xe3, 0xd2,
+  0xe5, 0xe2, 0x5e, 0x4a, 0x8a, 0xa5, 0xdd, 0xc5, 0xee, 0xf8, 0xec, 0x95, 0xeb, 0x75, 0x4d, 0xae,
+  0xaa, 0xef, 0x05, 0xa9, 0x6c, 0x23, 0x75, 0x7e, 0xe4, 0xe0, 0x20, 0xf4, 0x8c, 0x5f, 0x02, 0x51,
+  0x8d, 0x5a, 0x02, 0xdb, 0xe5, 0x7f, 0x29, 0x5b, 0x4e, 0xc5, 0x1e, 0x2e, 0x76, 0xbc, 0xb4, 0xe3,
+  0x6b, 0xd6, 0x46, 0x65, 0x90, 0x3e, 0x32, 0xe4, 0xd5, 0x01, 0x8e, 0x1c, 0x20, 0x54, 0xfb, 0xfe,
+  0x03, 0xfc, 0xf3, 0x7d, 0xb4, 0x97, 0x6b, 0x7b, 0x87, 0x66, 0x65, 0x7c, 0x84, 0xfb, 0xfe, 0x26,
+  0xbf, 0x32, 0x58, 0x96, 0x06, 0x5b, 0x58, 0xcc, 0x40, 0xb6, 0x2a, 0x4d, 0x89, 0xae, 0xff, 0x94,
+  0xcf, 0x5d, 0x40, 0xa7, 0xd6, 0x6f, 0x77, 0xa1, 0x79, 0x52, 0x27, 0x8c, 0x92, 0x87, 0xed, 0x2e,
+  0xd7, 0x1d, 0x01, 0xef, 0x28, 0x70, 0xfb, 0xd2, 0xd3, 0x28, 0xd0, 0xd9, 0x59, 0x3f, 0xb1, 0xed,
+  0x9a, 0x69, 0x4d, 0x37, 0xb2, 0x17, 0x1a, 0x19, 0x0c, 0xc4, 0x3b, 0xec, 0xf5, 0x6b, 0x1c, 0xcd,
+  0x96, 0x8b, 0x8a, 0x21, 0xf8, 0xc6, 0xf8, 0xa3, 0x0e, 0xa0, 0x95, 0x9e, 0x9f, 0x8b, 0x42, 0x57,
+  0x5a, 0xd7, 0x71, 0x9a, 0x00, 0xf0, 0xec, 0xdb, 0xe3, 0x0e, 0x3a, 0xd8, 0x6a, 0x3c, 0x0f, 0x97,
+  0xe8, 0x3e, 0xee, 0xee, 0xc0, 0xdc, 0xb5, 0xf0, 0x2d, 0x35, 0xac, 0x06, 0xa0, 0xcb, 0x84, 0xd3,
+  0x02, 0x2a, 0x95, 0x4a, 0x41, 0x4a, 0xa5, 0xa4, 0xab, 0x94, 0x16, 0x62, 0x28, 0x45, 0x82, 0xe6,
+  0xd6, 0x84, 0xa8, 0x5d, 0x20, 0x36, 0x6d, 0x07, 0x98, 0xae, 0x54, 0x49, 0x3b, 0xba, 0x3f, 0x91,
+  0x40, 0xfa, 0x88, 0xca, 0xe6, 0x7a, 0x15, 0xed, 0x7e, 0xa9, 0x99, 0xe4, 0xe1, 0xcc, 0x82, 0x1d,
+  0x50, 0xb4, 0x6b, 0xd8, 0xa5, 0x90, 0x2f, 0x87, 0x0b, 0x42, 0x00, 0xbe, 0x65, 0x75, 0x7c, 0xcb,
+  0x4e, 0xc2, 0x13, 0x28, 0xcf, 0xb8, 0xbf, 0x05, 0x3d, 0xa0, 0xbf, 0x56, 0x18, 0xbd, 0xa0, 0x22,
+  0x07, 0x18, 0x14, 0x19, 0xb4, 0xd0, 0xf7, 0x2e, 0x1f, 0xf0, 0xcd, 0xe0, 0xb8, 0x68, 0x18, 0x6f,
+  0x6e, 0x94, 0x48, 0xa8, 0x69, 0xd9, 0x56, 0xca, 0x7a, 0x08, 0x63, 0x81, 0xf1, 0x51, 0xad, 0x7d,
+  0x40, 0xf5, 0x8c, 0x32, 0x5e, 0xaf, 0x35, 0x2c, 0x65, 0x56, 0xbb, 0x53, 0x65, 0x79, 0x0c, 0x7d,
+  0x43, 0x09, 0xe6, 0xc0, 0xe8, 0x66, 0x51, 0xbe, 0x00, 0xaa, 0x63, 0xcd, 0xbe, 0x6b, 0xf8, 0xff,
+  0xc7, 0x3b, 0x20, 0x0a, 0xf3, 0x68, 0x14, 0xe6, 0xea, 0x03, 0xaa, 0xd0, 0x69, 0x59, 0x8b, 0xae,
+  0x4e, 0x82, 0x91, 0x2c, 0xa0, 0x89, 0xce, 0xcf, 0xa5, 0xc8, 0xf1, 0xe5, 0x05, 0x58, 0x0f, 0x7a,
+  0x5b, 0x58, 0xcc, 0xd3, 0x88, 0x55, 0xb5, 0x74, 0x28, 0x54, 0x34, 0x3a, 0xd2, 0x80, 0x30, 0x13,
+  0xe7, 0x52, 0xab, 0x6b, 0x1c, 0x27, 0x8a, 0x09, 0x3c, 0xd0, 0xbc, 0x37, 0x0b, 0xa5, 0xd2, 0xd0,
+  0xfc, 0x6a, 0xcb, 0x50, 0x7e, 0xab, 0x11, 0xf6, 0x5e, 0x3e, 0xea, 0x87, 0xc5, 0x2b, 0x05, 0xbc,
+  0x60, 0x69, 0x71, 0x5e, 0x5c, 0x95, 0x15, 0xab, 0xa4, 0x16, 0x64, 0x30, 0x22, 0xab, 0x51, 0x9e,
+  0xcd, 0xa8, 0x4c, 0x1f, 0xe6, 0x39, 0x34, 0xfe, 0x2b, 0x83, 0xc2, 0x2a, 0x5a, 0x3d, 0x78, 0xac,
+  0x50, 0xb4, 0x0d, 0x89, 0xd6, 0x52, 0xf6, 0x20, 0x09, 0x0a, 0xa9, 0x7d, 0x1c, 0x9f, 0xb8, 0x96,
+  0xb3, 0xc2, 0xa3, 0x99, 0xea, 0x1d, 0xd5, 0x7f, 0xee, 0x57, 0xc8, 0x23, 0x30, 0x30, 0xd9, 0x24,
+  0xa5, 0xfa, 0xfd, 0xa6, 0x7e, 0x6b, 0x57, 0x21, 0x6a, 0x90, 0x02, 0x03, 0x96, 0x5f, 0xfd, 0x63,
+  0xd3, 0x58, 0x68, 0xf3, 0xe5, 0x23, 0xbd, 0x8d, 0xbc, 0xf2, 0xcd, 0x0b, 0x3d, 0x4d, 0x2f, 0xcd,
+  0x30, 0xc0, 0x35, 0x0a, 0xf7, 0x4e, 0xb2, 0x99, 0x07, 0xe7, 0x20, 0x72, 0xae, 0xac, 0xed, 0x33,
+  0x5c, 0xeb, 0x03, 0x31, 0x71, 0xf6, 0xc5, 0xc4, 0xab, 0x48, 0x15, 0x51, 0x98, 0x08, 0xfb, 0x14,
+  0xd7, 0x1a, 0x2b, 0x97, 0xb1, 0x7d, 0xa2, 0x03, 0xa3, 0xc6, 0x1c, 0x8b, 0x10, 0x87, 0xc4, 0x12,
+  0x0e, 0x22, 0x71, 0x1b, 0xd2, 0xa0, 0x03, 0x61, 0xdf, 0xb6, 0xe4, 0xfc, 0x88, 0x36, 0x83, 0xce,
+  0x28, 0x02, 0x58, 0xf0, 0x0a, 0x39, 0x09, 0xaf, 0x21, 0x65, 0xe9, 0xad, 0x5b, 0x8b, 0xe9, 0xab,
+  0xbc, 0x7e, 0x01, 0x67, 0x17, 0x1d, 0xe4, 0xa0, 0xeb, 0xce, 0x9d, 0xfd, 0x36, 0x09, 0xb7, 0x36,
+  0x4a, 0xc6, 0x75, 0xf0, 0x28, 0x12, 0x06, 0x6d, 0xb0, 0x01, 0x8d, 0x48, 0xe2, 0xa4, 0x03, 0xf8,
+  0x38, 0xf8, 0x94, 0x90, 0x3f, 0x90, 0x29, 0x70, 0xa8, 0x44, 0xe6, 0xc1, 0x64, 0x5a, 0x8c, 0xb8,
+  0x69, 0xdc, 0x82, 0x6b, 0x59, 0x37, 0x19, 0x3e, 0xc0, 0x1f, 0x65, 0x46, 0xa4, 0xb6, 0x1f, 0xa8,
+  0xec, 0x38, 0x43, 0xab, 0xe0, 0x10, 0x78, 0x46, 0xb3, 0x06, 0xb9, 0x16, 0xa5, 0xd6, 0x34, 0x4c,
+  0x71, 0x90, 0x97, 0x4b, 0x45, 0x24, 0x9d, 0x26, 0x49, 0x59, 0x05, 0xe8, 0x78, 0x4b, 0x9b, 0xdb,
+  0xea, 0x55, 0xec, 0xd1, 0x98, 0xc2, 0x58, 0x61, 0x81, 0x47, 0x4f, 0xa4, 0x0c, 0xde, 0x31, 0xe8,
+  0x8d, 0x81, 0x82, 0xd0, 0x2d, 0x35, 0xbf, 0xc0, 0x5b, 0x53, 0x8b, 0xc1, 0xdd, 0xe8, 0xb2, 0xca,
+  0x1c, 0x98, 0xc2, 0xc6, 0x12, 0x03, 0x32, 0x49, 0xf8, 0x85, 0x93, 0x74, 0x74, 0xc7, 0x42, 0x0f,
+  0xbb, 0xbb, 0xf5, 0x35, 0xf9, 0xb2, 0x4c, 0x20, 0x2b, 0xdb, 0xc9, 0xcc, 0xf5, 0x12, 0x6b, 0x26,
+  0xb4, 0x60, 0x91, 0x9f, 0x81, 0x35, 0x12, 0x71, 0x80, 0x27, 0xbc, 0x69, 0x52, 0x8a, 0x56, 0xf8,
+  0xde, 0x05, 0xc6, 0xbd, 0xe6, 0x26, 0xfc, 0x20, 0xc3, 0xa0, 0x54, 0x93, 0x16, 0xa8, 0x2b, 0x1c,
+  0xe6, 0x37, 0xd7, 0x21, 0xef, 0xee, 0xec, 0xb4, 0xd8, 0x4f, 0x3f, 0x41, 0x80, 0x6f, 0xc3, 0x95,
+  0xa4, 0xe3, 0xe3, 0xc8, 0x6d, 0x95, 0x96, 0xe7, 0x59, 0x1d, 0x19, 0xc9, 0x4b, 0x76, 0xa0, 0x49,
+  0xc5, 0x0d, 0x9f, 0x6d, 0x66, 0xc0, 0xaa, 0xb3, 0xb3, 0x8b, 0xbc, 0x76, 0x4b, 0x5e, 0x75, 0xf3,
+  0xa8, 0xf5, 0x23, 0x9c, 0xa0, 0x0a, 0x52, 0x4b, 0x81, 0xfe, 0x2a, 0x18, 0xfe, 0x40, 0x75, 0x2f,
+  0x2e, 0xda, 0x97, 0x66, 0x2a, 0xad, 0x95, 0x74, 0xc1, 0xf5, 0xf4, 0xc1, 0x5d, 0x05, 0x97, 0x78,
+  0xd5, 0xd2, 0xaf, 0x81, 0x5a, 0xc3, 0xaa, 0xd4, 0xd0, 0x85, 0xae, 0x39, 0xe1, 0xb4, 0x08, 0xc3,
+  0x4d, 0x34, 0x62, 0x5c, 0x60, 0xe5, 0xb3, 0xdf, 0x79, 0xd0, 0x06, 0xf7, 0xa8, 0x22, 0xea, 0x70,
+  0xc0, 0x17, 0x4f, 0xc6, 0xb6, 0x3d, 0xfc, 0xe6, 0x40, 0x18, 0x4b, 0xe3, 0xe4, 0xaa, 0x3b, 0xa2,
+  0x30, 0xbd, 0x0b, 0x0b, 0x7c, 0xc9, 0x41, 0x92, 0xb7, 0x9c, 0x98, 0x86, 0x46, 0x91, 0x25, 0x99,
+  0x75, 0x65, 0x8e, 0xd4, 0xfd, 0x13, 0x73, 0x61, 0x49, 0xcb, 0xc7, 0x83, 0x03, 0xb8, 0x3e, 0x88,
+  0x7b, 0xf0, 0x77, 0x97, 0xde, 0xc4, 0x98, 0x9c, 0xc1, 0x9c, 0x35, 0x8c, 0xd5, 0x7d, 0x0b, 0x93,
+  0x61, 0x3e, 0x81, 0x7b, 0x7e, 0x33, 0x91, 0xa9, 0x68, 0xb6, 0x28, 0x31, 0x7b, 0x74, 0xe1, 0x44,
+  0x21, 0x7a, 0xa5, 0x30, 0x8d, 0xd2, 0x78, 0x3d, 0x76, 0x61, 0x0e, 0xcd, 0x59, 0x89, 0x42, 0xd2,
+  0x36, 0xae, 0xb3, 0x1c, 0xd4, 0x3b, 0x40, 0x99, 0x7b, 0x5a, 0x74, 0xd8, 0x0b, 0xa3, 0xdb, 0x1b,
+  0x6a, 0xee, 0xf6, 0x7e, 0x90, 0x8b, 0x49, 0x12, 0x46, 0x82, 0x37, 0x21, 0x92, 0x20, 0xc2, 0xda,
+  0x41, 0x17, 0x22, 0xaa, 0xd5, 0x18, 0xca, 0x24, 0xd1, 0x63, 0x4f, 0xab, 0xa1, 0x44, 0x5a, 0x80,
+  0xd1, 0xa0, 0x28, 0x06, 0xdb, 0x8d, 0xc5, 0x65, 0x03, 0x66, 0x15, 0xf3, 0x29, 0x00, 0x45, 0x34,
+  0xe5, 0x5f, 0xde, 0x89, 0x12, 0x9e, 0x0a, 0x04, 0x9d, 0xdd, 0xc3, 0x0f, 0x53, 0x32, 0xba, 0xc5,
+  0x15, 0x8b, 0x65, 0x01, 0xbc, 0x60, 0xc4, 0xa1, 0x8b, 0x2a, 0x5b, 0xe0, 0xd0, 0x33, 0xd7, 0x10,
+  0x2a, 0x11, 0x0e, 0x04, 0x11, 0x62, 0x68, 0x37, 0xb0, 0x09, 0x55, 0xed, 0x26, 0xc2, 0xeb, 0xe1,
+  0x91, 0x9c, 0xf9, 0xdc, 0x77, 0x2c, 0xa8, 0x30, 0xf4, 0xad, 0xe9, 0x9b, 0x1f, 0x38, 0xac, 0x7e,
+  0xfb, 0x5d, 0x1f, 0xad, 0xdc, 0x9b, 0x81, 0xfb, 0xa9, 0x0a, 0x8a, 0xfe, 0x4a, 0x81, 0xd3, 0xdf,
+  0x9c, 0xd6, 0xed, 0x17, 0x74, 0xa1, 0x13, 0x39, 0xa0, 0xf2, 0xe5, 0x73, 0x1a, 0xd7, 0xf5, 0xc0,
+  0x0e, 0xff, 0xff, 0x07, 0xc8, 0x8b, 0xd6, 0x25, 0xf1, 0x1b, 0x00, 0x00,
+};
+
+// index.html
+static const uint8_t ASSET_INDEX_HTML[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xc5, 0x56, 0xc1, 0x6e, 0xdb, 0x46,
+  0x10, 0xbd, 0xfb, 0x2b, 0xb6, 0x5b, 0xa0, 0x68, 0x80, 0xca, 0x12, 0x69, 0x29, 0x90, 0x2d, 0x91,
+  0x3d, 0xb8, 0x6d, 0x7c, 0x08, 0xd0, 0x22, 0x76, 0x0f, 0xcd, 0xa5, 0x58, 0xef, 0x8e, 0xc4, 0x69,
+  0xc8, 0x25, 0xbb, 0x3b, 0x94, 0xe2, 0x9c, 0x72, 0x6c, 0x8a, 0x00, 0x01, 0x92, 0x4b, 0xd2, 0x4b,
+  0x91, 0x53, 0x7e, 0xa1, 0xdf, 0x93, 0x1f, 0x48, 0x3f, 0xa1, 0xb3, 0x24, 0x15, 0x4b, 0xb6, 0x5c,
+  0x1b, 0x46, 0x8a, 0x5e, 0xb8, 0xd4, 0xee, 0x9b, 0x9d, 0xf7, 0x9e, 0x66, 0x87, 0x3b, 0xfd, 0xec,
+  0x9b, 0xef, 0x0f, 0x4f, 0x7e, 0xfa, 0xe1, 0x5b, 0x91, 0x51, 0x91, 0xa7, 0x3b, 0xd3, 0xd5, 0x00,
+  0xca, 0xf0, 0x40, 0x48, 0x39, 0xa4, 0xc7, 0x85, 0x72, 0x24, 0xee, 0x39, 0x00, 0x9b, 0x95, 0xb5,
+  0x87, 0x69, 0xbf, 0x9d, 0xdf, 0x99, 0x16, 0x40, 0x4a, 0x58, 0x55, 0x40, 0x22, 0x17, 0x08, 0xcb,
+  0xaa, 0x74, 0x24, 0x85, 0x2e, 0x2d, 0x81, 0xa5, 0x44, 0x2e, 0xd1, 0x50, 0x96, 0x18, 0x58, 0xa0,
+  0x86, 0x5e, 0xf3, 0xe3, 0x2b, 0x81, 0x16, 0x09, 0x55, 0xde, 0xf3, 0x5a, 0xe5, 0x90, 0x44, 0x92,
+  0x37, 0xc9, 0xd1, 0x3e, 0x12, 0x0e, 0xf2, 0x44, 0x7a, 0x3a, 0xcb, 0xc1, 0x67, 0x00, 0xbc, 0x0b,
+  0x9d, 0x55, 0xbc, 0x2b, 0xc1, 0x63, 0xea, 0x6b, 0xef, 0xa5, 0xc8, 0x1c, 0xcc, 0x3a, 0xc4, 0x2e,
+  0x4f, 0x7c, 0xbd, 0x48, 0xc6, 0x77, 0x61, 0x18, 0xcf, 0x86, 0xa0, 0x63, 0xd8, 0xd7, 0x66, 0x34,
+  0x0e, 0x7b, 0x79, 0xed, 0xb0, 0x22, 0xe1, 0x9d, 0x4e, 0xa4, 0xce, 0x98, 0x76, 0x2f, 0x47, 0x82,
+  0xdd, 0x5f, 0x02, 0x3e, 0x82, 0xbd, 0x78, 0x68, 0x4e, 0x47, 0x51, 0xac, 0xa2, 0x59, 0x34, 0x56,
+  0x32, 0x9d, 0xf6, 0x5b, 0x3c, 0x07, 0xf6, 0x3b, 0xc5, 0x8d, 0xa2, 0x10, 0xe9, 0x81, 0x15, 0xfc,
+  0x78, 0xf2, 0x5d, 0xaf, 0xd9, 0xf7, 0xb4, 0x34, 0x67, 0x3c, 0x18, 0x5c, 0x08, 0x9d, 0x2b, 0xef,
+  0x99, 0x59, 0x59, 0x59, 0xb5, 0x90, 0x9b, 0x93, 0x55, 0xae, 0x2c, 0xf5, 0xe6, 0xec, 0x14, 0xa1,
+  0x9d, 0x87, 0xc5, 0x4a, 0x34, 0x94, 0x13, 0xc9, 0x1e, 0xce, 0xd1, 0x1e, 0x88, 0xc1, 0x44, 0xcc,
+  0xd8, 0xa0, 0x9e, 0xc7, 0x27, 0x70, 0x20, 0xa2, 0xdd, 0xd8, 0x41, 0x31, 0x61, 0xcf, 0xf2, 0xd2,
+  0x1d, 0x88, 0x65, 0xc6, 0x6c, 0x27, 0x8d, 0x10, 0x72, 0xa5, 0x9d, 0x6f, 0xb1, 0xbe, 0x5b, 0x60,
+  0xc6, 0x55, 0x78, 0x70, 0xf2, 0xf3, 0xe1, 0x12, 0xbd, 0x38, 0x6c, 0x95, 0x45, 0xe9, 0x61, 0xa6,
+  0xec, 0x1c, 0xc4, 0x31, 0x50, 0x55, 0xa2, 0x25, 0xf1, 0xfe, 0x8f, 0x37, 0x1f, 0xfe, 0x7a, 0xc1,
+  0xa2, 0xa3, 0x90, 0x0a, 0x72, 0xd0, 0x24, 0xd0, 0x24, 0xf2, 0x49, 0x69, 0x81, 0xad, 0x46, 0x63,
+  0xc0, 0xf2, 0x4a, 0x59, 0x11, 0x96, 0x56, 0x2c, 0x54, 0x5e, 0xb3, 0x82, 0x81, 0x4c, 0x1f, 0xf2,
+  0xba, 0x88, 0xa6, 0xfd, 0x76, 0x21, 0x24, 0x6e, 0x83, 0xb7, 0x52, 0xe8, 0xea, 0xe0, 0x82, 0x45,
+  0x5a, 0x39, 0xc3, 0x0e, 0xa1, 0xd9, 0x32, 0xdf, 0x1a, 0xb6, 0x0e, 0x6c, 0x0a, 0x4d, 0xa6, 0x47,
+  0x75, 0x81, 0x06, 0xe9, 0xac, 0x15, 0xfd, 0x11, 0xe2, 0x97, 0x48, 0x3a, 0x0b, 0x51, 0x68, 0xab,
+  0x9a, 0xba, 0x9a, 0xb1, 0x75, 0x71, 0x0a, 0x4e, 0x36, 0x82, 0xf8, 0x5f, 0xe4, 0x58, 0x29, 0x0a,
+  0xb4, 0x41, 0x80, 0x28, 0xd4, 0xe3, 0x44, 0x46, 0x03, 0x7e, 0xf3, 0x04, 0x55, 0x22, 0x47, 0xcd,
+  0x9f, 0x5b, 0x13, 0xb1, 0xcc, 0xd2, 0xea, 0x1c, 0xf5, 0xa3, 0x10, 0x64, 0x0d, 0x47, 0x7d, 0x49,
+  0x19, 0xfa, 0x3b, 0x32, 0x65, 0xd7, 0xa6, 0xfd, 0x16, 0x73, 0xc1, 0xf6, 0x9b, 0xd2, 0xbf, 0x8f,
+  0xf3, 0x8c, 0x6e, 0xc3, 0xbd, 0x09, 0xbc, 0x05, 0xfb, 0x26, 0xee, 0xd3, 0xf1, 0x3f, 0x81, 0xa2,
+  0x02, 0xa7, 0xa8, 0x76, 0x70, 0x1b, 0x15, 0x21, 0xbc, 0x13, 0x11, 0xad, 0x54, 0xec, 0x7d, 0x14,
+  0x11, 0x5d, 0x25, 0x22, 0x84, 0x5d, 0xaf, 0xe1, 0x86, 0x27, 0xe0, 0x18, 0xac, 0x2f, 0x9d, 0x78,
+  0xc0, 0xa7, 0x9c, 0x4f, 0xa6, 0x17, 0x7f, 0xff, 0xf9, 0xea, 0xf7, 0xae, 0xfe, 0xff, 0xd3, 0xca,
+  0x15, 0xab, 0xd2, 0xe5, 0x8c, 0x2f, 0xdf, 0x5d, 0x70, 0xcf, 0xb5, 0x6c, 0xb8, 0x11, 0xf9, 0x4a,
+  0xd9, 0xc6, 0xae, 0xac, 0x83, 0x37, 0xcd, 0x89, 0x27, 0x53, 0xf1, 0x05, 0x5b, 0xaf, 0x2d, 0x4d,
+  0xda, 0xd8, 0x90, 0xb7, 0xc3, 0xf5, 0xd0, 0x1a, 0xd4, 0x8a, 0x4a, 0x76, 0xba, 0xdb, 0x90, 0x67,
+  0x7f, 0x5e, 0xa0, 0xaf, 0xb9, 0xc1, 0x9e, 0x2f, 0xa6, 0x57, 0x7b, 0xf4, 0xef, 0xd4, 0x9b, 0x2a,
+  0x12, 0xef, 0x5f, 0x3f, 0x6d, 0x7a, 0xc5, 0x75, 0xcc, 0xf3, 0xa6, 0x56, 0x57, 0xb4, 0x6f, 0x55,
+  0x67, 0x53, 0x5c, 0xcd, 0xce, 0x94, 0x17, 0x33, 0xd5, 0xa3, 0x0c, 0x5c, 0x51, 0x72, 0x4f, 0x06,
+  0xc7, 0xef, 0xdc, 0x05, 0x7f, 0xad, 0xb9, 0x1f, 0x82, 0xf3, 0x72, 0xd5, 0x56, 0xdb, 0xc6, 0xf9,
+  0xf9, 0x60, 0xb4, 0x0f, 0x63, 0x35, 0x09, 0xe9, 0x31, 0xdd, 0x59, 0xab, 0x57, 0xb6, 0xfd, 0xf9,
+  0xdb, 0x1b, 0xf1, 0xa7, 0xf3, 0xa0, 0x35, 0xf3, 0x0d, 0xcc, 0x27, 0x87, 0x9b, 0xd6, 0x07, 0xe0,
+  0x16, 0xef, 0xc3, 0xf4, 0xf5, 0xe6, 0xdf, 0xb0, 0x5c, 0x8f, 0xd0, 0x73, 0x74, 0x28, 0x9a, 0x57,
+  0xbf, 0x85, 0xc7, 0xb3, 0xcb, 0xbd, 0x3a, 0x6b, 0x21, 0x27, 0xc8, 0x27, 0xed, 0x52, 0xaf, 0x76,
+  0x6a, 0xc9, 0x6d, 0x47, 0x79, 0x12, 0xc3, 0x70, 0xf0, 0x6a, 0x02, 0xbf, 0xd6, 0xb5, 0x37, 0xb1,
+  0x51, 0xd1, 0x41, 0xf9, 0x0b, 0xe3, 0xae, 0x46, 0x8d, 0x56, 0xb0, 0x78, 0xd8, 0x20, 0xfd, 0xff,
+  0xfd, 0x19, 0xd0, 0xca, 0x2e, 0xb8, 0x4c, 0xd6, 0xbc, 0x38, 0x0c, 0x5f, 0xfc, 0xa3, 0xb5, 0x13,
+  0xd4, 0x42, 0x3e, 0x41, 0xc3, 0xbb, 0x22, 0x57, 0xd3, 0xd9, 0xb6, 0xe4, 0xd9, 0x1c, 0xd6, 0x2f,
+  0x25, 0xed, 0x7b, 0x7b, 0x21, 0x19, 0x8d, 0xcd, 0x08, 0xe2, 0xfd, 0xbd, 0x68, 0x7c, 0xf7, 0x74,
+  0x10, 0xab, 0xe1, 0xe6, 0x85, 0xa4, 0xbb, 0x72, 0xf4, 0xdb, 0x1b, 0xd9, 0x3f, 0x79, 0x45, 0xce,
+  0xb6, 0xa9, 0x09, 0x00, 0x00,
+};
+
+const WebAsset WEB_ASSETS[] = {
+  {"/style.css", "text/css", ASSET_STYLE_CSS, sizeof(ASSET_STYLE_CSS), "\"86e42f4ec2e9cd58\"", true},
+  {"/chart-lite.js", "application/javascript", ASSET_CHART_LITE_JS, sizeof(ASSET_CHART_LITE_JS), "\"1e324db512a1f18a\"", true},
+  {"/script.js", "application/javascript", ASSET_SCRIPT_JS, sizeof(ASSET_SCRIPT_JS), "\"58d5e293186b02a4\"", true},
+  {"/", "text/html", ASSET_INDEX_HTML, sizeof(ASSET_INDEX_HTML), "\"5819fa4acc764e3c\"", false},
+};
+
+const uint8_t WEB_ASSET_COUNT = sizeof(WEB_ASSETS) / sizeof(WEB_ASSETS[0]);
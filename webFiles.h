@@ -1,8 +1,27 @@
 #pragma once
 
 #include <pgmspace.h>
+#include <stdint.h>
 
-extern const char INDEX_HTML[];
-extern const char STYLE_CSS[];
-extern const char SCRIPT_JS[];
+/**
+ * @file webFiles.h
+ * @brief Dashboard assets served from flash.
+ *
+ * The sources live in web/; tools/gen_assets.py minifies and gzips them into
+ * webFiles.cpp. Every asset is stored gzip-encoded.
+ */
 
+/**
+ * @brief One precompressed asset.
+ */
+struct WebAsset {
+  const char *path;         ///< URL path
+  const char *contentType;
+  const uint8_t *data;      ///< Gzipped content (PROGMEM)
+  uint32_t length;
+  const char *etag;         ///< Strong ETag (quoted content hash)
+  bool immutable;           ///< Referenced with ?v=<hash>, so it may be cached forever
+};
+
+extern const WebAsset WEB_ASSETS[];
+extern const uint8_t WEB_ASSET_COUNT;
@@ -0,0 +1,184 @@
+/**
+ * @file wifiLink.cpp
+ * @brief Wi-Fi connection state machine with an RTC-cached fast reconnect.
+ *
+ * @details Phases: START picks the fast path when the RTC cache is valid,
+ * otherwise a full connection. FAST waits WIFI_FAST_TIMEOUT_MS for the cached
+ * access point, then falls back to FULL. FULL waits WIFI_CONNECT_TIMEOUT_MS,
+ * then backs off (WAIT) before starting over. UP checks the link every
+ * WIFI_CHECK_MS and starts over, on the fast path, when it is lost.
+ *
+ * The RTC cache is a magic number, the HalWifiLink of the last connection and
+ * a CRC-32, so garbage after a power cycle is never taken for a hint.
+ */
+#include "wifiLink.h"
+#include "hal.h"
+#include "eventLog.h"
+#include <string.h>
+
+enum WifiPhase : uint8_t { WIFI_START, WIFI_FAST, WIFI_FULL, WIFI_WAIT, WIFI_UP };
+
+/**
+ * @brief Layout of the RTC cache.
+ */
+struct WifiCache {
+  uint32_t magic;
+  HalWifiLink link;
+  uint32_t crc;      ///< CRC-32 of magic and link
+};
+
+static_assert(sizeof(WifiCache) % 4 == 0, "RTC memory is accessed in 32-bit words");
+
+static const uint32_t WIFI_CACHE_MAGIC = 0x57494631; // "WIF1"
+
+static WifiConfig cfg;
+static WifiMetrics metrics;
+static uint8_t  phase = WIFI_START;
+static uint32_t phaseStartMs = 0;
+static uint32_t downSinceMs = 0;   ///< Start of the current outage (or boot)
+static uint32_t backoffMs = WIFI_BACKOFF_MIN_MS;
+static bool     everUp = false;
+static WifiCache cache;
+static bool     cacheValid = false;
+
+static uint32_t crc32(const uint8_t *p, size_t len) {
+  uint32_t crc = 0xFFFFFFFFu;
+  while (len--) {
+    crc ^= *p++;
+    for (uint8_t i = 0; i < 8; i++) crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1)));
+  }
+  return ~crc;
+}
+
+static uint32_t cacheCrc(const WifiCache &c) {
+  return crc32((const uint8_t *)&c, offsetof(WifiCache, crc));
+}
+
+static void dropCache() {
+  cacheValid = false;
+  memset(&cache, 0, sizeof(cache));
+  halRtcWrite(&cache, sizeof(cache));
+}
+
+/**
+ * @brief Start an association attempt, from the cache if @p fast.
+ */
+static void startAttempt(bool fast, uint32_t now) {
+  metrics.attempts++;
+  halWifiBegin(cfg.ssid, cfg.password, fast ? &cache.link : nullptr);
+  phase = fast ? WIFI_FAST : WIFI_FULL;
+  phaseStartMs = now;
+}
+
+/**
+ * @brief The station is connected: cache the link and record the timings.
+ */
+static void linkUp(bool fast, uint32_t now) {
+  HalWifiLink link;
+  memset(&link, 0, sizeof(link)); // padding is part of the CRC
+  if (halWifiLinkInfo(link)) {
+    memset(&cache, 0, sizeof(cache));
+    cache.magic = WIFI_CACHE_MAGIC;
+    cache.link = link;
+    cache.crc = cacheCrc(cache);
+    cacheValid = halRtcWrite(&cache, sizeof(cache));
+  }
+
+  if (fast) metrics.fastHits++;
+  metrics.lastConnectMs = now - downSinceMs;
+  if (!everUp) {
+    everUp = true;
+    metrics.firstUpMs = now - metrics.startMs;
+    metrics.firstFast = fast;
+  } else {
+    metrics.reconnects++;
+  }
+  backoffMs = WIFI_BACKOFF_MIN_MS;
+  phase = WIFI_UP;
+  eventLog(EV_WIFI_UP, metrics.lastConnectMs, fast, metrics.attempts, link.ip);
+}
+
+/**
+ * @brief Load the RTC cache and schedule the first attempt (call in setup()).
+ *
+ * Returns at once; the connection is made by wifiLinkRun().
+ */
+void wifiLinkBegin(const WifiConfig &config) {
+  cfg = config;
+  memset(&metrics, 0, sizeof(metrics));
+  metrics.startMs = halMillis();
+  downSinceMs = metrics.startMs;
+  phase = WIFI_START;
+  backoffMs = WIFI_BACKOFF_MIN_MS;
+  everUp = false;
+
+  cacheValid = halRtcRead(&cache, sizeof(cache)) && cache.magic == WIFI_CACHE_MAGIC && cache.crc == cacheCrc(cache);
+}
+
+/**
+ * @brief Advance the connection; never blocks.
+ *
+ * @return Milliseconds until it wants to run again.
+ */
+uint32_t wifiLinkRun() {
+  const uint32_t now = halMillis();
+  switch (phase) {
+    case WIFI_WAIT:
+    case WIFI_START:
+      startAttempt(cacheValid, now);
+      return WIFI_POLL_MS;
+
+    case WIFI_FAST: {
+      const uint8_t st = halWifiState();
+      if (st == HAL_WIFI_CONNECTED) {
+        linkUp(true, now);
+        return WIFI_CHECK_MS;
+      }
+      if (st == HAL_WIFI_FAILED || (uint32_t)(now - phaseStartMs) >= WIFI_FAST_TIMEOUT_MS) {
+        // Access point moved or the address is stale: forget the cache, scan
+        metrics.fastMisses++;
+        dropCache();
+        halWifiDisconnect();
+        startAttempt(false, now);
+      }
+      return WIFI_POLL_MS;
+    }
+
+    case WIFI_FULL: {
+      const uint8_t st = halWifiState();
+      if (st == HAL_WIFI_CONNECTED) {
+        linkUp(false, now);
+        return WIFI_CHECK_MS;
+      }
+      if (st == HAL_WIFI_FAILED || (uint32_t)(now - phaseStartMs) >= WIFI_CONNECT_TIMEOUT_MS) {
+        halWifiDisconnect();
+        eventLog(EV_WIFI_RETRY, metrics.attempts, backoffMs);
+        phase = WIFI_WAIT;
+        const uint32_t wait = backoffMs;
+        backoffMs = backoffMs * 2 < WIFI_BACKOFF_MAX_MS ? backoffMs * 2 : WIFI_BACKOFF_MAX_MS;
+        return wait;
+      }
+      return WIFI_POLL_MS;
+    }
+
+    case WIFI_UP:
+    default:
+      if (halWifiState() == HAL_WIFI_CONNECTED) return WIFI_CHECK_MS;
+      eventLog(EV_WIFI_DOWN);
+      downSinceMs = now;
+      halWifiDisconnect();
+      startAttempt(cacheValid, now);
+      return WIFI_POLL_MS;
+  }
+}
+
+/**
+ * @brief True while the station is connected (as of the last wifiLinkRun()).
+ */
+bool wifiLinkUp() {
+  return phase == WIFI_UP;
+}
+
+void wifiLinkMetrics(WifiMetrics &out) {
+  out = metrics;
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include <stdint.h>
+
+/**
+ * @file wifiLink.h
+ * @brief Background Wi-Fi bring-up and reconnect, with an RTC-cached fast path.
+ *
+ * wifiLinkRun() is a scheduler task that never blocks, so the control loop
+ * runs from the first millisecond while the station associates.
+ *
+ * After every successful connection the access point (BSSID, channel) and the
+ * address configuration are cached in RTC memory, which survives resets.
+ * The next attempt, after a reboot or a lost link, goes straight to that
+ * access point with a static address: no scan and no DHCP, usually well under
+ * a second. If that does not work within WIFI_FAST_TIMEOUT_MS the cache is
+ * dropped and a full connection (scan + DHCP) follows.
+ */
+
+/// Give up on the cached access point after this long
+static const uint32_t WIFI_FAST_TIMEOUT_MS = 1500;
+/// Give up on a full connection (scan + DHCP) after this long
+static const uint32_t WIFI_CONNECT_TIMEOUT_MS = 20000;
+/// Delay after a failed full connection; doubles up to WIFI_BACKOFF_MAX_MS
+static const uint32_t WIFI_BACKOFF_MIN_MS = 1000;
+static const uint32_t WIFI_BACKOFF_MAX_MS = 30000;
+/// Status poll period while connecting, and while connected
+static const uint32_t WIFI_POLL_MS = 50;
+static const uint32_t WIFI_CHECK_MS = 500;
+
+/**
+ * @brief Network to join.
+ */
+struct WifiConfig {
+  const char *ssid;
+  const char *password;
+};
+
+/**
+ * @brief Connection timings and counters since boot.
+ */
+struct WifiMetrics {
+  uint32_t startMs;        ///< halMillis() when wifiLinkBegin() ran
+  uint32_t firstUpMs;      ///< Time from wifiLinkBegin() to the first connection (0 = not yet)
+  bool     firstFast;      ///< The first connection came from the RTC cache
+  uint32_t lastConnectMs;  ///< Time the latest connection took, from losing (or starting) to up
+  uint32_t attempts;       ///< Association attempts started
+  uint32_t fastHits;       ///< Attempts from the cache that connected
+  uint32_t fastMisses;     ///< Attempts from the cache that fell back to a full connection
+  uint32_t reconnects;     ///< Connections re-established after a loss
+};
+
+void     wifiLinkBegin(const WifiConfig &config);
+uint32_t wifiLinkRun();
+bool     wifiLinkUp();
+void     wifiLinkMetrics(WifiMetrics &out);
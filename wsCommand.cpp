@@ -0,0 +1,229 @@
+/**
+ * @file wsCommand.cpp
+ * @brief In-place parser and acknowledgement writer for dashboard commands.
+ *
+ * @details Tokens are [begin, end) ranges of the received payload; numbers are
+ * converted by hand, since strtof() needs a terminated string.
+ */
+#include "wsCommand.h"
+#include "telemetry.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+static bool isSpace(uint8_t c) {
+  return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+static bool isDigitChar(uint8_t c) {
+  return c >= '0' && c <= '9';
+}
+
+/// True if [p, end) is exactly the text @p word (case-insensitive if @p anyCase)
+static bool tokenIs(const uint8_t *p, const uint8_t *end, const char *word, bool anyCase) {
+  const size_t n = strlen(word);
+  if ((size_t)(end - p) != n) return false;
+  for (size_t i = 0; i < n; i++) {
+    uint8_t a = p[i], b = (uint8_t)word[i];
+    if (anyCase) {
+      if (a >= 'A' && a <= 'Z') a = (uint8_t)(a - 'A' + 'a');
+      if (b >= 'A' && b <= 'Z') b = (uint8_t)(b - 'A' + 'a');
+    }
+    if (a != b) return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Parse the unsigned integer [p, end); false unless it is all digits and fits.
+ */
+static bool parseUnsigned(const uint8_t *p, const uint8_t *end, uint32_t &out) {
+  if (p == end) return false;
+  uint32_t v = 0;
+  for (; p < end; p++) {
+    if (!isDigitChar(*p) || v > (INT32_MAX - 9) / 10) return false;
+    v = v * 10 + (uint32_t)(*p - '0');
+  }
+  out = v;
+  return true;
+}
+
+/**
+ * @brief Parse the decimal number [p, end): optional sign, digits, optional fraction.
+ */
+static bool parseDecimal(const uint8_t *p, const uint8_t *end, float &out) {
+  bool negative = false;
+  if (p < end && (*p == '-' || *p == '+')) negative = (*p++ == '-');
+  uint32_t whole = 0, frac = 0, scale = 1;
+  bool digits = false;
+  for (; p < end && isDigitChar(*p); p++) {
+    if (whole > 100000) return false; // far outside every range; keeps the float exact
+    whole = whole * 10 + (uint32_t)(*p - '0');
+    digits = true;
+  }
+  if (p < end && *p == '.') {
+    for (p++; p < end && isDigitChar(*p); p++) {
+      if (scale < 100000) { // further digits cannot change a setpoint
+        frac = frac * 10 + (uint32_t)(*p - '0');
+        scale *= 10;
+      }
+      digits = true;
+    }
+  }
+  if (!digits || p != end) return false;
+  const float v = (float)whole + (float)frac / (float)scale;
+  out = negative ? -v : v;
+  return true;
+}
+
+/**
+ * @brief Parse one trimmed, non-empty token into @p batch.
+ */
+static bool parseToken(const uint8_t *p, const uint8_t *end, WsCommandBatch &batch) {
+  if (*p == '#') {
+    uint32_t seq;
+    if (!parseUnsigned(p + 1, end, seq)) return false;
+    batch.seq = (int32_t)seq;
+    return true;
+  }
+
+  WsCommand cmd = {WS_CMD_READINGS, 0, false, 0.0f};
+  if (tokenIs(p, end, "getReadings", true)) {
+    cmd.kind = WS_CMD_READINGS;
+  } else if (tokenIs(p, end, TELEMETRY_PROTO_REQUEST, false)) {
+    cmd.kind = WS_CMD_PROTO;
+  } else if (end - p > 5 && tokenIs(p, p + 5, "rate:", false)) {
+    uint32_t ms;
+    if (!parseUnsigned(p + 5, end, ms)) return false;
+    cmd.kind = WS_CMD_RATE;
+    cmd.value = (float)ms;
+  } else {
+    // Setpoint "<T|H|L>[zone]:<value>"
+    if (*p == 'T') cmd.kind = WS_CMD_TEMP;
+    else if (*p == 'H') cmd.kind = WS_CMD_HUMIDITY;
+    else if (*p == 'L') cmd.kind = WS_CMD_LIGHT;
+    else return false;
+    const uint8_t *colon = (const uint8_t *)memchr(p, ':', (size_t)(end - p));
+    if (!colon) return false;
+    uint32_t zone = 0;
+    if (colon > p + 1 && (!parseUnsigned(p + 1, colon, zone) || zone >= ZONE_MAX)) return false;
+    cmd.zone = (uint8_t)zone;
+    if (!parseDecimal(colon + 1, end, cmd.value)) return false;
+  }
+
+  if (batch.count == WS_BATCH_MAX) return false;
+  batch.cmds[batch.count++] = cmd;
+  return true;
+}
+
+/**
+ * @brief Split the text payload [data, data + len) into commands.
+ *
+ * Commands are separated by ';' or line breaks and may be padded with blanks;
+ * empty ones are skipped. @p data is only read.
+ */
+void wsCommandParse(const uint8_t *data, size_t len, WsCommandBatch &batch) {
+  batch.seq = -1;
+  batch.count = 0;
+  batch.rejected = 0;
+
+  const uint8_t *p = data, *end = data + len;
+  while (p < end) {
+    const uint8_t *stop = p;
+    while (stop < end && *stop != ';' && *stop != '\n') stop++;
+    const uint8_t *b = p, *e = stop;
+    while (b < e && isSpace(*b)) b++;
+    while (e > b && isSpace(e[-1])) e--;
+    if (b < e && !parseToken(b, e, batch)) batch.rejected++;
+    p = stop + 1;
+  }
+}
+
+/**
+ * @brief Clamp a setpoint of @p kind into its accepted range (NAN becomes the minimum).
+ */
+float wsCommandClamp(uint8_t kind, float value) {
+  float lo, hi;
+  switch (kind) {
+    case WS_CMD_TEMP:     lo = WS_TEMP_MIN_C;       hi = WS_TEMP_MAX_C;       break;
+    case WS_CMD_HUMIDITY: lo = WS_HUMIDITY_MIN_PCT; hi = WS_HUMIDITY_MAX_PCT; break;
+    case WS_CMD_LIGHT:    lo = WS_LIGHT_MIN_H;      hi = WS_LIGHT_MAX_H;      break;
+    default: return value;
+  }
+  if (!(value >= lo)) return lo;
+  if (value > hi) return hi;
+  return value;
+}
+
+/**
+ * @brief Write the setpoints of @p batch into @p state, clamped.
+ *
+ * Setpoints for zones that are not in use are rejected. The state generation
+ * is bumped once for the whole frame. Other commands are left to the caller.
+ *
+ * @return Number of setpoints applied.
+ */
+uint8_t wsCommandApply(WsCommandBatch &batch, SharedState &state) {
+  uint8_t applied = 0;
+  for (uint8_t i = 0; i < batch.count; i++) {
+    WsCommand &cmd = batch.cmds[i];
+    if (cmd.kind > WS_CMD_LIGHT) continue;
+    if (cmd.zone >= state.zoneCount) {
+      batch.rejected++;
+      continue;
+    }
+    cmd.value = wsCommandClamp(cmd.kind, cmd.value);
+    if (cmd.kind == WS_CMD_TEMP) state.targetTempC[cmd.zone] = cmd.value;
+    else if (cmd.kind == WS_CMD_HUMIDITY) state.targetHumidityPct[cmd.zone] = cmd.value;
+    else state.targetLightHoursToday[cmd.zone] = cmd.value;
+    cmd.applied = true;
+    applied++;
+  }
+  if (applied) stateChanged(state);
+  return applied;
+}
+
+/**
+ * @brief True if the frame deserves an acknowledgement.
+ *
+ * Frames that only request readings or the binary protocol are answered by
+ * the readings themselves.
+ */
+bool wsCommandNeedsAck(const WsCommandBatch &batch) {
+  if (batch.seq >= 0 || batch.rejected) return true;
+  for (uint8_t i = 0; i < batch.count; i++) {
+    if (batch.cmds[i].kind <= WS_CMD_RATE) return true;
+  }
+  return false;
+}
+
+/**
+ * @brief Write the JSON acknowledgement of @p batch to @p out (always terminated).
+ *
+ * @return Length of the text; @p maxLen of WS_ACK_MAX always fits.
+ */
+size_t wsCommandAck(const WsCommandBatch &batch, char *out, size_t maxLen) {
+  static const char KIND_LETTERS[] = {'T', 'H', 'L'};
+  if (maxLen == 0) return 0;
+  size_t n = 0;
+  auto put = [&](int written) {
+    if (written > 0) n += (size_t)written;
+    if (n >= maxLen) n = maxLen - 1;
+  };
+
+  if (batch.seq >= 0) put(snprintf(out, maxLen, "{\"ack\":%ld,\"applied\":[", (long)batch.seq));
+  else put(snprintf(out, maxLen, "{\"ack\":null,\"applied\":["));
+  bool first = true;
+  for (uint8_t i = 0; i < batch.count; i++) {
+    const WsCommand &cmd = batch.cmds[i];
+    if (!cmd.applied) continue;
+    // Two decimals from an integer, so no float printf is needed
+    const long hundredths = lroundf(cmd.value * 100.0f);
+    const long mag = hundredths < 0 ? -hundredths : hundredths;
+    put(snprintf(out + n, maxLen - n, "%s{\"c\":\"%c\",\"z\":%u,\"v\":%s%ld.%02ld}", first ? "" : ",",
+                 KIND_LETTERS[cmd.kind], (unsigned)cmd.zone, hundredths < 0 ? "-" : "", mag / 100, mag % 100));
+    first = false;
+  }
+  put(snprintf(out + n, maxLen - n, "],\"rejected\":%u}", (unsigned)batch.rejected));
+  return n;
+}
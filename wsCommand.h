@@ -0,0 +1,80 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include "sharedState.h"
+
+/**
+ * @file wsCommand.h
+ * @brief Dashboard commands: in-place parser, setpoint ranges and acknowledgements.
+ *
+ * A text frame carries one or more commands separated by ';' (or newlines):
+ *  - `#<n>`               client sequence number, echoed in the acknowledgement
+ *  - `<T|H|L>[zone]:<v>`  setpoint (temperature, humidity, hours of light),
+ *                         zone 0 when the zone is omitted
+ *  - `rate:<ms>`          minimum time between two updates to this client
+ *  - `getReadings`        send the current readings now
+ *  - TELEMETRY_PROTO_REQUEST  switch to binary telemetry frames
+ *
+ * Example: `#12;T:23;H:55;L1:6`.
+ *
+ * The parser reads the payload where it lies and never allocates. A frame
+ * with a sequence number, a setpoint, a rate or a bad command is answered
+ * with one acknowledgement (JSON text) listing the values actually applied,
+ * after clamping to the ranges below:
+ *
+ *     {"ack":12,"applied":[{"c":"T","z":0,"v":23.00},{"c":"H","z":0,"v":55.00}],"rejected":0}
+ *
+ * "ack" is null when the frame had no sequence number.
+ */
+
+/// Commands one frame may carry (every target of every zone); further ones count as rejected
+static const uint8_t WS_BATCH_MAX = 3 * ZONE_MAX;
+/// Longest text message a client may send, also when fragmented
+static const uint16_t WS_MESSAGE_MAX = 128;
+/// Buffer that always holds wsCommandAck()'s reply
+static const size_t WS_ACK_MAX = 48 + WS_BATCH_MAX * 32;
+
+/// @name Accepted setpoint ranges (values outside are clamped)
+///@{
+static const float WS_TEMP_MIN_C = 0.0f;
+static const float WS_TEMP_MAX_C = 50.0f;
+static const float WS_HUMIDITY_MIN_PCT = 0.0f;
+static const float WS_HUMIDITY_MAX_PCT = 100.0f;
+static const float WS_LIGHT_MIN_H = 0.0f;
+static const float WS_LIGHT_MAX_H = 24.0f;
+///@}
+
+enum WsCommandKind : uint8_t {
+  WS_CMD_TEMP,
+  WS_CMD_HUMIDITY,
+  WS_CMD_LIGHT,
+  WS_CMD_RATE,
+  WS_CMD_READINGS,
+  WS_CMD_PROTO
+};
+
+/**
+ * @brief One parsed command.
+ */
+struct WsCommand {
+  uint8_t kind;   ///< WsCommandKind
+  uint8_t zone;   ///< Setpoints only
+  bool applied;   ///< Set by wsCommandApply()
+  float value;    ///< Setpoint (clamped once applied) or rate in ms
+};
+
+/**
+ * @brief All commands of one frame.
+ */
+struct WsCommandBatch {
+  int32_t seq;       ///< Client sequence number, -1 if none
+  uint8_t count;     ///< Entries in cmds
+  uint8_t rejected;  ///< Commands that did not parse, did not fit or named a missing zone
+  WsCommand cmds[WS_BATCH_MAX];
+};
+
+void   wsCommandParse(const uint8_t *data, size_t len, WsCommandBatch &batch);
+float  wsCommandClamp(uint8_t kind, float value);
+uint8_t wsCommandApply(WsCommandBatch &batch, SharedState &state);
+bool   wsCommandNeedsAck(const WsCommandBatch &batch);
+size_t wsCommandAck(const WsCommandBatch &batch, char *out, size_t maxLen);
@@ -0,0 +1,387 @@
+/**
+ * @file wsServer.cpp
+ * @brief WebSocket endpoint (/ws): commands in, change-driven telemetry out.
+ *
+ * @details
+ * Updates are pushed only when the state generation changed, never on a fixed timer.
+ * For each change the JSON text and the binary delta frame are serialized once, and
+ * sent in reference-counted AsyncWebSocketMessageBuffers that are shared by every
+ * client; a client whose rate limit held it back gets the same serialization later.
+ *
+ * Per client the server remembers:
+ *  - which protocol it negotiated (JSON text or binary, see telemetry.h),
+ *  - its maximum update rate (WS_MIN_INTERVAL_MS, or its own "rate:<ms>" request),
+ *  - whether it still has an update pending.
+ *
+ * A client that is rate-limited, or whose AsyncTCP queue is full, is skipped and its
+ * update stays pending; it later receives only the newest state, so a slow client can
+ * never make queued messages pile up on the heap. A binary client that missed a delta
+ * frame is sent a keyframe instead.
+ *
+ * Replies to a single client's request (getReadings, proto:bin2) and the acknowledgement
+ * of its commands (see wsCommand.h) go to that client only.
+ *
+ * The AsyncTCP callbacks never touch SharedState (see stateSync.h): setpoints are
+ * queued and applied by wsServerFanout() in loop(), which then acknowledges them and
+ * publishes a new snapshot; a text getReadings reply is built from that snapshot, and
+ * a keyframe request is served by the next fanout. A message that arrives in
+ * several pieces (TCP segments or WebSocket fragments) is collected in the client's
+ * WS_MESSAGE_MAX buffer; a message in one piece is parsed where it lies.
+ *
+ * Nothing here allocates except the library's own message objects, which every
+ * send needs (marked with HeapGuardAllow, see heapGuard.h): JSON text is written
+ * into static buffers and peers live in a fixed table.
+ */
+#include "wsServer.h"
+#include "telemetry.h"
+#include "hal.h"
+#include "eventLog.h"
+#include "wsCommand.h"
+#include "stateSync.h"
+#include "profiler.h"
+#include "heapGuard.h"
+#include "dataflow.h"
+
+/// Slowest rate a client may ask for
+static const uint16_t WS_MAX_INTERVAL_MS = 60000;
+
+/**
+ * @brief Bookkeeping for one connected client.
+ */
+struct WsPeer {
+  uint32_t id;            ///< AsyncWebSocketClient id, 0 = free slot
+  bool binary;            ///< True once the client asked for binary telemetry frames
+  bool pending;           ///< An update is waiting for this client
+  bool keyDue;            ///< The client asked for a keyframe
+  uint16_t lastSeq;       ///< Binary stream sequence number the client has
+  uint16_t minIntervalMs; ///< Minimum time between two updates
+  uint32_t lastSentMs;    ///< Time of the last update sent
+  uint16_t rxLen;         ///< Bytes of a pieced message collected so far
+  bool rxOverflow;        ///< The pieced message outgrew rx and is discarded
+  uint8_t rx[WS_MESSAGE_MAX];
+};
+
+/// Create a WebSocket object
+static AsyncWebSocket ws("/ws");
+
+static SharedState *shared = nullptr;
+static WsPeer peers[WS_MAX_CLIENTS];
+
+/// Generation of the state the clients were last marked pending for
+static uint32_t fanoutGeneration = 0;
+
+/// JSON text of the latest fanout
+static char jsonText[TELEMETRY_JSON_MAX];
+static size_t jsonLen = 0;            ///< 0 until jsonText was first written
+static uint32_t jsonGeneration = 0;   ///< State generation jsonText was written at
+
+/// Latest delta frame of the shared binary stream
+static uint8_t deltaFrame[TELEMETRY_FRAME_MAX];
+static size_t deltaLen = 0;
+static uint32_t deltaGeneration = 0;
+
+/**
+ * @brief Find the peer entry of client @p id (0 finds a free slot).
+ *
+ * @return The entry, or nullptr if none matches.
+ */
+static WsPeer *findPeer(uint32_t id) {
+  for (uint8_t i = 0; i < WS_MAX_CLIENTS; i++) {
+    if (peers[i].id == id) return &peers[i];
+  }
+  return nullptr;
+}
+
+/**
+ * @brief Copy @p len bytes into a new shared message buffer, locked for sending.
+ */
+static AsyncWebSocketMessageBuffer *makeShared(const uint8_t *data, size_t len) {
+  HeapGuardAllow allow;
+  AsyncWebSocketMessageBuffer *buffer = ws.makeBuffer(len);
+  if (!buffer) return nullptr;
+  memcpy(buffer->get(), data, len);
+  buffer->lock();
+  return buffer;
+}
+
+/**
+ * @brief Queue a shared text or binary buffer for @p client (the library allocates the message).
+ */
+static void sendShared(AsyncWebSocketClient *client, AsyncWebSocketMessageBuffer *buffer, bool binary) {
+  HeapGuardAllow allow;
+  if (binary) client->binary(buffer);
+  else client->text(buffer);
+}
+
+/**
+ * @brief Send the acknowledgement of @p batch to @p client if the frame needs one.
+ */
+static void sendAck(AsyncWebSocketClient *client, const WsCommandBatch &batch) {
+  if (!wsCommandNeedsAck(batch)) return;
+  char ack[WS_ACK_MAX];
+  const size_t ackLen = wsCommandAck(batch, ack, sizeof(ack));
+  HeapGuardAllow allow;
+  client->text(ack, ackLen);
+}
+
+/**
+ * @brief Execute one complete text message from @p client (network callback).
+ *
+ * @details
+ * Queues the setpoints (see wsCommand.h) for loop(), which acknowledges them
+ * once applied; answers data requests from the published snapshot, marks
+ * binary protocol requests (TELEMETRY_PROTO_REQUEST) for a keyframe, and takes
+ * "rate:<ms>" requests for a different update rate. A frame without setpoints,
+ * or one the full queue refused, is acknowledged here.
+ *
+ * @param client Sending client
+ * @param peer   Its bookkeeping (nullptr if all slots were taken)
+ * @param data   Message text (not terminated)
+ * @param len    Length of the message
+ * @param overflow The message was longer than WS_MESSAGE_MAX and was cut
+ */
+static void runCommands(AsyncWebSocketClient *client, WsPeer *peer, const uint8_t *data, size_t len, bool overflow) {
+  StateCommand cmd;
+  cmd.client = client->id();
+  WsCommandBatch &batch = cmd.batch;
+  wsCommandParse(data, len, batch);
+  if (overflow) {
+    batch.count = 0;   // never act on half a message
+    batch.rejected = 1;
+  }
+
+  uint8_t setpoints = 0;
+  for (uint8_t i = 0; i < batch.count; i++) {
+    const WsCommand &c = batch.cmds[i];
+    if (c.kind <= WS_CMD_LIGHT) {
+      setpoints++;
+    } else if (c.kind == WS_CMD_PROTO || (c.kind == WS_CMD_READINGS && peer && peer->binary)) {
+      if (peer) {
+        peer->binary = true;
+        peer->keyDue = true;
+      }
+    } else if (c.kind == WS_CMD_READINGS) {
+      static SharedState view; // callbacks never run concurrently with each other
+      static char reply[TELEMETRY_JSON_MAX];
+      stateSyncRead(view);
+      const size_t replyLen = getSensorReadings(view, reply, sizeof(reply));
+      HeapGuardAllow allow;
+      client->text(reply, replyLen);
+    } else if (c.kind == WS_CMD_RATE && peer) {
+      peer->minIntervalMs = (uint16_t)constrain((long)c.value, (long)WS_FANOUT_MS, (long)WS_MAX_INTERVAL_MS);
+    }
+  }
+
+  if (setpoints && stateSyncPost(cmd)) return; // loop() acknowledges
+  batch.rejected = (uint8_t)(batch.rejected + setpoints);
+  sendAck(client, batch);
+}
+
+/**
+ * @brief Apply the queued command frames, publish new setpoints and acknowledge them (loop() only).
+ */
+static void applyCommands(SharedState &state) {
+  StateCommand cmd;
+  while (stateSyncTake(cmd)) {
+    if (wsCommandApply(cmd.batch, state)) flowPublish(FLOW_TARGETS);
+    AsyncWebSocketClient *client = ws.client(cmd.client);
+    if (client && client->status() == WS_CONNECTED) sendAck(client, cmd.batch);
+  }
+}
+
+/**
+ * @brief Handle one piece of an incoming WebSocket message.
+ *
+ * @details A text message that arrives whole is parsed in place. Otherwise the
+ * pieces are appended to the client's buffer until the last one; a message
+ * longer than the buffer is discarded and rejected in its acknowledgement.
+ * Binary messages are ignored.
+ *
+ * @param client Sending client
+ * @param arg WebSocket frame information
+ * @param data Incoming message buffer
+ * @param len Length of the piece
+ */
+static void handleWebSocketMessage(AsyncWebSocketClient *client, void *arg, uint8_t *data, size_t len) {
+  AwsFrameInfo *info = (AwsFrameInfo*)arg;
+  if (info->message_opcode != WS_TEXT) return;
+
+  WsPeer *peer = findPeer(client->id());
+  const bool firstPiece = info->num == 0 && info->index == 0;
+  const bool lastPiece = info->final && info->index + len == info->len;
+
+  if (firstPiece && lastPiece) {
+    runCommands(client, peer, data, len, false);
+    return;
+  }
+  if (!peer) return; // no buffer to collect the pieces in
+
+  if (firstPiece) {
+    peer->rxLen = 0;
+    peer->rxOverflow = false;
+  }
+  if (peer->rxLen + len > WS_MESSAGE_MAX) {
+    peer->rxOverflow = true;
+  } else if (!peer->rxOverflow) {
+    memcpy(peer->rx + peer->rxLen, data, len);
+    peer->rxLen = (uint16_t)(peer->rxLen + len);
+  }
+  if (lastPiece) {
+    runCommands(client, peer, peer->rx, peer->rxLen, peer->rxOverflow);
+    peer->rxLen = 0;
+    peer->rxOverflow = false;
+  }
+}
+
+/**
+ * @brief Handle WebSocket connection events.
+ *
+ * @param server WebSocket server instance
+ * @param client Connected client
+ * @param type Event type
+ * @param arg Event-specific data
+ * @param data Payload data
+ * @param len Payload length
+ */
+static void onEvent(AsyncWebSocket *server, AsyncWebSocketClient *client, AwsEventType type, void *arg, uint8_t *data, size_t len) {
+  heapGuardEnter(HEAP_GUARD_CALLBACK);
+  switch (type) {
+    case WS_EVT_CONNECT:
+      eventLog(EV_WS_CONNECT, client->id(), (uint32_t)client->remoteIP());
+      if (WsPeer *slot = findPeer(0)) {
+        slot->id = client->id();
+        slot->binary = false;
+        slot->pending = false;
+        slot->keyDue = false;
+        slot->lastSeq = 0;
+        slot->minIntervalMs = WS_MIN_INTERVAL_MS;
+        slot->lastSentMs = halMillis() - WS_MIN_INTERVAL_MS;
+        slot->rxLen = 0;
+        slot->rxOverflow = false;
+      }
+      break;
+    case WS_EVT_DISCONNECT:
+      eventLog(EV_WS_DISCONNECT, client->id());
+      if (WsPeer *peer = findPeer(client->id())) peer->id = 0;
+      break;
+    case WS_EVT_DATA:
+      handleWebSocketMessage(client, arg, data, len);
+      break;
+    case WS_EVT_PONG:
+    case WS_EVT_ERROR:
+      break;
+  }
+  heapGuardLeave();
+}
+
+/**
+ * @brief Register the /ws endpoint on @p server.
+ *
+ * @param server Web server to attach to.
+ * @param state  Shared state that is published and whose targets clients may set.
+ */
+void wsServerBegin(AsyncWebServer &server, SharedState &state) {
+  shared = &state;
+  stateSyncBegin(state);
+  fanoutGeneration = state.generation;
+  deltaGeneration = state.generation;
+
+  ws.onEvent(onEvent);
+  server.addHandler(&ws);
+}
+
+/**
+ * @brief Apply queued commands, then push the latest state to every client that is due an update.
+ *
+ * Call every WS_FANOUT_MS. Also publishes the snapshot the network callbacks
+ * read. Sends nothing unless the state generation changed, some client still
+ * has an update pending or asked for a keyframe.
+ */
+void wsServerFanout() {
+  const uint32_t t = profStart();
+  SharedState &state = *shared;
+  applyCommands(state);
+  stateSyncPublish(state);
+
+  if (state.generation != fanoutGeneration) {
+    fanoutGeneration = state.generation;
+    for (uint8_t i = 0; i < WS_MAX_CLIENTS; i++) {
+      if (peers[i].id != 0) peers[i].pending = true;
+    }
+  }
+
+  const uint32_t now = halMillis();
+  AsyncWebSocketMessageBuffer *text = nullptr;
+  AsyncWebSocketMessageBuffer *delta = nullptr;
+  AsyncWebSocketMessageBuffer *key = nullptr;
+
+  for (uint8_t i = 0; i < WS_MAX_CLIENTS; i++) {
+    WsPeer &peer = peers[i];
+    if (peer.id == 0) continue;
+    if (!peer.keyDue) {
+      if (!peer.pending) continue;
+      if ((uint32_t)(now - peer.lastSentMs) < peer.minIntervalMs) continue; // stays pending
+    }
+
+    AsyncWebSocketClient *client = ws.client(peer.id);
+    if (!client || client->status() != WS_CONNECTED) continue;
+    if (client->queueIsFull()) continue; // slow client: coalesce into a later update
+
+    if (!peer.binary) {
+      if (!text) {
+        // Serialize at most once per state generation; clients held back by their rate reuse it.
+        if (jsonLen == 0 || jsonGeneration != state.generation) {
+          const uint32_t tr = profStart();
+          jsonLen = getSensorReadings(state, jsonText, sizeof(jsonText));
+          jsonGeneration = state.generation;
+          profEnd(PROF_READINGS, tr);
+        }
+        text = makeShared((const uint8_t *)jsonText, jsonLen);
+        if (!text) break;
+      }
+      sendShared(client, text, false);
+    } else {
+      // Encode the next delta frame at most once per state generation.
+      if (deltaGeneration != state.generation) {
+        deltaGeneration = state.generation;
+        const size_t len = telemetryEncodeDelta(state, deltaFrame);
+        if (len > 0) deltaLen = len;
+      }
+
+      const uint16_t seq = telemetrySeq();
+      if (peer.keyDue || peer.lastSeq != seq) {
+        if (!peer.keyDue && deltaLen > 0 && (uint16_t)(peer.lastSeq + 1) == seq) {
+          if (!delta) delta = makeShared(deltaFrame, deltaLen);
+          if (delta) sendShared(client, delta, true);
+        } else {
+          if (!key) {
+            uint8_t frame[TELEMETRY_FRAME_MAX];
+            key = makeShared(frame, telemetryEncodeSnapshot(state, frame));
+          }
+          if (key) sendShared(client, key, true);
+        }
+        peer.lastSeq = seq;
+        peer.keyDue = false;
+      }
+    }
+
+    peer.pending = false;
+    peer.lastSentMs = now;
+  }
+
+  if (text) text->unlock();
+  if (delta) delta->unlock();
+  if (key) key->unlock();
+  // makeBuffer() keeps every buffer on the socket's list until _cleanBuffers() drops the
+  // unlocked ones; the library only does that from textAll()/binaryAll(), which the
+  // per-client sends above cannot use. Without this call each fanout would leak its buffers.
+  if (text || delta || key) ws._cleanBuffers();
+  profEnd(PROF_WS, t);
+}
+
+/**
+ * @brief Drop disconnected clients and close the oldest beyond WS_MAX_CLIENTS (call about once per second).
+ */
+void wsServerCleanup() {
+  ws.cleanupClients(WS_MAX_CLIENTS);
+}
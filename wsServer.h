@@ -0,0 +1,21 @@
+#pragma once
+#include <ESPAsyncWebServer.h>
+#include "sharedState.h"
+
+/**
+ * @file wsServer.h
+ * @brief WebSocket endpoint (/ws) for the dashboard.
+ */
+
+/// Maximum simultaneous WebSocket clients (the library's ESP8266 default); wsServerCleanup() closes the oldest beyond it
+static const uint8_t WS_MAX_CLIENTS = 4;
+
+/// Period at which wsServerFanout() should be called
+static const uint32_t WS_FANOUT_MS = 50;
+
+/// Default minimum time between two updates to the same client
+static const uint16_t WS_MIN_INTERVAL_MS = 250;
+
+void wsServerBegin(AsyncWebServer &server, SharedState &state);
+void wsServerFanout();
+void wsServerCleanup();
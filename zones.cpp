@@ -0,0 +1,40 @@
+/**
+ * @file zones.cpp
+ * @brief Pin assignment of the greenhouse zones driven by this board.
+ *
+ * @details All zones share the one analog input (the LDR) and so share the
+ * ambient light reading; everything else is per zone.
+ */
+#include "zones.h"
+
+static ZonePins pinTable[ZONE_MAX] = {ZONE_DEFAULT_PINS};
+static uint8_t count = 1;
+
+/**
+ * @brief Set the zones in use and their pins.
+ *
+ * @param state Shared state; its zoneCount is set.
+ * @param pins  One entry per zone.
+ * @param n     Number of zones, clamped to 1..ZONE_MAX.
+ */
+void zonesBegin(SharedState &state, const ZonePins *pins, uint8_t n) {
+  if (n < 1) n = 1;
+  if (n > ZONE_MAX) n = ZONE_MAX;
+  for (uint8_t z = 0; z < n; z++) pinTable[z] = pins[z];
+  count = n;
+  state.zoneCount = n;
+}
+
+/**
+ * @brief Number of zones in use.
+ */
+uint8_t zoneCount() {
+  return count;
+}
+
+/**
+ * @brief Pins of @p zone (0 .. zoneCount() - 1).
+ */
+const ZonePins &zonePins(uint8_t zone) {
+  return pinTable[zone < count ? zone : 0];
+}
@@ -0,0 +1,29 @@
+#pragma once
+#include <stdint.h>
+#include "sharedState.h"
+
+/**
+ * @file zones.h
+ * @brief Pin assignment of the greenhouse zones driven by this board.
+ *
+ * Call zonesBegin() in setup() before the sensor and actuator modules are
+ * initialised; they look their pins up here.
+ */
+
+/**
+ * @brief Pins of one zone.
+ */
+struct ZonePins {
+  uint8_t dht;          ///< DHT11 data line (needs interrupt support)
+  uint8_t heater;       ///< Heater output
+  uint8_t mister;       ///< Mister output
+  uint8_t lamp;         ///< Grow lamp output
+  bool misterActiveLow; ///< Mister module switches on with a LOW level
+};
+
+/// The original single-zone wiring, used until zonesBegin() is called
+static const ZonePins ZONE_DEFAULT_PINS = {D7, D2, D1, D5, true};
+
+void zonesBegin(SharedState &state, const ZonePins *pins, uint8_t count);
+uint8_t zoneCount();
+const ZonePins &zonePins(uint8_t zone);